@@ -140,6 +140,8 @@ HEADERS += sources/document_saver.h
 SOURCES += sources/document_saver.cc
 HEADERS += sources/document_window.h
 SOURCES += sources/document_window.cc
+HEADERS += sources/ds3_deflate.h
+SOURCES += sources/ds3_deflate.cc
 HEADERS += sources/steps_replay_window.h
 SOURCES += sources/steps_replay_window.cc
 HEADERS += sources/turnaround_overlay_widget.h
@@ -173,6 +175,8 @@ SOURCES += sources/log_browser.cc
 HEADERS += sources/log_browser_dialog.h
 SOURCES += sources/log_browser_dialog.cc
 SOURCES += sources/main.cc
+HEADERS += sources/mesh_generation_scheduler.h
+SOURCES += sources/mesh_generation_scheduler.cc
 HEADERS += sources/mesh_generator.h
 SOURCES += sources/mesh_generator.cc
 HEADERS += sources/mesh_preview_images_generator.h
@@ -283,6 +287,7 @@ SOURCES += ../dust3d/base/cut_face.cc
 HEADERS += ../dust3d/base/debug.h
 HEADERS += ../dust3d/base/ds3_file.h
 SOURCES += ../dust3d/base/ds3_file.cc
+HEADERS += ../dust3d/base/flat_hash_map.h
 HEADERS += ../dust3d/base/math.h
 HEADERS += ../dust3d/base/matrix4x4.h
 HEADERS += ../dust3d/base/object.h
@@ -293,12 +298,20 @@ SOURCES += ../dust3d/base/position_key.cc
 HEADERS += ../dust3d/base/quaternion.h
 HEADERS += ../dust3d/base/rectangle.h
 HEADERS += ../dust3d/base/snapshot.h
+HEADERS += ../dust3d/base/snapshot_binary.h
+SOURCES += ../dust3d/base/snapshot_binary.cc
+HEADERS += ../dust3d/base/snapshot_history.h
+SOURCES += ../dust3d/base/snapshot_history.cc
+HEADERS += ../dust3d/base/snapshot_view.h
+SOURCES += ../dust3d/base/snapshot_view.cc
 HEADERS += ../dust3d/base/snapshot_xml.h
 SOURCES += ../dust3d/base/snapshot_xml.cc
 HEADERS += ../dust3d/base/string.h
 SOURCES += ../dust3d/base/string.cc
 HEADERS += ../dust3d/base/texture_type.h
 SOURCES += ../dust3d/base/texture_type.cc
+HEADERS += ../dust3d/base/thread_pool.h
+SOURCES += ../dust3d/base/thread_pool.cc
 HEADERS += ../dust3d/base/vector3.h
 SOURCES += ../dust3d/base/vector3.cc
 HEADERS += ../dust3d/base/vector2.h
@@ -326,6 +339,16 @@ HEADERS += ../dust3d/animation/snake/die.h
 HEADERS += ../dust3d/animation/quadruped/walk.h
 HEADERS += ../dust3d/mesh/base_normal.h
 SOURCES += ../dust3d/animation/animation_generator.cc
+HEADERS += ../dust3d/animation/animation_registry.h
+SOURCES += ../dust3d/animation/animation_registry.cc
+HEADERS += ../dust3d/animation/bone_pose.h
+SOURCES += ../dust3d/animation/bone_pose.cc
+HEADERS += ../dust3d/animation/bone_position_tracks.h
+SOURCES += ../dust3d/animation/bone_position_tracks.cc
+HEADERS += ../dust3d/animation/mesh_skinner.h
+SOURCES += ../dust3d/animation/mesh_skinner.cc
+HEADERS += ../dust3d/animation/reduce_keyframes.h
+SOURCES += ../dust3d/animation/reduce_keyframes.cc
 HEADERS += ../dust3d/animation/sound_generator.h
 SOURCES += ../dust3d/animation/sound_generator.cc
 HEADERS += ../dust3d/animation/sound_event_detector.h
@@ -412,6 +435,8 @@ HEADERS += ../dust3d/mesh/hole_wrapper.h
 SOURCES += ../dust3d/mesh/hole_wrapper.cc
 HEADERS += ../dust3d/mesh/mesh_combiner.h
 SOURCES += ../dust3d/mesh/mesh_combiner.cc
+HEADERS += ../dust3d/mesh/mesh_dependency_graph.h
+SOURCES += ../dust3d/mesh/mesh_dependency_graph.cc
 HEADERS += ../dust3d/mesh/mesh_generator.h
 SOURCES += ../dust3d/mesh/mesh_generator.cc
 HEADERS += ../dust3d/mesh/mesh_node.h
@@ -419,6 +444,10 @@ HEADERS += ../dust3d/mesh/mesh_recombiner.h
 SOURCES += ../dust3d/mesh/mesh_recombiner.cc
 HEADERS += ../dust3d/mesh/mesh_state.h
 SOURCES += ../dust3d/mesh/mesh_state.cc
+HEADERS += ../dust3d/mesh/optimize_vertex_cache.h
+SOURCES += ../dust3d/mesh/optimize_vertex_cache.cc
+HEADERS += ../dust3d/mesh/part_mesh_cache.h
+SOURCES += ../dust3d/mesh/part_mesh_cache.cc
 HEADERS += ../dust3d/mesh/re_triangulator.h
 SOURCES += ../dust3d/mesh/re_triangulator.cc
 HEADERS += ../dust3d/mesh/resolve_triangle_tangent.h
@@ -440,6 +469,8 @@ HEADERS += ../dust3d/mesh/trim_vertices.h
 SOURCES += ../dust3d/mesh/trim_vertices.cc
 HEADERS += ../dust3d/mesh/tube_mesh_builder.h
 SOURCES += ../dust3d/mesh/tube_mesh_builder.cc
+HEADERS += ../dust3d/mesh/weld_vertices.h
+SOURCES += ../dust3d/mesh/weld_vertices.cc
 HEADERS += ../dust3d/rig/rig_generator.h
 SOURCES += ../dust3d/rig/rig_generator.cc
 HEADERS += ../dust3d/uv/chart_packer.h
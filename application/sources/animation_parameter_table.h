@@ -1,6 +1,7 @@
 #ifndef DUST3D_APPLICATION_ANIMATION_PARAMETER_TABLE_H_
 #define DUST3D_APPLICATION_ANIMATION_PARAMETER_TABLE_H_
 
+#include <dust3d/animation/animation_registry.h>
 #include <functional>
 #include <string>
 #include <unordered_map>
@@ -46,30 +47,30 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
 {
     static const std::vector<AnimationParameterDef> empty;
 
-    static const std::unordered_map<std::string, std::vector<AnimationParameterDef>> table = {
-        { "InsectWalk", {
+    static const std::unordered_map<dust3d::AnimationId, std::vector<AnimationParameterDef>> table = {
+        { dust3d::AnimationId::InsectWalk, {
                             makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                             makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                             makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
                             makeLinearParam("gaitSpeedFactor", "Gait Speed", 100, 25, 200, 1.0, 10.0),
                         } },
-        { "InsectForward", {
+        { dust3d::AnimationId::InsectForward, {
                                makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                                makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                                makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
                                makeLinearParam("gaitSpeedFactor", "Gait Speed", 100, 25, 200, 1.0, 10.0),
                            } },
-        { "InsectFly", {
+        { dust3d::AnimationId::InsectFly, {
                            makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                            makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                            makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
                            makeLinearParam("gaitSpeedFactor", "Gait Speed", 100, 25, 200, 1.0, 10.0),
                        } },
-        { "InsectAttack", {
+        { dust3d::AnimationId::InsectAttack, {
                               makeDiv100Param("attackSpeedFactor", "Attack Speed", 100, 25, 200, 1.0),
                               makeDiv100Param("diveIntensityFactor", "Dive Intensity", 100, 25, 200, 1.0),
                           } },
-        { "InsectRubHands", {
+        { dust3d::AnimationId::InsectRubHands, {
                                 makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                                 makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                                 makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
@@ -77,26 +78,26 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                                 makeDiv100Param("rubForwardOffsetFactor", "Rub Forward Offset", 100, 25, 200, 1.0),
                                 makeDiv100Param("rubUpOffsetFactor", "Rub Up Offset", 100, 25, 200, 1.0),
                             } },
-        { "InsectDie", {
+        { dust3d::AnimationId::InsectDie, {
                            makeDiv100Param("lengthStiffness", "Length Stiffness", 90, 10, 200, 0.9),
                            makeDiv100Param("parentStiffness", "Parent Stiffness", 80, 10, 200, 0.8),
                            makeDirectParam("maxJointAngleDeg", "Max Joint Angle", 120, 60, 180, 120.0),
                            makeDiv100Param("damping", "Damping", 95, 50, 99, 0.95),
                            makeDiv100Param("groundBounce", "Ground Bounce", 22, 0, 100, 0.22),
                        } },
-        { "BirdForward", {
+        { dust3d::AnimationId::BirdForward, {
                              makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                              makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                              makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
                              makeLinearParam("gaitSpeedFactor", "Gait Speed", 100, 25, 200, 1.0, 10.0),
                          } },
-        { "BirdFly", {
+        { dust3d::AnimationId::BirdFly, {
                          makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                          makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                          makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
                          makeLinearParam("gaitSpeedFactor", "Gait Speed", 100, 25, 200, 1.0, 10.0),
                      } },
-        { "BirdWalk", {
+        { dust3d::AnimationId::BirdWalk, {
                           makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                           makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                           makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
@@ -107,7 +108,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                           makeDiv100Param("wingSpreadFactor", "Wing Spread", 0, 0, 200, 0.0),
                           makeDiv100Param("footSpreadFactor", "Foot Spread", 0, 0, 200, 0.0),
                       } },
-        { "BirdRun", {
+        { dust3d::AnimationId::BirdRun, {
                          makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                          makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                          makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
@@ -119,7 +120,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                          makeDiv100Param("wingSpreadFactor", "Wing Spread", 0, 0, 200, 0.0),
                          makeDiv100Param("footSpreadFactor", "Foot Spread", 0, 0, 200, 0.0),
                      } },
-        { "BirdGlide", {
+        { dust3d::AnimationId::BirdGlide, {
                            makeDiv100Param("bankAmplitudeFactor", "Bank Amplitude", 100, 0, 300, 1.0),
                            makeDiv100Param("altitudeOscFactor", "Altitude Oscillation", 100, 0, 300, 1.0),
                            makeDiv100Param("wingTipFlexFactor", "Wing Tip Flex", 100, 0, 300, 1.0),
@@ -127,7 +128,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                            makeDiv100Param("headStabilizeFactor", "Head Stabilize", 100, 0, 200, 1.0),
                            makeDiv100Param("tailSteerFactor", "Tail Steer", 100, 0, 300, 1.0),
                        } },
-        { "BirdAttack", {
+        { dust3d::AnimationId::BirdAttack, {
                             makeDiv100Param("divePitchFactor", "Dive Pitch", 100, 25, 300, 1.0),
                             makeDiv100Param("diveDepthFactor", "Dive Depth", 100, 25, 300, 1.0),
                             makeDiv100Param("wingTuckFactor", "Wing Tuck", 100, 25, 300, 1.0),
@@ -135,7 +136,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                             makeDiv100Param("recoverySpeedFactor", "Recovery Speed", 100, 25, 300, 1.0),
                             makeDiv100Param("headTrackFactor", "Head Track", 100, 0, 200, 1.0),
                         } },
-        { "BirdEat", {
+        { dust3d::AnimationId::BirdEat, {
                          makeDiv100Param("peckSpeedFactor", "Peck Speed", 100, 25, 300, 1.0),
                          makeDiv100Param("peckDepthFactor", "Peck Depth", 100, 25, 200, 1.0),
                          makeDiv100Param("bodyLeanFactor", "Body Lean", 100, 25, 200, 1.0),
@@ -143,7 +144,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                          makeDiv100Param("headShakeFactor", "Head Shake", 100, 0, 300, 1.0),
                          makeDiv100Param("crouchFactor", "Crouch", 100, 25, 200, 1.0),
                      } },
-        { "BirdDie", {
+        { dust3d::AnimationId::BirdDie, {
                          makeDiv100Param("collapseSpeedFactor", "Collapse Speed", 100, 10, 300, 1.0),
                          makeDiv100Param("wingFlapFactor", "Wing Flap", 100, 0, 300, 1.0),
                          makeDiv100Param("rollIntensityFactor", "Roll Intensity", 100, 0, 300, 1.0),
@@ -153,7 +154,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                          makeDiv100Param("damping", "Damping", 95, 50, 99, 0.95),
                          makeDiv100Param("groundBounce", "Ground Bounce", 22, 0, 100, 0.22),
                      } },
-        { "FishForward", {
+        { dust3d::AnimationId::FishForward, {
                              makeLinearParam("bodyBob", "Body Bob", 100, 0, 300, 0.02, 5000.0),
                              makeDiv100Param("swimSpeedFactor", "Swim Speed", 100, 25, 300, 1.0),
                              makeLinearParam("swimFrequency", "Swim Frequency", 100, 25, 400, 2.0, 50.0),
@@ -169,7 +170,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                              makeDiv100Param("pectoralPhaseOffset", "Pectoral Phase Offset", 0, -200, 200, 0.0),
                              makeDiv100Param("pelvicPhaseOffset", "Pelvic Phase Offset", 50, -200, 200, 0.5),
                          } },
-        { "FishSwim", {
+        { dust3d::AnimationId::FishSwim, {
                           makeLinearParam("bodyBob", "Body Bob", 100, 0, 300, 0.02, 5000.0),
                           makeDiv100Param("swimSpeedFactor", "Swim Speed", 100, 25, 300, 1.0),
                           makeLinearParam("swimFrequency", "Swim Frequency", 100, 25, 400, 2.0, 50.0),
@@ -185,7 +186,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                           makeDiv100Param("pectoralPhaseOffset", "Pectoral Phase Offset", 0, -200, 200, 0.0),
                           makeDiv100Param("pelvicPhaseOffset", "Pelvic Phase Offset", 50, -200, 200, 0.5),
                       } },
-        { "FishDie", {
+        { dust3d::AnimationId::FishDie, {
                          makeDiv100Param("hitIntensityFactor", "Hit Intensity", 100, 10, 300, 1.0),
                          { "hitFrequency", "Hit Frequency", 100, 20, 300, 8.0, [](int v) { return v / 100.0 * 8.0; }, [](double v) { return static_cast<int>(v / 8.0 * 100); } },
                          makeDiv100Param("flipSpeedFactor", "Flip Speed", 100, 25, 400, 1.0),
@@ -194,7 +195,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                          makeDiv100Param("finFlopFactor", "Fin Flop", 100, 0, 300, 1.0),
                          { "spinDecay", "Spin Decay", 100, 10, 300, 4.0, [](int v) { return v / 100.0 * 4.0; }, [](double v) { return static_cast<int>(v / 4.0 * 100); } },
                      } },
-        { "SnakeForward", {
+        { dust3d::AnimationId::SnakeForward, {
                               makeDiv100Param("waveSpeedFactor", "Wave Speed", 100, 25, 300, 1.0),
                               makeLinearParam("waveFrequency", "Wave Frequency", 100, 25, 400, 2.0, 50.0),
                               makeLinearParam("waveAmplitude", "Wave Amplitude", 100, 10, 300, 0.15, 667.0),
@@ -205,7 +206,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                               makeLinearParam("jawAmplitude", "Jaw Amplitude", 200, 0, 600, 0.25, 500.0),
                               makeDiv100Param("jawFrequency", "Jaw Frequency", 100, 0, 600, 1.0),
                           } },
-        { "SnakeSlither", {
+        { dust3d::AnimationId::SnakeSlither, {
                               makeDiv100Param("waveSpeedFactor", "Wave Speed", 100, 25, 300, 1.0),
                               makeLinearParam("waveFrequency", "Wave Frequency", 100, 25, 400, 2.0, 50.0),
                               makeLinearParam("waveAmplitude", "Wave Amplitude", 100, 10, 300, 0.15, 667.0),
@@ -216,12 +217,12 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                               makeLinearParam("jawAmplitude", "Jaw Amplitude", 200, 0, 600, 0.25, 500.0),
                               makeDiv100Param("jawFrequency", "Jaw Frequency", 100, 0, 600, 1.0),
                           } },
-        { "SnakeDie", {
+        { dust3d::AnimationId::SnakeDie, {
                           makeDiv100Param("flipSpeedFactor", "Flip Speed", 100, 25, 400, 1.0),
                           makeDirectParam("flipAngle", "Flip Angle", 180, 0, 180, 180.0),
                           makeDirectParam("jawOpen", "Jaw Open", 63, 0, 63, 63.0),
                       } },
-        { "QuadrupedWalk", {
+        { dust3d::AnimationId::QuadrupedWalk, {
                                makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                                makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                                makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
@@ -232,7 +233,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                                makeDiv100Param("backKneeBendFactor", "Back Knee Bend", 100, 10, 400, 1.0),
                                makeDiv100Param("crouchFactor", "Crouch", 0, 0, 100, 0.0),
                            } },
-        { "QuadrupedRun", {
+        { dust3d::AnimationId::QuadrupedRun, {
                               makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                               makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                               makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
@@ -247,7 +248,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                               makeDiv100Param("backKneeBendFactor", "Back Knee Bend", 100, 10, 400, 1.0),
                               makeDiv100Param("crouchFactor", "Crouch", 0, 0, 100, 0.0),
                           } },
-        { "QuadrupedAttack", {
+        { dust3d::AnimationId::QuadrupedAttack, {
                                  makeDiv100Param("chargeDistanceFactor", "Charge Distance", 100, 25, 300, 1.0),
                                  makeDiv100Param("chargeSpeedFactor", "Charge Speed", 100, 25, 300, 1.0),
                                  makeDiv100Param("headDropFactor", "Head Drop", 100, 25, 250, 1.0),
@@ -260,7 +261,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                                  makeDiv100Param("bodyMassFactor", "Body Mass", 100, 25, 300, 1.0),
                                  makeDiv100Param("recoverySpeed", "Recovery Speed", 100, 25, 300, 1.0),
                              } },
-        { "QuadrupedEat", {
+        { dust3d::AnimationId::QuadrupedEat, {
                               makeDiv100Param("headLowerDepthFactor", "Head Lower Depth", 100, 25, 200, 1.0),
                               makeDiv100Param("neckCurveFactor", "Neck Curve", 100, 25, 200, 1.0),
                               makeDiv100Param("jawChewFactor", "Jaw Chew", 100, 0, 200, 1.0),
@@ -275,7 +276,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                               makeDiv100Param("tailSwayFactor", "Tail Sway", 100, 25, 200, 1.0),
                               makeDiv100Param("bodyShiftFactor", "Body Shift", 100, 25, 200, 1.0),
                           } },
-        { "QuadrupedHurt", {
+        { dust3d::AnimationId::QuadrupedHurt, {
                                makeDiv100Param("recoilIntensity", "Recoil Intensity", 100, 25, 300, 1.0),
                                makeDiv100Param("staggerAmplitude", "Stagger Amplitude", 100, 25, 300, 1.0),
                                makeLinearParam("hitDirection", "Hit Direction", 0, -100, 100, 0.0, 100.0),
@@ -287,7 +288,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                                makeDiv100Param("recoverySpeed", "Recovery Speed", 100, 25, 300, 1.0),
                                makeDiv100Param("bodyMassFactor", "Body Mass", 100, 25, 300, 1.0),
                            } },
-        { "QuadrupedRoar", {
+        { dust3d::AnimationId::QuadrupedRoar, {
                                makeDiv100Param("roarIntensity", "Roar Intensity", 100, 25, 300, 1.0),
                                makeDiv100Param("chestPuffFactor", "Chest Puff", 100, 25, 300, 1.0),
                                makeDiv100Param("headThrowFactor", "Head Throw", 100, 25, 300, 1.0),
@@ -304,7 +305,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                                makeDiv100Param("frontLegBendDirection", "Front Knee Direction", 50, -100, 100, 0.5),
                                makeDiv100Param("backLegBendDirection", "Back Knee Direction", -50, -100, 100, -0.5),
                            } },
-        { "QuadrupedDie", {
+        { dust3d::AnimationId::QuadrupedDie, {
                               makeDiv100Param("collapseSpeedFactor", "Collapse Speed", 100, 10, 300, 1.0),
                               makeDiv100Param("legSpreadFactor", "Leg Spread", 100, 10, 300, 1.0),
                               makeDiv100Param("rollIntensityFactor", "Roll Intensity", 100, 0, 300, 1.0),
@@ -314,7 +315,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                               makeDiv100Param("damping", "Damping", 95, 50, 99, 0.95),
                               makeDiv100Param("groundBounce", "Ground Bounce", 22, 0, 100, 0.22),
                           } },
-        { "BipedWalk", {
+        { dust3d::AnimationId::BipedWalk, {
                            makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                            makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                            makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
@@ -330,7 +331,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                            makeDiv100Param("forearmPhaseOffset", "Forearm Phase Offset", 50, 0, 100, 0.5),
                            makeDiv100Param("tailSwayFactor", "Tail Sway", 100, 25, 200, 1.0),
                        } },
-        { "BipedRun", {
+        { dust3d::AnimationId::BipedRun, {
                           makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                           makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                           makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
@@ -348,7 +349,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                           makeDiv100Param("suspensionFactor", "Suspension", 100, 25, 200, 1.0),
                           makeDiv100Param("strideFrequencyFactor", "Stride Frequency", 100, 25, 200, 1.0),
                       } },
-        { "BipedJump", {
+        { dust3d::AnimationId::BipedJump, {
                            makeDiv100Param("jumpHeightFactor", "Jump Height", 100, 25, 300, 1.0),
                            makeDiv100Param("crouchDepthFactor", "Crouch Depth", 100, 25, 200, 1.0),
                            makeDiv100Param("armRaiseFactor", "Arm Raise", 100, 0, 200, 1.0),
@@ -367,7 +368,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                            makeDiv100Param("tailStiffnessFactor", "Tail Stiffness", 100, 25, 200, 1.0),
                            makeDiv100Param("tailSwayFactor", "Tail Sway", 100, 0, 200, 1.0),
                        } },
-        { "BipedRoar", {
+        { dust3d::AnimationId::BipedRoar, {
                            makeDiv100Param("roarIntensity", "Roar Intensity", 100, 25, 300, 1.0),
                            makeDiv100Param("chestPuffFactor", "Chest Puff", 100, 25, 300, 1.0),
                            makeDiv100Param("headThrowFactor", "Head Throw", 100, 25, 300, 1.0),
@@ -381,7 +382,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                            makeDiv100Param("backChargeFactor", "Back Charge", 100, 25, 300, 1.0),
                            makeDiv100Param("forwardThrustFactor", "Forward Thrust", 100, 25, 300, 1.0),
                        } },
-        { "BipedHurt", {
+        { dust3d::AnimationId::BipedHurt, {
                            makeDiv100Param("recoilIntensity", "Recoil Intensity", 100, 25, 300, 1.0),
                            makeDiv100Param("staggerAmplitude", "Stagger Amplitude", 100, 25, 300, 1.0),
                            makeLinearParam("hitDirection", "Hit Direction", 0, -100, 100, 0.0, 100.0),
@@ -393,7 +394,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                            makeDiv100Param("recoverySpeed", "Recovery Speed", 100, 25, 300, 1.0),
                            makeDiv100Param("bodyMassFactor", "Body Mass", 100, 25, 300, 1.0),
                        } },
-        { "BipedSlam", {
+        { dust3d::AnimationId::BipedSlam, {
                            makeDiv100Param("slamForceFactor", "Slam Force", 100, 25, 200, 1.0),
                            makeDiv100Param("windupHeightFactor", "Windup Height", 100, 25, 200, 1.0),
                            makeDiv100Param("spineArchFactor", "Spine Arch", 100, 0, 200, 1.0),
@@ -404,7 +405,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                            makeDiv100Param("tailWhipFactor", "Tail Whip", 100, 0, 200, 1.0),
                            makeDiv100Param("armSpreadFactor", "Arm Spread", 100, 0, 200, 1.0),
                        } },
-        { "BipedStab", {
+        { dust3d::AnimationId::BipedStab, {
                            makeDiv100Param("thrustReachFactor", "Thrust Reach", 100, 25, 200, 1.0),
                            makeDiv100Param("thrustSpeedFactor", "Thrust Speed", 100, 25, 200, 1.0),
                            makeDiv100Param("hipDriveFactor", "Hip Drive", 100, 0, 200, 1.0),
@@ -415,7 +416,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                            makeDiv100Param("bodyMassFactor", "Body Mass", 100, 25, 300, 1.0),
                            makeDiv100Param("tailReactFactor", "Tail React", 100, 0, 200, 1.0),
                        } },
-        { "BipedCast", {
+        { dust3d::AnimationId::BipedCast, {
                            makeDiv100Param("castForceFactor", "Cast Force", 100, 25, 200, 1.0),
                            makeDiv100Param("gatherDepthFactor", "Gather Depth", 100, 0, 200, 1.0),
                            makeDiv100Param("spineRecoilFactor", "Spine Recoil", 100, 0, 200, 1.0),
@@ -426,7 +427,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                            makeDiv100Param("recoverySpeedFactor", "Recovery Speed", 100, 25, 300, 1.0),
                            makeDiv100Param("tailReactFactor", "Tail React", 100, 0, 200, 1.0),
                        } },
-        { "BipedChannel", {
+        { dust3d::AnimationId::BipedChannel, {
                               makeDiv100Param("channelIntensityFactor", "Intensity", 100, 25, 200, 1.0),
                               makeDiv100Param("armHoldAngleFactor", "Arm Hold Angle", 100, 0, 200, 1.0),
                               makeDiv100Param("trembleAmplitudeFactor", "Tremble", 100, 0, 200, 1.0),
@@ -436,7 +437,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                               makeDiv100Param("tailChannelFactor", "Tail Channel", 100, 0, 200, 1.0),
                               makeDiv100Param("bodyMassFactor", "Body Mass", 100, 25, 300, 1.0),
                           } },
-        { "BipedDie", {
+        { dust3d::AnimationId::BipedDie, {
                           makeDiv100Param("collapseSpeedFactor", "Collapse Speed", 50, 10, 300, 0.25),
                           makeDiv100Param("armFlailFactor", "Arm Flail", 100, 0, 300, 1.0),
                           makeDiv100Param("headDropFactor", "Head Drop", 100, 0, 300, 1.0),
@@ -450,7 +451,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                           makeDiv100Param("hitForceFactor", "Hit Force", 100, 10, 300, 1.0),
                           makeDiv100Param("selfCollisionFactor", "Self Collision", 100, 0, 200, 1.0),
                       } },
-        { "SpiderWalk", {
+        { dust3d::AnimationId::SpiderWalk, {
                             makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 200, 1.0),
                             makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 200, 1.0),
                             makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 200, 1.0),
@@ -462,7 +463,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                             makeDirectParam("springStiffness", "Spring Stiffness", 120, 30, 300, 120.0),
                             makeDirectParam("springDamping", "Spring Damping", 12, 3, 30, 12.0),
                         } },
-        { "SpiderRun", {
+        { dust3d::AnimationId::SpiderRun, {
                            makeDiv100Param("stepLengthFactor", "Step Length", 100, 25, 300, 1.0),
                            makeDiv100Param("stepHeightFactor", "Step Height", 100, 25, 300, 1.0),
                            makeDiv100Param("bodyBobFactor", "Body Bob", 100, 25, 300, 1.0),
@@ -476,7 +477,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                            makeDirectParam("springStiffness", "Spring Stiffness", 150, 30, 400, 150.0),
                            makeDirectParam("springDamping", "Spring Damping", 14, 3, 35, 14.0),
                        } },
-        { "SpiderDie", {
+        { dust3d::AnimationId::SpiderDie, {
                            makeDiv100Param("collapseSpeedFactor", "Collapse Speed", 100, 10, 300, 1.0),
                            makeDiv100Param("legSpreadFactor", "Leg Spread", 100, 0, 300, 1.0),
                            makeDiv100Param("lengthStiffness", "Length Stiffness", 90, 10, 200, 0.9),
@@ -485,7 +486,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                            makeDiv100Param("damping", "Damping", 95, 50, 99, 0.95),
                            makeDiv100Param("groundBounce", "Ground Bounce", 22, 0, 100, 0.22),
                        } },
-        { "BipedIdle", {
+        { dust3d::AnimationId::BipedIdle, {
                            makeDiv100Param("breathingAmplitudeFactor", "Breathing Amplitude", 100, 0, 300, 1.0),
                            makeDiv100Param("breathingSpeedFactor", "Breathing Speed", 100, 25, 300, 1.0),
                            makeDiv100Param("weightShiftFactor", "Weight Shift", 100, 0, 300, 1.0),
@@ -495,7 +496,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                            makeDiv100Param("tailIdleFactor", "Tail Idle", 100, 0, 300, 1.0),
                            makeDiv100Param("armRestFactor", "Arm Rest Sway", 100, 0, 300, 1.0),
                        } },
-        { "QuadrupedIdle", {
+        { dust3d::AnimationId::QuadrupedIdle, {
                                makeDiv100Param("breathingAmplitudeFactor", "Breathing Amplitude", 100, 0, 300, 1.0),
                                makeDiv100Param("breathingSpeedFactor", "Breathing Speed", 100, 25, 300, 1.0),
                                makeDiv100Param("weightShiftFactor", "Weight Shift", 100, 0, 300, 1.0),
@@ -506,7 +507,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                                makeDiv100Param("frontKneeBendFactor", "Front Knee Bend", 100, 10, 300, 1.0),
                                makeDiv100Param("backKneeBendFactor", "Back Knee Bend", 100, 10, 300, 1.0),
                            } },
-        { "InsectIdle", {
+        { dust3d::AnimationId::InsectIdle, {
                             makeDiv100Param("breathingAmplitudeFactor", "Breathing Amplitude", 100, 0, 300, 1.0),
                             makeDiv100Param("breathingSpeedFactor", "Breathing Speed", 100, 25, 300, 1.0),
                             makeDiv100Param("antennaeSwayFactor", "Antennae Sway", 100, 0, 300, 1.0),
@@ -514,7 +515,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                             makeDiv100Param("wingFoldFactor", "Wing Fold", 100, 0, 300, 1.0),
                             makeDiv100Param("abdomenSwayFactor", "Abdomen Sway", 100, 0, 300, 1.0),
                         } },
-        { "SpiderIdle", {
+        { dust3d::AnimationId::SpiderIdle, {
                             makeDiv100Param("breathingAmplitudeFactor", "Breathing Amplitude", 100, 0, 300, 1.0),
                             makeDiv100Param("breathingSpeedFactor", "Breathing Speed", 100, 25, 300, 1.0),
                             makeDiv100Param("pedipalpSwayFactor", "Pedipalp Sway", 100, 0, 300, 1.0),
@@ -522,7 +523,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                             makeDiv100Param("abdomenPulseFactor", "Abdomen Pulse", 100, 0, 300, 1.0),
                             makeDiv100Param("bodySwayFactor", "Body Sway", 100, 0, 300, 1.0),
                         } },
-        { "BirdIdle", {
+        { dust3d::AnimationId::BirdIdle, {
                           makeDiv100Param("breathingAmplitudeFactor", "Breathing Amplitude", 100, 0, 300, 1.0),
                           makeDiv100Param("breathingSpeedFactor", "Breathing Speed", 100, 25, 300, 1.0),
                           makeDiv100Param("weightShiftFactor", "Weight Shift", 100, 0, 300, 1.0),
@@ -530,7 +531,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                           makeDiv100Param("headPeckFactor", "Head Peck", 100, 0, 300, 1.0),
                           makeDiv100Param("tailFeatherFactor", "Tail Feather", 100, 0, 300, 1.0),
                       } },
-        { "FishIdle", {
+        { dust3d::AnimationId::FishIdle, {
                           makeDiv100Param("breathingAmplitudeFactor", "Breathing Amplitude", 100, 0, 300, 1.0),
                           makeDiv100Param("breathingSpeedFactor", "Breathing Speed", 100, 25, 300, 1.0),
                           makeDiv100Param("finScullFactor", "Fin Scull", 100, 0, 300, 1.0),
@@ -539,7 +540,7 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                           makeDiv100Param("dorsalSwayFactor", "Dorsal Sway", 100, 0, 300, 1.0),
                           makeDiv100Param("driftFactor", "Drift", 100, 0, 300, 1.0),
                       } },
-        { "SnakeIdle", {
+        { dust3d::AnimationId::SnakeIdle, {
                            makeDiv100Param("breathingAmplitudeFactor", "Breathing Amplitude", 100, 0, 300, 1.0),
                            makeDiv100Param("breathingSpeedFactor", "Breathing Speed", 100, 25, 300, 1.0),
                            makeDiv100Param("headSwayFactor", "Head Sway", 100, 0, 300, 1.0),
@@ -549,7 +550,10 @@ inline const std::vector<AnimationParameterDef>& getAnimationParameterDefs(const
                        } },
     };
 
-    auto it = table.find(animationType);
+    const dust3d::AnimationDefinition* definition = dust3d::AnimationRegistry::find(animationType);
+    if (nullptr == definition)
+        return empty;
+    auto it = table.find(definition->id);
     if (it != table.end())
         return it->second;
     return empty;
@@ -3,11 +3,26 @@
 #include <QDebug>
 #include <algorithm>
 #include <cstring>
+#include <dust3d/animation/mesh_skinner.h>
 #include <dust3d/animation/sound_event_detector.h>
 #include <dust3d/animation/sound_generator.h>
+#include <dust3d/base/thread_pool.h>
 #include <dust3d/base/vector3.h>
 #include <dust3d/rig/rig_generator.h>
 
+static bool isSameSoundEvents(const std::vector<dust3d::SoundEvent>& first, const std::vector<dust3d::SoundEvent>& second)
+{
+    return first.size() == second.size()
+        && std::equal(first.begin(), first.end(), second.begin(), [](const dust3d::SoundEvent& a, const dust3d::SoundEvent& b) {
+               return a.timeSeconds == b.timeSeconds
+                   && a.intensity == b.intensity
+                   && a.boneName == b.boneName
+                   && a.isUnderwater == b.isUnderwater
+                   && a.isWhoosh == b.isWhoosh
+                   && a.whooshDuration == b.whooshDuration;
+           });
+}
+
 void AnimationPreviewWorker::process()
 {
     m_previewMeshes.clear();
@@ -39,23 +54,124 @@ void AnimationPreviewWorker::process()
     // Generate procedural sound from animation contact events
     m_soundData = dust3d::AnimationSoundData();
     if (m_soundEnabled) {
-        auto soundEvents = dust3d::SoundEventDetector::detect(animationClip, m_animationType, m_animationParameters);
+        auto soundEvents = m_soundEventDetector.update(animationClip, m_animationType, m_animationParameters);
         if (!soundEvents.empty()) {
-            m_soundData = dust3d::SoundGenerator::generate(
-                soundEvents, animationClip.durationSeconds, m_surfaceMaterial);
+            if (m_lastSoundData.pcmSamples.empty()
+                || m_lastSoundDurationSeconds != animationClip.durationSeconds
+                || m_lastSurfaceMaterial != m_surfaceMaterial
+                || !isSameSoundEvents(m_lastSoundEvents, soundEvents)) {
+                m_lastSoundData = dust3d::SoundGenerator::generate(
+                    soundEvents, animationClip.durationSeconds, m_surfaceMaterial);
+                m_lastSoundEvents = std::move(soundEvents);
+                m_lastSoundDurationSeconds = animationClip.durationSeconds;
+                m_lastSurfaceMaterial = m_surfaceMaterial;
+            }
+            m_soundData = m_lastSoundData;
         }
     }
+    // Resolve rig bones to pose indices once, frames are addressed by index
+    std::vector<size_t> poseBoneIndices(m_rigStructure.bones.size(), dust3d::BonePoseLayout::npos);
+    if (animationClip.poseLayout) {
+        for (size_t i = 0; i < m_rigStructure.bones.size(); ++i)
+            poseBoneIndices[i] = animationClip.poseLayout->boneIndex(m_rigStructure.bones[i].name.toStdString());
+    }
+
+    // Skin every frame up front. The rest pose vertex buffer is built and colored once,
+    // then each frame only rewrites positions and normals in its own copy of it.
+    // Frames are independent, so they are skinned on the thread pool.
+    std::vector<std::unique_ptr<ModelMesh>> skinnedMeshes(animationClip.frames.size());
+    if (!m_hideParts && m_rigObject && !m_rigObject->vertices.empty() && animationClip.poseLayout) {
+        ModelMesh restMesh(*m_rigObject);
+        ModelOpenGLVertex* restVertices = restMesh.triangleVertices();
+        int restVertexCount = restMesh.triangleVertexCount();
+
+        if (m_textureImage && m_textureImage->width() > 0 && m_textureImage->height() > 0) {
+            int texW = m_textureImage->width();
+            int texH = m_textureImage->height();
+            for (int i = 0; i < restVertexCount; ++i) {
+                ModelOpenGLVertex& v = restVertices[i];
+                float u = std::max(0.0f, std::min(1.0f, v.texU));
+                float vc = std::max(0.0f, std::min(1.0f, v.texV));
+                int px = std::min((int)(u * texW), texW - 1);
+                int py = std::min((int)(vc * texH), texH - 1);
+                QRgb pixel = m_textureImage->pixel(px, py);
+                v.colorR = qRed(pixel) / 255.0f;
+                v.colorG = qGreen(pixel) / 255.0f;
+                v.colorB = qBlue(pixel) / 255.0f;
+            }
+        }
+
+        if (!m_selectedBoneName.isEmpty()) {
+            std::string selectedBoneStd = m_selectedBoneName.toStdString();
+            std::vector<dust3d::Color> vertexWeightColors(m_rigObject->vertices.size());
+            for (size_t i = 0; i < m_rigObject->vertices.size(); ++i) {
+                float weight = 0.0f;
+                if (i < m_rigObject->vertexBone1.size() && m_rigObject->vertexBone1[i].first == selectedBoneStd)
+                    weight += m_rigObject->vertexBone1[i].second;
+                if (i < m_rigObject->vertexBone2.size() && m_rigObject->vertexBone2[i].first == selectedBoneStd)
+                    weight += m_rigObject->vertexBone2[i].second;
+                vertexWeightColors[i] = calculateBoneWeightColor(weight);
+            }
+            int destIndex = 0;
+            for (size_t ti = 0; ti < m_rigObject->triangles.size() && destIndex < restVertexCount; ++ti) {
+                const auto& tri = m_rigObject->triangles[ti];
+                for (size_t j = 0; j < 3 && j < tri.size() && destIndex < restVertexCount; ++j) {
+                    const dust3d::Color& c = vertexWeightColors[tri[j]];
+                    restVertices[destIndex].colorR = c.r();
+                    restVertices[destIndex].colorG = c.g();
+                    restVertices[destIndex].colorB = c.b();
+                    ++destIndex;
+                }
+            }
+        }
+
+        dust3d::MeshSkinner skinner(*m_rigObject, *animationClip.poseLayout);
+        const auto& triangles = m_rigObject->triangles;
+        dust3d::ThreadPool::globalInstance()->parallelFor(animationClip.frames.size(), [&](size_t frameIndex) {
+            const auto& frame = animationClip.frames[frameIndex];
+            if (frame.boneSkinMatrices.empty())
+                return;
+            dust3d::MeshSkinner::SkinnedVertices skinnedVertices;
+            if (!skinner.skin(frame.boneSkinMatrices, &skinnedVertices))
+                return;
+
+            ModelOpenGLVertex* vertices = new ModelOpenGLVertex[restVertexCount];
+            std::memcpy(vertices, restVertices, restVertexCount * sizeof(ModelOpenGLVertex));
+            int destIndex = 0;
+            for (const auto& triangle : triangles) {
+                for (size_t j = 0; j < 3; ++j) {
+                    size_t vertexIndex = triangle[j];
+                    ModelOpenGLVertex& dest = vertices[destIndex++];
+                    dest.posX = skinnedVertices.positionX[vertexIndex];
+                    dest.posY = skinnedVertices.positionY[vertexIndex];
+                    dest.posZ = skinnedVertices.positionZ[vertexIndex];
+                    float direction[3];
+                    skinnedVertices.transformNormal(vertexIndex, dest.normX, dest.normY, dest.normZ, direction);
+                    dest.normX = direction[0];
+                    dest.normY = direction[1];
+                    dest.normZ = direction[2];
+                    skinnedVertices.transformNormal(vertexIndex, dest.tangentX, dest.tangentY, dest.tangentZ, direction);
+                    dest.tangentX = direction[0];
+                    dest.tangentY = direction[1];
+                    dest.tangentZ = direction[2];
+                }
+            }
+            skinnedMeshes[frameIndex] = std::make_unique<ModelMesh>(vertices, restVertexCount);
+        });
+    }
 
     // Generate a mesh for every frame
-    for (const auto& frame : animationClip.frames) {
+    for (size_t frameIndex = 0; frameIndex < animationClip.frames.size(); ++frameIndex) {
+        const auto& frame = animationClip.frames[frameIndex];
         RigStructure poseRig = m_rigStructure;
 
-        for (auto& boneNode : poseRig.bones) {
-            auto iter = frame.boneWorldTransforms.find(boneNode.name.toStdString());
-            if (iter == frame.boneWorldTransforms.end())
+        for (size_t boneIndex = 0; boneIndex < poseRig.bones.size(); ++boneIndex) {
+            auto& boneNode = poseRig.bones[boneIndex];
+            const dust3d::Matrix4x4* worldTransform = frame.boneWorldTransforms.find(poseBoneIndices[boneIndex]);
+            if (nullptr == worldTransform)
                 continue;
 
-            const dust3d::Matrix4x4& boneTransform = iter->second;
+            const dust3d::Matrix4x4& boneTransform = *worldTransform;
 
             float boneLength = 1.0f;
             for (const auto& sourceBone : m_rigStructure.bones) {
@@ -106,47 +222,7 @@ void AnimationPreviewWorker::process()
             dust3d::Color(Theme::green.redF(), Theme::green.greenF(), Theme::green.blueF()),
             0.0f, 1.0f, vertexProperties);
 
-        std::unique_ptr<ModelMesh> frameMesh;
-        if (m_rigObject && !m_rigObject->vertices.empty() && !frame.boneSkinMatrices.empty()) {
-            dust3d::Object skinnedObject(*m_rigObject);
-
-            for (size_t i = 0; i < skinnedObject.vertices.size(); ++i) {
-                const dust3d::Vector3& origin = m_rigObject->vertices[i];
-                dust3d::Vector3 transformed(0.0f, 0.0f, 0.0f);
-                float totalWeight = 0.0f;
-
-                if (i < m_rigObject->vertexBone1.size()) {
-                    const auto& b1 = m_rigObject->vertexBone1[i];
-                    if (!b1.first.empty()) {
-                        auto it = frame.boneSkinMatrices.find(b1.first);
-                        if (it != frame.boneSkinMatrices.end()) {
-                            transformed += it->second.transformPoint(origin) * b1.second;
-                            totalWeight += b1.second;
-                        }
-                    }
-                }
-
-                if (i < m_rigObject->vertexBone2.size()) {
-                    const auto& b2 = m_rigObject->vertexBone2[i];
-                    if (!b2.first.empty()) {
-                        auto it = frame.boneSkinMatrices.find(b2.first);
-                        if (it != frame.boneSkinMatrices.end()) {
-                            transformed += it->second.transformPoint(origin) * b2.second;
-                            totalWeight += b2.second;
-                        }
-                    }
-                }
-
-                if (totalWeight > 1e-6f) {
-                    transformed /= totalWeight;
-                    skinnedObject.vertices[i] = transformed;
-                } else {
-                    skinnedObject.vertices[i] = origin;
-                }
-            }
-
-            frameMesh = std::make_unique<ModelMesh>(skinnedObject);
-        }
+        std::unique_ptr<ModelMesh> frameMesh = std::move(skinnedMeshes[frameIndex]);
 
         // Decide what should be visible according to the hide options.
         bool showSkeleton = !m_hideBones && skeletonMesh.triangleVertexCount() > 0;
@@ -178,58 +254,6 @@ void AnimationPreviewWorker::process()
         }
     }
 
-    if (m_textureImage && m_textureImage->width() > 0 && m_textureImage->height() > 0) {
-        int texW = m_textureImage->width();
-        int texH = m_textureImage->height();
-        for (auto& frame : m_previewMeshes) {
-            int skeletonCount = frame.skeletonVertexCount();
-            int totalCount = frame.triangleVertexCount();
-            ModelOpenGLVertex* vertices = frame.triangleVertices();
-            for (int i = skeletonCount; i < totalCount; ++i) {
-                ModelOpenGLVertex& v = vertices[i];
-                float u = std::max(0.0f, std::min(1.0f, v.texU));
-                float vc = std::max(0.0f, std::min(1.0f, v.texV));
-                int px = std::min((int)(u * texW), texW - 1);
-                int py = std::min((int)(vc * texH), texH - 1);
-                QRgb pixel = m_textureImage->pixel(px, py);
-                v.colorR = qRed(pixel) / 255.0f;
-                v.colorG = qGreen(pixel) / 255.0f;
-                v.colorB = qBlue(pixel) / 255.0f;
-            }
-        }
-    }
-
-    if (!m_selectedBoneName.isEmpty() && m_rigObject) {
-        std::string selectedBoneStd = m_selectedBoneName.toStdString();
-        std::vector<dust3d::Color> vertexWeightColors(m_rigObject->vertices.size());
-        for (size_t i = 0; i < m_rigObject->vertices.size(); ++i) {
-            float weight = 0.0f;
-            if (i < m_rigObject->vertexBone1.size() && m_rigObject->vertexBone1[i].first == selectedBoneStd)
-                weight += m_rigObject->vertexBone1[i].second;
-            if (i < m_rigObject->vertexBone2.size() && m_rigObject->vertexBone2[i].first == selectedBoneStd)
-                weight += m_rigObject->vertexBone2[i].second;
-            vertexWeightColors[i] = calculateBoneWeightColor(weight);
-        }
-        for (auto& frame : m_previewMeshes) {
-            int skeletonCount = frame.skeletonVertexCount();
-            int totalCount = frame.triangleVertexCount();
-            if (skeletonCount >= totalCount)
-                continue;
-            ModelOpenGLVertex* vertices = frame.triangleVertices();
-            int destIndex = skeletonCount;
-            for (size_t ti = 0; ti < m_rigObject->triangles.size() && destIndex < totalCount; ++ti) {
-                const auto& tri = m_rigObject->triangles[ti];
-                for (size_t j = 0; j < 3 && j < tri.size() && destIndex < totalCount; ++j) {
-                    const dust3d::Color& c = vertexWeightColors[tri[j]];
-                    vertices[destIndex].colorR = c.r();
-                    vertices[destIndex].colorG = c.g();
-                    vertices[destIndex].colorB = c.b();
-                    ++destIndex;
-                }
-            }
-        }
-    }
-
     qDebug() << "Animation preview: generated" << m_previewMeshes.size() << "frames";
 
     emit finished();
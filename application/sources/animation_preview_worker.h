@@ -6,6 +6,7 @@
 #include "rig_skeleton_mesh_generator.h"
 #include <QObject>
 #include <dust3d/animation/animation_generator.h>
+#include <dust3d/animation/sound_event_detector.h>
 #include <dust3d/animation/sound_generator.h>
 #include <dust3d/rig/rig_generator.h>
 #include <map>
@@ -93,6 +94,12 @@ private:
     QString m_selectedBoneName;
     std::unique_ptr<QImage> m_textureImage;
     dust3d::AnimationSoundData m_soundData;
+    // Kept across runs, so tweaking a parameter only re-detects and re-synthesizes what it changed
+    dust3d::SoundEventDetector m_soundEventDetector;
+    std::vector<dust3d::SoundEvent> m_lastSoundEvents;
+    float m_lastSoundDurationSeconds = 0.0f;
+    dust3d::SurfaceMaterial m_lastSurfaceMaterial = dust3d::SurfaceMaterial::Stone;
+    dust3d::AnimationSoundData m_lastSoundData;
     float m_movementSpeed = 0.0f;
     float m_movementDirectionX = 0.0f;
     float m_movementDirectionZ = 0.0f;
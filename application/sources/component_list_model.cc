@@ -26,6 +26,11 @@ ComponentListModel::ComponentListModel(const Document* document, QObject* parent
             return;
         this->reload();
     });
+    connect(m_document, &Document::componentRemoved, [this](const dust3d::Uuid& componentId) {
+        if (componentId != this->listingComponentId())
+            return;
+        this->setListingComponentId(dust3d::Uuid());
+    });
     connect(this, &ComponentListModel::listingComponentChanged, m_document, &Document::setCurrentCanvasComponentId);
 }
 
@@ -1,16 +1,19 @@
 #include "document.h"
 #include "glb_forever.h"
+#include "mesh_generation_scheduler.h"
 #include "mesh_generator.h"
 #include "rig_generator_worker.h"
 #include "uv_map_generator.h"
 #include <QApplication>
 #include <QClipboard>
 #include <QDebug>
+#include <QDir>
 #include <QElapsedTimer>
 #include <QFile>
 #include <QFileDialog>
 #include <QGuiApplication>
 #include <QMimeData>
+#include <QStandardPaths>
 #include <QThread>
 #include <QVector3D>
 #include <QtCore/qbuffer.h>
@@ -30,15 +33,7 @@ Document::Document()
 Document::~Document()
 {
     // Ensure workers are stopped before cleanup
-    if (nullptr != m_meshGeneratorThread) {
-        m_meshGeneratorThread->quit();
-        m_meshGeneratorThread->wait();
-        m_meshGeneratorThread = nullptr;
-    }
-    if (nullptr != m_meshGenerator) {
-        delete m_meshGenerator;
-        m_meshGenerator = nullptr;
-    }
+    m_meshGenerationScheduler.reset();
     if (nullptr != m_rigGeneratorWorker) {
         delete m_rigGeneratorWorker;
         m_rigGeneratorWorker = nullptr;
@@ -1141,6 +1136,8 @@ void Document::setComponentColorImage(const dust3d::Uuid& componentId, const dus
                 componentSnapshotIt->second.erase("colorImageId");
             else
                 componentSnapshotIt->second["colorImageId"] = imageId.toString();
+            // Workers keep the view they were started with, so swap in a fresh one instead of patching it
+            m_currentSnapshotView = std::make_shared<dust3d::SnapshotView>(*m_currentSnapshot);
         }
     }
     emit componentColorImageChanged(componentId);
@@ -1729,18 +1726,16 @@ void Document::generateRig()
 
     m_isRigObsolete = false;
 
-    if (!m_uvMappedObject || m_uvMappedObject->vertices.empty() || nullptr == m_currentSnapshot)
+    if (!m_uvMappedObject || m_uvMappedObject->vertices.empty() || nullptr == m_currentSnapshotView)
         return;
 
-    auto snapshot = std::make_unique<dust3d::Snapshot>(*m_currentSnapshot);
-
     auto object = std::make_unique<dust3d::Object>(*m_uvMappedObject);
 
     RigStructure rigWithSettings = *templateRig;
     rigWithSettings.headHasEyelids = m_headHasEyelids;
 
     m_rigGeneratorWorker = new RigGeneratorWorker;
-    m_rigGeneratorWorker->setParameters(std::move(snapshot), std::move(object), rigWithSettings);
+    m_rigGeneratorWorker->setParameters(m_currentSnapshotView, std::move(object), rigWithSettings);
 
     emit rigGenerating();
 
@@ -2235,6 +2230,134 @@ void Document::toSnapshot(dust3d::Snapshot* snapshot, const std::set<dust3d::Uui
     }
 }
 
+void Document::loadPartAttributes(Part* part, const std::map<std::string, std::string>& attributes)
+{
+    part->name = dust3d::String::valueOrEmpty(attributes, "name").c_str();
+    const auto& visibleIt = attributes.find("visible");
+    if (visibleIt != attributes.end()) {
+        part->visible = dust3d::String::isTrue(visibleIt->second);
+    } else {
+        part->visible = true;
+    }
+    part->locked = dust3d::String::isTrue(dust3d::String::valueOrEmpty(attributes, "locked"));
+    part->subdived = dust3d::String::isTrue(dust3d::String::valueOrEmpty(attributes, "subdived"));
+    part->disabled = dust3d::String::isTrue(dust3d::String::valueOrEmpty(attributes, "disabled"));
+    part->xMirrored = dust3d::String::isTrue(dust3d::String::valueOrEmpty(attributes, "xMirrored"));
+    part->rounded = dust3d::String::isTrue(dust3d::String::valueOrEmpty(attributes, "rounded"));
+    part->chamfered = dust3d::String::isTrue(dust3d::String::valueOrEmpty(attributes, "chamfered"));
+    part->fillLoopInterior = dust3d::String::isTrue(dust3d::String::valueOrEmpty(attributes, "fillLoopInterior"));
+    part->target = dust3d::PartTargetFromString(dust3d::String::valueOrEmpty(attributes, "target").c_str());
+    const auto& cutRotationIt = attributes.find("cutRotation");
+    if (cutRotationIt != attributes.end())
+        part->setCutRotation(dust3d::String::toFloat(cutRotationIt->second));
+    const auto& cutFaceIt = attributes.find("cutFace");
+    if (cutFaceIt != attributes.end()) {
+        dust3d::Uuid cutFaceLinkedId = dust3d::Uuid(cutFaceIt->second);
+        if (cutFaceLinkedId.isNull()) {
+            part->setCutFace(dust3d::CutFaceFromString(cutFaceIt->second.c_str()));
+        } else {
+            part->setCutFaceLinkedId(cutFaceLinkedId);
+        }
+    }
+    const auto& metalnessIt = attributes.find("metallic");
+    if (metalnessIt != attributes.end())
+        part->metalness = dust3d::String::toFloat(metalnessIt->second);
+    const auto& roughnessIt = attributes.find("roughness");
+    if (roughnessIt != attributes.end())
+        part->roughness = dust3d::String::toFloat(roughnessIt->second);
+    const auto& deformThicknessIt = attributes.find("deformThickness");
+    if (deformThicknessIt != attributes.end())
+        part->setDeformThickness(dust3d::String::toFloat(deformThicknessIt->second));
+    const auto& deformWidthIt = attributes.find("deformWidth");
+    if (deformWidthIt != attributes.end())
+        part->setDeformWidth(dust3d::String::toFloat(deformWidthIt->second));
+    const auto& deformUnifiedIt = attributes.find("deformUnified");
+    if (deformUnifiedIt != attributes.end())
+        part->deformUnified = dust3d::String::isTrue(deformUnifiedIt->second);
+    const auto& hollowThicknessIt = attributes.find("hollowThickness");
+    if (hollowThicknessIt != attributes.end())
+        part->hollowThickness = dust3d::String::toFloat(hollowThicknessIt->second);
+    const auto& importedModelIdIt = attributes.find("importedModelId");
+    if (importedModelIdIt != attributes.end())
+        part->importedModelId = dust3d::Uuid(importedModelIdIt->second);
+}
+
+void Document::loadNodeAttributes(Node* node, const std::map<std::string, std::string>& attributes)
+{
+    node->name = dust3d::String::valueOrEmpty(attributes, "name").c_str();
+    node->radius = dust3d::String::toFloat(dust3d::String::valueOrEmpty(attributes, "radius"));
+    node->setX(dust3d::String::toFloat(dust3d::String::valueOrEmpty(attributes, "x")));
+    node->setY(dust3d::String::toFloat(dust3d::String::valueOrEmpty(attributes, "y")));
+    node->setZ(dust3d::String::toFloat(dust3d::String::valueOrEmpty(attributes, "z")));
+    const auto& cutRotationIt = attributes.find("cutRotation");
+    if (cutRotationIt != attributes.end())
+        node->setCutRotation(dust3d::String::toFloat(cutRotationIt->second));
+    const auto& cutFaceIt = attributes.find("cutFace");
+    if (cutFaceIt != attributes.end()) {
+        dust3d::Uuid cutFaceLinkedId = dust3d::Uuid(cutFaceIt->second);
+        if (cutFaceLinkedId.isNull()) {
+            node->setCutFace(dust3d::CutFaceFromString(cutFaceIt->second.c_str()));
+        } else {
+            node->setCutFaceLinkedId(cutFaceLinkedId);
+        }
+    }
+}
+
+void Document::loadComponentAttributes(Component* component, const std::map<std::string, std::string>& attributes)
+{
+    component->name = dust3d::String::valueOrEmpty(attributes, "name").c_str();
+    component->expanded = dust3d::String::isTrue(dust3d::String::valueOrEmpty(attributes, "expanded"));
+    component->combineMode = dust3d::CombineModeFromString(dust3d::String::valueOrEmpty(attributes, "combineMode").c_str());
+    component->sideClosed = dust3d::String::isTrue(dust3d::String::valueOrEmpty(attributes, "sideClosed"));
+    component->frontClosed = dust3d::String::isTrue(dust3d::String::valueOrEmpty(attributes, "frontClosed"));
+    component->backClosed = dust3d::String::isTrue(dust3d::String::valueOrEmpty(attributes, "backClosed"));
+    const auto& backCloseDepthRatioIt = attributes.find("backCloseDepthRatio");
+    if (backCloseDepthRatioIt != attributes.end())
+        component->backCloseDepthRatio = dust3d::String::toFloat(backCloseDepthRatioIt->second);
+    const auto& backCloseSharpnessIt = attributes.find("backCloseSharpness");
+    if (backCloseSharpnessIt != attributes.end())
+        component->backCloseSharpness = dust3d::String::toFloat(backCloseSharpnessIt->second);
+    const auto& smoothCutoffDegreesIt = attributes.find("smoothCutoffDegrees");
+    if (smoothCutoffDegreesIt != attributes.end())
+        component->smoothCutoffDegrees = dust3d::String::toFloat(smoothCutoffDegreesIt->second);
+    const auto& targetSegmentsIt = attributes.find("targetSegments");
+    if (targetSegmentsIt != attributes.end())
+        component->targetSegments = dust3d::String::toFloat(targetSegmentsIt->second);
+    const auto& colorImageIt = attributes.find("colorImageId");
+    if (colorImageIt != attributes.end()) {
+        component->colorImageId = dust3d::Uuid(colorImageIt->second);
+    }
+    const auto& colorIt = attributes.find("color");
+    if (colorIt != attributes.end()) {
+        component->color = QColor(colorIt->second.c_str());
+        component->hasColor = true;
+    }
+    if (component->combineMode == dust3d::CombineMode::Normal) {
+        if (dust3d::String::isTrue(dust3d::String::valueOrEmpty(attributes, "inverse")))
+            component->combineMode = dust3d::CombineMode::Inversion;
+    }
+}
+
+bool Document::loadAnimationAttributes(Animation* animation, const std::map<std::string, std::string>& attributes)
+{
+    const auto nameIt = attributes.find("name");
+    const auto typeIt = attributes.find("type");
+    if (nameIt == attributes.end() || typeIt == attributes.end())
+        return false;
+
+    animation->name = QString::fromUtf8(nameIt->second.c_str());
+    animation->type = QString::fromUtf8(typeIt->second.c_str());
+
+    // Copy all parameters except metadata fields
+    animation->params.clear();
+    for (const auto& attrIt : attributes) {
+        if (attrIt.first != "id" && attrIt.first != "name" && attrIt.first != "type") {
+            animation->params[attrIt.first] = attrIt.second;
+        }
+    }
+    return true;
+}
+
 void Document::addFromSnapshot(const dust3d::Snapshot& snapshot, enum SnapshotSource source)
 {
     bool isOriginChanged = false;
@@ -2277,57 +2400,11 @@ void Document::addFromSnapshot(const dust3d::Snapshot& snapshot, enum SnapshotSo
         Document::Part& part = partMap[newUuid];
         part.id = newUuid;
         oldNewIdMap[dust3d::Uuid(partKv.first)] = part.id;
-        part.name = dust3d::String::valueOrEmpty(partKv.second, "name").c_str();
-        const auto& visibleIt = partKv.second.find("visible");
-        if (visibleIt != partKv.second.end()) {
-            part.visible = dust3d::String::isTrue(visibleIt->second);
-        } else {
-            part.visible = true;
-        }
-        part.locked = dust3d::String::isTrue(dust3d::String::valueOrEmpty(partKv.second, "locked"));
-        part.subdived = dust3d::String::isTrue(dust3d::String::valueOrEmpty(partKv.second, "subdived"));
-        part.disabled = dust3d::String::isTrue(dust3d::String::valueOrEmpty(partKv.second, "disabled"));
-        part.xMirrored = dust3d::String::isTrue(dust3d::String::valueOrEmpty(partKv.second, "xMirrored"));
-        part.rounded = dust3d::String::isTrue(dust3d::String::valueOrEmpty(partKv.second, "rounded"));
-        part.chamfered = dust3d::String::isTrue(dust3d::String::valueOrEmpty(partKv.second, "chamfered"));
-        part.fillLoopInterior = dust3d::String::isTrue(dust3d::String::valueOrEmpty(partKv.second, "fillLoopInterior"));
-        part.target = dust3d::PartTargetFromString(dust3d::String::valueOrEmpty(partKv.second, "target").c_str());
-        const auto& cutRotationIt = partKv.second.find("cutRotation");
-        if (cutRotationIt != partKv.second.end())
-            part.setCutRotation(dust3d::String::toFloat(cutRotationIt->second));
-        const auto& cutFaceIt = partKv.second.find("cutFace");
-        if (cutFaceIt != partKv.second.end()) {
-            dust3d::Uuid cutFaceLinkedId = dust3d::Uuid(cutFaceIt->second);
-            if (cutFaceLinkedId.isNull()) {
-                part.setCutFace(dust3d::CutFaceFromString(cutFaceIt->second.c_str()));
-            } else {
-                part.setCutFaceLinkedId(cutFaceLinkedId);
-                cutFaceLinkedIdModifyMap.insert({ part.id, cutFaceLinkedId });
-            }
-        }
+        loadPartAttributes(&part, partKv.second);
+        if (!part.cutFaceLinkedId.isNull())
+            cutFaceLinkedIdModifyMap.insert({ part.id, part.cutFaceLinkedId });
         if (dust3d::String::isTrue(dust3d::String::valueOrEmpty(partKv.second, "inverse")))
             inversePartIds.insert(part.id);
-        const auto& metalnessIt = partKv.second.find("metallic");
-        if (metalnessIt != partKv.second.end())
-            part.metalness = dust3d::String::toFloat(metalnessIt->second);
-        const auto& roughnessIt = partKv.second.find("roughness");
-        if (roughnessIt != partKv.second.end())
-            part.roughness = dust3d::String::toFloat(roughnessIt->second);
-        const auto& deformThicknessIt = partKv.second.find("deformThickness");
-        if (deformThicknessIt != partKv.second.end())
-            part.setDeformThickness(dust3d::String::toFloat(deformThicknessIt->second));
-        const auto& deformWidthIt = partKv.second.find("deformWidth");
-        if (deformWidthIt != partKv.second.end())
-            part.setDeformWidth(dust3d::String::toFloat(deformWidthIt->second));
-        const auto& deformUnifiedIt = partKv.second.find("deformUnified");
-        if (deformUnifiedIt != partKv.second.end())
-            part.deformUnified = dust3d::String::isTrue(dust3d::String::valueOrEmpty(partKv.second, "deformUnified"));
-        const auto& hollowThicknessIt = partKv.second.find("hollowThickness");
-        if (hollowThicknessIt != partKv.second.end())
-            part.hollowThickness = dust3d::String::toFloat(hollowThicknessIt->second);
-        const auto& importedModelIdIt = partKv.second.find("importedModelId");
-        if (importedModelIdIt != partKv.second.end())
-            part.importedModelId = dust3d::Uuid(importedModelIdIt->second);
         newAddedPartIds.insert(part.id);
     }
     for (const auto& it : cutFaceLinkedIdModifyMap) {
@@ -2357,30 +2434,20 @@ void Document::addFromSnapshot(const dust3d::Snapshot& snapshot, enum SnapshotSo
         dust3d::Uuid oldNodeId = dust3d::Uuid(nodeKv.first);
         Document::Node node(nodeMap.find(oldNodeId) == nodeMap.end() ? oldNodeId : dust3d::Uuid::createUuid());
         oldNewIdMap[oldNodeId] = node.id;
-        node.name = dust3d::String::valueOrEmpty(nodeKv.second, "name").c_str();
-        node.radius = dust3d::String::toFloat(dust3d::String::valueOrEmpty(nodeKv.second, "radius"));
-        node.setX(dust3d::String::toFloat(dust3d::String::valueOrEmpty(nodeKv.second, "x")));
-        node.setY(dust3d::String::toFloat(dust3d::String::valueOrEmpty(nodeKv.second, "y")) + (isPastedFromSelf ? pasteOffset : 0.0f));
-        node.setZ(dust3d::String::toFloat(dust3d::String::valueOrEmpty(nodeKv.second, "z")) + (isPastedFromSelf ? pasteOffset : 0.0f));
+        loadNodeAttributes(&node, nodeKv.second);
+        if (isPastedFromSelf) {
+            node.addY(pasteOffset);
+            node.addZ(pasteOffset);
+        }
         node.partId = oldNewIdMap[dust3d::Uuid(dust3d::String::valueOrEmpty(nodeKv.second, "partId"))];
-        const auto& cutRotationIt = nodeKv.second.find("cutRotation");
-        if (cutRotationIt != nodeKv.second.end())
-            node.setCutRotation(dust3d::String::toFloat(cutRotationIt->second));
-        const auto& cutFaceIt = nodeKv.second.find("cutFace");
-        if (cutFaceIt != nodeKv.second.end()) {
-            dust3d::Uuid cutFaceLinkedId = dust3d::Uuid(cutFaceIt->second);
-            if (cutFaceLinkedId.isNull()) {
-                node.setCutFace(dust3d::CutFaceFromString(cutFaceIt->second.c_str()));
-            } else {
-                node.setCutFaceLinkedId(cutFaceLinkedId);
-                auto findNewLinkedId = oldNewIdMap.find(cutFaceLinkedId);
-                if (findNewLinkedId == oldNewIdMap.end()) {
-                    if (partMap.find(cutFaceLinkedId) == partMap.end()) {
-                        node.setCutFaceLinkedId(dust3d::Uuid());
-                    }
-                } else {
-                    node.setCutFaceLinkedId(findNewLinkedId->second);
+        if (!node.cutFaceLinkedId.isNull()) {
+            auto findNewLinkedId = oldNewIdMap.find(node.cutFaceLinkedId);
+            if (findNewLinkedId == oldNewIdMap.end()) {
+                if (partMap.find(node.cutFaceLinkedId) == partMap.end()) {
+                    node.setCutFaceLinkedId(dust3d::Uuid());
                 }
+            } else {
+                node.setCutFaceLinkedId(findNewLinkedId->second);
             }
         }
         nodeMap[node.id] = node;
@@ -2446,37 +2513,7 @@ void Document::addFromSnapshot(const dust3d::Snapshot& snapshot, enum SnapshotSo
         Document::Component component(dust3d::Uuid(), linkData, linkDataType);
         auto componentId = component.id;
         oldNewIdMap[dust3d::Uuid(componentKv.first)] = componentId;
-        component.name = dust3d::String::valueOrEmpty(componentKv.second, "name").c_str();
-        component.expanded = dust3d::String::isTrue(dust3d::String::valueOrEmpty(componentKv.second, "expanded"));
-        component.combineMode = dust3d::CombineModeFromString(dust3d::String::valueOrEmpty(componentKv.second, "combineMode").c_str());
-        component.sideClosed = dust3d::String::isTrue(dust3d::String::valueOrEmpty(componentKv.second, "sideClosed"));
-        component.frontClosed = dust3d::String::isTrue(dust3d::String::valueOrEmpty(componentKv.second, "frontClosed"));
-        component.backClosed = dust3d::String::isTrue(dust3d::String::valueOrEmpty(componentKv.second, "backClosed"));
-        const auto& backCloseDepthRatioIt = componentKv.second.find("backCloseDepthRatio");
-        if (backCloseDepthRatioIt != componentKv.second.end())
-            component.backCloseDepthRatio = dust3d::String::toFloat(backCloseDepthRatioIt->second);
-        const auto& backCloseSharpnessIt = componentKv.second.find("backCloseSharpness");
-        if (backCloseSharpnessIt != componentKv.second.end())
-            component.backCloseSharpness = dust3d::String::toFloat(backCloseSharpnessIt->second);
-        const auto& smoothCutoffDegreesIt = componentKv.second.find("smoothCutoffDegrees");
-        if (smoothCutoffDegreesIt != componentKv.second.end())
-            component.smoothCutoffDegrees = dust3d::String::toFloat(smoothCutoffDegreesIt->second);
-        const auto& targetSegmentsIt = componentKv.second.find("targetSegments");
-        if (targetSegmentsIt != componentKv.second.end())
-            component.targetSegments = dust3d::String::toFloat(targetSegmentsIt->second);
-        const auto& colorImageIt = componentKv.second.find("colorImageId");
-        if (colorImageIt != componentKv.second.end()) {
-            component.colorImageId = dust3d::Uuid(colorImageIt->second);
-        }
-        const auto& colorIt = componentKv.second.find("color");
-        if (colorIt != componentKv.second.end()) {
-            component.color = QColor(colorIt->second.c_str());
-            component.hasColor = true;
-        }
-        if (component.combineMode == dust3d::CombineMode::Normal) {
-            if (dust3d::String::isTrue(dust3d::String::valueOrEmpty(componentKv.second, "inverse")))
-                component.combineMode = dust3d::CombineMode::Inversion;
-        }
+        loadComponentAttributes(&component, componentKv.second);
         //qDebug() << "Add component:" << component.id << " old:" << componentKv.first << "name:" << component.name;
         if ("partId" == linkDataType) {
             dust3d::Uuid partId = oldNewIdMap[dust3d::Uuid(linkData.toUtf8().constData())];
@@ -2546,24 +2583,10 @@ void Document::addFromSnapshot(const dust3d::Snapshot& snapshot, enum SnapshotSo
     bool hasAnimation = false;
     if (SnapshotSource::Paste != source && SnapshotSource::Import != source) {
         for (const auto& animationKv : snapshot.animations) {
-            const auto& attrs = animationKv.second;
-            const auto nameIt = attrs.find("name");
-            const auto typeIt = attrs.find("type");
-            if (nameIt == attrs.end() || typeIt == attrs.end())
-                continue;
-
             Animation anim;
             anim.id = dust3d::Uuid(animationKv.first);
-            anim.name = QString::fromUtf8(nameIt->second.c_str());
-            anim.type = QString::fromUtf8(typeIt->second.c_str());
-
-            // Copy all parameters except metadata fields
-            for (const auto& attrIt : attrs) {
-                if (attrIt.first != "id" && attrIt.first != "name" && attrIt.first != "type") {
-                    anim.params[attrIt.first] = attrIt.second;
-                }
-            }
-
+            if (!loadAnimationAttributes(&anim, animationKv.second))
+                continue;
             m_animations[anim.id] = anim;
             hasAnimation = true;
         }
@@ -2642,7 +2665,7 @@ void Document::clearResults()
 
     // Only clear result meshes if no mesh generation is in progress
     // to avoid race conditions where meshReady() may still be running
-    if (nullptr == m_meshGenerator) {
+    if (!isMeshGenerating()) {
         m_resultMesh.reset();
         m_resultTextureMesh.reset();
         m_generatedCacheContext.reset();
@@ -2652,6 +2675,7 @@ void Document::clearResults()
     m_wireframeMesh.reset();
     m_currentObject.reset();
     m_currentSnapshot.reset();
+    m_currentSnapshotView.reset();
     m_uvMappedObject = std::make_unique<dust3d::Object>();
 
     // Only clear rig object if rig generator is not running
@@ -2684,6 +2708,337 @@ void Document::fromSnapshot(const dust3d::Snapshot& snapshot)
     emit uncheckAll();
 }
 
+void Document::applySnapshotDelta(const dust3d::SnapshotDelta& delta, bool forward)
+{
+    // Unlike fromSnapshot, ids are kept and only the changed entities are touched,
+    // so the next generation rebuilds just the parts and components the step affected
+    typedef std::map<std::string, std::string> Attributes;
+    const Attributes* canvas = nullptr;
+    const Attributes* rootComponentAttributes = nullptr;
+    std::map<dust3d::Uuid, const Attributes*> changedNodes;
+    std::map<dust3d::Uuid, const Attributes*> changedEdges;
+    std::map<dust3d::Uuid, const Attributes*> changedParts;
+    std::map<dust3d::Uuid, const Attributes*> changedComponents;
+    std::map<dust3d::Uuid, const Attributes*> changedAnimations;
+    auto collectChange = [&](dust3d::SnapshotDelta::Section section, const std::string& id, const Attributes* attributes) {
+        switch (section) {
+        case dust3d::SnapshotDelta::Section::Canvas:
+            canvas = attributes;
+            break;
+        case dust3d::SnapshotDelta::Section::RootComponent:
+            rootComponentAttributes = attributes;
+            break;
+        case dust3d::SnapshotDelta::Section::Nodes:
+            changedNodes[dust3d::Uuid(id)] = attributes;
+            break;
+        case dust3d::SnapshotDelta::Section::Edges:
+            changedEdges[dust3d::Uuid(id)] = attributes;
+            break;
+        case dust3d::SnapshotDelta::Section::Parts:
+            changedParts[dust3d::Uuid(id)] = attributes;
+            break;
+        case dust3d::SnapshotDelta::Section::Components:
+            changedComponents[dust3d::Uuid(id)] = attributes;
+            break;
+        case dust3d::SnapshotDelta::Section::Animations:
+            changedAnimations[dust3d::Uuid(id)] = attributes;
+            break;
+        }
+    };
+    if (forward)
+        delta.visitForward(collectChange);
+    else
+        delta.visitBackward(collectChange);
+
+    emit uncheckAll();
+
+    std::set<dust3d::Uuid> dirtyPartIds;
+
+    // Removals first, edges before the nodes they connect
+    for (const auto& it : changedEdges) {
+        if (nullptr != it.second)
+            continue;
+        auto edge = edgeMap.find(it.first);
+        if (edge == edgeMap.end())
+            continue;
+        for (const auto& nodeId : edge->second.nodeIds) {
+            auto node = nodeMap.find(nodeId);
+            if (node == nodeMap.end())
+                continue;
+            node->second.edgeIds.erase(std::remove(node->second.edgeIds.begin(), node->second.edgeIds.end(), it.first), node->second.edgeIds.end());
+        }
+        dirtyPartIds.insert(edge->second.partId);
+        edgeMap.erase(edge);
+        emit edgeRemoved(it.first);
+    }
+    for (const auto& it : changedNodes) {
+        if (nullptr != it.second)
+            continue;
+        auto node = nodeMap.find(it.first);
+        if (node == nodeMap.end())
+            continue;
+        auto part = partMap.find(node->second.partId);
+        if (part != partMap.end())
+            part->second.nodeIds.erase(std::remove(part->second.nodeIds.begin(), part->second.nodeIds.end(), it.first), part->second.nodeIds.end());
+        dirtyPartIds.insert(node->second.partId);
+        nodeMap.erase(node);
+        emit nodeRemoved(it.first);
+    }
+    for (const auto& it : changedComponents) {
+        if (nullptr != it.second)
+            continue;
+        if (0 == componentMap.erase(it.first))
+            continue;
+        emit componentRemoved(it.first);
+    }
+    for (const auto& it : changedParts) {
+        if (nullptr != it.second)
+            continue;
+        if (0 == partMap.erase(it.first))
+            continue;
+        emit partRemoved(it.first);
+    }
+
+    std::vector<dust3d::Uuid> addedPartIds;
+    for (const auto& it : changedParts) {
+        if (nullptr == it.second)
+            continue;
+        auto findPart = partMap.find(it.first);
+        if (findPart == partMap.end()) {
+            Document::Part& part = partMap[it.first];
+            part.id = it.first;
+            loadPartAttributes(&part, *it.second);
+            addedPartIds.push_back(it.first);
+        } else {
+            Document::Part loadedPart(it.first);
+            loadPartAttributes(&loadedPart, *it.second);
+            Document::Part& part = findPart->second;
+            dust3d::Uuid componentId = part.componentId;
+            part.copyAttributes(loadedPart);
+            part.componentId = componentId;
+            part.name = loadedPart.name;
+            part.fillLoopInterior = loadedPart.fillLoopInterior;
+        }
+        dirtyPartIds.insert(it.first);
+    }
+
+    std::vector<dust3d::Uuid> addedNodeIds;
+    std::vector<dust3d::Uuid> changedNodeIds;
+    for (const auto& it : changedNodes) {
+        if (nullptr == it.second)
+            continue;
+        Document::Node node(it.first);
+        loadNodeAttributes(&node, *it.second);
+        node.partId = dust3d::Uuid(dust3d::String::valueOrEmpty(*it.second, "partId"));
+        bool isPartChanged = true;
+        auto findNode = nodeMap.find(it.first);
+        if (findNode != nodeMap.end()) {
+            node.edgeIds = findNode->second.edgeIds;
+            isPartChanged = findNode->second.partId != node.partId;
+            if (isPartChanged) {
+                auto oldPart = partMap.find(findNode->second.partId);
+                if (oldPart != partMap.end())
+                    oldPart->second.nodeIds.erase(std::remove(oldPart->second.nodeIds.begin(), oldPart->second.nodeIds.end(), it.first), oldPart->second.nodeIds.end());
+                dirtyPartIds.insert(findNode->second.partId);
+            }
+            changedNodeIds.push_back(it.first);
+        } else {
+            addedNodeIds.push_back(it.first);
+        }
+        if (isPartChanged) {
+            auto part = partMap.find(node.partId);
+            if (part != partMap.end())
+                part->second.nodeIds.push_back(it.first);
+        }
+        dirtyPartIds.insert(node.partId);
+        nodeMap[it.first] = node;
+    }
+
+    std::vector<dust3d::Uuid> addedEdgeIds;
+    std::vector<dust3d::Uuid> changedEdgeIds;
+    for (const auto& it : changedEdges) {
+        if (nullptr == it.second)
+            continue;
+        Document::Edge edge(it.first);
+        edge.name = dust3d::String::valueOrEmpty(*it.second, "name").c_str();
+        edge.boneName = dust3d::String::valueOrEmpty(*it.second, "boneName").c_str();
+        edge.partId = dust3d::Uuid(dust3d::String::valueOrEmpty(*it.second, "partId"));
+        for (const auto& endpoint : { "from", "to" }) {
+            std::string nodeId = dust3d::String::valueOrEmpty(*it.second, endpoint);
+            if (!nodeId.empty())
+                edge.nodeIds.push_back(dust3d::Uuid(nodeId));
+        }
+        auto findEdge = edgeMap.find(it.first);
+        if (findEdge != edgeMap.end()) {
+            for (const auto& nodeId : findEdge->second.nodeIds) {
+                auto node = nodeMap.find(nodeId);
+                if (node == nodeMap.end())
+                    continue;
+                node->second.edgeIds.erase(std::remove(node->second.edgeIds.begin(), node->second.edgeIds.end(), it.first), node->second.edgeIds.end());
+            }
+            dirtyPartIds.insert(findEdge->second.partId);
+            changedEdgeIds.push_back(it.first);
+        } else {
+            addedEdgeIds.push_back(it.first);
+        }
+        for (const auto& nodeId : edge.nodeIds) {
+            auto node = nodeMap.find(nodeId);
+            if (node != nodeMap.end())
+                node->second.edgeIds.push_back(it.first);
+        }
+        dirtyPartIds.insert(edge.partId);
+        edgeMap[it.first] = edge;
+    }
+
+    for (const auto& it : changedComponents) {
+        if (nullptr == it.second)
+            continue;
+        Document::Component component(it.first,
+            dust3d::String::valueOrEmpty(*it.second, "linkData").c_str(),
+            dust3d::String::valueOrEmpty(*it.second, "linkDataType").c_str());
+        loadComponentAttributes(&component, *it.second);
+        if (!component.linkToPartId.isNull()) {
+            auto part = partMap.find(component.linkToPartId);
+            if (part != partMap.end())
+                part->second.componentId = it.first;
+        }
+        auto existingComponent = componentMap.find(it.first);
+        if (existingComponent != componentMap.end()) {
+            // The parent is only rewritten when the parent itself changed, and the preview stays until regenerated
+            component.parentId = existingComponent->second.parentId;
+            component.previewImage = std::move(existingComponent->second.previewImage);
+            component.previewPixmap = existingComponent->second.previewPixmap;
+            existingComponent->second = std::move(component);
+        } else {
+            componentMap.emplace(it.first, std::move(component));
+        }
+    }
+    auto resetChildren = [&](Document::Component* parent, const dust3d::Uuid& parentId, const Attributes& attributes) {
+        auto childrenIds = parent->childrenIds;
+        for (const auto& childId : childrenIds)
+            parent->removeChild(childId);
+        for (const auto& childId : dust3d::String::split(dust3d::String::valueOrEmpty(attributes, "children"), ',')) {
+            if (childId.empty())
+                continue;
+            dust3d::Uuid childComponentId = dust3d::Uuid(childId);
+            auto childComponent = componentMap.find(childComponentId);
+            if (childComponent == componentMap.end())
+                continue;
+            parent->addChild(childComponentId);
+            childComponent->second.parentId = parentId;
+        }
+    };
+    for (const auto& it : changedComponents) {
+        if (nullptr == it.second)
+            continue;
+        resetChildren(&componentMap[it.first], it.first, *it.second);
+    }
+    if (nullptr != rootComponentAttributes)
+        resetChildren(&rootComponent, dust3d::Uuid(), *rootComponentAttributes);
+
+    for (const auto& partId : dirtyPartIds) {
+        auto part = partMap.find(partId);
+        if (part != partMap.end())
+            part->second.dirty = true;
+    }
+
+    if (nullptr != canvas) {
+        setOriginX(dust3d::String::toFloat(dust3d::String::valueOrEmpty(*canvas, "originX")));
+        setOriginY(dust3d::String::toFloat(dust3d::String::valueOrEmpty(*canvas, "originY")));
+        setOriginZ(dust3d::String::toFloat(dust3d::String::valueOrEmpty(*canvas, "originZ")));
+    }
+
+    for (const auto& it : changedAnimations) {
+        if (nullptr == it.second) {
+            m_animations.erase(it.first);
+            if (m_currentAnimationId == it.first)
+                m_currentAnimationId = dust3d::Uuid();
+            continue;
+        }
+        Animation anim;
+        anim.id = it.first;
+        if (!loadAnimationAttributes(&anim, *it.second))
+            continue;
+        m_animations[anim.id] = anim;
+    }
+
+    for (const auto& nodeId : addedNodeIds)
+        emit nodeAdded(nodeId);
+    for (const auto& edgeId : addedEdgeIds)
+        emit edgeAdded(edgeId);
+    for (const auto& partId : addedPartIds)
+        emit partAdded(partId);
+    for (const auto& edgeId : changedEdgeIds)
+        emit edgeNodeChanged(edgeId);
+    for (const auto& nodeId : changedNodeIds) {
+        emit nodeOriginChanged(nodeId);
+        emit nodeRadiusChanged(nodeId);
+        emit nodeCutRotationChanged(nodeId);
+        emit nodeCutFaceChanged(nodeId);
+    }
+    for (const auto& it : changedComponents) {
+        if (nullptr == it.second)
+            continue;
+        emit componentChildrenChanged(it.first);
+        emit componentNameChanged(it.first);
+        emit componentColorStateChanged(it.first);
+        emit componentColorImageChanged(it.first);
+        emit componentExpandStateChanged(it.first);
+        emit componentSideCloseStateChanged(it.first);
+        emit componentFrontCloseStateChanged(it.first);
+        emit componentBackCloseStateChanged(it.first);
+        emit componentBackCloseDepthRatioChanged(it.first);
+        emit componentBackCloseSharpnessChanged(it.first);
+        emit componentSmoothCutoffDegreesChanged(it.first);
+        emit componentTargetSegmentsChanged(it.first);
+        emit componentCombineModeChanged(it.first);
+    }
+    if (nullptr != rootComponentAttributes)
+        emit componentChildrenChanged(dust3d::Uuid());
+    if (nullptr != canvas)
+        emit originChanged();
+
+    emit skeletonChanged();
+
+    for (const auto& partId : dirtyPartIds) {
+        if (partMap.find(partId) != partMap.end())
+            emit partVisibleStateChanged(partId);
+    }
+    // Every property of a changed part may differ, so every listener gets to refresh
+    for (const auto& it : changedParts) {
+        if (nullptr == it.second)
+            continue;
+        const dust3d::Uuid& partId = it.first;
+        emit partLockStateChanged(partId);
+        emit partDisableStateChanged(partId);
+        emit partSubdivStateChanged(partId);
+        emit partXmirrorStateChanged(partId);
+        emit partDeformThicknessChanged(partId);
+        emit partDeformWidthChanged(partId);
+        emit partDeformUnifyStateChanged(partId);
+        emit partRoundStateChanged(partId);
+        emit partChamferStateChanged(partId);
+        emit partFillLoopInteriorStateChanged(partId);
+        emit partCutRotationChanged(partId);
+        emit partCutFaceChanged(partId);
+        emit partTargetChanged(partId);
+        emit partMetalnessChanged(partId);
+        emit partRoughnessChanged(partId);
+        emit partHollowThicknessChanged(partId);
+        emit partImportedModelIdChanged(partId);
+    }
+
+    if (nullptr != canvas) {
+        setHeadHasEyelids(dust3d::String::isTrue(dust3d::String::valueOrEmpty(*canvas, "headHasEyelids")));
+        setRigType(QString::fromUtf8(dust3d::String::valueOrEmpty(*canvas, "rigType").c_str()));
+    }
+
+    if (!changedAnimations.empty()) {
+        emit animationsChanged();
+        emit optionsChanged();
+    }
+}
+
 ModelMesh* Document::takeResultMesh()
 {
     if (nullptr == m_resultMesh)
@@ -2728,14 +3083,26 @@ quint64 Document::resultTextureMeshId()
 
 void Document::meshReady()
 {
-    ModelMesh* resultMesh = m_meshGenerator->takeResultMesh();
-    m_wireframeMesh.reset(m_meshGenerator->takeWireframeMesh());
-    dust3d::Object* object = m_meshGenerator->takeObject();
-    dust3d::Snapshot* snapshot = m_meshGenerator->takeSnapshot();
-    bool isSuccessful = m_meshGenerator->isSuccessful();
+    std::unique_ptr<MeshGenerator> meshGenerator = m_meshGenerationScheduler->takeFinishedGenerator();
+
+    // Only a newer request cancels a generation, so start it and keep the current result on screen
+    if (meshGenerator->isCancelled()) {
+        qDebug() << "Mesh generation cancelled";
+        meshGenerator.reset();
+        if (m_isResultMeshObsolete && 0 == m_batchChangeRefCount)
+            startMeshGeneration();
+        return;
+    }
+
+    ModelMesh* resultMesh = meshGenerator->takeResultMesh();
+    m_wireframeMesh.reset(meshGenerator->takeWireframeMesh());
+    dust3d::Object* object = meshGenerator->takeObject();
+    dust3d::Snapshot* snapshot = meshGenerator->takeSnapshot();
+    auto snapshotView = meshGenerator->snapshotView();
+    bool isSuccessful = meshGenerator->isSuccessful();
 
     std::unique_ptr<std::map<dust3d::Uuid, std::unique_ptr<ModelMesh>>> componentPreviewMeshes;
-    componentPreviewMeshes.reset(m_meshGenerator->takeComponentPreviewMeshes());
+    componentPreviewMeshes.reset(meshGenerator->takeComponentPreviewMeshes());
     bool componentPreviewsChanged = componentPreviewMeshes && !componentPreviewMeshes->empty();
     if (componentPreviewsChanged) {
         for (auto& it : *componentPreviewMeshes) {
@@ -2745,7 +3112,7 @@ void Document::meshReady()
     }
 
     std::unique_ptr<std::map<dust3d::Uuid, std::unique_ptr<QImage>>> componentPreviewImages;
-    componentPreviewImages.reset(m_meshGenerator->takeComponentPreviewImages());
+    componentPreviewImages.reset(meshGenerator->takeComponentPreviewImages());
     if (componentPreviewImages && !componentPreviewImages->empty()) {
         for (auto& it : *componentPreviewImages) {
             setComponentPreviewImage(it.first, std::move(it.second));
@@ -2758,22 +3125,20 @@ void Document::meshReady()
 
     m_currentObject.reset(object);
     m_currentSnapshot.reset(snapshot);
+    m_currentSnapshotView = std::move(snapshotView);
 
     if (nullptr == m_resultMesh) {
         qDebug() << "Result mesh is null";
     }
 
-    delete m_meshGenerator;
-    m_meshGenerator = nullptr;
-
-    m_meshGeneratorThread = nullptr;
+    meshGenerator.reset();
 
     qDebug() << "Mesh generation done";
 
     emit resultMeshChanged();
 
-    if (m_isResultMeshObsolete) {
-        generateMesh();
+    if (m_isResultMeshObsolete && 0 == m_batchChangeRefCount) {
+        startMeshGeneration();
     }
 }
 
@@ -2786,8 +3151,8 @@ void Document::batchChangeEnd()
 {
     m_batchChangeRefCount--;
     if (0 == m_batchChangeRefCount) {
-        if (m_isResultMeshObsolete) {
-            generateMesh();
+        if (m_isResultMeshObsolete && !isMeshGenerating()) {
+            startMeshGeneration();
         }
     }
 }
@@ -2812,11 +3177,22 @@ void Document::enableWeld(bool enabled)
 
 void Document::generateMesh()
 {
-    if (nullptr != m_meshGenerator || m_batchChangeRefCount > 0) {
+    if (!m_meshGenerationScheduler) {
+        m_meshGenerationScheduler = std::make_unique<MeshGenerationScheduler>();
+        connect(m_meshGenerationScheduler.get(), &MeshGenerationScheduler::finished, this, &Document::meshReady);
+    }
+
+    m_meshGenerationScheduler->request();
+    if (m_meshGenerationScheduler->isGenerating() || m_batchChangeRefCount > 0) {
         m_isResultMeshObsolete = true;
         return;
     }
 
+    startMeshGeneration();
+}
+
+void Document::startMeshGeneration()
+{
     emit meshGenerating();
 
     qDebug() << "Mesh generating..";
@@ -2825,17 +3201,20 @@ void Document::generateMesh()
 
     m_isResultMeshObsolete = false;
 
-    m_meshGeneratorThread = new QThread;
-
     dust3d::Snapshot* snapshot = new dust3d::Snapshot;
     toSnapshot(snapshot);
     resetDirtyFlags();
-    m_meshGenerator = new MeshGenerator(snapshot);
-    m_meshGenerator->setId(m_nextMeshGenerationId++);
-    m_meshGenerator->setDefaultPartColor(dust3d::Color::createWhite());
+    auto meshGenerator = new MeshGenerator(snapshot);
+    meshGenerator->setId(m_nextMeshGenerationId++);
+    meshGenerator->setDefaultPartColor(dust3d::Color::createWhite());
     if (!m_generatedCacheContext)
         m_generatedCacheContext = std::make_unique<dust3d::MeshGenerator::GeneratedCacheContext>();
-    m_meshGenerator->setGeneratedCacheContext(m_generatedCacheContext.get());
+    meshGenerator->setGeneratedCacheContext(m_generatedCacheContext.get());
+    {
+        QString partMeshCacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/part-meshes";
+        if (QDir().mkpath(partMeshCacheDirectory))
+            meshGenerator->setPartMeshCacheDirectory(partMeshCacheDirectory.toStdString());
+    }
 
     // Pass raw GLB data to mesh generator for parsing on the worker thread
     {
@@ -2853,24 +3232,19 @@ void Document::generateMesh()
             if (nullptr == glbData)
                 continue;
             std::string componentIdString = partIt.second.componentId.isNull() ? std::string() : partIt.second.componentId.toString();
-            m_meshGenerator->addPendingGlbData(idString, *glbData, componentIdString);
+            meshGenerator->addPendingGlbData(idString, *glbData, componentIdString);
         }
     }
 
     if (!m_smoothNormal) {
-        m_meshGenerator->setSmoothShadingThresholdAngleDegrees(0);
+        meshGenerator->setSmoothShadingThresholdAngleDegrees(0);
     }
-    m_meshGenerator->moveToThread(m_meshGeneratorThread);
-    connect(m_meshGeneratorThread, &QThread::started, m_meshGenerator, &MeshGenerator::process);
-    connect(m_meshGenerator, &MeshGenerator::importedModelTextureReady, this, [this](dust3d::Uuid componentId, dust3d::Uuid textureId) {
+    connect(meshGenerator, &MeshGenerator::importedModelTextureReady, this, [this](dust3d::Uuid componentId, dust3d::Uuid textureId) {
         auto componentIt = componentMap.find(componentId);
         if (componentIt != componentMap.end() && componentIt->second.colorImageId != textureId)
             componentIt->second.colorImageId = textureId;
     });
-    connect(m_meshGenerator, &MeshGenerator::finished, this, &Document::meshReady);
-    connect(m_meshGenerator, &MeshGenerator::finished, m_meshGeneratorThread, &QThread::quit);
-    connect(m_meshGeneratorThread, &QThread::finished, m_meshGeneratorThread, &QThread::deleteLater);
-    m_meshGeneratorThread->start();
+    m_meshGenerationScheduler->start(meshGenerator);
 }
 
 void Document::generateTexture()
@@ -2882,7 +3256,7 @@ void Document::generateTexture()
 
     m_isTextureObsolete = false;
 
-    if (nullptr == m_currentObject || nullptr == m_currentSnapshot)
+    if (nullptr == m_currentObject || nullptr == m_currentSnapshotView)
         return;
 
     qDebug() << "UV mapping generating..";
@@ -2890,10 +3264,8 @@ void Document::generateTexture()
 
     auto object = std::make_unique<dust3d::Object>(*m_currentObject);
 
-    auto snapshot = std::make_unique<dust3d::Snapshot>(*m_currentSnapshot);
-
     QThread* thread = new QThread;
-    m_textureGenerator = new UvMapGenerator(std::move(object), std::move(snapshot));
+    m_textureGenerator = new UvMapGenerator(std::move(object), m_currentSnapshotView);
     m_textureGenerator->moveToThread(thread);
     connect(thread, &QThread::started, m_textureGenerator, &UvMapGenerator::process);
     connect(m_textureGenerator, &UvMapGenerator::finished, this, &Document::textureReady);
@@ -3321,39 +3693,32 @@ void Document::setComponentColorState(const dust3d::Uuid& componentId, bool hasC
 
 void Document::saveSnapshot()
 {
-    Document::HistoryItem item;
-    toSnapshot(&item.snapshot);
-    if (m_undoItems.size() + 1 > m_maxSnapshot)
-        m_undoItems.pop_front();
-    m_undoItems.push_back(item);
+    dust3d::Snapshot snapshot;
+    toSnapshot(&snapshot);
+    m_history.record(snapshot);
 }
 
 void Document::undo()
 {
-    if (!undoable())
+    const dust3d::SnapshotDelta* delta = m_history.undo();
+    if (nullptr == delta)
         return;
-    m_redoItems.push_back(m_undoItems.back());
-    m_undoItems.pop_back();
-    const auto& item = m_undoItems.back();
-    fromSnapshot(item.snapshot);
-    qDebug() << "Undo/Redo items:" << m_undoItems.size() << m_redoItems.size();
+    applySnapshotDelta(*delta, false);
+    qDebug() << "Undo/Redo items:" << m_history.undoCount() << m_history.redoCount() << "history bytes:" << m_history.memoryUsage();
 }
 
 void Document::redo()
 {
-    if (m_redoItems.empty())
+    const dust3d::SnapshotDelta* delta = m_history.redo();
+    if (nullptr == delta)
         return;
-    m_undoItems.push_back(m_redoItems.back());
-    const auto& item = m_redoItems.back();
-    fromSnapshot(item.snapshot);
-    m_redoItems.pop_back();
-    qDebug() << "Undo/Redo items:" << m_undoItems.size() << m_redoItems.size();
+    applySnapshotDelta(*delta, true);
+    qDebug() << "Undo/Redo items:" << m_history.undoCount() << m_history.redoCount() << "history bytes:" << m_history.memoryUsage();
 }
 
 void Document::clearHistories()
 {
-    m_undoItems.clear();
-    m_redoItems.clear();
+    m_history.clear();
 }
 
 void Document::paste()
@@ -3399,12 +3764,12 @@ bool Document::hasPastableNodesInClipboard() const
 
 bool Document::undoable() const
 {
-    return m_undoItems.size() >= 2;
+    return m_history.undoable();
 }
 
 bool Document::redoable() const
 {
-    return !m_redoItems.empty();
+    return m_history.redoable();
 }
 
 bool Document::isNodeEditable(dust3d::Uuid nodeId) const
@@ -3429,7 +3794,7 @@ bool Document::isEdgeEditable(dust3d::Uuid edgeId) const
 
 bool Document::isExportReady() const
 {
-    if (m_meshGenerator || m_textureGenerator || m_rigGeneratorWorker)
+    if (isMeshGenerating() || m_textureGenerator || m_rigGeneratorWorker)
         return false;
 
     if (m_isResultMeshObsolete || m_isTextureObsolete || m_isRigObsolete)
@@ -3446,7 +3811,12 @@ void Document::checkExportReadyState()
 
 bool Document::isMeshGenerating() const
 {
-    return nullptr != m_meshGenerator;
+    return m_meshGenerationScheduler && m_meshGenerationScheduler->isGenerating();
+}
+
+const MeshGenerationScheduler* Document::meshGenerationScheduler() const
+{
+    return m_meshGenerationScheduler.get();
 }
 
 bool Document::isTextureGenerating() const
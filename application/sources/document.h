@@ -11,11 +11,12 @@
 #include <QPolygon>
 #include <algorithm>
 #include <cmath>
-#include <deque>
 #include <dust3d/base/combine_mode.h>
 #include <dust3d/base/cut_face.h>
 #include <dust3d/base/part_target.h>
 #include <dust3d/base/snapshot.h>
+#include <dust3d/base/snapshot_history.h>
+#include <dust3d/base/snapshot_view.h>
 #include <dust3d/base/texture_type.h>
 #include <dust3d/base/uuid.h>
 #include <dust3d/mesh/mesh_generator.h>
@@ -25,6 +26,7 @@
 #include <vector>
 
 class UvMapGenerator;
+class MeshGenerationScheduler;
 class MeshGenerator;
 class RigGeneratorWorker;
 
@@ -43,11 +45,6 @@ public:
         Document = (SnapshotFor::Nodes)
     };
 
-    class HistoryItem {
-    public:
-        dust3d::Snapshot snapshot;
-    };
-
     enum class Profile {
         Unknown = 0,
         Main,
@@ -348,6 +345,7 @@ public:
     const RigStructure& currentActualRigStructure() const;
     bool isExportReady() const;
     bool isMeshGenerating() const;
+    const MeshGenerationScheduler* meshGenerationScheduler() const;
     bool isTextureGenerating() const;
     bool isRigGenerating() const;
     void collectCutFaceList(std::vector<QString>& cutFaces) const;
@@ -561,6 +559,7 @@ private:
     void resolveSnapshotBoundingBox(const dust3d::Snapshot& snapshot, QRectF* mainProfile, QRectF* sideProfile);
     void settleOrigin();
     void checkExportReadyState();
+    void startMeshGeneration();
     void splitPartByNode(std::vector<std::vector<dust3d::Uuid>>* groups, dust3d::Uuid nodeId);
     void joinNodeAndNeiborsToGroup(std::vector<dust3d::Uuid>* group, dust3d::Uuid nodeId, std::set<dust3d::Uuid>* visitMap, dust3d::Uuid noUseEdgeId = dust3d::Uuid());
     void splitPartByEdge(std::vector<std::vector<dust3d::Uuid>>* groups, dust3d::Uuid edgeId);
@@ -570,16 +569,21 @@ private:
     void removeComponentRecursively(dust3d::Uuid componentId);
     void updateLinkedPart(dust3d::Uuid oldPartId, dust3d::Uuid newPartId);
     dust3d::Uuid createNode(dust3d::Uuid nodeId, float x, float y, float z, float radius, dust3d::Uuid fromNodeId);
+    void applySnapshotDelta(const dust3d::SnapshotDelta& delta, bool forward);
+    static void loadPartAttributes(Part* part, const std::map<std::string, std::string>& attributes);
+    static void loadNodeAttributes(Node* node, const std::map<std::string, std::string>& attributes);
+    static void loadComponentAttributes(Component* component, const std::map<std::string, std::string>& attributes);
+    static bool loadAnimationAttributes(Animation* animation, const std::map<std::string, std::string>& attributes);
 
     bool m_isResultMeshObsolete = false;
-    MeshGenerator* m_meshGenerator = nullptr;
-    QThread* m_meshGeneratorThread = nullptr;
+    std::unique_ptr<MeshGenerationScheduler> m_meshGenerationScheduler;
     std::unique_ptr<ModelMesh> m_resultMesh;
     std::unique_ptr<MonochromeMesh> m_wireframeMesh;
     bool m_isMeshGenerationSucceed = true;
     int m_batchChangeRefCount = 0;
     std::unique_ptr<dust3d::Object> m_currentObject;
     std::unique_ptr<dust3d::Snapshot> m_currentSnapshot;
+    std::shared_ptr<const dust3d::SnapshotView> m_currentSnapshotView;
     bool m_isTextureObsolete = false;
     UvMapGenerator* m_textureGenerator = nullptr;
     std::unique_ptr<dust3d::Object> m_uvMappedObject = std::make_unique<dust3d::Object>();
@@ -608,8 +612,7 @@ private:
 
 private:
     static unsigned long m_maxSnapshot;
-    std::deque<HistoryItem> m_undoItems;
-    std::deque<HistoryItem> m_redoItems;
+    dust3d::SnapshotHistory m_history = dust3d::SnapshotHistory(m_maxSnapshot);
 };
 
 #endif
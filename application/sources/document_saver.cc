@@ -1,9 +1,12 @@
 #include "document_saver.h"
+#include "ds3_deflate.h"
 #include "glb_forever.h"
 #include "image_forever.h"
 #include <QGuiApplication>
+#include <QSaveFile>
 #include <QtCore/qbuffer.h>
 #include <dust3d/base/ds3_file.h>
+#include <dust3d/base/snapshot_binary.h>
 #include <dust3d/base/snapshot_xml.h>
 #include <set>
 
@@ -51,16 +54,22 @@ void DocumentSaver::collectUsedResourceIds(const dust3d::Snapshot* snapshot,
     }
 }
 
-bool DocumentSaver::save(dust3d::Ds3FileWriter& ds3Writer,
+bool DocumentSaver::addItems(dust3d::Ds3FileWriter& ds3Writer,
+    const std::string& modelXml,
+    const std::vector<std::uint8_t>& modelBinary,
     dust3d::Snapshot* snapshot,
     const QByteArray* turnaroundPngByteArray)
 {
-    {
-        std::string modelXml;
-        saveSnapshotToXmlString(*snapshot, modelXml);
-        if (modelXml.size() > 0) {
-            ds3Writer.add("model.xml", "model", modelXml.c_str(), modelXml.size());
-        }
+    // Releases without the decoder read items as stored, so only items they don't know get deflated
+    ds3Writer.setEncoder(Ds3Deflate::encoding, Ds3Deflate::encode);
+
+    if (modelXml.size() > 0) {
+        ds3Writer.add("model.xml", "model", modelXml.c_str(), modelXml.size());
+    }
+
+    // Opened in preference to the xml, which stays uncompressed for older versions and as the fallback
+    if (modelBinary.size() > 0) {
+        ds3Writer.add("model.bin", "snapshot", modelBinary.data(), modelBinary.size(), true);
     }
 
     if (nullptr != turnaroundPngByteArray && turnaroundPngByteArray->size() > 0)
@@ -93,25 +102,42 @@ bool DocumentSaver::save(const QString* filename,
     dust3d::Snapshot* snapshot,
     const QByteArray* turnaroundPngByteArray)
 {
-    dust3d::Ds3FileWriter ds3Writer;
-
-    save(ds3Writer, snapshot, turnaroundPngByteArray);
+    std::string modelXml;
+    saveSnapshotToXmlString(*snapshot, modelXml);
+    std::vector<std::uint8_t> modelBinary;
+    saveSnapshotToBinary(*snapshot, modelBinary);
 
-    return ds3Writer.save(filename->toUtf8().constData());
+    dust3d::Ds3FileWriter ds3Writer;
+    addItems(ds3Writer, modelXml, modelBinary, snapshot, turnaroundPngByteArray);
+
+    // Items are written straight from their buffers, and the target is only replaced once everything is written
+    QSaveFile file(*filename);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    bool isWritten = ds3Writer.save([&](const void* data, size_t size) {
+        return (qint64)size == file.write((const char*)data, (qint64)size);
+    });
+    if (!isWritten) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
 }
 
 bool DocumentSaver::save(QByteArray& byteArray,
     dust3d::Snapshot* snapshot,
     const QByteArray* turnaroundPngByteArray)
 {
-    dust3d::Ds3FileWriter ds3Writer;
-
-    save(ds3Writer, snapshot, turnaroundPngByteArray);
+    std::string modelXml;
+    saveSnapshotToXmlString(*snapshot, modelXml);
+    std::vector<std::uint8_t> modelBinary;
+    saveSnapshotToBinary(*snapshot, modelBinary);
 
-    std::vector<uint8_t> rawArray;
-    ds3Writer.save(rawArray);
-
-    byteArray.append((char*)rawArray.data(), rawArray.size());
+    dust3d::Ds3FileWriter ds3Writer;
+    addItems(ds3Writer, modelXml, modelBinary, snapshot, turnaroundPngByteArray);
 
-    return true;
+    return ds3Writer.save([&](const void* data, size_t size) {
+        byteArray.append((const char*)data, (int)size);
+        return true;
+    });
 }
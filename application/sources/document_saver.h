@@ -9,6 +9,8 @@
 #include <dust3d/base/uuid.h>
 #include <map>
 #include <set>
+#include <string>
+#include <vector>
 
 class DocumentSaver : public QObject {
     Q_OBJECT
@@ -23,7 +25,10 @@ public:
     static bool save(QByteArray& byteArray,
         dust3d::Snapshot* snapshot,
         const QByteArray* turnaroundPngByteArray);
-    static bool save(dust3d::Ds3FileWriter& ds3Writer,
+    // Items reference the model xml, the model binary and the stored assets, so all must outlive the writer
+    static bool addItems(dust3d::Ds3FileWriter& ds3Writer,
+        const std::string& modelXml,
+        const std::vector<std::uint8_t>& modelBinary,
         dust3d::Snapshot* snapshot,
         const QByteArray* turnaroundPngByteArray);
     static void collectUsedResourceIds(const dust3d::Snapshot* snapshot,
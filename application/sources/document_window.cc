@@ -5,6 +5,7 @@
 #include "cut_face_preview.h"
 #include "document.h"
 #include "document_saver.h"
+#include "ds3_deflate.h"
 #include "export_animation_worker.h"
 #include "export_progress_widget.h"
 #include "fbx_file.h"
@@ -69,8 +70,12 @@
 #include <dust3d/base/debug.h>
 #include <dust3d/base/ds3_file.h>
 #include <dust3d/base/snapshot.h>
+#include <dust3d/base/snapshot_binary.h>
 #include <dust3d/base/snapshot_xml.h>
+#include <dust3d/base/thread_pool.h>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -1348,12 +1353,34 @@ void DocumentWindow::saveTo(const QString& saveAsFilename)
 }
 
 void DocumentWindow::openPathDataAs(const QString& path, const QByteArray& fileData, const QString& asName)
+{
+    openPathDataAs(path, (const std::uint8_t*)fileData.data(), fileData.size(), asName);
+}
+
+void DocumentWindow::openPathDataAs(const QString& path, const std::uint8_t* fileData, size_t fileSize, const QString& asName)
 {
     QApplication::setOverrideCursor(Qt::WaitCursor);
 
     reset();
 
-    dust3d::Ds3FileReader ds3Reader((const std::uint8_t*)fileData.data(), fileData.size());
+    // Items are decoded straight from the file data, only the model xml is copied because it's parsed in place.
+    // Deflated items need a decoded copy.
+    dust3d::Ds3FileReader ds3Reader(fileData, fileSize);
+    ds3Reader.setDecoder(Ds3Deflate::encoding, Ds3Deflate::decode);
+    std::vector<std::uint8_t> decodedData;
+    static constexpr size_t maxModelSize = 256 * 1024 * 1024; // 256 MB
+    auto modelSize = [](const dust3d::Ds3ReaderItem& item) {
+        return (size_t)(item.encoding.empty() ? item.size : item.decodedSize);
+    };
+    auto itemBytes = [&](const dust3d::Ds3ReaderItem& item, size_t* size) {
+        if (item.encoding.empty()) {
+            *size = (size_t)item.size;
+            return ds3Reader.itemData(item);
+        }
+        ds3Reader.loadItem(item.name, &decodedData);
+        *size = decodedData.size();
+        return (const std::uint8_t*)decodedData.data();
+    };
     for (int i = 0; i < (int)ds3Reader.items().size(); ++i) {
         const dust3d::Ds3ReaderItem& item = ds3Reader.items()[i];
         qDebug() << "[" << i << "]item.name:" << item.name << "item.type:" << item.type;
@@ -1363,9 +1390,9 @@ void DocumentWindow::openPathDataAs(const QString& path, const QByteArray& fileD
                 std::string imageIdString = dust3d::String::split(filename, '.')[0];
                 dust3d::Uuid imageId = dust3d::Uuid(imageIdString);
                 if (!imageId.isNull()) {
-                    std::vector<std::uint8_t> data;
-                    ds3Reader.loadItem(item.name, &data);
-                    QImage image = QImage::fromData(data.data(), (int)data.size(), "PNG");
+                    size_t size = 0;
+                    const std::uint8_t* data = itemBytes(item, &size);
+                    QImage image = QImage::fromData(data, (int)size, "PNG");
                     (void)ImageForever::add(&image, imageId);
                 }
             } else if (dust3d::String::startsWith(item.name, "models/")) {
@@ -1373,25 +1400,51 @@ void DocumentWindow::openPathDataAs(const QString& path, const QByteArray& fileD
                 std::string glbIdString = dust3d::String::split(filename, '.')[0];
                 dust3d::Uuid glbId = dust3d::Uuid(glbIdString);
                 if (!glbId.isNull()) {
-                    std::vector<std::uint8_t> data;
-                    ds3Reader.loadItem(item.name, &data);
-                    QByteArray glbData((const char*)data.data(), (int)data.size());
+                    size_t size = 0;
+                    const std::uint8_t* data = itemBytes(item, &size);
+                    QByteArray glbData((const char*)data, (int)size);
                     (void)GlbForever::add(&glbData, glbId);
                 }
             }
         }
     }
 
+    // The binary snapshot is preferred, model.xml is only parsed for files without a readable one
+    bool isSnapshotLoaded = false;
+    for (const auto& item : ds3Reader.items()) {
+        if (item.type != "snapshot")
+            continue;
+        if (modelSize(item) > maxModelSize) {
+            qWarning() << "Skipping oversized snapshot item:" << modelSize(item) << "bytes (limit" << maxModelSize << ")";
+            break;
+        }
+        size_t size = 0;
+        const std::uint8_t* data = itemBytes(item, &size);
+        dust3d::Snapshot snapshot;
+        if (!dust3d::loadSnapshotFromBinary(&snapshot, data, size)) {
+            qWarning() << "Unreadable snapshot item, falling back to model XML:" << item.name;
+            break;
+        }
+        unifySnapshotEdgeLinkDirection(snapshot);
+        m_document->fromSnapshot(snapshot);
+        m_document->saveSnapshot();
+        isSnapshotLoaded = true;
+        break;
+    }
+
     for (int i = 0; i < (int)ds3Reader.items().size(); ++i) {
         const dust3d::Ds3ReaderItem& item = ds3Reader.items()[i];
         if (item.type == "model") {
-            static constexpr size_t maxXmlSize = 256 * 1024 * 1024; // 256 MB
-            std::vector<std::uint8_t> data;
-            ds3Reader.loadItem(item.name, &data);
-            if (data.size() > maxXmlSize) {
-                qWarning() << "Skipping oversized model XML chunk:" << data.size() << "bytes (limit" << maxXmlSize << ")";
+            if (isSnapshotLoaded)
+                continue;
+            size_t xmlSize = modelSize(item);
+            if (xmlSize > maxModelSize) {
+                qWarning() << "Skipping oversized model XML chunk:" << xmlSize << "bytes (limit" << maxModelSize << ")";
                 continue;
             }
+            std::vector<std::uint8_t> data;
+            data.reserve(xmlSize + 1);
+            ds3Reader.loadItem(item.name, &data);
             data.push_back('\0');
             dust3d::Snapshot snapshot;
             loadSnapshotFromXmlString(&snapshot, reinterpret_cast<char*>(data.data()));
@@ -1400,9 +1453,9 @@ void DocumentWindow::openPathDataAs(const QString& path, const QByteArray& fileD
             m_document->saveSnapshot();
         } else if (item.type == "asset") {
             if (item.name == "canvas.png") {
-                std::vector<std::uint8_t> data;
-                ds3Reader.loadItem(item.name, &data);
-                QImage canvasImage = QImage::fromData(data.data(), (int)data.size(), "PNG");
+                size_t size = 0;
+                const std::uint8_t* data = itemBytes(item, &size);
+                QImage canvasImage = QImage::fromData(data, (int)size, "PNG");
                 if (!canvasImage.isNull())
                     m_document->updateTurnaround(canvasImage);
             }
@@ -1424,8 +1477,17 @@ void DocumentWindow::openPathAs(const QString& path, const QString& asName)
 {
     QFile file(path);
     file.open(QFile::ReadOnly);
-    QByteArray fileData = file.readAll();
 
+    // Map the file instead of reading it, so embedded images and models are never copied
+    // before decoding, and pages of unused items are never loaded at all
+    uchar* mappedData = file.size() > 0 ? file.map(0, file.size()) : nullptr;
+    if (nullptr != mappedData) {
+        openPathDataAs(path, mappedData, (size_t)file.size(), asName);
+        file.unmap(mappedData);
+        return;
+    }
+
+    QByteArray fileData = file.readAll();
     openPathDataAs(path, fileData, asName);
 }
 
@@ -1807,18 +1869,25 @@ void DocumentWindow::exportGlbResult()
     delete textureMetalnessRoughnessAmbientOcclusionImage;
     QFileDialog::saveFileContent(fileData, exportedFilename(m_currentFilename, ".glb"));
 #else
+    QString compactFilter = tr("Compact glTF Binary Format (*.glb)");
+    QString selectedFilter;
     QString filename = QFileDialog::getSaveFileName(this, QString(), QString(),
-        tr("glTF Binary Format (*.glb)"));
+        tr("glTF Binary Format (*.glb)") + ";;" + compactFilter, &selectedFilter);
     if (filename.isEmpty()) {
         return;
     }
     ensureFileExtension(&filename, ".glb");
-    exportGlbToFilename(filename);
+    exportGlbToFilename(filename, nullptr, selectedFilter == compactFilter);
 #endif
 }
 
-void DocumentWindow::exportGlbToFilename(const QString& filename, std::function<void()> onFinished)
+void DocumentWindow::exportGlbToFilename(const QString& filename, std::function<void()> onFinished, bool isCompact)
 {
+    // Compact files need KHR_mesh_quantization support from the importer
+    GlbFileWriter::Options options;
+    options.quantizeAttributes = isCompact;
+    options.reduceKeyframes = isCompact;
+
     if (!m_document->isExportReady()) {
         qDebug() << "Export but document is not export ready";
         if (onFinished)
@@ -1836,7 +1905,8 @@ void DocumentWindow::exportGlbToFilename(const QString& filename, std::function<
         QApplication::setOverrideCursor(Qt::WaitCursor);
         dust3d::Object uvObject = m_document->currentUvMappedObject();
         GlbFileWriter glbFileWriter(uvObject, filename,
-            m_document->textureImage.get(), m_document->textureNormalImage.get(), ormImage);
+            m_document->textureImage.get(), m_document->textureNormalImage.get(), ormImage,
+            nullptr, nullptr, nullptr, options);
         glbFileWriter.save();
         delete ormImage;
         QApplication::restoreOverrideCursor();
@@ -1880,7 +1950,8 @@ void DocumentWindow::exportGlbToFilename(const QString& filename, std::function<
             m_document->textureImage.get(), m_document->textureNormalImage.get(), ormImage,
             &m_document->getActualRigStructure(),
             &worker.inverseBindMatrices(),
-            nullptr);
+            nullptr,
+            options);
         glbFileWriter.save();
         delete ormImage;
         QApplication::restoreOverrideCursor();
@@ -1922,7 +1993,8 @@ void DocumentWindow::exportGlbToFilename(const QString& filename, std::function<
             textureImage, normalImage, ormImage,
             &rigStructure,
             &ibm,
-            &clips);
+            &clips,
+            options);
         glbFileWriter.save();
 
         delete textureImage;
@@ -2100,40 +2172,54 @@ void DocumentWindow::exportModelAndWavs(const QString& directory, const QString&
         QThread* wavThread = new QThread;
         auto wavWorker = new QObject;
         wavWorker->moveToThread(wavThread);
+        auto failedWavFilenames = std::make_shared<QStringList>();
 
         connect(wavThread, &QThread::started, wavWorker, [=]() {
+            std::vector<std::vector<dust3d::SoundEvent>> clipSoundEvents(clips.size());
+            std::vector<std::pair<size_t, dust3d::SurfaceMaterial>> wavJobs;
             for (size_t i = 0; i < clips.size(); ++i) {
                 const auto& clip = clips[i];
                 if (clip.frames.empty())
                     continue;
 
-                auto soundEvents = dust3d::SoundEventDetector::detect(clip, animTypes[i]);
-                if (soundEvents.empty())
+                clipSoundEvents[i] = dust3d::SoundEventDetector::detect(clip, animTypes[i]);
+                if (clipSoundEvents[i].empty())
                     continue;
 
-                for (auto material : materials) {
-                    auto soundData = dust3d::SoundGenerator::generate(
-                        soundEvents, clip.durationSeconds, material);
-                    if (soundData.pcmSamples.empty())
-                        continue;
-
-                    auto wavData = dust3d::SoundGenerator::encodeWav(soundData);
-
-                    std::string materialName = dust3d::surfaceMaterialName(material);
-                    QString wavFilename = QString("%1/%2_%3_%4.wav")
-                                              .arg(directory)
-                                              .arg(modelName)
-                                              .arg(QString::fromStdString(animNames[i]))
-                                              .arg(QString::fromStdString(materialName));
-
-                    QFile file(wavFilename);
-                    if (file.open(QIODevice::WriteOnly)) {
-                        file.write(reinterpret_cast<const char*>(wavData.data()), static_cast<qint64>(wavData.size()));
-                        file.close();
-                    }
-                }
+                for (auto material : materials)
+                    wavJobs.push_back({ i, material });
             }
 
+            // Every clip and material pair renders independently and streams straight into its own file
+            std::mutex failedWavFilenamesMutex;
+            dust3d::ThreadPool::globalInstance()->parallelFor(wavJobs.size(), [&](size_t jobIndex) {
+                size_t i = wavJobs[jobIndex].first;
+                auto material = wavJobs[jobIndex].second;
+                dust3d::SoundRenderer soundRenderer(clipSoundEvents[i], clips[i].durationSeconds, material);
+                if (0 == soundRenderer.sampleCount())
+                    return;
+
+                std::string materialName = dust3d::surfaceMaterialName(material);
+                QString wavFilename = QString("%1/%2_%3_%4.wav")
+                                          .arg(directory)
+                                          .arg(modelName)
+                                          .arg(QString::fromStdString(animNames[i]))
+                                          .arg(QString::fromStdString(materialName));
+
+                QFile file(wavFilename);
+                bool written = file.open(QIODevice::WriteOnly)
+                    && dust3d::SoundGenerator::writeWav(soundRenderer, [&](const uint8_t* data, size_t size) {
+                           return file.write(reinterpret_cast<const char*>(data), static_cast<qint64>(size)) == static_cast<qint64>(size);
+                       });
+                file.close();
+                if (!written) {
+                    file.remove();
+                    std::lock_guard<std::mutex> lock(failedWavFilenamesMutex);
+                    failedWavFilenames->append(QDir::toNativeSeparators(wavFilename));
+                }
+            });
+            failedWavFilenames->sort();
+
             QMetaObject::invokeMethod(wavWorker, "deleteLater");
         });
         connect(wavWorker, &QObject::destroyed, this, [=]() {
@@ -2146,6 +2232,8 @@ void DocumentWindow::exportModelAndWavs(const QString& directory, const QString&
             progressWidget->close();
             progressWidget->deleteLater();
             wavThread->quit();
+            if (!failedWavFilenames->isEmpty())
+                QMessageBox::warning(this, tr("Export"), tr("Failed to write sound files:\n%1").arg(failedWavFilenames->join("\n")));
         });
         connect(wavThread, &QThread::finished, wavThread, &QThread::deleteLater);
 
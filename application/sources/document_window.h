@@ -17,6 +17,7 @@
 #include <QShowEvent>
 #include <QString>
 #include <QStringList>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
@@ -57,6 +58,7 @@ public:
     static void showSupporters();
     static void showAbout();
     static size_t total();
+    void openPathDataAs(const QString& path, const std::uint8_t* fileData, size_t fileSize, const QString& asName);
 
 protected:
     void showEvent(QShowEvent* event);
@@ -103,7 +105,7 @@ public slots:
     void checkExportWaitingList();
     void exportObjToFilename(const QString& filename);
     void exportFbxToFilename(const QString& filename);
-    void exportGlbToFilename(const QString& filename, std::function<void()> onFinished = nullptr);
+    void exportGlbToFilename(const QString& filename, std::function<void()> onFinished = nullptr, bool isCompact = false);
     void exportModelAndWavs(const QString& directory, const QString& format);
     void toggleRotation();
     void generateComponentPreviewImages();
@@ -0,0 +1,25 @@
+#include "ds3_deflate.h"
+#include <miniz.h>
+
+const std::string Ds3Deflate::encoding = "deflate";
+
+bool Ds3Deflate::encode(const std::uint8_t* data, size_t size, std::vector<std::uint8_t>* output)
+{
+    // Saving should not stall the editor, and the xml and mesh data already shrink well at the fastest level
+    mz_ulong outputSize = mz_compressBound((mz_ulong)size);
+    output->resize(outputSize);
+    if (MZ_OK != mz_compress2(output->data(), &outputSize, data, (mz_ulong)size, MZ_BEST_SPEED)) {
+        output->clear();
+        return false;
+    }
+    output->resize(outputSize);
+    return true;
+}
+
+bool Ds3Deflate::decode(const std::uint8_t* data, size_t size, std::vector<std::uint8_t>* output)
+{
+    mz_ulong outputSize = (mz_ulong)output->size();
+    if (MZ_OK != mz_uncompress(output->data(), &outputSize, data, (mz_ulong)size))
+        return false;
+    return outputSize == (mz_ulong)output->size();
+}
@@ -0,0 +1,17 @@
+#ifndef DUST3D_APPLICATION_DS3_DEFLATE_H_
+#define DUST3D_APPLICATION_DS3_DEFLATE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Zlib codec for the encoded items of .ds3 files, backed by the bundled miniz
+class Ds3Deflate {
+public:
+    static const std::string encoding;
+    static bool encode(const std::uint8_t* data, size_t size, std::vector<std::uint8_t>* output);
+    static bool decode(const std::uint8_t* data, size_t size, std::vector<std::uint8_t>* output);
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "export_animation_worker.h"
 #include <QDebug>
+#include <dust3d/base/thread_pool.h>
 
 void ExportAnimationWorker::process()
 {
@@ -18,31 +19,32 @@ void ExportAnimationWorker::process()
     }
 
     int total = (int)m_animations.size();
-    int current = 0;
 
+    std::vector<dust3d::AnimationClipRequest> requests;
+    requests.reserve(m_animations.size());
     for (const auto& animation : m_animations) {
-        emit progress(current, total);
-        ++current;
-
-        dust3d::AnimationParams params;
-        params.values = animation.params;
+        dust3d::AnimationClipRequest request;
+        request.name = animation.name.toStdString();
+        request.type = animation.type.toStdString();
+        request.parameters.values = animation.params;
+        requests.push_back(std::move(request));
+    }
 
-        dust3d::RigAnimationClip clip;
-        clip.name = animation.name.toStdString();
+    emit progress(0, total);
 
-        if (!dust3d::AnimationGenerator::generate(baseRig, m_inverseBindMatrices, clip,
-                animation.type.toStdString(), params)) {
+    // Failed clips stay in the list without frames so indices align with the input animations list
+    std::vector<bool> results = dust3d::AnimationGenerator::generateClips(baseRig, m_inverseBindMatrices,
+        requests, m_animationClips, dust3d::ThreadPool::globalInstance(),
+        [this, total](size_t generatedCount) {
+            emit progress((int)generatedCount, total);
+        });
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!results[i]) {
             qWarning() << "Export animation: generate failed for animation"
-                       << animation.name;
-            // Push an empty clip so indices align with input animations list
-            clip.frames.clear();
+                       << m_animations[i].name;
         }
-
-        m_animationClips.push_back(std::move(clip));
     }
 
-    emit progress(total, total);
-
     m_successful = true;
     emit finished();
 }
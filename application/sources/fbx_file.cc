@@ -3816,23 +3816,38 @@ FbxFileWriter::FbxFileWriter(dust3d::Object& object,
                 connections.addChild(p);
             }
 
+            // Resolve each bone and its parent to pose indices once for all frames
+            std::vector<size_t> poseBoneIndices(rigStructure->bones.size(), dust3d::BonePoseLayout::npos);
+            std::vector<size_t> poseParentIndices(rigStructure->bones.size(), dust3d::BonePoseLayout::npos);
+            if (clip.poseLayout) {
+                for (size_t i = 0; i < rigStructure->bones.size(); ++i) {
+                    const auto& bone = rigStructure->bones[i];
+                    poseBoneIndices[i] = clip.poseLayout->boneIndex(bone.name.toStdString());
+                    if (!bone.parent.isEmpty())
+                        poseParentIndices[i] = clip.poseLayout->boneIndex(bone.parent.toStdString());
+                }
+            }
+            auto frameLocalTransform = [&](const dust3d::BoneAnimationFrame& frame, size_t boneIdx, dust3d::Matrix4x4* localMat) -> bool {
+                const dust3d::Matrix4x4* frameWorld = frame.boneWorldTransforms.find(poseBoneIndices[boneIdx]);
+                if (nullptr == frameWorld)
+                    return false;
+                const dust3d::Matrix4x4* parentWorld = frame.boneWorldTransforms.find(poseParentIndices[boneIdx]);
+                if (nullptr != parentWorld) {
+                    *localMat = parentWorld->inverted();
+                    *localMat *= *frameWorld;
+                } else {
+                    *localMat = *frameWorld;
+                }
+                return true;
+            };
+
             // Determine which bones have changing translation/rotation across frames
             std::set<size_t> translatedBones, rotatedBones;
             for (const auto& frame : clip.frames) {
                 for (size_t i = 0; i < rigStructure->bones.size(); ++i) {
-                    const auto& bone = rigStructure->bones[i];
-                    const std::string boneNameStr = bone.name.toStdString();
-                    if (!frame.boneWorldTransforms.count(boneNameStr))
-                        continue;
-                    const auto& frameWorld = frame.boneWorldTransforms.at(boneNameStr);
                     dust3d::Matrix4x4 localMat;
-                    const std::string parentNameStr = bone.parent.toStdString();
-                    if (!parentNameStr.empty() && frame.boneWorldTransforms.count(parentNameStr)) {
-                        localMat = frame.boneWorldTransforms.at(parentNameStr).inverted();
-                        localMat *= frameWorld;
-                    } else {
-                        localMat = frameWorld;
-                    }
+                    if (!frameLocalTransform(frame, i, &localMat))
+                        continue;
                     double tx = localMat.constData()[dust3d::Matrix4x4::M30];
                     double ty = localMat.constData()[dust3d::Matrix4x4::M31];
                     double tz = localMat.constData()[dust3d::Matrix4x4::M32];
@@ -3850,25 +3865,15 @@ FbxFileWriter::FbxFileWriter(dust3d::Object& object,
 
             // Build translation curves for bones with changing translation
             for (const size_t boneIdx : translatedBones) {
-                const auto& bone = rigStructure->bones[boneIdx];
-                const std::string boneNameStr = bone.name.toStdString();
-                const std::string parentNameStr = bone.parent.toStdString();
                 int64_t animationCurveIds[3];
                 for (int ci = 0; ci < 3; ++ci)
                     animationCurveIds[ci] = m_next64Id++;
                 std::vector<int64_t> ktimes;
                 std::vector<float> values[3];
                 for (const auto& frame : clip.frames) {
-                    if (!frame.boneWorldTransforms.count(boneNameStr))
-                        continue;
-                    const auto& frameWorld = frame.boneWorldTransforms.at(boneNameStr);
                     dust3d::Matrix4x4 localMat;
-                    if (!parentNameStr.empty() && frame.boneWorldTransforms.count(parentNameStr)) {
-                        localMat = frame.boneWorldTransforms.at(parentNameStr).inverted();
-                        localMat *= frameWorld;
-                    } else {
-                        localMat = frameWorld;
-                    }
+                    if (!frameLocalTransform(frame, boneIdx, &localMat))
+                        continue;
                     values[0].push_back((float)localMat.constData()[dust3d::Matrix4x4::M30]);
                     values[1].push_back((float)localMat.constData()[dust3d::Matrix4x4::M31]);
                     values[2].push_back((float)localMat.constData()[dust3d::Matrix4x4::M32]);
@@ -3971,25 +3976,15 @@ FbxFileWriter::FbxFileWriter(dust3d::Object& object,
 
             // Build rotation curves for bones with changing rotation
             for (const size_t boneIdx : rotatedBones) {
-                const auto& bone = rigStructure->bones[boneIdx];
-                const std::string boneNameStr = bone.name.toStdString();
-                const std::string parentNameStr = bone.parent.toStdString();
                 int64_t animationCurveIds[3];
                 for (int ci = 0; ci < 3; ++ci)
                     animationCurveIds[ci] = m_next64Id++;
                 std::vector<int64_t> ktimes;
                 std::vector<float> values[3];
                 for (const auto& frame : clip.frames) {
-                    if (!frame.boneWorldTransforms.count(boneNameStr))
-                        continue;
-                    const auto& frameWorld = frame.boneWorldTransforms.at(boneNameStr);
                     dust3d::Matrix4x4 localMat;
-                    if (!parentNameStr.empty() && frame.boneWorldTransforms.count(parentNameStr)) {
-                        localMat = frame.boneWorldTransforms.at(parentNameStr).inverted();
-                        localMat *= frameWorld;
-                    } else {
-                        localMat = frameWorld;
-                    }
+                    if (!frameLocalTransform(frame, boneIdx, &localMat))
+                        continue;
                     double pitch = 0, yaw = 0, roll = 0;
                     matrixToFbxEulerAngles(localMat, &pitch, &yaw, &roll);
                     values[0].push_back((float)normalizeFbxEulerAngle(pitch));
@@ -8,10 +8,30 @@
 #include <QFileInfo>
 #include <QQuaternion>
 #include <QtCore/qbuffer.h>
+#include <algorithm>
 #include <cmath>
+#include <dust3d/animation/reduce_keyframes.h>
+#include <dust3d/mesh/optimize_vertex_cache.h>
+#include <dust3d/mesh/weld_vertices.h>
+#include <numeric>
 
 bool GlbFileWriter::m_enableComment = false;
 
+static quint16 toUnsignedShort(double value)
+{
+    return (quint16)std::lround(std::max(0.0, std::min(value, 65535.0)));
+}
+
+static qint8 toNormalizedByte(double value)
+{
+    return (qint8)std::lround(std::max(-1.0, std::min(value, 1.0)) * 127.0);
+}
+
+static qint16 toNormalizedShort(double value)
+{
+    return (qint16)std::lround(std::max(-1.0, std::min(value, 1.0)) * 32767.0);
+}
+
 GlbFileWriter::GlbFileWriter(dust3d::Object& object,
     const QString& filename,
     QImage* textureImage,
@@ -19,7 +39,8 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
     QImage* ormImage,
     const RigStructure* rigStructure,
     const std::map<std::string, dust3d::Matrix4x4>* inverseBindMatrices,
-    const std::vector<dust3d::RigAnimationClip>* animationClips)
+    const std::vector<dust3d::RigAnimationClip>* animationClips,
+    const Options& options)
     : m_filename(filename)
 {
     const std::vector<std::vector<dust3d::Vector3>>* triangleVertexNormals = object.triangleVertexNormals();
@@ -119,29 +140,112 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
         return inv;
     };
 
+    auto computeFrameLocalTransform = [](const dust3d::BonePose& worldTransforms,
+                                          size_t boneIndex,
+                                          size_t parentBoneIndex) -> dust3d::Matrix4x4 {
+        dust3d::Matrix4x4 childWorldTransform;
+        const dust3d::Matrix4x4* worldTransform = worldTransforms.find(boneIndex);
+        if (nullptr != worldTransform)
+            childWorldTransform = *worldTransform;
+        const dust3d::Matrix4x4* parentWorldTransform = worldTransforms.find(parentBoneIndex);
+        if (nullptr == parentWorldTransform)
+            return childWorldTransform;
+        dust3d::Matrix4x4 inv = parentWorldTransform->inverted();
+        inv *= childWorldTransform;
+        return inv;
+    };
+
     m_json["asset"]["version"] = "2.0";
     m_json["asset"]["generator"] = APP_NAME " " APP_HUMAN_VER;
     m_json["scenes"][0]["nodes"] = { 0 };
 
+    // The mesh is only skinned when it carries the joints and weights to go with the skin
+    int meshNodeIndex = hasRig ? 1 : 0;
     if (hasRig) {
         m_json["nodes"][0]["children"] = { 1, skeletonNodeStartIndex };
         m_json["nodes"][1]["mesh"] = 0;
-        m_json["nodes"][1]["skin"] = 0;
+        if (hasVertexBoneBindings)
+            m_json["nodes"][1]["skin"] = 0;
     } else {
         m_json["nodes"][0]["mesh"] = 0;
     }
 
-    std::vector<dust3d::Vector3> triangleVertexPositions;
-    std::vector<size_t> triangleVertexOldIndices;
-    for (const auto& triangleIndices : object.triangles) {
+    // Corners with the same position, normal, uv and skinning are welded into one vertex,
+    // then triangles are ordered for the post-transform cache and vertices for fetch
+    struct GlbVertex {
+        float position[3];
+        float normal[3];
+        float uv[2];
+        quint16 joints[4];
+        float weights[4];
+    };
+    std::vector<GlbVertex> triangleCorners(object.triangles.size() * 3);
+    for (size_t i = 0; i < object.triangles.size(); ++i) {
+        const auto& triangleIndices = object.triangles[i];
         for (size_t j = 0; j < 3; ++j) {
-            triangleVertexOldIndices.push_back(triangleIndices[j]);
-            triangleVertexPositions.push_back(object.vertices[triangleIndices[j]]);
+            size_t oldIndex = triangleIndices[j];
+            GlbVertex& corner = triangleCorners[i * 3 + j];
+            const auto& position = object.vertices[oldIndex];
+            corner.position[0] = (float)position.x();
+            corner.position[1] = (float)position.y();
+            corner.position[2] = (float)position.z();
+            if (m_outputNormal) {
+                const auto& normal = (*triangleVertexNormals)[i][j];
+                corner.normal[0] = (float)normal.x();
+                corner.normal[1] = (float)normal.y();
+                corner.normal[2] = (float)normal.z();
+            }
+            if (m_outputUv) {
+                const auto& uv = (*triangleVertexUvs)[i][j];
+                corner.uv[0] = (float)uv.x();
+                corner.uv[1] = (float)uv.y();
+            }
+            if (hasVertexBoneBindings) {
+                if (oldIndex < object.vertexBone1.size() && !object.vertexBone1[oldIndex].first.empty()) {
+                    auto it = boneNameToIndex.find(object.vertexBone1[oldIndex].first);
+                    if (it != boneNameToIndex.end())
+                        corner.joints[0] = (quint16)it->second;
+                    corner.weights[0] = object.vertexBone1[oldIndex].second;
+                }
+                if (oldIndex < object.vertexBone2.size() && !object.vertexBone2[oldIndex].first.empty()) {
+                    auto it = boneNameToIndex.find(object.vertexBone2[oldIndex].first);
+                    if (it != boneNameToIndex.end())
+                        corner.joints[1] = (quint16)it->second;
+                    corner.weights[1] = object.vertexBone2[oldIndex].second;
+                }
+            }
         }
     }
+    std::vector<std::uint32_t> triangleVertexIndices;
+    std::vector<std::uint32_t> vertexCorners;
+    dust3d::weldVertices(triangleCorners.data(), triangleCorners.size(), sizeof(GlbVertex), &triangleVertexIndices, &vertexCorners);
+    dust3d::optimizeVertexCache(&triangleVertexIndices, vertexCorners.size());
+    std::vector<std::uint32_t> newToOldVertices;
+    dust3d::optimizeVertexFetch(&triangleVertexIndices, vertexCorners.size(), &newToOldVertices);
+    std::vector<GlbVertex> vertices(newToOldVertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)
+        vertices[i] = triangleCorners[vertexCorners[newToOldVertices[i]]];
+    if (!triangleVertexIndices.empty()) {
+        qDebug() << "Welded" << triangleCorners.size() << "corners into" << vertices.size() << "vertices, ACMR:" << dust3d::averageCacheMissRatio(triangleVertexIndices, vertices.size());
+    }
+
+    // Attributes are gathered into typed arrays and written in one go, buffers are in host byte order
+    static_assert(Q_BYTE_ORDER == Q_LITTLE_ENDIAN, "GLB buffers must be little endian");
+    auto writeBin = [&binStream](const void* data, size_t size) {
+        binStream.writeRawData((const char*)data, (int)size);
+    };
+
+    // Quantized positions are mapped back by this offset and uniform scale, uniform so that normals keep their direction
+    bool isPositionQuantized = false;
+    float positionOffset[3] = { 0.0f, 0.0f, 0.0f };
+    float positionScale = 1.0f;
+    if (options.quantizeAttributes && !vertices.empty()) {
+        m_json["extensionsUsed"] = { "KHR_mesh_quantization" };
+        m_json["extensionsRequired"] = { "KHR_mesh_quantization" };
+    }
 
     int primitiveIndex = 0;
-    if (!triangleVertexPositions.empty()) {
+    if (!vertices.empty()) {
 
         m_json["meshes"][0]["primitives"][primitiveIndex]["indices"] = bufferViewIndex;
         m_json["meshes"][0]["primitives"][primitiveIndex]["material"] = primitiveIndex;
@@ -177,31 +281,28 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
         bufferViewFromOffset = (int)m_binByteArray.size();
         // Vertex indices are written as UNSIGNED_SHORT (16-bit) to keep small
         // meshes compact, but that only addresses index values up to 65535. When
-        // the de-indexed mesh has more vertices we must use UNSIGNED_INT (32-bit)
+        // the welded mesh has more vertices we must use UNSIGNED_INT (32-bit)
         // indices, otherwise the (quint16) casts overflow and corrupt the mesh.
-        const bool useIntIndices = triangleVertexPositions.size() > 65536;
+        const bool useIntIndices = vertices.size() > 65536;
         const size_t indexComponentSize = useIntIndices ? sizeof(quint32) : sizeof(quint16);
         if (useIntIndices) {
-            for (size_t index = 0; index < triangleVertexPositions.size(); index += 3) {
-                binStream << (quint32)index << (quint32)(index + 1) << (quint32)(index + 2);
-            }
+            writeBin(triangleVertexIndices.data(), triangleVertexIndices.size() * sizeof(quint32));
         } else {
-            for (size_t index = 0; index < triangleVertexPositions.size(); index += 3) {
-                binStream << (quint16)index << (quint16)(index + 1) << (quint16)(index + 2);
-            }
+            std::vector<quint16> shortIndices(triangleVertexIndices.begin(), triangleVertexIndices.end());
+            writeBin(shortIndices.data(), shortIndices.size() * sizeof(quint16));
         }
         m_json["bufferViews"][bufferViewIndex]["buffer"] = 0;
         m_json["bufferViews"][bufferViewIndex]["byteOffset"] = bufferViewFromOffset;
-        m_json["bufferViews"][bufferViewIndex]["byteLength"] = (int)(triangleVertexPositions.size() * indexComponentSize);
+        m_json["bufferViews"][bufferViewIndex]["byteLength"] = (int)(triangleVertexIndices.size() * indexComponentSize);
         m_json["bufferViews"][bufferViewIndex]["target"] = 34963;
-        Q_ASSERT((int)(triangleVertexPositions.size() * indexComponentSize) == m_binByteArray.size() - bufferViewFromOffset);
+        Q_ASSERT((int)(triangleVertexIndices.size() * indexComponentSize) == m_binByteArray.size() - bufferViewFromOffset);
         alignBin();
         if (m_enableComment)
             m_json["accessors"][bufferViewIndex]["__comment"] = QString("/accessors/%1: triangle indices").arg(QString::number(bufferViewIndex)).toUtf8().constData();
         m_json["accessors"][bufferViewIndex]["bufferView"] = bufferViewIndex;
         m_json["accessors"][bufferViewIndex]["byteOffset"] = 0;
         m_json["accessors"][bufferViewIndex]["componentType"] = useIntIndices ? 5125 : 5123;
-        m_json["accessors"][bufferViewIndex]["count"] = triangleVertexPositions.size();
+        m_json["accessors"][bufferViewIndex]["count"] = triangleVertexIndices.size();
         m_json["accessors"][bufferViewIndex]["type"] = "SCALAR";
         bufferViewIndex++;
 
@@ -214,58 +315,129 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
         float maxY = -100;
         float minZ = 100;
         float maxZ = -100;
-        for (const auto& position : triangleVertexPositions) {
-            if (position.x() < minX)
-                minX = position.x();
-            if (position.x() > maxX)
-                maxX = position.x();
-            if (position.y() < minY)
-                minY = position.y();
-            if (position.y() > maxY)
-                maxY = position.y();
-            if (position.z() < minZ)
-                minZ = position.z();
-            if (position.z() > maxZ)
-                maxZ = position.z();
-            binStream << (float)position.x() << (float)position.y() << (float)position.z();
+        std::vector<float> positions;
+        positions.reserve(vertices.size() * 3);
+        for (const auto& vertex : vertices) {
+            const float* position = vertex.position;
+            if (position[0] < minX)
+                minX = position[0];
+            if (position[0] > maxX)
+                maxX = position[0];
+            if (position[1] < minY)
+                minY = position[1];
+            if (position[1] > maxY)
+                maxY = position[1];
+            if (position[2] < minZ)
+                minZ = position[2];
+            if (position[2] > maxZ)
+                maxZ = position[2];
+            positions.insert(positions.end(), position, position + 3);
+        }
+        if (options.quantizeAttributes) {
+            isPositionQuantized = true;
+            positionOffset[0] = minX;
+            positionOffset[1] = minY;
+            positionOffset[2] = minZ;
+            float extent = std::max({ maxX - minX, maxY - minY, maxZ - minZ });
+            if (extent > 0.0f)
+                positionScale = extent / 65535.0f;
+            // Elements of vertex attributes are 4 byte aligned, each position is padded to 8 bytes
+            std::vector<quint16> quantizedPositions;
+            quantizedPositions.reserve(vertices.size() * 4);
+            quint16 quantizedMin[3] = { 65535, 65535, 65535 };
+            quint16 quantizedMax[3] = { 0, 0, 0 };
+            for (const auto& vertex : vertices) {
+                for (size_t axis = 0; axis < 3; ++axis) {
+                    quint16 value = toUnsignedShort((vertex.position[axis] - positionOffset[axis]) / positionScale);
+                    quantizedMin[axis] = std::min(quantizedMin[axis], value);
+                    quantizedMax[axis] = std::max(quantizedMax[axis], value);
+                    quantizedPositions.push_back(value);
+                }
+                quantizedPositions.push_back(0);
+            }
+            writeBin(quantizedPositions.data(), quantizedPositions.size() * sizeof(quint16));
+            m_json["bufferViews"][bufferViewIndex]["byteLength"] = m_binByteArray.size() - bufferViewFromOffset;
+            m_json["bufferViews"][bufferViewIndex]["byteStride"] = 4 * sizeof(quint16);
+            m_json["bufferViews"][bufferViewIndex]["target"] = 34962;
+            alignBin();
+            if (m_enableComment)
+                m_json["accessors"][bufferViewIndex]["__comment"] = QString("/accessors/%1: xyz").arg(QString::number(bufferViewIndex)).toUtf8().constData();
+            m_json["accessors"][bufferViewIndex]["bufferView"] = bufferViewIndex;
+            m_json["accessors"][bufferViewIndex]["byteOffset"] = 0;
+            m_json["accessors"][bufferViewIndex]["componentType"] = 5123;
+            m_json["accessors"][bufferViewIndex]["count"] = vertices.size();
+            m_json["accessors"][bufferViewIndex]["type"] = "VEC3";
+            m_json["accessors"][bufferViewIndex]["max"] = { quantizedMax[0], quantizedMax[1], quantizedMax[2] };
+            m_json["accessors"][bufferViewIndex]["min"] = { quantizedMin[0], quantizedMin[1], quantizedMin[2] };
+            bufferViewIndex++;
+
+            // Skinned mesh nodes ignore their transform, the inverse bind matrices carry it instead
+            if (!hasVertexBoneBindings) {
+                m_json["nodes"][meshNodeIndex]["translation"] = { positionOffset[0], positionOffset[1], positionOffset[2] };
+                m_json["nodes"][meshNodeIndex]["scale"] = { positionScale, positionScale, positionScale };
+            }
+        } else {
+            writeBin(positions.data(), positions.size() * sizeof(float));
+            Q_ASSERT((int)vertices.size() * 3 * sizeof(float) == m_binByteArray.size() - bufferViewFromOffset);
+            m_json["bufferViews"][bufferViewIndex]["byteLength"] = vertices.size() * 3 * sizeof(float);
+            m_json["bufferViews"][bufferViewIndex]["target"] = 34962;
+            alignBin();
+            if (m_enableComment)
+                m_json["accessors"][bufferViewIndex]["__comment"] = QString("/accessors/%1: xyz").arg(QString::number(bufferViewIndex)).toUtf8().constData();
+            m_json["accessors"][bufferViewIndex]["bufferView"] = bufferViewIndex;
+            m_json["accessors"][bufferViewIndex]["byteOffset"] = 0;
+            m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
+            m_json["accessors"][bufferViewIndex]["count"] = vertices.size();
+            m_json["accessors"][bufferViewIndex]["type"] = "VEC3";
+            m_json["accessors"][bufferViewIndex]["max"] = { maxX, maxY, maxZ };
+            m_json["accessors"][bufferViewIndex]["min"] = { minX, minY, minZ };
+            bufferViewIndex++;
         }
-        Q_ASSERT((int)triangleVertexPositions.size() * 3 * sizeof(float) == m_binByteArray.size() - bufferViewFromOffset);
-        m_json["bufferViews"][bufferViewIndex]["byteLength"] = triangleVertexPositions.size() * 3 * sizeof(float);
-        m_json["bufferViews"][bufferViewIndex]["target"] = 34962;
-        alignBin();
-        if (m_enableComment)
-            m_json["accessors"][bufferViewIndex]["__comment"] = QString("/accessors/%1: xyz").arg(QString::number(bufferViewIndex)).toUtf8().constData();
-        m_json["accessors"][bufferViewIndex]["bufferView"] = bufferViewIndex;
-        m_json["accessors"][bufferViewIndex]["byteOffset"] = 0;
-        m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
-        m_json["accessors"][bufferViewIndex]["count"] = triangleVertexPositions.size();
-        m_json["accessors"][bufferViewIndex]["type"] = "VEC3";
-        m_json["accessors"][bufferViewIndex]["max"] = { maxX, maxY, maxZ };
-        m_json["accessors"][bufferViewIndex]["min"] = { minX, minY, minZ };
-        bufferViewIndex++;
 
         if (m_outputNormal) {
             bufferViewFromOffset = (int)m_binByteArray.size();
             m_json["bufferViews"][bufferViewIndex]["buffer"] = 0;
             m_json["bufferViews"][bufferViewIndex]["byteOffset"] = bufferViewFromOffset;
             QStringList normalList;
-            for (const auto& normals : (*triangleVertexNormals)) {
-                for (const auto& it : normals) {
-                    binStream << (float)it.x() << (float)it.y() << (float)it.z();
-                    if (m_enableComment && m_outputNormal)
-                        normalList.append(QString("<%1,%2,%3>").arg(QString::number(it.x())).arg(QString::number(it.y())).arg(QString::number(it.z())));
+            if (m_enableComment && m_outputNormal) {
+                for (const auto& vertex : vertices) {
+                    const float* normal = vertex.normal;
+                    normalList.append(QString("<%1,%2,%3>").arg(QString::number(normal[0])).arg(QString::number(normal[1])).arg(QString::number(normal[2])));
                 }
             }
-            Q_ASSERT((int)triangleVertexNormals->size() * 3 * 3 * sizeof(float) == m_binByteArray.size() - bufferViewFromOffset);
-            m_json["bufferViews"][bufferViewIndex]["byteLength"] = triangleVertexNormals->size() * 3 * 3 * sizeof(float);
+            if (options.quantizeAttributes) {
+                std::vector<qint8> quantizedNormals;
+                quantizedNormals.reserve(vertices.size() * 4);
+                for (const auto& vertex : vertices) {
+                    for (size_t axis = 0; axis < 3; ++axis)
+                        quantizedNormals.push_back(toNormalizedByte(vertex.normal[axis]));
+                    quantizedNormals.push_back(0);
+                }
+                writeBin(quantizedNormals.data(), quantizedNormals.size() * sizeof(qint8));
+                m_json["bufferViews"][bufferViewIndex]["byteLength"] = m_binByteArray.size() - bufferViewFromOffset;
+                m_json["bufferViews"][bufferViewIndex]["byteStride"] = 4 * sizeof(qint8);
+            } else {
+                std::vector<float> normals;
+                normals.reserve(vertices.size() * 3);
+                for (const auto& vertex : vertices)
+                    normals.insert(normals.end(), vertex.normal, vertex.normal + 3);
+                writeBin(normals.data(), normals.size() * sizeof(float));
+                Q_ASSERT((int)vertices.size() * 3 * sizeof(float) == m_binByteArray.size() - bufferViewFromOffset);
+                m_json["bufferViews"][bufferViewIndex]["byteLength"] = vertices.size() * 3 * sizeof(float);
+            }
             m_json["bufferViews"][bufferViewIndex]["target"] = 34962;
             alignBin();
             if (m_enableComment)
                 m_json["accessors"][bufferViewIndex]["__comment"] = QString("/accessors/%1: normal %2").arg(QString::number(bufferViewIndex)).arg(normalList.join(" ")).toUtf8().constData();
             m_json["accessors"][bufferViewIndex]["bufferView"] = bufferViewIndex;
             m_json["accessors"][bufferViewIndex]["byteOffset"] = 0;
-            m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
-            m_json["accessors"][bufferViewIndex]["count"] = triangleVertexNormals->size() * 3;
+            if (options.quantizeAttributes) {
+                m_json["accessors"][bufferViewIndex]["componentType"] = 5120;
+                m_json["accessors"][bufferViewIndex]["normalized"] = true;
+            } else {
+                m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
+            }
+            m_json["accessors"][bufferViewIndex]["count"] = vertices.size();
             m_json["accessors"][bufferViewIndex]["type"] = "VEC3";
             bufferViewIndex++;
         }
@@ -274,9 +446,24 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
             bufferViewFromOffset = (int)m_binByteArray.size();
             m_json["bufferViews"][bufferViewIndex]["buffer"] = 0;
             m_json["bufferViews"][bufferViewIndex]["byteOffset"] = bufferViewFromOffset;
-            for (const auto& uvs : (*triangleVertexUvs)) {
-                for (const auto& it : uvs)
-                    binStream << (float)it.x() << (float)it.y();
+            // Normalized unsigned shorts only cover the unit square, uvs outside of it stay floats
+            bool isUvQuantized = options.quantizeAttributes && std::all_of(vertices.begin(), vertices.end(), [](const GlbVertex& vertex) {
+                return vertex.uv[0] >= 0.0f && vertex.uv[0] <= 1.0f && vertex.uv[1] >= 0.0f && vertex.uv[1] <= 1.0f;
+            });
+            if (isUvQuantized) {
+                std::vector<quint16> quantizedUvs;
+                quantizedUvs.reserve(vertices.size() * 2);
+                for (const auto& vertex : vertices) {
+                    quantizedUvs.push_back(toUnsignedShort(vertex.uv[0] * 65535.0));
+                    quantizedUvs.push_back(toUnsignedShort(vertex.uv[1] * 65535.0));
+                }
+                writeBin(quantizedUvs.data(), quantizedUvs.size() * sizeof(quint16));
+            } else {
+                std::vector<float> uvs;
+                uvs.reserve(vertices.size() * 2);
+                for (const auto& vertex : vertices)
+                    uvs.insert(uvs.end(), vertex.uv, vertex.uv + 2);
+                writeBin(uvs.data(), uvs.size() * sizeof(float));
             }
             m_json["bufferViews"][bufferViewIndex]["byteLength"] = m_binByteArray.size() - bufferViewFromOffset;
             alignBin();
@@ -284,8 +471,13 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
                 m_json["accessors"][bufferViewIndex]["__comment"] = QString("/accessors/%1: uv").arg(QString::number(bufferViewIndex)).toUtf8().constData();
             m_json["accessors"][bufferViewIndex]["bufferView"] = bufferViewIndex;
             m_json["accessors"][bufferViewIndex]["byteOffset"] = 0;
-            m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
-            m_json["accessors"][bufferViewIndex]["count"] = triangleVertexUvs->size() * 3;
+            if (isUvQuantized) {
+                m_json["accessors"][bufferViewIndex]["componentType"] = 5123;
+                m_json["accessors"][bufferViewIndex]["normalized"] = true;
+            } else {
+                m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
+            }
+            m_json["accessors"][bufferViewIndex]["count"] = vertices.size();
             m_json["accessors"][bufferViewIndex]["type"] = "VEC2";
             bufferViewIndex++;
         }
@@ -294,19 +486,19 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
             bufferViewFromOffset = (int)m_binByteArray.size();
             m_json["bufferViews"][bufferViewIndex]["buffer"] = 0;
             m_json["bufferViews"][bufferViewIndex]["byteOffset"] = bufferViewFromOffset;
-            for (const auto& oldIndex : triangleVertexOldIndices) {
-                quint16 j0 = 0, j1 = 0;
-                if (oldIndex < object.vertexBone1.size() && !object.vertexBone1[oldIndex].first.empty()) {
-                    auto it = boneNameToIndex.find(object.vertexBone1[oldIndex].first);
-                    if (it != boneNameToIndex.end())
-                        j0 = (quint16)it->second;
-                }
-                if (oldIndex < object.vertexBone2.size() && !object.vertexBone2[oldIndex].first.empty()) {
-                    auto it = boneNameToIndex.find(object.vertexBone2[oldIndex].first);
-                    if (it != boneNameToIndex.end())
-                        j1 = (quint16)it->second;
-                }
-                binStream << j0 << j1 << (quint16)0 << (quint16)0;
+            bool isJointByte = options.quantizeAttributes && rigStructure->bones.size() <= 256;
+            if (isJointByte) {
+                std::vector<quint8> byteJoints;
+                byteJoints.reserve(vertices.size() * 4);
+                for (const auto& vertex : vertices)
+                    byteJoints.insert(byteJoints.end(), vertex.joints, vertex.joints + 4);
+                writeBin(byteJoints.data(), byteJoints.size() * sizeof(quint8));
+            } else {
+                std::vector<quint16> joints;
+                joints.reserve(vertices.size() * 4);
+                for (const auto& vertex : vertices)
+                    joints.insert(joints.end(), vertex.joints, vertex.joints + 4);
+                writeBin(joints.data(), joints.size() * sizeof(quint16));
             }
             m_json["bufferViews"][bufferViewIndex]["byteLength"] = m_binByteArray.size() - bufferViewFromOffset;
             alignBin();
@@ -314,21 +506,42 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
                 m_json["accessors"][bufferViewIndex]["__comment"] = QString("/accessors/%1: bone joints").arg(QString::number(bufferViewIndex)).toUtf8().constData();
             m_json["accessors"][bufferViewIndex]["bufferView"] = bufferViewIndex;
             m_json["accessors"][bufferViewIndex]["byteOffset"] = 0;
-            m_json["accessors"][bufferViewIndex]["componentType"] = 5123;
-            m_json["accessors"][bufferViewIndex]["count"] = triangleVertexOldIndices.size();
+            m_json["accessors"][bufferViewIndex]["componentType"] = isJointByte ? 5121 : 5123;
+            m_json["accessors"][bufferViewIndex]["count"] = vertices.size();
             m_json["accessors"][bufferViewIndex]["type"] = "VEC4";
             bufferViewIndex++;
 
             bufferViewFromOffset = (int)m_binByteArray.size();
             m_json["bufferViews"][bufferViewIndex]["buffer"] = 0;
             m_json["bufferViews"][bufferViewIndex]["byteOffset"] = bufferViewFromOffset;
-            for (const auto& oldIndex : triangleVertexOldIndices) {
-                float w0 = 0.0f, w1 = 0.0f;
-                if (oldIndex < object.vertexBone1.size() && !object.vertexBone1[oldIndex].first.empty())
-                    w0 = object.vertexBone1[oldIndex].second;
-                if (oldIndex < object.vertexBone2.size() && !object.vertexBone2[oldIndex].first.empty())
-                    w1 = object.vertexBone2[oldIndex].second;
-                binStream << w0 << w1 << (float)0.0f << (float)0.0f;
+            if (options.quantizeAttributes) {
+                // Rounding is corrected on the largest weight, so the weights still sum to one
+                std::vector<quint8> quantizedWeights;
+                quantizedWeights.reserve(vertices.size() * 4);
+                for (const auto& vertex : vertices) {
+                    float sum = vertex.weights[0] + vertex.weights[1] + vertex.weights[2] + vertex.weights[3];
+                    int values[4] = { 0, 0, 0, 0 };
+                    if (sum > 0.0f) {
+                        int total = 0;
+                        size_t largest = 0;
+                        for (size_t i = 0; i < 4; ++i) {
+                            values[i] = (int)std::lround(vertex.weights[i] / sum * 255.0f);
+                            total += values[i];
+                            if (vertex.weights[i] > vertex.weights[largest])
+                                largest = i;
+                        }
+                        values[largest] += 255 - total;
+                    }
+                    for (size_t i = 0; i < 4; ++i)
+                        quantizedWeights.push_back((quint8)values[i]);
+                }
+                writeBin(quantizedWeights.data(), quantizedWeights.size() * sizeof(quint8));
+            } else {
+                std::vector<float> weights;
+                weights.reserve(vertices.size() * 4);
+                for (const auto& vertex : vertices)
+                    weights.insert(weights.end(), vertex.weights, vertex.weights + 4);
+                writeBin(weights.data(), weights.size() * sizeof(float));
             }
             m_json["bufferViews"][bufferViewIndex]["byteLength"] = m_binByteArray.size() - bufferViewFromOffset;
             alignBin();
@@ -336,8 +549,13 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
                 m_json["accessors"][bufferViewIndex]["__comment"] = QString("/accessors/%1: bone weights").arg(QString::number(bufferViewIndex)).toUtf8().constData();
             m_json["accessors"][bufferViewIndex]["bufferView"] = bufferViewIndex;
             m_json["accessors"][bufferViewIndex]["byteOffset"] = 0;
-            m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
-            m_json["accessors"][bufferViewIndex]["count"] = triangleVertexOldIndices.size();
+            if (options.quantizeAttributes) {
+                m_json["accessors"][bufferViewIndex]["componentType"] = 5121;
+                m_json["accessors"][bufferViewIndex]["normalized"] = true;
+            } else {
+                m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
+            }
+            m_json["accessors"][bufferViewIndex]["count"] = vertices.size();
             m_json["accessors"][bufferViewIndex]["type"] = "VEC4";
             bufferViewIndex++;
         }
@@ -351,14 +569,24 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
         for (const auto& bone : rigStructure->bones) {
             std::string boneName = bone.name.toStdString();
             auto invIt = inverseBindMatrices->find(boneName);
+            double matrix[16];
             if (invIt != inverseBindMatrices->end()) {
                 const double* d = invIt->second.constData();
-                for (int j = 0; j < 16; ++j)
-                    binStream << (float)d[j];
+                std::copy(d, d + 16, matrix);
             } else {
                 for (int j = 0; j < 16; ++j)
-                    binStream << (float)(j % 5 == 0 ? 1.0 : 0.0);
+                    matrix[j] = j % 5 == 0 ? 1.0 : 0.0;
+            }
+            if (isPositionQuantized && hasVertexBoneBindings) {
+                // Column major, multiplied on the right by the dequantization transform
+                for (int row = 0; row < 4; ++row) {
+                    matrix[12 + row] += matrix[row] * positionOffset[0] + matrix[4 + row] * positionOffset[1] + matrix[8 + row] * positionOffset[2];
+                    for (int column = 0; column < 3; ++column)
+                        matrix[column * 4 + row] *= positionScale;
+                }
             }
+            for (int j = 0; j < 16; ++j)
+                binStream << (float)matrix[j];
         }
         Q_ASSERT((int)rigStructure->bones.size() * 16 * sizeof(float) == m_binByteArray.size() - bufferViewFromOffset);
         m_json["bufferViews"][bufferViewIndex]["byteLength"] = m_binByteArray.size() - bufferViewFromOffset;
@@ -443,30 +671,44 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
             const auto& clip = (*animationClips)[animIdx];
             m_json["animations"][animIdx]["name"] = clip.name;
 
-            // Input: keyframe timestamps
-            int inputAccessorIdx = bufferViewIndex;
-            bufferViewFromOffset = (int)m_binByteArray.size();
-            m_json["bufferViews"][bufferViewIndex]["buffer"] = 0;
-            m_json["bufferViews"][bufferViewIndex]["byteOffset"] = bufferViewFromOffset;
-            float minTime = clip.frames.empty() ? 0.0f : clip.frames[0].time;
-            float maxTime = minTime;
-            for (const auto& frame : clip.frames) {
-                binStream << frame.time;
-                if (frame.time < minTime)
-                    minTime = frame.time;
-                if (frame.time > maxTime)
-                    maxTime = frame.time;
-            }
-            m_json["bufferViews"][bufferViewIndex]["byteLength"] = m_binByteArray.size() - bufferViewFromOffset;
-            alignBin();
-            m_json["accessors"][bufferViewIndex]["bufferView"] = bufferViewIndex;
-            m_json["accessors"][bufferViewIndex]["byteOffset"] = 0;
-            m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
-            m_json["accessors"][bufferViewIndex]["count"] = clip.frames.size();
-            m_json["accessors"][bufferViewIndex]["type"] = "SCALAR";
-            m_json["accessors"][bufferViewIndex]["max"][0] = maxTime;
-            m_json["accessors"][bufferViewIndex]["min"][0] = minTime;
-            bufferViewIndex++;
+            std::vector<float> times(clip.frames.size());
+            for (size_t i = 0; i < clip.frames.size(); ++i)
+                times[i] = clip.frames[i].time;
+            std::vector<size_t> allKeys(times.size());
+            std::iota(allKeys.begin(), allKeys.end(), 0);
+
+            // Input: keyframe timestamps, shared by the channels keeping the same keys
+            std::map<std::vector<size_t>, int> inputAccessors;
+            auto writeInputAccessor = [&](const std::vector<size_t>& keys) {
+                auto findAccessor = inputAccessors.find(keys);
+                if (findAccessor != inputAccessors.end())
+                    return findAccessor->second;
+                bufferViewFromOffset = (int)m_binByteArray.size();
+                m_json["bufferViews"][bufferViewIndex]["buffer"] = 0;
+                m_json["bufferViews"][bufferViewIndex]["byteOffset"] = bufferViewFromOffset;
+                float minTime = keys.empty() ? 0.0f : times[keys[0]];
+                float maxTime = minTime;
+                for (const auto& key : keys) {
+                    binStream << times[key];
+                    if (times[key] < minTime)
+                        minTime = times[key];
+                    if (times[key] > maxTime)
+                        maxTime = times[key];
+                }
+                m_json["bufferViews"][bufferViewIndex]["byteLength"] = m_binByteArray.size() - bufferViewFromOffset;
+                alignBin();
+                m_json["accessors"][bufferViewIndex]["bufferView"] = bufferViewIndex;
+                m_json["accessors"][bufferViewIndex]["byteOffset"] = 0;
+                m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
+                m_json["accessors"][bufferViewIndex]["count"] = keys.size();
+                m_json["accessors"][bufferViewIndex]["type"] = "SCALAR";
+                m_json["accessors"][bufferViewIndex]["max"][0] = maxTime;
+                m_json["accessors"][bufferViewIndex]["min"][0] = minTime;
+                int inputAccessorIdx = bufferViewIndex;
+                bufferViewIndex++;
+                inputAccessors.insert({ keys, inputAccessorIdx });
+                return inputAccessorIdx;
+            };
 
             int samplerIndex = 0;
             int channelIndex = 0;
@@ -476,56 +718,88 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
                 std::string boneName = bone.name.toStdString();
                 std::string parentName = bone.parent.toStdString();
                 int nodeIdx = skeletonNodeStartIndex + (int)boneIdx;
+                size_t poseBoneIndex = dust3d::BonePoseLayout::npos;
+                size_t poseParentIndex = dust3d::BonePoseLayout::npos;
+                if (clip.poseLayout) {
+                    poseBoneIndex = clip.poseLayout->boneIndex(boneName);
+                    if (!parentName.empty())
+                        poseParentIndex = clip.poseLayout->boneIndex(parentName);
+                }
+
+                std::vector<dust3d::Vector3> translations;
+                std::vector<dust3d::Quaternion> rotations;
+                translations.reserve(clip.frames.size());
+                rotations.reserve(clip.frames.size());
+                for (const auto& frame : clip.frames) {
+                    dust3d::Matrix4x4 localTransform = computeFrameLocalTransform(frame.boneWorldTransforms, poseBoneIndex, poseParentIndex);
+                    float tx, ty, tz, qx, qy, qz, qw;
+                    matrixToTranslationAndRotation(localTransform, tx, ty, tz, qx, qy, qz, qw);
+                    translations.emplace_back(tx, ty, tz);
+                    rotations.emplace_back(qw, qx, qy, qz);
+                }
+
+                std::vector<size_t> translationKeys = allKeys;
+                std::vector<size_t> rotationKeys = allKeys;
+                if (options.reduceKeyframes) {
+                    // Neighboring keys on opposite hemispheres would be interpolated the long way round
+                    for (size_t i = 0; i < rotations.size(); ++i) {
+                        rotations[i] = rotations[i].normalized();
+                        if (i > 0 && rotations[i].w() * rotations[i - 1].w() + rotations[i].x() * rotations[i - 1].x() + rotations[i].y() * rotations[i - 1].y() + rotations[i].z() * rotations[i - 1].z() < 0.0)
+                            rotations[i] *= -1.0;
+                    }
+                    translationKeys = dust3d::reduceTranslationKeyframes(times, translations, options.translationTolerance);
+                    rotationKeys = dust3d::reduceRotationKeyframes(times, rotations, options.rotationTolerance);
+                }
 
                 // Translation output
+                int translationInputAccessorIdx = writeInputAccessor(translationKeys);
                 bufferViewFromOffset = (int)m_binByteArray.size();
                 m_json["bufferViews"][bufferViewIndex]["buffer"] = 0;
                 m_json["bufferViews"][bufferViewIndex]["byteOffset"] = bufferViewFromOffset;
-                for (const auto& frame : clip.frames) {
-                    dust3d::Matrix4x4 worldTransform;
-                    auto worldIt = frame.boneWorldTransforms.find(boneName);
-                    if (worldIt != frame.boneWorldTransforms.end())
-                        worldTransform = worldIt->second;
-                    dust3d::Matrix4x4 localTransform = computeLocalTransform(parentName, worldTransform, frame.boneWorldTransforms);
-                    float tx, ty, tz, qx, qy, qz, qw;
-                    matrixToTranslationAndRotation(localTransform, tx, ty, tz, qx, qy, qz, qw);
-                    binStream << tx << ty << tz;
+                for (const auto& key : translationKeys) {
+                    const auto& translation = translations[key];
+                    binStream << (float)translation.x() << (float)translation.y() << (float)translation.z();
                 }
                 m_json["bufferViews"][bufferViewIndex]["byteLength"] = m_binByteArray.size() - bufferViewFromOffset;
                 alignBin();
                 m_json["accessors"][bufferViewIndex]["bufferView"] = bufferViewIndex;
                 m_json["accessors"][bufferViewIndex]["byteOffset"] = 0;
                 m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
-                m_json["accessors"][bufferViewIndex]["count"] = clip.frames.size();
+                m_json["accessors"][bufferViewIndex]["count"] = translationKeys.size();
                 m_json["accessors"][bufferViewIndex]["type"] = "VEC3";
                 int translationAccessorIdx = bufferViewIndex;
                 bufferViewIndex++;
 
                 // Rotation output
+                int rotationInputAccessorIdx = writeInputAccessor(rotationKeys);
                 bufferViewFromOffset = (int)m_binByteArray.size();
                 m_json["bufferViews"][bufferViewIndex]["buffer"] = 0;
                 m_json["bufferViews"][bufferViewIndex]["byteOffset"] = bufferViewFromOffset;
-                for (const auto& frame : clip.frames) {
-                    dust3d::Matrix4x4 worldTransform;
-                    auto worldIt = frame.boneWorldTransforms.find(boneName);
-                    if (worldIt != frame.boneWorldTransforms.end())
-                        worldTransform = worldIt->second;
-                    dust3d::Matrix4x4 localTransform = computeLocalTransform(parentName, worldTransform, frame.boneWorldTransforms);
-                    float tx, ty, tz, qx, qy, qz, qw;
-                    matrixToTranslationAndRotation(localTransform, tx, ty, tz, qx, qy, qz, qw);
-                    binStream << qx << qy << qz << qw;
+                for (const auto& key : rotationKeys) {
+                    const auto& rotation = rotations[key];
+                    if (options.quantizeAttributes) {
+                        binStream << toNormalizedShort(rotation.x()) << toNormalizedShort(rotation.y())
+                                  << toNormalizedShort(rotation.z()) << toNormalizedShort(rotation.w());
+                    } else {
+                        binStream << (float)rotation.x() << (float)rotation.y() << (float)rotation.z() << (float)rotation.w();
+                    }
                 }
                 m_json["bufferViews"][bufferViewIndex]["byteLength"] = m_binByteArray.size() - bufferViewFromOffset;
                 alignBin();
                 m_json["accessors"][bufferViewIndex]["bufferView"] = bufferViewIndex;
                 m_json["accessors"][bufferViewIndex]["byteOffset"] = 0;
-                m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
-                m_json["accessors"][bufferViewIndex]["count"] = clip.frames.size();
+                if (options.quantizeAttributes) {
+                    m_json["accessors"][bufferViewIndex]["componentType"] = 5122;
+                    m_json["accessors"][bufferViewIndex]["normalized"] = true;
+                } else {
+                    m_json["accessors"][bufferViewIndex]["componentType"] = 5126;
+                }
+                m_json["accessors"][bufferViewIndex]["count"] = rotationKeys.size();
                 m_json["accessors"][bufferViewIndex]["type"] = "VEC4";
                 int rotationAccessorIdx = bufferViewIndex;
                 bufferViewIndex++;
 
-                m_json["animations"][animIdx]["samplers"][samplerIndex]["input"] = inputAccessorIdx;
+                m_json["animations"][animIdx]["samplers"][samplerIndex]["input"] = translationInputAccessorIdx;
                 m_json["animations"][animIdx]["samplers"][samplerIndex]["output"] = translationAccessorIdx;
                 m_json["animations"][animIdx]["samplers"][samplerIndex]["interpolation"] = "LINEAR";
                 m_json["animations"][animIdx]["channels"][channelIndex]["sampler"] = samplerIndex;
@@ -534,7 +808,7 @@ GlbFileWriter::GlbFileWriter(dust3d::Object& object,
                 ++samplerIndex;
                 ++channelIndex;
 
-                m_json["animations"][animIdx]["samplers"][samplerIndex]["input"] = inputAccessorIdx;
+                m_json["animations"][animIdx]["samplers"][samplerIndex]["input"] = rotationInputAccessorIdx;
                 m_json["animations"][animIdx]["samplers"][samplerIndex]["output"] = rotationAccessorIdx;
                 m_json["animations"][animIdx]["samplers"][samplerIndex]["interpolation"] = "LINEAR";
                 m_json["animations"][animIdx]["channels"][channelIndex]["sampler"] = samplerIndex;
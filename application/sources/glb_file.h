@@ -19,6 +19,24 @@
 class GlbFileWriter : public QObject {
     Q_OBJECT
 public:
+    // Compact output for runtimes that stream the assets
+    struct Options {
+        // Member initializers can't be used here, the struct is a default argument inside its enclosing class
+        Options()
+            : quantizeAttributes(false)
+            , reduceKeyframes(false)
+            , translationTolerance(0.0001)
+            , rotationTolerance(0.0005)
+        {
+        }
+        // Positions, normals and uvs as KHR_mesh_quantization integers, skinning and rotation keys as normalized integers
+        bool quantizeAttributes;
+        // Animation keys that linear interpolation reproduces within the tolerances are dropped
+        bool reduceKeyframes;
+        double translationTolerance;
+        double rotationTolerance;
+    };
+
     GlbFileWriter(dust3d::Object& object,
         const QString& filename,
         QImage* textureImage = nullptr,
@@ -26,7 +44,8 @@ public:
         QImage* ormImage = nullptr,
         const RigStructure* rigStructure = nullptr,
         const std::map<std::string, dust3d::Matrix4x4>* inverseBindMatrices = nullptr,
-        const std::vector<dust3d::RigAnimationClip>* animationClips = nullptr);
+        const std::vector<dust3d::RigAnimationClip>* animationClips = nullptr,
+        const Options& options = Options());
     bool save();
     bool save(QDataStream& output);
 
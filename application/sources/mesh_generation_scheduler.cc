@@ -0,0 +1,89 @@
+#include "mesh_generation_scheduler.h"
+#include "mesh_generator.h"
+#include <QDebug>
+#include <QThread>
+#include <algorithm>
+
+const int MeshGenerationScheduler::m_maxCancelledInRow = 3;
+
+MeshGenerationScheduler::MeshGenerationScheduler()
+{
+    m_thread = new QThread;
+    m_thread->start();
+}
+
+MeshGenerationScheduler::~MeshGenerationScheduler()
+{
+    if (m_runningGenerator)
+        m_runningGenerator->cancel();
+    m_thread->quit();
+    m_thread->wait();
+    delete m_thread;
+}
+
+void MeshGenerationScheduler::request()
+{
+    ++m_statistics.requests;
+    if (m_pendingTimer.isValid())
+        ++m_statistics.coalescedRequests;
+    else
+        m_pendingTimer.start();
+
+    if (!m_runningGenerator || m_runningGenerator->isCancelled())
+        return;
+    if (m_cancelledInRow >= m_maxCancelledInRow)
+        return;
+    m_runningGenerator->cancel();
+}
+
+void MeshGenerationScheduler::start(MeshGenerator* meshGenerator)
+{
+    m_runningGenerator.reset(meshGenerator);
+
+    if (m_pendingTimer.isValid()) {
+        qint64 latency = m_pendingTimer.elapsed();
+        m_statistics.lastQueueLatencyMilliseconds = latency;
+        m_statistics.maxQueueLatencyMilliseconds = std::max(m_statistics.maxQueueLatencyMilliseconds, latency);
+        m_statistics.totalQueueLatencyMilliseconds += latency;
+        m_pendingTimer.invalidate();
+    }
+    m_runningTimer.start();
+
+    meshGenerator->moveToThread(m_thread);
+    connect(meshGenerator, &MeshGenerator::finished, this, &MeshGenerationScheduler::generatorFinished);
+    QMetaObject::invokeMethod(meshGenerator, "process", Qt::QueuedConnection);
+}
+
+bool MeshGenerationScheduler::isGenerating() const
+{
+    return nullptr != m_runningGenerator || nullptr != m_finishedGenerator;
+}
+
+std::unique_ptr<MeshGenerator> MeshGenerationScheduler::takeFinishedGenerator()
+{
+    return std::move(m_finishedGenerator);
+}
+
+const MeshGenerationScheduler::Statistics& MeshGenerationScheduler::statistics() const
+{
+    return m_statistics;
+}
+
+void MeshGenerationScheduler::generatorFinished()
+{
+    if (m_runningGenerator->isCancelled()) {
+        ++m_cancelledInRow;
+        ++m_statistics.cancelledGenerations;
+        m_statistics.cancelledWorkMilliseconds += m_runningTimer.elapsed();
+    } else {
+        m_cancelledInRow = 0;
+        ++m_statistics.completedGenerations;
+    }
+
+    qDebug() << "Mesh generation queue latency:" << m_statistics.lastQueueLatencyMilliseconds << "milliseconds,"
+             << "cancelled:" << m_statistics.cancelledGenerations << "of" << (m_statistics.cancelledGenerations + m_statistics.completedGenerations)
+             << "generations," << m_statistics.cancelledWorkMilliseconds << "milliseconds of work";
+
+    m_finishedGenerator = std::move(m_runningGenerator);
+    emit finished();
+}
@@ -0,0 +1,57 @@
+#ifndef DUST3D_APPLICATION_MESH_GENERATION_SCHEDULER_H_
+#define DUST3D_APPLICATION_MESH_GENERATION_SCHEDULER_H_
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <memory>
+
+class MeshGenerator;
+class QThread;
+
+// Runs mesh generations one at a time on a long lived worker thread.
+// Requests arriving while a generation runs are coalesced, and the running generation is
+// cancelled so the latest document state starts as soon as possible. Several cancellations
+// in a row let the next generation finish, so a long drag still shows intermediate results.
+class MeshGenerationScheduler : public QObject {
+    Q_OBJECT
+public:
+    struct Statistics {
+        quint64 requests = 0;
+        quint64 coalescedRequests = 0;
+        quint64 completedGenerations = 0;
+        quint64 cancelledGenerations = 0;
+        // From the first pending request to the start of the generation serving it
+        qint64 lastQueueLatencyMilliseconds = 0;
+        qint64 maxQueueLatencyMilliseconds = 0;
+        qint64 totalQueueLatencyMilliseconds = 0;
+        // Worker time spent on generations whose result was thrown away
+        qint64 cancelledWorkMilliseconds = 0;
+    };
+
+    MeshGenerationScheduler();
+    ~MeshGenerationScheduler();
+    void request();
+    void start(MeshGenerator* meshGenerator);
+    bool isGenerating() const;
+    std::unique_ptr<MeshGenerator> takeFinishedGenerator();
+    const Statistics& statistics() const;
+
+signals:
+    void finished();
+
+private slots:
+    void generatorFinished();
+
+private:
+    QThread* m_thread = nullptr;
+    std::unique_ptr<MeshGenerator> m_runningGenerator;
+    std::unique_ptr<MeshGenerator> m_finishedGenerator;
+    QElapsedTimer m_pendingTimer;
+    QElapsedTimer m_runningTimer;
+    int m_cancelledInRow = 0;
+    Statistics m_statistics;
+
+    static const int m_maxCancelledInRow;
+};
+
+#endif
@@ -89,6 +89,12 @@ void MeshGenerator::process()
     parseImportedModelData();
     generate();
 
+    if (isCancelled()) {
+        qDebug() << "The mesh generation was cancelled after" << countTimeConsumed.elapsed() << "milliseconds";
+        emit finished();
+        return;
+    }
+
     if (nullptr != m_object)
         m_resultMesh = std::make_unique<ModelMesh>(*m_object);
 
@@ -106,18 +112,8 @@ void MeshGenerator::process()
             continue;
         }
         std::vector<std::array<dust3d::Vector2, 3>> triangleUvs;
-        if (!it->second.triangleUvs.empty()) {
-            triangleUvs.resize(it->second.triangles.size());
-            for (size_t i = 0; i < it->second.triangles.size(); ++i) {
-                const auto& triangle = it->second.triangles[i];
-                auto findUv = it->second.triangleUvs.find({ dust3d::PositionKey(it->second.vertices[triangle[0]]),
-                    dust3d::PositionKey(it->second.vertices[triangle[1]]),
-                    dust3d::PositionKey(it->second.vertices[triangle[2]]) });
-                if (findUv != it->second.triangleUvs.end()) {
-                    triangleUvs[i] = findUv->second;
-                }
-            }
-        }
+        if (it->second.triangleUvs.size() == it->second.triangles.size())
+            triangleUvs = it->second.triangleUvs;
         dust3d::trimVertices(&it->second.vertices, true);
         for (auto& it : it->second.vertices) {
             it *= 2.0;
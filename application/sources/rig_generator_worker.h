@@ -4,16 +4,16 @@
 #include "bone_structure.h"
 #include <QObject>
 #include <dust3d/base/object.h>
-#include <dust3d/base/snapshot.h>
+#include <dust3d/base/snapshot_view.h>
 #include <dust3d/rig/rig_generator.h>
 #include <memory>
 
 class RigGeneratorWorker : public QObject {
     Q_OBJECT
 public:
-    void setParameters(std::unique_ptr<dust3d::Snapshot> snapshot, std::unique_ptr<dust3d::Object> object, const RigStructure& templateRig)
+    void setParameters(std::shared_ptr<const dust3d::SnapshotView> snapshotView, std::unique_ptr<dust3d::Object> object, const RigStructure& templateRig)
     {
-        m_snapshot = std::move(snapshot);
+        m_snapshotView = std::move(snapshotView);
         m_object = std::move(object);
         m_templateRig = templateRig;
     }
@@ -32,11 +32,11 @@ public slots:
         dust3d::RigStructure templateRig = m_templateRig.toRigStructure();
         dust3d::RigStructure actualRig;
 
-        m_successful = generator.generateRig(m_snapshot.get(), templateRig, actualRig);
+        m_successful = generator.generateRig(m_snapshotView.get(), templateRig, actualRig);
         if (m_successful) {
-            generator.applyRigBindings(m_object.get(), m_snapshot.get(), &actualRig);
+            generator.applyRigBindings(m_object.get(), m_snapshotView.get(), &actualRig);
             if (actualRig.headHasEyelids) {
-                generator.generateEyelidBones(m_object.get(), m_snapshot.get(), actualRig);
+                generator.generateEyelidBones(m_object.get(), m_snapshotView.get(), actualRig);
             }
             m_actualRig = RigStructure(actualRig);
         }
@@ -45,7 +45,7 @@ public slots:
     }
 
 private:
-    std::unique_ptr<dust3d::Snapshot> m_snapshot;
+    std::shared_ptr<const dust3d::SnapshotView> m_snapshotView;
     std::unique_ptr<dust3d::Object> m_object;
     RigStructure m_templateRig;
     RigStructure m_actualRig;
@@ -3,17 +3,17 @@
 #include <QPainter>
 #include <QTransform>
 #include <cmath>
+#include <algorithm>
 #include <dust3d/base/part_target.h>
 #include <dust3d/uv/uv_map_packer.h>
-#include <map>
 #include <queue>
 #include <unordered_set>
 
 size_t UvMapGenerator::m_textureSize = 4096;
 
-UvMapGenerator::UvMapGenerator(std::unique_ptr<dust3d::Object> object, std::unique_ptr<dust3d::Snapshot> snapshot)
+UvMapGenerator::UvMapGenerator(std::unique_ptr<dust3d::Object> object, std::shared_ptr<const dust3d::SnapshotView> snapshotView)
     : m_object(std::move(object))
-    , m_snapshot(std::move(snapshot))
+    , m_snapshotView(std::move(snapshotView))
 {
 }
 
@@ -100,22 +100,58 @@ void UvMapGenerator::packUvs()
 {
     m_mapPacker = std::make_unique<dust3d::UvMapPacker>();
 
-    // Build vertex-position-key → component base color lookup so we can identify
+    const auto& components = m_snapshotView->components();
+
+    const auto* triangleCharts = m_object->triangleCharts();
+    if (nullptr == triangleCharts || triangleCharts->size() != m_object->triangles.size()) {
+        m_mapPacker->pack();
+        return;
+    }
+    const auto& chartComponentIds = m_object->chartComponentIds();
+    std::vector<size_t> chartComponentIndices(chartComponentIds.size());
+    for (size_t i = 0; i < chartComponentIds.size(); ++i)
+        chartComponentIndices[i] = m_snapshotView->findComponent(chartComponentIds[i]);
+
+    // Build vertex → component base color lookup so we can identify
     // the colors on each side of a seam boundary.
-    std::map<dust3d::PositionKey, QColor> vertexToComponentColor;
-    for (const auto& compIt : m_object->componentTriangleUvs) {
-        QColor color(255, 255, 255);
-        auto snapshotCompIt = m_snapshot->components.find(compIt.first.toString());
-        if (snapshotCompIt != m_snapshot->components.end()) {
-            const auto& colorIt = snapshotCompIt->second.find("color");
-            if (colorIt != snapshotCompIt->second.end())
-                color = QColor(QString::fromStdString(colorIt->second));
+    std::vector<QColor> chartComponentColors(chartComponentIds.size(), QColor(255, 255, 255));
+    for (size_t i = 0; i < chartComponentIds.size(); ++i) {
+        size_t componentIndex = chartComponentIndices[i];
+        if (dust3d::SnapshotView::InvalidIndex != componentIndex && components[componentIndex].hasColor) {
+            const auto& componentColor = components[componentIndex].color;
+            chartComponentColors[i] = QColor::fromRgbF(componentColor.r(), componentColor.g(), componentColor.b(), componentColor.alpha());
         }
-        for (const auto& triIt : compIt.second) {
-            for (size_t i = 0; i < 3; ++i)
-                vertexToComponentColor.insert({ triIt.first[i], color });
+    }
+    std::vector<std::uint32_t> vertexChartComponentIndices(m_object->vertices.size(), dust3d::ObjectTriangleChart::InvalidIndex);
+    std::uint32_t seamCount = 0;
+    for (size_t i = 0; i < m_object->triangles.size(); ++i) {
+        const auto& chart = (*triangleCharts)[i];
+        if (dust3d::ObjectTriangleChart::InvalidIndex != chart.seamIndex)
+            seamCount = std::max(seamCount, chart.seamIndex + 1);
+        if (dust3d::ObjectTriangleChart::InvalidIndex == chart.componentIndex)
+            continue;
+        for (const auto& vertexIndex : m_object->triangles[i]) {
+            if (dust3d::ObjectTriangleChart::InvalidIndex == vertexChartComponentIndices[vertexIndex])
+                vertexChartComponentIndices[vertexIndex] = chart.componentIndex;
         }
     }
+    auto findVertexColor = [&](size_t vertexIndex, QColor* color) {
+        std::uint32_t chartComponentIndex = vertexChartComponentIndices[vertexIndex];
+        if (dust3d::ObjectTriangleChart::InvalidIndex != chartComponentIndex)
+            *color = chartComponentColors[chartComponentIndex];
+    };
+
+    // Bridging triangles grouped by seam, the large side ones first
+    std::vector<std::pair<std::vector<size_t>, std::vector<size_t>>> seamTriangles(seamCount);
+    for (size_t i = 0; i < m_object->triangles.size(); ++i) {
+        const auto& chart = (*triangleCharts)[i];
+        if (dust3d::ObjectTriangleChart::InvalidIndex == chart.seamIndex)
+            continue;
+        if (chart.isSmallSide)
+            seamTriangles[chart.seamIndex].second.push_back(i);
+        else
+            seamTriangles[chart.seamIndex].first.push_back(i);
+    }
 
     // For each seam create a dedicated gradient chart.  Large-side vertices are
     // mapped to u=0 and small-side vertices to u=1, so the renderer interpolates
@@ -125,27 +161,19 @@ void UvMapGenerator::packUvs()
     //
     // seam.first  triangles have layout [large₀, large₁, small].
     // seam.second triangles have layout [small₀, small₁, large].
-    for (const auto& seam : m_object->seamTriangleUvs) {
+    for (const auto& seam : seamTriangles) {
         if (seam.first.empty() && seam.second.empty())
             continue;
 
         QColor colorLarge(200, 200, 200), colorSmall(200, 200, 200);
         if (!seam.first.empty()) {
-            const auto& tri = *seam.first.begin();
-            auto it = vertexToComponentColor.find(tri[0]);
-            if (it != vertexToComponentColor.end())
-                colorLarge = it->second;
-            it = vertexToComponentColor.find(tri[2]);
-            if (it != vertexToComponentColor.end())
-                colorSmall = it->second;
+            const auto& tri = m_object->triangles[seam.first.front()];
+            findVertexColor(tri[0], &colorLarge);
+            findVertexColor(tri[2], &colorSmall);
         } else {
-            const auto& tri = *seam.second.begin();
-            auto it = vertexToComponentColor.find(tri[2]);
-            if (it != vertexToComponentColor.end())
-                colorLarge = it->second;
-            it = vertexToComponentColor.find(tri[0]);
-            if (it != vertexToComponentColor.end())
-                colorSmall = it->second;
+            const auto& tri = m_object->triangles[seam.second.front()];
+            findVertexColor(tri[2], &colorLarge);
+            findVertexColor(tri[0], &colorSmall);
         }
 
         // 512×512 horizontal gradient to provide sufficient texture detail and prevent seam artifacts.
@@ -181,49 +209,39 @@ void UvMapGenerator::packUvs()
 
         // large side: triangle[0,1] are large-side vertices → u≈0
         //             triangle[2]   is the small-side vertex  → u≈1
-        for (const auto& tri : seam.first) {
-            seamPart.localUv[tri] = {
-                dust3d::Vector2(kUvMin, kUvMin),
-                dust3d::Vector2(kUvMin, kUvMax),
-                dust3d::Vector2(kUvMax, kUvMid)
-            };
+        for (const auto& triangleIndex : seam.first) {
+            seamPart.localUv.push_back({ triangleIndex, { dust3d::Vector2(kUvMin, kUvMin),
+                                                            dust3d::Vector2(kUvMin, kUvMax),
+                                                            dust3d::Vector2(kUvMax, kUvMid) } });
         }
         // small side: triangle[0,1] are small-side vertices → u≈1
         //             triangle[2]   is the large-side vertex  → u≈0
-        for (const auto& tri : seam.second) {
-            seamPart.localUv[tri] = {
-                dust3d::Vector2(kUvMax, kUvMin),
-                dust3d::Vector2(kUvMax, kUvMax),
-                dust3d::Vector2(kUvMin, kUvMid)
-            };
+        for (const auto& triangleIndex : seam.second) {
+            seamPart.localUv.push_back({ triangleIndex, { dust3d::Vector2(kUvMax, kUvMin),
+                                                            dust3d::Vector2(kUvMax, kUvMax),
+                                                            dust3d::Vector2(kUvMin, kUvMid) } });
         }
 
         m_mapPacker->addPart(seamPart);
     }
 
-    // Lookup from quantized vertex position back to its 3D coordinate so we can
-    // measure the surface area of image-less charts.  The keys in componentTriangleUvs
-    // were built from these same vertex positions, so the quantization matches.
-    std::map<dust3d::PositionKey, dust3d::Vector3> positionKeyToVertex;
-    for (const auto& vertex : m_object->vertices)
-        positionKeyToVertex.insert({ dust3d::PositionKey(vertex), vertex });
-    auto sumTriangleArea = [&](const std::map<std::array<dust3d::PositionKey, 3>, std::array<dust3d::Vector2, 3>>& localUv) -> double {
-        double total = 0.0;
-        for (const auto& it : localUv) {
-            auto findA = positionKeyToVertex.find(it.first[0]);
-            auto findB = positionKeyToVertex.find(it.first[1]);
-            auto findC = positionKeyToVertex.find(it.first[2]);
-            if (findA == positionKeyToVertex.end() || findB == positionKeyToVertex.end() || findC == positionKeyToVertex.end())
-                continue;
-            total += dust3d::Vector3::area(findA->second, findB->second, findC->second);
-        }
-        return total;
-    };
-    auto componentColorImage = [&](const std::map<std::string, std::string>& component) -> const QImage* {
-        const auto& colorImageIdIt = component.find("colorImageId");
-        if (colorImageIdIt == component.end())
+    // Chart uvs and surface area of each component's triangles, the area is used to size image-less charts
+    std::vector<std::vector<std::pair<size_t, std::array<dust3d::Vector2, 3>>>> componentLocalUvs(chartComponentIds.size());
+    std::vector<double> componentSurfaceArea(chartComponentIds.size(), 0.0);
+    for (size_t i = 0; i < m_object->triangles.size(); ++i) {
+        const auto& chart = (*triangleCharts)[i];
+        if (dust3d::ObjectTriangleChart::InvalidIndex == chart.componentIndex)
+            continue;
+        const auto& triangle = m_object->triangles[i];
+        componentLocalUvs[chart.componentIndex].push_back({ i, chart.uv });
+        componentSurfaceArea[chart.componentIndex] += dust3d::Vector3::area(m_object->vertices[triangle[0]],
+            m_object->vertices[triangle[1]],
+            m_object->vertices[triangle[2]]);
+    }
+    auto componentColorImage = [&](const dust3d::SnapshotView::Component& component) -> const QImage* {
+        if (!component.hasColorImage)
             return nullptr;
-        return ImageForever::get(dust3d::Uuid(colorImageIdIt->second));
+        return ImageForever::get(component.colorImageId);
     };
 
     // A part with a texture image occupies a chart sized to the image resolution.  A
@@ -234,42 +252,38 @@ void UvMapGenerator::packUvs()
     // one texture's worth of texels.  This keeps texel density consistent and is
     // invariant to the model's absolute scale.
     double totalImagelessArea = 0.0;
-    std::map<dust3d::Uuid, double> componentImagelessArea;
-    for (const auto& componentTriangleUvIt : m_object->componentTriangleUvs) {
-        auto componentIt = m_snapshot->components.find(componentTriangleUvIt.first.toString());
-        if (componentIt == m_snapshot->components.end())
+    for (size_t i = 0; i < chartComponentIds.size(); ++i) {
+        size_t componentIndex = chartComponentIndices[i];
+        if (dust3d::SnapshotView::InvalidIndex == componentIndex || componentLocalUvs[i].empty())
             continue;
-        if (nullptr != componentColorImage(componentIt->second))
+        if (nullptr != componentColorImage(components[componentIndex]))
             continue;
-        double area = sumTriangleArea(componentTriangleUvIt.second);
-        componentImagelessArea[componentTriangleUvIt.first] = area;
-        totalImagelessArea += area;
+        totalImagelessArea += componentSurfaceArea[i];
     }
     const double imagelessSizeScale = totalImagelessArea > 0.0
         ? (double)UvMapGenerator::m_textureSize / std::sqrt(totalImagelessArea)
         : 1.0;
 
-    for (const auto& componentTriangleUvIt : m_object->componentTriangleUvs) {
-        auto componentIt = m_snapshot->components.find(componentTriangleUvIt.first.toString());
-        if (componentIt == m_snapshot->components.end())
+    for (size_t i = 0; i < chartComponentIds.size(); ++i) {
+        size_t componentIndex = chartComponentIndices[i];
+        if (dust3d::SnapshotView::InvalidIndex == componentIndex || componentLocalUvs[i].empty())
             continue;
+        const auto& component = components[componentIndex];
         dust3d::Uuid imageId;
         dust3d::Color color(1.0, 1.0, 1.0);
         double width = 1.0;
         double height = 1.0;
-        const auto& colorIt = componentIt->second.find("color");
-        if (colorIt != componentIt->second.end()) {
-            color = dust3d::Color(colorIt->second);
+        if (component.hasColor) {
+            color = component.color;
         }
-        const QImage* image = componentColorImage(componentIt->second);
+        const QImage* image = componentColorImage(component);
         if (nullptr != image) {
-            const auto& colorImageIdIt = componentIt->second.find("colorImageId");
-            imageId = dust3d::Uuid(colorImageIdIt->second);
+            imageId = component.colorImageId;
             width = image->width();
             height = image->height();
         } else {
             // Image-less chart: size it by surface area so it keeps a fair share of the atlas.
-            double area = componentImagelessArea[componentTriangleUvIt.first];
+            double area = componentSurfaceArea[i];
             double side = std::max(1.0, std::sqrt(area) * imagelessSizeScale);
             width = side;
             height = side;
@@ -279,33 +293,36 @@ void UvMapGenerator::packUvs()
         part.color = color;
         part.width = width;
         part.height = height;
-        part.localUv = componentTriangleUvIt.second;
+        part.localUv = std::move(componentLocalUvs[i]);
         m_mapPacker->addPart(part);
     }
 
     // The following is to make a component colored UV for those broken triangles which generated by mesh boolean algorithm
-    std::map<dust3d::Uuid, dust3d::UvMapPacker::Part> partWithBrokenTriangles;
+    std::vector<dust3d::UvMapPacker::Part> partWithBrokenTriangles(chartComponentIds.size());
     const auto zeroUv = std::array<dust3d::Vector2, 3> {
         dust3d::Vector2(0.0, 0.0), dust3d::Vector2(0.0, 0.0), dust3d::Vector2(0.0, 0.0)
     };
-    for (const auto& brokenTrianglesToComponentIdIt : m_object->brokenTrianglesToComponentIdMap) {
-        partWithBrokenTriangles[brokenTrianglesToComponentIdIt.second].localUv.insert({ brokenTrianglesToComponentIdIt.first, zeroUv });
+    for (size_t i = 0; i < m_object->triangles.size(); ++i) {
+        const auto& chart = (*triangleCharts)[i];
+        if (!chart.isBroken || dust3d::ObjectTriangleChart::InvalidIndex == chart.brokenComponentIndex)
+            continue;
+        partWithBrokenTriangles[chart.brokenComponentIndex].localUv.push_back({ i, zeroUv });
     }
-    for (auto& partIt : partWithBrokenTriangles) {
-        auto componentIt = m_snapshot->components.find(partIt.first.toString());
-        if (componentIt == m_snapshot->components.end())
+    for (size_t i = 0; i < partWithBrokenTriangles.size(); ++i) {
+        auto& part = partWithBrokenTriangles[i];
+        size_t componentIndex = chartComponentIndices[i];
+        if (dust3d::SnapshotView::InvalidIndex == componentIndex || part.localUv.empty())
             continue;
         dust3d::Color color(1.0, 1.0, 1.0);
         double width = 1.0;
         double height = 1.0;
-        const auto& colorIt = componentIt->second.find("color");
-        if (colorIt != componentIt->second.end()) {
-            color = dust3d::Color(colorIt->second);
+        if (components[componentIndex].hasColor) {
+            color = components[componentIndex].color;
         }
-        partIt.second.color = color;
-        partIt.second.width = width;
-        partIt.second.height = height;
-        m_mapPacker->addPart(partIt.second);
+        part.color = color;
+        part.width = width;
+        part.height = height;
+        m_mapPacker->addPart(part);
     }
 
     m_mapPacker->pack();
@@ -446,24 +463,16 @@ void UvMapGenerator::dilateTexture(QImage* image)
 
 void UvMapGenerator::generateUvCoords()
 {
-    std::map<std::array<dust3d::PositionKey, 3>, std::array<dust3d::Vector2, 3>> mergedUvs;
+    // Layouts are in packing order, the first one to cover a triangle gives its uv
+    std::vector<std::vector<dust3d::Vector2>> triangleUvs(m_object->triangles.size(), std::vector<dust3d::Vector2> { dust3d::Vector2(0.0, 0.0), dust3d::Vector2(0.0, 0.0), dust3d::Vector2(0.0, 0.0) });
+    std::vector<bool> isTriangleUvSet(m_object->triangles.size(), false);
     for (const auto& layout : m_mapPacker->packedLayouts()) {
         for (const auto& it : layout.globalUv) {
-            mergedUvs.insert({ it.first, it.second });
-        }
-    }
-    std::vector<std::vector<dust3d::Vector2>> triangleUvs(m_object->triangles.size(), std::vector<dust3d::Vector2> { dust3d::Vector2(0.0, 0.0), dust3d::Vector2(0.0, 0.0), dust3d::Vector2(0.0, 0.0) });
-    for (size_t n = 0; n < m_object->triangles.size(); ++n) {
-        const auto& triangle = m_object->triangles[n];
-        auto findUvs = mergedUvs.find({ dust3d::PositionKey(m_object->vertices[triangle[0]]),
-            dust3d::PositionKey(m_object->vertices[triangle[1]]),
-            dust3d::PositionKey(m_object->vertices[triangle[2]]) });
-        if (findUvs == mergedUvs.end()) {
-            continue;
+            if (it.first >= triangleUvs.size() || isTriangleUvSet[it.first])
+                continue;
+            isTriangleUvSet[it.first] = true;
+            triangleUvs[it.first] = { it.second[0], it.second[1], it.second[2] };
         }
-        triangleUvs[n][0] = findUvs->second[0];
-        triangleUvs[n][1] = findUvs->second[1];
-        triangleUvs[n][2] = findUvs->second[2];
     }
     m_object->setTriangleVertexUvs(triangleUvs);
 }
@@ -473,7 +482,7 @@ void UvMapGenerator::generate()
     if (nullptr == m_object)
         return;
 
-    if (nullptr == m_snapshot)
+    if (nullptr == m_snapshotView)
         return;
 
     packUvs();
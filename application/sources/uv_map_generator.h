@@ -5,14 +5,14 @@
 #include <QImage>
 #include <QObject>
 #include <dust3d/base/object.h>
-#include <dust3d/base/snapshot.h>
+#include <dust3d/base/snapshot_view.h>
 #include <dust3d/uv/uv_map_packer.h>
 #include <memory>
 
 class UvMapGenerator : public QObject {
     Q_OBJECT
 public:
-    UvMapGenerator(std::unique_ptr<dust3d::Object> object, std::unique_ptr<dust3d::Snapshot> snapshot);
+    UvMapGenerator(std::unique_ptr<dust3d::Object> object, std::shared_ptr<const dust3d::SnapshotView> snapshotView);
     void generate();
     std::unique_ptr<QImage> takeResultTextureColorImage();
     std::unique_ptr<QImage> takeResultTextureNormalImage();
@@ -32,7 +32,7 @@ public slots:
 
 private:
     std::unique_ptr<dust3d::Object> m_object;
-    std::unique_ptr<dust3d::Snapshot> m_snapshot;
+    std::shared_ptr<const dust3d::SnapshotView> m_snapshotView;
     std::unique_ptr<dust3d::UvMapPacker> m_mapPacker;
     std::unique_ptr<QImage> m_textureColorImage;
     std::unique_ptr<QImage> m_textureNormalImage;
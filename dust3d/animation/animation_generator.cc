@@ -20,51 +20,10 @@
  *  SOFTWARE.
  */
 
+#include <atomic>
 #include <dust3d/animation/animation_generator.h>
-#include <dust3d/animation/biped/cast.h>
-#include <dust3d/animation/biped/channel.h>
-#include <dust3d/animation/biped/die.h>
-#include <dust3d/animation/biped/hurt.h>
-#include <dust3d/animation/biped/idle.h>
-#include <dust3d/animation/biped/jump.h>
-#include <dust3d/animation/biped/roar.h>
-#include <dust3d/animation/biped/run.h>
-#include <dust3d/animation/biped/slam.h>
-#include <dust3d/animation/biped/stab.h>
-#include <dust3d/animation/biped/walk.h>
-#include <dust3d/animation/bird/attack.h>
-#include <dust3d/animation/bird/die.h>
-#include <dust3d/animation/bird/eat.h>
-#include <dust3d/animation/bird/fly.h>
-#include <dust3d/animation/bird/glide.h>
-#include <dust3d/animation/bird/idle.h>
-#include <dust3d/animation/bird/run.h>
-#include <dust3d/animation/bird/walk.h>
+#include <dust3d/animation/animation_registry.h>
 #include <dust3d/animation/common.h>
-#include <dust3d/animation/fish/die.h>
-#include <dust3d/animation/fish/idle.h>
-#include <dust3d/animation/fish/swim.h>
-#include <dust3d/animation/insect/attack.h>
-#include <dust3d/animation/insect/die.h>
-#include <dust3d/animation/insect/fly.h>
-#include <dust3d/animation/insect/idle.h>
-#include <dust3d/animation/insect/rub_hands.h>
-#include <dust3d/animation/insect/walk.h>
-#include <dust3d/animation/quadruped/attack.h>
-#include <dust3d/animation/quadruped/die.h>
-#include <dust3d/animation/quadruped/eat.h>
-#include <dust3d/animation/quadruped/hurt.h>
-#include <dust3d/animation/quadruped/idle.h>
-#include <dust3d/animation/quadruped/roar.h>
-#include <dust3d/animation/quadruped/run.h>
-#include <dust3d/animation/quadruped/walk.h>
-#include <dust3d/animation/snake/die.h>
-#include <dust3d/animation/snake/idle.h>
-#include <dust3d/animation/snake/slither.h>
-#include <dust3d/animation/spider/die.h>
-#include <dust3d/animation/spider/idle.h>
-#include <dust3d/animation/spider/run.h>
-#include <dust3d/animation/spider/walk.h>
 
 namespace dust3d {
 
@@ -74,96 +33,69 @@ bool AnimationGenerator::generate(const RigStructure& rigStructure,
     const std::string& animationType,
     const AnimationParams& parameters)
 {
-    bool result = false;
+    const AnimationDefinition* definition = AnimationRegistry::find(animationType);
+    if (nullptr == definition)
+        return false;
+    return generateClip(rigStructure, inverseBindMatrices, animationClip, *definition, parameters,
+        std::make_shared<const BonePoseLayout>(rigStructure), nullptr);
+}
+
+std::vector<bool> AnimationGenerator::generateClips(const RigStructure& rigStructure,
+    const std::map<std::string, Matrix4x4>& inverseBindMatrices,
+    const std::vector<AnimationClipRequest>& requests,
+    std::vector<RigAnimationClip>& animationClips,
+    ThreadPool* threadPool,
+    const std::function<void(size_t)>& clipGenerated)
+{
+    auto poseLayout = std::make_shared<const BonePoseLayout>(rigStructure);
+
+    animationClips.clear();
+    animationClips.resize(requests.size());
+    std::vector<char> results(requests.size(), 0);
+    std::atomic<size_t> generatedCount(0);
 
-    if (animationType == "InsectWalk")
-        result = insect::walk(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "InsectIdle")
-        result = insect::idle(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "InsectRubHands")
-        result = insect::rubHands(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "InsectForward" || animationType == "InsectFly")
-        result = insect::fly(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "InsectAttack")
-        result = insect::attack(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "InsectDie")
-        result = insect::die(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BirdForward" || animationType == "BirdFly")
-        result = bird::fly(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BirdGlide")
-        result = bird::glide(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BirdIdle")
-        result = bird::idle(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BirdAttack")
-        result = bird::attack(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BirdWalk")
-        result = bird::walk(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BirdRun")
-        result = bird::run(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "FishForward" || animationType == "FishSwim")
-        result = fish::swim(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "FishIdle")
-        result = fish::idle(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "FishDie")
-        result = fish::die(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "SnakeForward" || animationType == "SnakeSlither")
-        result = snake::slither(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "SnakeIdle")
-        result = snake::idle(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "SnakeDie")
-        result = snake::die(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BipedWalk")
-        result = biped::walk(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BipedIdle")
-        result = biped::idle(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BipedRun")
-        result = biped::run(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BipedJump")
-        result = biped::jump(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BipedRoar")
-        result = biped::roar(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BipedHurt")
-        result = biped::hurt(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BipedDie")
-        result = biped::die(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BipedSlam")
-        result = biped::slam(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BipedStab")
-        result = biped::stab(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BipedCast")
-        result = biped::cast(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BipedChannel")
-        result = biped::channel(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "QuadrupedWalk")
-        result = quadruped::walk(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "QuadrupedIdle")
-        result = quadruped::idle(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "QuadrupedRun")
-        result = quadruped::run(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "QuadrupedAttack")
-        result = quadruped::attack(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "QuadrupedHurt")
-        result = quadruped::hurt(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "QuadrupedEat")
-        result = quadruped::eat(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "QuadrupedRoar")
-        result = quadruped::roar(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "QuadrupedDie")
-        result = quadruped::die(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BirdEat")
-        result = bird::eat(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "BirdDie")
-        result = bird::die(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "SpiderDie")
-        result = spider::die(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "SpiderIdle")
-        result = spider::idle(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "SpiderWalk")
-        result = spider::walk(rigStructure, inverseBindMatrices, animationClip, parameters);
-    else if (animationType == "SpiderRun")
-        result = spider::run(rigStructure, inverseBindMatrices, animationClip, parameters);
+    // Resolve every animation type once up front
+    std::vector<const AnimationDefinition*> definitions(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i)
+        definitions[i] = AnimationRegistry::find(requests[i].type);
+
+    // Every clip is a pure function of the rig, the bind matrices and its own parameters,
+    // so clips are independent and the result does not depend on scheduling
+    auto generateRequest = [&](size_t requestIndex) {
+        const auto& request = requests[requestIndex];
+        auto& animationClip = animationClips[requestIndex];
+        animationClip.name = request.name;
+        if (nullptr != definitions[requestIndex]) {
+            results[requestIndex] = generateClip(rigStructure, inverseBindMatrices, animationClip,
+                *definitions[requestIndex], request.parameters, poseLayout, threadPool);
+        }
+        if (!results[requestIndex])
+            animationClip.frames.clear();
+        size_t finishedCount = ++generatedCount;
+        if (clipGenerated)
+            clipGenerated(finishedCount);
+    };
+    if (nullptr != threadPool) {
+        threadPool->parallelFor(requests.size(), generateRequest);
+    } else {
+        for (size_t i = 0; i < requests.size(); ++i)
+            generateRequest(i);
+    }
+
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+bool AnimationGenerator::generateClip(const RigStructure& rigStructure,
+    const std::map<std::string, Matrix4x4>& inverseBindMatrices,
+    RigAnimationClip& animationClip,
+    const AnimationDefinition& definition,
+    const AnimationParams& parameters,
+    const std::shared_ptr<const BonePoseLayout>& poseLayout,
+    ThreadPool* threadPool)
+{
+    animationClip.poseLayout = poseLayout;
 
-    if (!result)
+    if (!definition.generate(rigStructure, inverseBindMatrices, animationClip, parameters))
         return false;
 
     // Post-process: apply eyelid blink if eyelid bones exist
@@ -172,31 +104,26 @@ bool AnimationGenerator::generate(const RigStructure& rigStructure,
         bool hasEyelids = (boneIdx.count("LeftUpperEyelid") && boneIdx.count("LeftLowerEyelid"))
             || (boneIdx.count("RightUpperEyelid") && boneIdx.count("RightLowerEyelid"));
         if (hasEyelids) {
-            for (auto& frame : animationClip.frames) {
+            // Each frame is blinked on its own, so frames can run in parallel
+            auto blinkFrame = [&](size_t frameIndex) {
+                auto& frame = animationClip.frames[frameIndex];
                 float tNormalized = (animationClip.durationSeconds > 0.0f)
                     ? frame.time / animationClip.durationSeconds
                     : 0.0f;
                 animation::applyEyelidBlink(rigStructure, boneIdx, inverseBindMatrices,
                     frame.boneWorldTransforms, frame.boneSkinMatrices, tNormalized);
+            };
+            if (nullptr != threadPool) {
+                threadPool->parallelFor(animationClip.frames.size(), blinkFrame);
+            } else {
+                for (size_t i = 0; i < animationClip.frames.size(); ++i)
+                    blinkFrame(i);
             }
         }
     }
 
-    // Determine movement speed and direction based on animation type
-    float speedFactor = 0.0f;
-    if (animationType.find("Run") != std::string::npos)
-        speedFactor = 2.0f;
-    else if (animationType.find("Walk") != std::string::npos)
-        speedFactor = 1.0f;
-    else if (animationType.find("Forward") != std::string::npos
-        || animationType.find("Fly") != std::string::npos
-        || animationType.find("Swim") != std::string::npos
-        || animationType.find("Slither") != std::string::npos)
-        speedFactor = 1.0f;
-    else if (animationType.find("Glide") != std::string::npos)
-        speedFactor = 1.2f;
-    else if (animationType.find("Jump") != std::string::npos)
-        speedFactor = 1.5f;
+    // Movement speed and direction
+    float speedFactor = definition.movementSpeedFactor;
 
     if (speedFactor > 0.0f) {
         // Compute forward direction from rig bone positions
@@ -23,24 +23,41 @@
 #ifndef DUST3D_ANIMATION_ANIMATION_GENERATOR_H_
 #define DUST3D_ANIMATION_ANIMATION_GENERATOR_H_
 
+#include <dust3d/animation/bone_pose.h>
+#include <dust3d/base/thread_pool.h>
 #include <dust3d/rig/rig_generator.h>
+#include <functional>
 #include <map>
+#include <memory>
 
 namespace dust3d {
 
 struct BoneAnimationFrame {
     float time = 0.0f;
-    std::map<std::string, Matrix4x4> boneWorldTransforms;
-    std::map<std::string, Matrix4x4> boneSkinMatrices;
+    BonePose boneWorldTransforms;
+    BonePose boneSkinMatrices;
+
+    BoneAnimationFrame() = default;
+    explicit BoneAnimationFrame(const std::shared_ptr<const BonePoseLayout>& poseLayout)
+        : boneWorldTransforms(poseLayout)
+        , boneSkinMatrices(poseLayout)
+    {
+    }
 };
 
 struct RigAnimationClip {
     std::string name;
     float durationSeconds = 1.0f;
+    std::shared_ptr<const BonePoseLayout> poseLayout;
     std::vector<BoneAnimationFrame> frames;
     float movementSpeed = 0.0f;
     float movementDirectionX = 0.0f;
     float movementDirectionZ = 0.0f;
+
+    void resizeFrames(size_t frameCount)
+    {
+        frames.assign(frameCount, BoneAnimationFrame(poseLayout));
+    }
 };
 
 struct AnimationParams {
@@ -78,6 +95,14 @@ struct AnimationParams {
     }
 };
 
+struct AnimationDefinition;
+
+struct AnimationClipRequest {
+    std::string name;
+    std::string type;
+    AnimationParams parameters;
+};
+
 class AnimationGenerator {
 public:
     AnimationGenerator() = default;
@@ -88,6 +113,27 @@ public:
         RigAnimationClip& animationClip,
         const std::string& animationName,
         const AnimationParams& parameters = AnimationParams());
+
+    // Bake one clip per request for the same rig, concurrently when a thread pool is given.
+    // Clips come back in request order and share one pose layout; a clip that failed
+    // to generate has no frames and a false entry in the returned list.
+    // clipGenerated, if set, is called with the number of finished clips from whichever
+    // thread finished the clip.
+    static std::vector<bool> generateClips(const RigStructure& rigStructure,
+        const std::map<std::string, Matrix4x4>& inverseBindMatrices,
+        const std::vector<AnimationClipRequest>& requests,
+        std::vector<RigAnimationClip>& animationClips,
+        ThreadPool* threadPool = nullptr,
+        const std::function<void(size_t)>& clipGenerated = nullptr);
+
+private:
+    static bool generateClip(const RigStructure& rigStructure,
+        const std::map<std::string, Matrix4x4>& inverseBindMatrices,
+        RigAnimationClip& animationClip,
+        const AnimationDefinition& definition,
+        const AnimationParams& parameters,
+        const std::shared_ptr<const BonePoseLayout>& poseLayout,
+        ThreadPool* threadPool);
 };
 
 }
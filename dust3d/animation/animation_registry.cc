@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <dust3d/animation/animation_registry.h>
+#include <dust3d/animation/biped/cast.h>
+#include <dust3d/animation/biped/channel.h>
+#include <dust3d/animation/biped/die.h>
+#include <dust3d/animation/biped/hurt.h>
+#include <dust3d/animation/biped/idle.h>
+#include <dust3d/animation/biped/jump.h>
+#include <dust3d/animation/biped/roar.h>
+#include <dust3d/animation/biped/run.h>
+#include <dust3d/animation/biped/slam.h>
+#include <dust3d/animation/biped/stab.h>
+#include <dust3d/animation/biped/walk.h>
+#include <dust3d/animation/bird/attack.h>
+#include <dust3d/animation/bird/die.h>
+#include <dust3d/animation/bird/eat.h>
+#include <dust3d/animation/bird/fly.h>
+#include <dust3d/animation/bird/glide.h>
+#include <dust3d/animation/bird/idle.h>
+#include <dust3d/animation/bird/run.h>
+#include <dust3d/animation/bird/walk.h>
+#include <dust3d/animation/fish/die.h>
+#include <dust3d/animation/fish/idle.h>
+#include <dust3d/animation/fish/swim.h>
+#include <dust3d/animation/insect/attack.h>
+#include <dust3d/animation/insect/die.h>
+#include <dust3d/animation/insect/fly.h>
+#include <dust3d/animation/insect/idle.h>
+#include <dust3d/animation/insect/rub_hands.h>
+#include <dust3d/animation/insect/walk.h>
+#include <dust3d/animation/quadruped/attack.h>
+#include <dust3d/animation/quadruped/die.h>
+#include <dust3d/animation/quadruped/eat.h>
+#include <dust3d/animation/quadruped/hurt.h>
+#include <dust3d/animation/quadruped/idle.h>
+#include <dust3d/animation/quadruped/roar.h>
+#include <dust3d/animation/quadruped/run.h>
+#include <dust3d/animation/quadruped/walk.h>
+#include <dust3d/animation/snake/die.h>
+#include <dust3d/animation/snake/idle.h>
+#include <dust3d/animation/snake/slither.h>
+#include <dust3d/animation/spider/die.h>
+#include <dust3d/animation/spider/idle.h>
+#include <dust3d/animation/spider/run.h>
+#include <dust3d/animation/spider/walk.h>
+
+namespace dust3d {
+
+static constexpr AnimationDefinition g_animationDefinitions[] = {
+    { AnimationId::BipedCast, "BipedCast", "Biped", false, 0.0f, biped::cast },
+    { AnimationId::BipedChannel, "BipedChannel", "Biped", false, 0.0f, biped::channel },
+    { AnimationId::BipedDie, "BipedDie", "Biped", false, 0.0f, biped::die },
+    { AnimationId::BipedHurt, "BipedHurt", "Biped", false, 0.0f, biped::hurt },
+    { AnimationId::BipedIdle, "BipedIdle", "Biped", false, 0.0f, biped::idle },
+    { AnimationId::BipedJump, "BipedJump", "Biped", false, 1.5f, biped::jump },
+    { AnimationId::BipedRoar, "BipedRoar", "Biped", false, 0.0f, biped::roar },
+    { AnimationId::BipedRun, "BipedRun", "Biped", false, 2.0f, biped::run },
+    { AnimationId::BipedSlam, "BipedSlam", "Biped", false, 0.0f, biped::slam },
+    { AnimationId::BipedStab, "BipedStab", "Biped", false, 0.0f, biped::stab },
+    { AnimationId::BipedWalk, "BipedWalk", "Biped", false, 1.0f, biped::walk },
+    { AnimationId::BirdAttack, "BirdAttack", "Bird", false, 0.0f, bird::attack },
+    { AnimationId::BirdDie, "BirdDie", "Bird", false, 0.0f, bird::die },
+    { AnimationId::BirdEat, "BirdEat", "Bird", false, 0.0f, bird::eat },
+    { AnimationId::BirdFly, "BirdFly", "Bird", false, 1.0f, bird::fly },
+    { AnimationId::BirdForward, "BirdForward", "Bird", true, 1.0f, bird::fly },
+    { AnimationId::BirdGlide, "BirdGlide", "Bird", false, 1.2f, bird::glide },
+    { AnimationId::BirdIdle, "BirdIdle", "Bird", false, 0.0f, bird::idle },
+    { AnimationId::BirdRun, "BirdRun", "Bird", false, 2.0f, bird::run },
+    { AnimationId::BirdWalk, "BirdWalk", "Bird", false, 1.0f, bird::walk },
+    { AnimationId::FishDie, "FishDie", "Fish", false, 0.0f, fish::die },
+    { AnimationId::FishForward, "FishForward", "Fish", true, 1.0f, fish::swim },
+    { AnimationId::FishIdle, "FishIdle", "Fish", false, 0.0f, fish::idle },
+    { AnimationId::FishSwim, "FishSwim", "Fish", false, 1.0f, fish::swim },
+    { AnimationId::InsectAttack, "InsectAttack", "Insect", false, 0.0f, insect::attack },
+    { AnimationId::InsectDie, "InsectDie", "Insect", false, 0.0f, insect::die },
+    { AnimationId::InsectFly, "InsectFly", "Insect", false, 1.0f, insect::fly },
+    { AnimationId::InsectForward, "InsectForward", "Insect", true, 1.0f, insect::fly },
+    { AnimationId::InsectIdle, "InsectIdle", "Insect", false, 0.0f, insect::idle },
+    { AnimationId::InsectRubHands, "InsectRubHands", "Insect", false, 0.0f, insect::rubHands },
+    { AnimationId::InsectWalk, "InsectWalk", "Insect", false, 1.0f, insect::walk },
+    { AnimationId::QuadrupedAttack, "QuadrupedAttack", "Quadruped", false, 0.0f, quadruped::attack },
+    { AnimationId::QuadrupedDie, "QuadrupedDie", "Quadruped", false, 0.0f, quadruped::die },
+    { AnimationId::QuadrupedEat, "QuadrupedEat", "Quadruped", false, 0.0f, quadruped::eat },
+    { AnimationId::QuadrupedHurt, "QuadrupedHurt", "Quadruped", false, 0.0f, quadruped::hurt },
+    { AnimationId::QuadrupedIdle, "QuadrupedIdle", "Quadruped", false, 0.0f, quadruped::idle },
+    { AnimationId::QuadrupedRoar, "QuadrupedRoar", "Quadruped", false, 0.0f, quadruped::roar },
+    { AnimationId::QuadrupedRun, "QuadrupedRun", "Quadruped", false, 2.0f, quadruped::run },
+    { AnimationId::QuadrupedWalk, "QuadrupedWalk", "Quadruped", false, 1.0f, quadruped::walk },
+    { AnimationId::SnakeDie, "SnakeDie", "Snake", false, 0.0f, snake::die },
+    { AnimationId::SnakeForward, "SnakeForward", "Snake", true, 1.0f, snake::slither },
+    { AnimationId::SnakeIdle, "SnakeIdle", "Snake", false, 0.0f, snake::idle },
+    { AnimationId::SnakeSlither, "SnakeSlither", "Snake", false, 1.0f, snake::slither },
+    { AnimationId::SpiderDie, "SpiderDie", "Spider", false, 0.0f, spider::die },
+    { AnimationId::SpiderIdle, "SpiderIdle", "Spider", false, 0.0f, spider::idle },
+    { AnimationId::SpiderRun, "SpiderRun", "Spider", false, 2.0f, spider::run },
+    { AnimationId::SpiderWalk, "SpiderWalk", "Spider", false, 1.0f, spider::walk },
+};
+
+static constexpr size_t g_animationDefinitionCount = sizeof(g_animationDefinitions) / sizeof(g_animationDefinitions[0]);
+
+static constexpr bool isNameLess(const char* first, const char* second)
+{
+    while (*first && *first == *second) {
+        ++first;
+        ++second;
+    }
+    return (unsigned char)*first < (unsigned char)*second;
+}
+
+static constexpr bool isTableOrdered()
+{
+    for (size_t i = 0; i < g_animationDefinitionCount; ++i) {
+        if (g_animationDefinitions[i].id != static_cast<AnimationId>(i))
+            return false;
+        if (i > 0 && !isNameLess(g_animationDefinitions[i - 1].name, g_animationDefinitions[i].name))
+            return false;
+    }
+    return true;
+}
+
+static_assert(g_animationDefinitionCount == static_cast<size_t>(AnimationId::Count),
+    "Every AnimationId needs a registry entry");
+static_assert(isTableOrdered(),
+    "Registry entries must follow AnimationId order and be sorted by name");
+
+const AnimationDefinition* AnimationRegistry::begin()
+{
+    return g_animationDefinitions;
+}
+
+const AnimationDefinition* AnimationRegistry::end()
+{
+    return g_animationDefinitions + g_animationDefinitionCount;
+}
+
+const AnimationDefinition& AnimationRegistry::definition(AnimationId id)
+{
+    return g_animationDefinitions[static_cast<size_t>(id)];
+}
+
+const AnimationDefinition* AnimationRegistry::find(const std::string& name)
+{
+    auto it = std::lower_bound(begin(), end(), name.c_str(), [](const AnimationDefinition& definition, const char* name) {
+        return isNameLess(definition.name, name);
+    });
+    if (it == end() || 0 != std::strcmp(it->name, name.c_str()))
+        return nullptr;
+    return it;
+}
+
+}
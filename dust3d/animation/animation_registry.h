@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_ANIMATION_ANIMATION_REGISTRY_H_
+#define DUST3D_ANIMATION_ANIMATION_REGISTRY_H_
+
+#include <cstdint>
+#include <dust3d/animation/animation_generator.h>
+#include <map>
+#include <string>
+
+namespace dust3d {
+
+// One id per animation type name, in the same order as the registry table
+enum class AnimationId : std::uint8_t {
+    BipedCast,
+    BipedChannel,
+    BipedDie,
+    BipedHurt,
+    BipedIdle,
+    BipedJump,
+    BipedRoar,
+    BipedRun,
+    BipedSlam,
+    BipedStab,
+    BipedWalk,
+    BirdAttack,
+    BirdDie,
+    BirdEat,
+    BirdFly,
+    BirdForward,
+    BirdGlide,
+    BirdIdle,
+    BirdRun,
+    BirdWalk,
+    FishDie,
+    FishForward,
+    FishIdle,
+    FishSwim,
+    InsectAttack,
+    InsectDie,
+    InsectFly,
+    InsectForward,
+    InsectIdle,
+    InsectRubHands,
+    InsectWalk,
+    QuadrupedAttack,
+    QuadrupedDie,
+    QuadrupedEat,
+    QuadrupedHurt,
+    QuadrupedIdle,
+    QuadrupedRoar,
+    QuadrupedRun,
+    QuadrupedWalk,
+    SnakeDie,
+    SnakeForward,
+    SnakeIdle,
+    SnakeSlither,
+    SpiderDie,
+    SpiderIdle,
+    SpiderRun,
+    SpiderWalk,
+    Count
+};
+
+struct AnimationDefinition {
+    typedef bool (*GenerateFunction)(const RigStructure& rigStructure,
+        const std::map<std::string, Matrix4x4>& inverseBindMatrices,
+        RigAnimationClip& animationClip,
+        const AnimationParams& parameters);
+
+    AnimationId id;
+    const char* name;
+    const char* rigType;
+    // Alternative names still accepted from older documents, not offered for new animations
+    bool isAlias;
+    // Movement speed in body lengths, 0 for animations played in place
+    float movementSpeedFactor;
+    GenerateFunction generate;
+};
+
+// Static table of every animation the generator knows, sorted by name at compile time.
+// The generator, the exporters and the UI all enumerate and resolve animations through it.
+class AnimationRegistry {
+public:
+    static const AnimationDefinition* begin();
+    static const AnimationDefinition* end();
+    static const AnimationDefinition& definition(AnimationId id);
+    static const AnimationDefinition* find(const std::string& name);
+};
+
+}
+
+#endif
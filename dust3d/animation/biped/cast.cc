@@ -127,7 +127,7 @@ namespace biped {
         double massInertia = 0.6 + 0.4 * bodyMassFactor;
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         // Hair chain physics: gentle secondary motion during casting.
         const std::vector<std::string> hairBoneNames = { "HairBack1", "HairBack2", "HairBack3" };
@@ -354,13 +354,13 @@ namespace biped {
                         hairSim.step(boneWorldTransforms["Head"], hairDt, boneWorldTransforms);
                     if (capeSim.active)
                         capeSim.step(boneWorldTransforms["Chest"], hairDt, boneWorldTransforms);
-                    animFrame.boneWorldTransforms = boneWorldTransforms;
+                    animFrame.boneWorldTransforms.assign(boneWorldTransforms);
                     for (const auto& pair : boneWorldTransforms) {
                         auto invIt = inverseBindMatrices.find(pair.first);
                         if (invIt != inverseBindMatrices.end()) {
                             Matrix4x4 skinMat = pair.second;
                             skinMat *= invIt->second;
-                            animFrame.boneSkinMatrices[pair.first] = skinMat;
+                            animFrame.boneSkinMatrices.set(pair.first, skinMat);
                         }
                     }
                 } else {
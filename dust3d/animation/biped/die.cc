@@ -394,8 +394,7 @@ namespace biped {
         // 5. Generate frames with XPBD + muscle tone decay + self-collision
         // ===================================================================
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.clear();
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         double dt = durationSeconds / std::max(1, frameCount);
         double dtSq = dt * dt;
@@ -671,13 +670,13 @@ namespace biped {
                 hairSim.step(boneWorldTransforms["Head"], dt, boneWorldTransforms);
             if (capeSim.active)
                 capeSim.step(boneWorldTransforms["Chest"], dt, boneWorldTransforms);
-            frameData.boneWorldTransforms = boneWorldTransforms;
+            frameData.boneWorldTransforms.assign(boneWorldTransforms);
             for (const auto& pair : boneWorldTransforms) {
                 auto invIt = inverseBindMatrices.find(pair.first);
                 if (invIt != inverseBindMatrices.end()) {
                     Matrix4x4 skinMat = pair.second;
                     skinMat *= invIt->second;
-                    frameData.boneSkinMatrices[pair.first] = skinMat;
+                    frameData.boneSkinMatrices.set(pair.first, skinMat);
                 }
             }
         }
@@ -183,7 +183,7 @@ namespace biped {
         double recoveryEnd = 0.75; // back to neutral by here
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         // Hair chain physics: reactive snap, higher stiffness for quick response.
         const std::vector<std::string> hairBoneNames = { "HairBack1", "HairBack2", "HairBack3" };
@@ -517,14 +517,14 @@ namespace biped {
 
             auto& frameData = animationClip.frames[frame];
             frameData.time = static_cast<float>(tNormalized) * durationSeconds;
-            frameData.boneWorldTransforms = boneWorldTransforms;
+            frameData.boneWorldTransforms.assign(boneWorldTransforms);
 
             for (const auto& pair : boneWorldTransforms) {
                 auto invIt = inverseBindMatrices.find(pair.first);
                 if (invIt != inverseBindMatrices.end()) {
                     Matrix4x4 skinMat = pair.second;
                     skinMat *= invIt->second;
-                    frameData.boneSkinMatrices[pair.first] = skinMat;
+                    frameData.boneSkinMatrices.set(pair.first, skinMat);
                 }
             }
         }
@@ -142,7 +142,7 @@ namespace biped {
         // looping while still breaking single-frequency regularity.
         // ===================================================================
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         // Hair chain physics: gentle secondary motion tied to breathing/weight shift.
         // Low stiffness and high damping gives a soft, floaty feel at rest.
@@ -453,14 +453,14 @@ namespace biped {
             // Skin matrices
             auto& animFrame = animationClip.frames[frame];
             animFrame.time = static_cast<float>(tNormalized) * durationSeconds;
-            animFrame.boneWorldTransforms = boneWorldTransforms;
+            animFrame.boneWorldTransforms.assign(boneWorldTransforms);
 
             for (const auto& pair : boneWorldTransforms) {
                 auto invIt = inverseBindMatrices.find(pair.first);
                 if (invIt != inverseBindMatrices.end()) {
                     Matrix4x4 skinMat = pair.second;
                     skinMat *= invIt->second;
-                    animFrame.boneSkinMatrices[pair.first] = skinMat;
+                    animFrame.boneSkinMatrices.set(pair.first, skinMat);
                 }
             }
         }
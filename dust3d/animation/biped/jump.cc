@@ -290,7 +290,7 @@ namespace biped {
         // 5. Generate frames
         // ===================================================================
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         // Hair chain physics: floaty feel with reduced gravity during airborne phase.
         const std::vector<std::string> hairBoneNames = { "HairBack1", "HairBack2", "HairBack3" };
@@ -642,14 +642,14 @@ namespace biped {
 
                     auto& animFrame = animationClip.frames[frame];
                     animFrame.time = static_cast<float>(t) * durationSeconds;
-                    animFrame.boneWorldTransforms = boneWorldTransforms;
+                    animFrame.boneWorldTransforms.assign(boneWorldTransforms);
 
                     for (const auto& pair : boneWorldTransforms) {
                         auto invIt = inverseBindMatrices.find(pair.first);
                         if (invIt != inverseBindMatrices.end()) {
                             Matrix4x4 skinMat = pair.second;
                             skinMat *= invIt->second;
-                            animFrame.boneSkinMatrices[pair.first] = skinMat;
+                            animFrame.boneSkinMatrices.set(pair.first, skinMat);
                         }
                     }
                 } else {
@@ -248,7 +248,7 @@ namespace biped {
         // 4. Generate frames
         // ===================================================================
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         const double cycles = std::max(1.0, std::round(gaitSpeedFactor));
         // Run has shorter stance phase: swing duty ~40% (vs 30% in walk)
@@ -491,14 +491,14 @@ namespace biped {
                 if (pass == 1) {
                     auto& animFrame = animationClip.frames[frame];
                     animFrame.time = static_cast<float>(tNormalized) * durationSeconds;
-                    animFrame.boneWorldTransforms = boneWorldTransforms;
+                    animFrame.boneWorldTransforms.assign(boneWorldTransforms);
 
                     for (const auto& pair : boneWorldTransforms) {
                         auto invIt = inverseBindMatrices.find(pair.first);
                         if (invIt != inverseBindMatrices.end()) {
                             Matrix4x4 skinMat = pair.second;
                             skinMat *= invIt->second;
-                            animFrame.boneSkinMatrices[pair.first] = skinMat;
+                            animFrame.boneSkinMatrices.set(pair.first, skinMat);
                         }
                     }
                 }
@@ -135,7 +135,7 @@ namespace biped {
         double massInertia = 0.6 + 0.4 * bodyMassFactor;
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         // Hair chain physics: quick forward thrust causes whip-back lag.
         const std::vector<std::string> hairBoneNames = { "HairBack1", "HairBack2", "HairBack3" };
@@ -414,13 +414,13 @@ namespace biped {
                         hairSim.step(boneWorldTransforms["Head"], hairDt, boneWorldTransforms);
                     if (capeSim.active)
                         capeSim.step(boneWorldTransforms["Chest"], hairDt, boneWorldTransforms);
-                    animFrame.boneWorldTransforms = boneWorldTransforms;
+                    animFrame.boneWorldTransforms.assign(boneWorldTransforms);
                     for (const auto& pair : boneWorldTransforms) {
                         auto invIt = inverseBindMatrices.find(pair.first);
                         if (invIt != inverseBindMatrices.end()) {
                             Matrix4x4 skinMat = pair.second;
                             skinMat *= invIt->second;
-                            animFrame.boneSkinMatrices[pair.first] = skinMat;
+                            animFrame.boneSkinMatrices.set(pair.first, skinMat);
                         }
                     }
                 } else {
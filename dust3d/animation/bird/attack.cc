@@ -355,7 +355,7 @@ namespace bird {
         uint32_t noiseSeed = 42u;
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         animation::CapeGridSimulator capeSim;
         if (boneIdx.count("CenterCape1"))
@@ -672,8 +672,8 @@ namespace bird {
             // ---- Write frame ----
             auto& animFrame = animationClip.frames[frame];
             animFrame.time = static_cast<float>(t) * durationSeconds;
-            animFrame.boneWorldTransforms = boneWorldTransforms;
-            animFrame.boneSkinMatrices = boneSkinMatrices;
+            animFrame.boneWorldTransforms.assign(boneWorldTransforms);
+            animFrame.boneSkinMatrices.assign(boneSkinMatrices);
         }
 
         return true;
@@ -258,8 +258,7 @@ namespace bird {
         }
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.clear();
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         std::set<std::string> spineChainBones = { "Spine", "Chest", "Neck", "Head", "Beak" };
         float spineJointStiffness = static_cast<float>(parameters.getValue("spineStiffness", 0.98));
@@ -388,13 +387,13 @@ namespace bird {
 
             auto& frameData = animationClip.frames[frame];
             frameData.time = static_cast<float>(tNormalized) * durationSeconds;
-            frameData.boneWorldTransforms = boneWorldTransforms;
+            frameData.boneWorldTransforms.assign(boneWorldTransforms);
             for (const auto& pair : boneWorldTransforms) {
                 auto invIt = inverseBindMatrices.find(pair.first);
                 if (invIt != inverseBindMatrices.end()) {
                     Matrix4x4 skinMat = pair.second;
                     skinMat *= invIt->second;
-                    frameData.boneSkinMatrices[pair.first] = skinMat;
+                    frameData.boneSkinMatrices.set(pair.first, skinMat);
                 }
             }
         }
@@ -142,7 +142,7 @@ namespace bird {
         double pecksPerCycle = std::max(2.0, std::round(5.0 * peckSpeedFactor));
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         animation::CapeGridSimulator capeSim;
         if (boneIdx.count("CenterCape1"))
@@ -349,8 +349,8 @@ namespace bird {
                     // Write frame
                     auto& animFrame = animationClip.frames[frame];
                     animFrame.time = static_cast<float>(tNormalized) * durationSeconds;
-                    animFrame.boneWorldTransforms = boneWorldTransforms;
-                    animFrame.boneSkinMatrices = boneSkinMatrices;
+                    animFrame.boneWorldTransforms.assign(boneWorldTransforms);
+                    animFrame.boneSkinMatrices.assign(boneSkinMatrices);
                 }
             }
         } // end pass
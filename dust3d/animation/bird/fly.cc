@@ -109,7 +109,7 @@ namespace bird {
         double tailFlapAmp = 0.15; // radians
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         const double cycles = std::max(1.0, std::round(gaitSpeedFactor));
 
@@ -301,8 +301,8 @@ namespace bird {
                     // Write frame
                     auto& animFrame = animationClip.frames[frame];
                     animFrame.time = static_cast<float>(tNormalized) * durationSeconds;
-                    animFrame.boneWorldTransforms = boneWorldTransforms;
-                    animFrame.boneSkinMatrices = boneSkinMatrices;
+                    animFrame.boneWorldTransforms.assign(boneWorldTransforms);
+                    animFrame.boneSkinMatrices.assign(boneSkinMatrices);
                 }
             }
         } // end pass
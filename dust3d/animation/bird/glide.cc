@@ -109,7 +109,7 @@ namespace bird {
         double tailYawAmp = 0.06 * tailSteerFactor; // radians
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         animation::CapeGridSimulator capeSim;
         if (boneIdx.count("CenterCape1"))
@@ -355,8 +355,8 @@ namespace bird {
                     // Write frame
                     auto& animFrame = animationClip.frames[frame];
                     animFrame.time = static_cast<float>(tNormalized) * durationSeconds;
-                    animFrame.boneWorldTransforms = boneWorldTransforms;
-                    animFrame.boneSkinMatrices = boneSkinMatrices;
+                    animFrame.boneWorldTransforms.assign(boneWorldTransforms);
+                    animFrame.boneSkinMatrices.assign(boneSkinMatrices);
                 }
             }
         } // end pass
@@ -128,7 +128,7 @@ namespace bird {
         };
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         animation::CapeGridSimulator capeSim;
         if (boneIdx.count("CenterCape1"))
@@ -294,8 +294,8 @@ namespace bird {
                     // Write frame
                     auto& animFrame = animationClip.frames[frame];
                     animFrame.time = static_cast<float>(tNormalized) * durationSeconds;
-                    animFrame.boneWorldTransforms = boneWorldTransforms;
-                    animFrame.boneSkinMatrices = boneSkinMatrices;
+                    animFrame.boneWorldTransforms.assign(boneWorldTransforms);
+                    animFrame.boneSkinMatrices.assign(boneSkinMatrices);
                 }
             }
         } // end pass
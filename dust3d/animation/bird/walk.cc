@@ -174,7 +174,7 @@ namespace bird {
         const double swingFraction = 1.0 - dutyFactor;
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         const double cycles = std::max(1.0, std::round(gaitSpeedFactor));
         double dt = durationSeconds / static_cast<double>(frameCount);
@@ -620,8 +620,8 @@ namespace bird {
                 }
                 auto& animFrame = animationClip.frames[frame];
                 animFrame.time = static_cast<float>(tNormalized) * durationSeconds;
-                animFrame.boneWorldTransforms = boneWorldTransforms;
-                animFrame.boneSkinMatrices = boneSkinMatrices;
+                animFrame.boneWorldTransforms.assign(boneWorldTransforms);
+                animFrame.boneSkinMatrices.assign(boneSkinMatrices);
             }
         }
 
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <algorithm>
+#include <dust3d/animation/bone_pose.h>
+
+namespace dust3d {
+
+BonePoseLayout::BonePoseLayout(const RigStructure& rigStructure)
+{
+    m_boneNames.reserve(rigStructure.bones.size());
+    for (size_t i = 0; i < rigStructure.bones.size(); ++i) {
+        m_boneNames.push_back(rigStructure.bones[i].name);
+        m_boneNameToIndexMap[rigStructure.bones[i].name] = i;
+    }
+}
+
+size_t BonePoseLayout::boneIndex(const std::string& boneName) const
+{
+    auto findIndex = m_boneNameToIndexMap.find(boneName);
+    if (findIndex == m_boneNameToIndexMap.end())
+        return npos;
+    return findIndex->second;
+}
+
+BonePose::BonePose(std::shared_ptr<const BonePoseLayout> layout)
+    : m_layout(std::move(layout))
+{
+    if (nullptr != m_layout) {
+        m_matrices.resize(m_layout->boneCount());
+        m_present.resize(m_layout->boneCount(), 0);
+    }
+}
+
+void BonePose::set(size_t boneIndex, const Matrix4x4& matrix)
+{
+    if (boneIndex >= m_matrices.size())
+        return;
+    m_matrices[boneIndex] = matrix;
+    if (!m_present[boneIndex]) {
+        m_present[boneIndex] = 1;
+        ++m_presentCount;
+    }
+}
+
+void BonePose::clear()
+{
+    std::fill(m_present.begin(), m_present.end(), 0);
+    m_presentCount = 0;
+}
+
+const Matrix4x4* BonePose::find(const std::string& boneName) const
+{
+    if (nullptr == m_layout)
+        return nullptr;
+    return find(m_layout->boneIndex(boneName));
+}
+
+void BonePose::set(const std::string& boneName, const Matrix4x4& matrix)
+{
+    if (nullptr == m_layout)
+        return;
+    set(m_layout->boneIndex(boneName), matrix);
+}
+
+void BonePose::assign(const std::map<std::string, Matrix4x4>& matrices)
+{
+    clear();
+    for (const auto& it : matrices)
+        set(it.first, it.second);
+}
+
+std::map<std::string, Matrix4x4> BonePose::toMap() const
+{
+    std::map<std::string, Matrix4x4> matrices;
+    for (size_t i = 0; i < m_matrices.size(); ++i) {
+        if (m_present[i])
+            matrices[m_layout->boneName(i)] = m_matrices[i];
+    }
+    return matrices;
+}
+
+}
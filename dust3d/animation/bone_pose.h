@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_ANIMATION_BONE_POSE_H_
+#define DUST3D_ANIMATION_BONE_POSE_H_
+
+#include <dust3d/base/matrix4x4.h>
+#include <dust3d/rig/rig_generator.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dust3d {
+
+// Maps bone names to the contiguous indices used by BonePose.
+// Indices follow the order of RigStructure::bones, so a layout is built
+// once per rig and shared by every frame of every clip generated from it.
+class BonePoseLayout {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    BonePoseLayout() = default;
+    explicit BonePoseLayout(const RigStructure& rigStructure);
+
+    size_t boneCount() const
+    {
+        return m_boneNames.size();
+    }
+
+    const std::string& boneName(size_t boneIndex) const
+    {
+        return m_boneNames[boneIndex];
+    }
+
+    size_t boneIndex(const std::string& boneName) const;
+
+private:
+    std::vector<std::string> m_boneNames;
+    std::map<std::string, size_t> m_boneNameToIndexMap;
+};
+
+// Per bone matrices of one frame, stored as a flat array addressed by the
+// indices of a shared BonePoseLayout. Bones never written are absent.
+class BonePose {
+public:
+    BonePose() = default;
+    explicit BonePose(std::shared_ptr<const BonePoseLayout> layout);
+
+    const std::shared_ptr<const BonePoseLayout>& layout() const
+    {
+        return m_layout;
+    }
+
+    size_t boneCount() const
+    {
+        return m_matrices.size();
+    }
+
+    bool empty() const
+    {
+        return 0 == m_presentCount;
+    }
+
+    bool has(size_t boneIndex) const
+    {
+        return boneIndex < m_present.size() && m_present[boneIndex];
+    }
+
+    const Matrix4x4& matrix(size_t boneIndex) const
+    {
+        return m_matrices[boneIndex];
+    }
+
+    const Matrix4x4* find(size_t boneIndex) const
+    {
+        return has(boneIndex) ? &m_matrices[boneIndex] : nullptr;
+    }
+
+    void set(size_t boneIndex, const Matrix4x4& matrix);
+    void clear();
+
+    // Name based accessors, resolving through the layout on every call.
+    // Hot loops should resolve bone indices once and use the index overloads.
+    const Matrix4x4* find(const std::string& boneName) const;
+    void set(const std::string& boneName, const Matrix4x4& matrix);
+    void assign(const std::map<std::string, Matrix4x4>& matrices);
+    std::map<std::string, Matrix4x4> toMap() const;
+
+private:
+    std::shared_ptr<const BonePoseLayout> m_layout;
+    std::vector<Matrix4x4> m_matrices;
+    std::vector<char> m_present;
+    size_t m_presentCount = 0;
+};
+
+}
+
+#endif
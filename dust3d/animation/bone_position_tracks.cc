@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <dust3d/animation/bone_position_tracks.h>
+
+namespace dust3d {
+
+BonePositionTracks::BonePositionTracks(const RigAnimationClip& clip)
+    : m_layout(clip.poseLayout)
+{
+    if (nullptr == m_layout && !clip.frames.empty())
+        m_layout = clip.frames[0].boneWorldTransforms.layout();
+
+    size_t frameCount = clip.frames.size();
+    m_boneCount = nullptr == m_layout ? 0 : m_layout->boneCount();
+    m_times.resize(frameCount);
+    m_positions.resize(m_boneCount * 3 * frameCount, 0.0);
+    m_present.resize(m_boneCount * frameCount, 0);
+    m_zeros.resize(frameCount, 0.0);
+
+    for (size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        const auto& frame = clip.frames[frameIndex];
+        m_times[frameIndex] = frame.time;
+        const BonePose& pose = frame.boneWorldTransforms;
+        if (pose.layout() != m_layout)
+            continue;
+        for (size_t boneIndex = 0; boneIndex < m_boneCount; ++boneIndex) {
+            const Matrix4x4* worldTransform = pose.find(boneIndex);
+            if (nullptr == worldTransform)
+                continue;
+            const double* data = worldTransform->constData();
+            m_positions[(boneIndex * 3 + 0) * frameCount + frameIndex] = data[Matrix4x4::M30];
+            m_positions[(boneIndex * 3 + 1) * frameCount + frameIndex] = data[Matrix4x4::M31];
+            m_positions[(boneIndex * 3 + 2) * frameCount + frameIndex] = data[Matrix4x4::M32];
+            m_present[boneIndex * frameCount + frameIndex] = 1;
+        }
+    }
+}
+
+size_t BonePositionTracks::boneIndex(const std::string& boneName) const
+{
+    if (nullptr == m_layout)
+        return BonePoseLayout::npos;
+    return m_layout->boneIndex(boneName);
+}
+
+std::vector<double> BonePositionTracks::signature(const std::vector<size_t>& boneIndices) const
+{
+    size_t frameCount = m_times.size();
+    std::vector<double> result;
+    result.reserve(frameCount * (1 + boneIndices.size() * 4));
+    result.insert(result.end(), m_times.begin(), m_times.end());
+    for (size_t boneIndex : boneIndices) {
+        for (size_t axis = 0; axis < 3; ++axis) {
+            const double* values = track(boneIndex, axis);
+            result.insert(result.end(), values, values + frameCount);
+        }
+        for (size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+            result.push_back(has(boneIndex, frameIndex) ? 1.0 : 0.0);
+    }
+    return result;
+}
+
+}
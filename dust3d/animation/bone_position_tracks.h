@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_ANIMATION_BONE_POSITION_TRACKS_H_
+#define DUST3D_ANIMATION_BONE_POSITION_TRACKS_H_
+
+#include <dust3d/animation/animation_generator.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dust3d {
+
+// World positions of every bone over all frames of a clip, extracted once and
+// stored as one contiguous array per bone and axis. A bone missing from a frame
+// reads as the origin there, the same as a missing world transform does.
+class BonePositionTracks {
+public:
+    BonePositionTracks() = default;
+    explicit BonePositionTracks(const RigAnimationClip& clip);
+
+    const std::shared_ptr<const BonePoseLayout>& layout() const
+    {
+        return m_layout;
+    }
+
+    size_t frameCount() const
+    {
+        return m_times.size();
+    }
+
+    float time(size_t frameIndex) const
+    {
+        return m_times[frameIndex];
+    }
+
+    // Returns BonePoseLayout::npos for bones the clip does not know
+    size_t boneIndex(const std::string& boneName) const;
+
+    bool has(size_t boneIndex, size_t frameIndex) const
+    {
+        return boneIndex < m_boneCount && m_present[boneIndex * frameCount() + frameIndex];
+    }
+
+    // Unknown bones get a track of zeros
+    const double* x(size_t boneIndex) const
+    {
+        return track(boneIndex, 0);
+    }
+    const double* y(size_t boneIndex) const
+    {
+        return track(boneIndex, 1);
+    }
+    const double* z(size_t boneIndex) const
+    {
+        return track(boneIndex, 2);
+    }
+
+    // Everything a detection over the given bones depends on, for comparing clips
+    std::vector<double> signature(const std::vector<size_t>& boneIndices) const;
+
+private:
+    const double* track(size_t boneIndex, size_t axis) const
+    {
+        if (boneIndex >= m_boneCount)
+            return m_zeros.data();
+        return m_positions.data() + (boneIndex * 3 + axis) * frameCount();
+    }
+
+    std::shared_ptr<const BonePoseLayout> m_layout;
+    size_t m_boneCount = 0;
+    std::vector<float> m_times;
+    std::vector<double> m_positions;
+    std::vector<char> m_present;
+    std::vector<double> m_zeros;
+};
+
+}
+
+#endif
@@ -26,6 +26,7 @@
 #ifndef DUST3D_ANIMATION_COMMON_H
 #define DUST3D_ANIMATION_COMMON_H
 
+#include <dust3d/animation/bone_pose.h>
 #include <dust3d/base/matrix4x4.h>
 #include <dust3d/base/quaternion.h>
 #include <dust3d/base/vector3.h>
@@ -575,8 +576,8 @@ namespace animation {
     inline void applyEyelidBlink(const RigStructure& rig,
         const std::map<std::string, size_t>& boneIdx,
         const std::map<std::string, Matrix4x4>& inverseBindMatrices,
-        std::map<std::string, Matrix4x4>& boneWorldTransforms,
-        std::map<std::string, Matrix4x4>& boneSkinMatrices,
+        BonePose& boneWorldTransforms,
+        BonePose& boneSkinMatrices,
         float tNormalized,
         float blinkTime = 0.5f,
         float blinkDuration = 0.1f)
@@ -606,8 +607,8 @@ namespace animation {
         // To avoid any numerical offset, we derive the eyelid's rest-pose world
         // transform from its own inverse bind matrix (guaranteed exact match),
         // then apply the Head's animation delta on top.
-        auto headWorldIt = boneWorldTransforms.find("Head");
-        if (headWorldIt == boneWorldTransforms.end())
+        const Matrix4x4* headWorld = boneWorldTransforms.find("Head");
+        if (nullptr == headWorld)
             return;
 
         // Head's rest-pose world transform from its inverse bind matrix
@@ -616,7 +617,7 @@ namespace animation {
             return;
 
         // Delta = animatedHead * inverse(restHead)
-        Matrix4x4 headDelta = headWorldIt->second;
+        Matrix4x4 headDelta = *headWorld;
         headDelta *= headInvBindIt->second;
 
         // For blink, rotate each lid around the bone direction (the hinge axis).
@@ -673,11 +674,11 @@ namespace animation {
                 }
             }
 
-            boneWorldTransforms[eyelidName] = transform;
+            boneWorldTransforms.set(it->second, transform);
 
             Matrix4x4 skin = transform;
             skin *= invIt->second;
-            boneSkinMatrices[eyelidName] = skin;
+            boneSkinMatrices.set(it->second, skin);
         }
     }
 
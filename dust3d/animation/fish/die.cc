@@ -101,7 +101,7 @@ namespace fish {
         double spinDecay = parameters.getValue("spinDecay", 4.0);
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         const std::vector<std::string> spineBones = {
             "Root", "Head", "BodyFront", "BodyMid", "BodyRear", "TailStart", "TailEnd"
@@ -181,7 +181,7 @@ namespace fish {
                 skinMat.rotate(forwardDir, rollAngle);
                 skinMat.translate(-bodyFront);
                 skinMat.translate(thrash);
-                animationClip.frames[frame].boneSkinMatrices[boneName] = skinMat;
+                animationClip.frames[frame].boneSkinMatrices.set(boneName, skinMat);
 
                 // World transform: skinMat applied to the bind-pose bone transform.
                 // Using matrix composition rather than endpoint reconstruction preserves
@@ -227,7 +227,7 @@ namespace fish {
                 skinMat.rotate(forwardDir, rollAngle);
                 skinMat.translate(-bodyFront);
                 skinMat.translate(parentThrash);
-                animationClip.frames[frame].boneSkinMatrices[boneName] = skinMat;
+                animationClip.frames[frame].boneSkinMatrices.set(boneName, skinMat);
 
                 // World transform: skinMat * bindPoseTransform preserves orientation
                 // for all bone directions including those aligned with the roll axis.
@@ -253,7 +253,7 @@ namespace fish {
 
             auto& animFrame = animationClip.frames[frame];
             animFrame.time = static_cast<float>(t) * durationSeconds;
-            animFrame.boneWorldTransforms = boneWorldTransforms;
+            animFrame.boneWorldTransforms.assign(boneWorldTransforms);
             // boneSkinMatrices were written directly above; skip the endpoint-based recomputation.
         }
 
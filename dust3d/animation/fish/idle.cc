@@ -102,7 +102,7 @@ namespace fish {
         double driftAmp = bodyLength * 0.005 * driftFactor;
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         for (int frame = 0; frame < frameCount; ++frame) {
             double tNormalized = static_cast<double>(frame) / static_cast<double>(frameCount);
@@ -137,7 +137,7 @@ namespace fish {
                     skinMat.translate(-pos);
                 }
 
-                animationClip.frames[frame].boneSkinMatrices[name] = skinMat;
+                animationClip.frames[frame].boneSkinMatrices.set(name, skinMat);
 
                 Matrix4x4 animBoneTransform = skinMat;
                 animBoneTransform *= buildBoneWorldTransform(pos, end);
@@ -197,7 +197,7 @@ namespace fish {
 
             auto& animFrame = animationClip.frames[frame];
             animFrame.time = static_cast<float>(tNormalized) * durationSeconds;
-            animFrame.boneWorldTransforms = boneWorldTransforms;
+            animFrame.boneWorldTransforms.assign(boneWorldTransforms);
         }
 
         return true;
@@ -104,7 +104,7 @@ namespace fish {
         double forwardAmp = bodyLength * forwardThrust;
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         const std::vector<std::string> spineBones = {
             "Root", "Head", "BodyFront", "BodyMid", "BodyRear", "TailStart", "TailEnd"
@@ -218,14 +218,14 @@ namespace fish {
 
             auto& animFrame = animationClip.frames[frame];
             animFrame.time = static_cast<float>(tNormalized) * durationSeconds;
-            animFrame.boneWorldTransforms = boneWorldTransforms;
+            animFrame.boneWorldTransforms.assign(boneWorldTransforms);
 
             for (const auto& pair : boneWorldTransforms) {
                 auto invIt = inverseBindMatrices.find(pair.first);
                 if (invIt != inverseBindMatrices.end()) {
                     Matrix4x4 skinMat = pair.second;
                     skinMat *= invIt->second;
-                    animFrame.boneSkinMatrices[pair.first] = skinMat;
+                    animFrame.boneSkinMatrices.set(pair.first, skinMat);
                 }
             }
         }
@@ -130,7 +130,7 @@ namespace insect {
         double wingSwingAmp = 1.0; // rad
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         // Keep one attack cycle by matching to speed factor to keep loop smooth
         double cycles = std::max(1.0, std::round(attackSpeedFactor));
@@ -242,14 +242,14 @@ namespace insect {
 
             auto& frameData = animationClip.frames[frame];
             frameData.time = static_cast<float>(tNormalized) * durationSeconds;
-            frameData.boneWorldTransforms = boneWorldTransforms;
+            frameData.boneWorldTransforms.assign(boneWorldTransforms);
 
             for (const auto& pair : boneWorldTransforms) {
                 auto invIt = inverseBindMatrices.find(pair.first);
                 if (invIt != inverseBindMatrices.end()) {
                     Matrix4x4 skinMat = pair.second;
                     skinMat *= invIt->second;
-                    frameData.boneSkinMatrices[pair.first] = skinMat;
+                    frameData.boneSkinMatrices.set(pair.first, skinMat);
                 }
             }
         }
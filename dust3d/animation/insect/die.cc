@@ -243,8 +243,7 @@ namespace insect {
         }
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.clear();
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         double dt = durationSeconds / std::max(1, frameCount);
         Vector3 gravity = gravityDir * 9.80;
@@ -387,14 +386,14 @@ namespace insect {
 
             auto& frameData = animationClip.frames[frame];
             frameData.time = static_cast<float>(tNormalized) * durationSeconds;
-            frameData.boneWorldTransforms = boneWorldTransforms;
+            frameData.boneWorldTransforms.assign(boneWorldTransforms);
 
             for (const auto& pair : boneWorldTransforms) {
                 auto invIt = inverseBindMatrices.find(pair.first);
                 if (invIt != inverseBindMatrices.end()) {
                     Matrix4x4 skinMat = pair.second;
                     skinMat *= invIt->second;
-                    frameData.boneSkinMatrices[pair.first] = skinMat;
+                    frameData.boneSkinMatrices.set(pair.first, skinMat);
                 }
             }
         }
@@ -132,7 +132,7 @@ namespace insect {
         double wingFlapAmp = 0.8; // radians (approx 45 degrees)
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         const double cycles = std::max(1.0, std::round(gaitSpeedFactor));
 
@@ -251,14 +251,14 @@ namespace insect {
 
             auto& animFrame = animationClip.frames[frame];
             animFrame.time = static_cast<float>(tNormalized) * durationSeconds;
-            animFrame.boneWorldTransforms = boneWorldTransforms;
+            animFrame.boneWorldTransforms.assign(boneWorldTransforms);
 
             for (const auto& pair : boneWorldTransforms) {
                 auto invIt = inverseBindMatrices.find(pair.first);
                 if (invIt != inverseBindMatrices.end()) {
                     Matrix4x4 skinMat = pair.second;
                     skinMat *= invIt->second;
-                    animFrame.boneSkinMatrices[pair.first] = skinMat;
+                    animFrame.boneSkinMatrices.set(pair.first, skinMat);
                 }
             }
         }
@@ -181,7 +181,7 @@ namespace insect {
         // 4. Generate animation frames
         // ===================================================================
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         // Round gaitSpeedFactor to the nearest positive integer so the clip always
         // contains a whole number of gait cycles.  A fractional value would leave
@@ -335,14 +335,14 @@ namespace insect {
             // Use the frame's actual position in the clip, not the wrapped gait
             // phase, so that frame times remain monotonically increasing.
             animFrame.time = static_cast<float>(tNormalized) * durationSeconds;
-            animFrame.boneWorldTransforms = boneWorldTransforms;
+            animFrame.boneWorldTransforms.assign(boneWorldTransforms);
 
             for (const auto& pair : boneWorldTransforms) {
                 auto invIt = inverseBindMatrices.find(pair.first);
                 if (invIt != inverseBindMatrices.end()) {
                     Matrix4x4 skinMat = pair.second;
                     skinMat *= invIt->second;
-                    animFrame.boneSkinMatrices[pair.first] = skinMat;
+                    animFrame.boneSkinMatrices.set(pair.first, skinMat);
                 }
             }
         }
@@ -0,0 +1,142 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <dust3d/animation/mesh_skinner.h>
+
+namespace dust3d {
+
+MeshSkinner::MeshSkinner(const Object& object, const BonePoseLayout& poseLayout)
+    : m_poseLayout(&poseLayout)
+    , m_boneCount(poseLayout.boneCount())
+{
+    size_t vertexCount = object.vertices.size();
+    m_restX.resize(vertexCount);
+    m_restY.resize(vertexCount);
+    m_restZ.resize(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        m_restX[i] = (float)object.vertices[i].x();
+        m_restY[i] = (float)object.vertices[i].y();
+        m_restZ[i] = (float)object.vertices[i].z();
+    }
+
+    // Unbound influences point at the extra slot past the last bone, which is never present
+    auto resolveInfluences = [&](const std::vector<std::pair<std::string, float>>& vertexBones,
+                                 std::vector<std::uint32_t>* boneIndices,
+                                 std::vector<float>* weights) {
+        boneIndices->resize(vertexCount, (std::uint32_t)m_boneCount);
+        weights->resize(vertexCount, 0.0f);
+        for (size_t i = 0; i < vertexCount && i < vertexBones.size(); ++i) {
+            if (vertexBones[i].first.empty())
+                continue;
+            size_t boneIndex = poseLayout.boneIndex(vertexBones[i].first);
+            if (BonePoseLayout::npos == boneIndex)
+                continue;
+            (*boneIndices)[i] = (std::uint32_t)boneIndex;
+            (*weights)[i] = vertexBones[i].second;
+        }
+    };
+    resolveInfluences(object.vertexBone1, &m_boneIndices1, &m_weights1);
+    resolveInfluences(object.vertexBone2, &m_boneIndices2, &m_weights2);
+}
+
+size_t MeshSkinner::vertexCount() const
+{
+    return m_restX.size();
+}
+
+bool MeshSkinner::skin(const BonePose& skinMatrices, SkinnedVertices* skinnedVertices) const
+{
+    // Bone indices are only meaningful in the layout they were resolved against
+    if (skinMatrices.layout().get() != m_poseLayout || skinMatrices.boneCount() != m_boneCount)
+        return false;
+
+    // Flatten the frame to float 3x4 rows, absent bones get a zero matrix and a zero presence
+    // so their influence drops out of both the blend and the weight sum
+    std::vector<float> boneMatrices((m_boneCount + 1) * 12, 0.0f);
+    std::vector<float> bonePresences(m_boneCount + 1, 0.0f);
+    for (size_t boneIndex = 0; boneIndex < m_boneCount; ++boneIndex) {
+        const Matrix4x4* matrix = skinMatrices.find(boneIndex);
+        if (nullptr == matrix)
+            continue;
+        const double* data = matrix->constData();
+        float* row = &boneMatrices[boneIndex * 12];
+        row[0] = (float)data[Matrix4x4::M00];
+        row[1] = (float)data[Matrix4x4::M10];
+        row[2] = (float)data[Matrix4x4::M20];
+        row[3] = (float)data[Matrix4x4::M30];
+        row[4] = (float)data[Matrix4x4::M01];
+        row[5] = (float)data[Matrix4x4::M11];
+        row[6] = (float)data[Matrix4x4::M21];
+        row[7] = (float)data[Matrix4x4::M31];
+        row[8] = (float)data[Matrix4x4::M02];
+        row[9] = (float)data[Matrix4x4::M12];
+        row[10] = (float)data[Matrix4x4::M22];
+        row[11] = (float)data[Matrix4x4::M32];
+        bonePresences[boneIndex] = 1.0f;
+    }
+
+    static const float identity[12] = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f
+    };
+
+    size_t vertexCount = m_restX.size();
+    skinnedVertices->matrices.resize(vertexCount * 12);
+    skinnedVertices->positionX.resize(vertexCount);
+    skinnedVertices->positionY.resize(vertexCount);
+    skinnedVertices->positionZ.resize(vertexCount);
+    float* vertexMatrices = skinnedVertices->matrices.data();
+    float* positionX = skinnedVertices->positionX.data();
+    float* positionY = skinnedVertices->positionY.data();
+    float* positionZ = skinnedVertices->positionZ.data();
+    for (size_t i = 0; i < vertexCount; ++i) {
+        std::uint32_t boneIndex1 = m_boneIndices1[i];
+        std::uint32_t boneIndex2 = m_boneIndices2[i];
+        float weight1 = m_weights1[i] * bonePresences[boneIndex1];
+        float weight2 = m_weights2[i] * bonePresences[boneIndex2];
+        float totalWeight = weight1 + weight2;
+
+        // Vertices with no usable influence keep their rest position
+        float bound = totalWeight > 1e-6f ? 1.0f : 0.0f;
+        float inverseTotalWeight = bound / (totalWeight + (1.0f - bound));
+        weight1 *= inverseTotalWeight;
+        weight2 *= inverseTotalWeight;
+        float unbound = 1.0f - bound;
+
+        const float* matrix1 = &boneMatrices[boneIndex1 * 12];
+        const float* matrix2 = &boneMatrices[boneIndex2 * 12];
+        float* m = vertexMatrices + i * 12;
+        for (size_t k = 0; k < 12; ++k)
+            m[k] = matrix1[k] * weight1 + matrix2[k] * weight2 + identity[k] * unbound;
+
+        float x = m_restX[i];
+        float y = m_restY[i];
+        float z = m_restZ[i];
+        positionX[i] = m[0] * x + m[1] * y + m[2] * z + m[3];
+        positionY[i] = m[4] * x + m[5] * y + m[6] * z + m[7];
+        positionZ[i] = m[8] * x + m[9] * y + m[10] * z + m[11];
+    }
+    return true;
+}
+
+}
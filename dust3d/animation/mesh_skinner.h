@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_ANIMATION_MESH_SKINNER_H_
+#define DUST3D_ANIMATION_MESH_SKINNER_H_
+
+#include <cmath>
+#include <cstdint>
+#include <dust3d/animation/bone_pose.h>
+#include <dust3d/base/object.h>
+#include <vector>
+
+namespace dust3d {
+
+// Linear blend skinning of an Object's vertices by the two bone influences
+// stored in Object::vertexBone1/vertexBone2.
+// Bone names are resolved to pose indices once on construction, rest positions
+// are kept as separate x/y/z float arrays, and each frame is skinned by one
+// branch free pass over them. skin() only reads the skinner, so frames can be
+// skinned concurrently from several threads. Frames must be addressed by the
+// same layout the skinner was built with, skin() refuses any other frame.
+class MeshSkinner {
+public:
+    struct SkinnedVertices {
+        // Blended bone matrix of each vertex, 3 rows of 4 floats
+        std::vector<float> matrices;
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> positionZ;
+
+        inline void transformNormal(size_t vertexIndex, float x, float y, float z, float* result) const
+        {
+            const float* m = &matrices[vertexIndex * 12];
+            float nx = m[0] * x + m[1] * y + m[2] * z;
+            float ny = m[4] * x + m[5] * y + m[6] * z;
+            float nz = m[8] * x + m[9] * y + m[10] * z;
+            float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+            if (length > 1e-12f) {
+                nx /= length;
+                ny /= length;
+                nz /= length;
+            }
+            result[0] = nx;
+            result[1] = ny;
+            result[2] = nz;
+        }
+    };
+
+    MeshSkinner(const Object& object, const BonePoseLayout& poseLayout);
+    size_t vertexCount() const;
+    bool skin(const BonePose& skinMatrices, SkinnedVertices* skinnedVertices) const;
+
+private:
+    const BonePoseLayout* m_poseLayout = nullptr;
+    size_t m_boneCount = 0;
+    std::vector<float> m_restX;
+    std::vector<float> m_restY;
+    std::vector<float> m_restZ;
+    std::vector<std::uint32_t> m_boneIndices1;
+    std::vector<std::uint32_t> m_boneIndices2;
+    std::vector<float> m_weights1;
+    std::vector<float> m_weights2;
+};
+
+}
+
+#endif
@@ -295,8 +295,7 @@ namespace quadruped {
         }
 
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.clear();
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         double dt = durationSeconds / std::max(1, frameCount);
         Vector3 gravity = gravityDir * 9.80;
@@ -422,14 +421,14 @@ namespace quadruped {
 
             auto& frameData = animationClip.frames[frame];
             frameData.time = static_cast<float>(tNormalized) * durationSeconds;
-            frameData.boneWorldTransforms = boneWorldTransforms;
+            frameData.boneWorldTransforms.assign(boneWorldTransforms);
 
             for (const auto& pair : boneWorldTransforms) {
                 auto invIt = inverseBindMatrices.find(pair.first);
                 if (invIt != inverseBindMatrices.end()) {
                     Matrix4x4 skinMat = pair.second;
                     skinMat *= invIt->second;
-                    frameData.boneSkinMatrices[pair.first] = skinMat;
+                    frameData.boneSkinMatrices.set(pair.first, skinMat);
                 }
             }
         }
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <dust3d/animation/reduce_keyframes.h>
+
+namespace dust3d {
+
+template <typename Value, typename Error>
+static std::vector<size_t> reduceKeyframes(const std::vector<float>& times,
+    const std::vector<Value>& values,
+    const Error& error,
+    double tolerance)
+{
+    size_t count = std::min(times.size(), values.size());
+    std::vector<size_t> keptKeys;
+    if (0 == count)
+        return keptKeys;
+    keptKeys.push_back(0);
+    size_t anchor = 0;
+    for (size_t end = anchor + 2; end < count; ++end) {
+        // Extend the span from the last kept key as long as every key inside it is reproduced
+        double duration = times[end] - times[anchor];
+        for (size_t key = anchor + 1; key < end; ++key) {
+            double t = duration > 0.0 ? (times[key] - times[anchor]) / duration : 0.0;
+            if (error(values[anchor], values[end], t, values[key]) > tolerance) {
+                anchor = end - 1;
+                keptKeys.push_back(anchor);
+                break;
+            }
+        }
+    }
+    if (count > 1)
+        keptKeys.push_back(count - 1);
+    return keptKeys;
+}
+
+std::vector<size_t> reduceTranslationKeyframes(const std::vector<float>& times,
+    const std::vector<Vector3>& translations,
+    double tolerance)
+{
+    return reduceKeyframes(
+        times, translations, [](const Vector3& from, const Vector3& to, double t, const Vector3& value) {
+            return (from + (to - from) * t - value).length();
+        },
+        tolerance);
+}
+
+std::vector<size_t> reduceRotationKeyframes(const std::vector<float>& times,
+    const std::vector<Quaternion>& rotations,
+    double tolerance)
+{
+    return reduceKeyframes(
+        times, rotations, [](const Quaternion& from, const Quaternion& to, double t, const Quaternion& value) {
+            Quaternion interpolated = Quaternion::slerp(from, to, t);
+            double dot = std::abs(interpolated.w() * value.w() + interpolated.x() * value.x() + interpolated.y() * value.y() + interpolated.z() * value.z());
+            return 2.0 * std::acos(std::min(dot, 1.0));
+        },
+        tolerance);
+}
+
+}
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_ANIMATION_REDUCE_KEYFRAMES_H_
+#define DUST3D_ANIMATION_REDUCE_KEYFRAMES_H_
+
+#include <dust3d/base/quaternion.h>
+#include <dust3d/base/vector3.h>
+#include <vector>
+
+namespace dust3d {
+
+// Baked channels are reduced to the keys that linear interpolation needs to stay within tolerance
+// of every dropped key. The first and the last key are always kept, so a constant channel collapses
+// to two keys and the clip keeps its duration. The returned indices are in ascending order.
+
+// Tolerance is the distance to the interpolated translation
+std::vector<size_t> reduceTranslationKeyframes(const std::vector<float>& times,
+    const std::vector<Vector3>& translations,
+    double tolerance);
+
+// Tolerance is the angle in radians to the slerp interpolated rotation
+std::vector<size_t> reduceRotationKeyframes(const std::vector<float>& times,
+    const std::vector<Quaternion>& rotations,
+    double tolerance);
+
+}
+
+#endif
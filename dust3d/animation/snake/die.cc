@@ -162,8 +162,7 @@ namespace snake {
         double jawOpenDeg = parameters.getValue("jawOpen", 63.0);
         double jawOpenMax = jawOpenDeg * (Math::Pi / 180.0);
         animationClip.durationSeconds = durationSeconds;
-        animationClip.frames.clear();
-        animationClip.frames.resize(frameCount);
+        animationClip.resizeFrames(frameCount);
 
         for (int frame = 0; frame < frameCount; ++frame) {
             double tNormalized = static_cast<double>(frame) / static_cast<double>(std::max(1, frameCount - 1));
@@ -199,16 +198,16 @@ namespace snake {
 
             auto& frameData = animationClip.frames[frame];
             frameData.time = static_cast<float>(tNormalized) * durationSeconds;
-            frameData.boneWorldTransforms = boneWorldTransforms;
+            frameData.boneWorldTransforms.assign(boneWorldTransforms);
             for (const auto& bone : bones) {
                 if (bone.name == "Jaw") {
                     Matrix4x4 jawSkinMat = bodyRollMat;
                     jawSkinMat.translate(bone.headPos);
                     jawSkinMat.rotate(sideDir, jawOpenAngle);
                     jawSkinMat.translate(bone.headPos * -1.0);
-                    frameData.boneSkinMatrices[bone.name] = jawSkinMat;
+                    frameData.boneSkinMatrices.set(bone.name, jawSkinMat);
                 } else {
-                    frameData.boneSkinMatrices[bone.name] = bodyRollMat;
+                    frameData.boneSkinMatrices.set(bone.name, bodyRollMat);
                 }
             }
         }
@@ -27,184 +27,248 @@
 
 namespace dust3d {
 
-float SoundEventDetector::getBoneY(const BoneAnimationFrame& frame, const std::string& boneName)
+std::vector<SoundEvent> SoundEventDetector::detect(
+    const RigAnimationClip& clip,
+    const std::string& animationType)
 {
-    auto it = frame.boneWorldTransforms.find(boneName);
-    if (it == frame.boneWorldTransforms.end())
-        return 0.0f;
-    return static_cast<float>(it->second.constData()[Matrix4x4::M31]);
+    SoundEventDetector detector;
+    return detector.update(clip, animationType);
 }
 
-float SoundEventDetector::getBoneX(const BoneAnimationFrame& frame, const std::string& boneName)
+std::vector<SoundEvent> SoundEventDetector::detect(
+    const RigAnimationClip& clip,
+    const std::string& animationType,
+    const AnimationParams& parameters)
 {
-    auto it = frame.boneWorldTransforms.find(boneName);
-    if (it == frame.boneWorldTransforms.end())
-        return 0.0f;
-    return static_cast<float>(it->second.constData()[Matrix4x4::M30]);
+    SoundEventDetector detector;
+    return detector.update(clip, animationType, parameters);
 }
 
-float SoundEventDetector::getBoneZ(const BoneAnimationFrame& frame, const std::string& boneName)
+std::vector<SoundEvent> SoundEventDetector::update(
+    const RigAnimationClip& clip,
+    const std::string& animationType,
+    const AnimationParams& parameters)
 {
-    auto it = frame.boneWorldTransforms.find(boneName);
-    if (it == frame.boneWorldTransforms.end())
-        return 0.0f;
-    return static_cast<float>(it->second.constData()[Matrix4x4::M32]);
+    if (clip.frames.empty())
+        return {};
+
+    m_tracks = BonePositionTracks(clip);
+    m_durationSeconds = clip.durationSeconds;
+    return detectEvents(animationType, parameters);
 }
 
-std::vector<SoundEvent> SoundEventDetector::detectHandRelease(
-    const RigAnimationClip& clip,
-    const std::string& boneName)
+std::vector<SoundEvent> SoundEventDetector::cachedDetection(const std::string& key,
+    const std::vector<std::string>& boneNames,
+    const std::function<std::vector<SoundEvent>()>& detection)
 {
-    std::vector<SoundEvent> events;
-    if (clip.frames.size() < 3)
-        return events;
+    std::vector<size_t> boneIndices;
+    boneIndices.reserve(boneNames.size());
+    for (const auto& name : boneNames)
+        boneIndices.push_back(m_tracks.boneIndex(name));
+    std::vector<double> signature = m_tracks.signature(boneIndices);
+
+    auto findCache = m_cache.find(key);
+    if (findCache != m_cache.end() && findCache->second.signature == signature)
+        return findCache->second.events;
+
+    auto events = detection();
+    m_cache[key] = CachedDetection { std::move(signature), events };
+    return events;
+}
 
-    // Compute per-frame 3-D speed of the bone
-    std::vector<float> speed(clip.frames.size(), 0.0f);
-    for (size_t i = 1; i < clip.frames.size(); ++i) {
-        float dt = clip.frames[i].time - clip.frames[i - 1].time;
+std::vector<float> SoundEventDetector::boneSpeeds(size_t boneIndex) const
+{
+    // Per-frame 3-D speed of the bone
+    size_t frameCount = m_tracks.frameCount();
+    const double* x = m_tracks.x(boneIndex);
+    const double* y = m_tracks.y(boneIndex);
+    const double* z = m_tracks.z(boneIndex);
+    std::vector<float> speed(frameCount, 0.0f);
+    for (size_t i = 1; i < frameCount; ++i) {
+        float dt = m_tracks.time(i) - m_tracks.time(i - 1);
         if (dt < 1e-6f)
             continue;
-        float dx = getBoneX(clip.frames[i], boneName) - getBoneX(clip.frames[i - 1], boneName);
-        float dy = getBoneY(clip.frames[i], boneName) - getBoneY(clip.frames[i - 1], boneName);
-        float dz = getBoneZ(clip.frames[i], boneName) - getBoneZ(clip.frames[i - 1], boneName);
+        float dx = static_cast<float>(x[i]) - static_cast<float>(x[i - 1]);
+        float dy = static_cast<float>(y[i]) - static_cast<float>(y[i - 1]);
+        float dz = static_cast<float>(z[i]) - static_cast<float>(z[i - 1]);
         speed[i] = std::sqrt(dx * dx + dy * dy + dz * dz) / dt;
     }
+    return speed;
+}
 
-    float maxSpeed = *std::max_element(speed.begin(), speed.end());
-    if (maxSpeed < 1e-6f)
-        return events;
+std::vector<SoundEvent> SoundEventDetector::detectHandRelease(const std::string& boneName)
+{
+    return cachedDetection("release:" + boneName, { boneName }, [&]() {
+        std::vector<SoundEvent> events;
+        if (m_tracks.frameCount() < 3)
+            return events;
 
-    // Fire at the frame of largest deceleration (speed drops fastest) after peak.
-    // This is the wrist-snap / projectile-release moment.
-    size_t peakIdx = std::max_element(speed.begin(), speed.end()) - speed.begin();
-    float maxDecel = 0.0f;
-    size_t eventIdx = peakIdx;
-    for (size_t i = peakIdx + 1; i < speed.size(); ++i) {
-        float dt = clip.frames[i].time - clip.frames[i - 1].time;
-        if (dt < 1e-6f)
-            continue;
-        float decel = (speed[i - 1] - speed[i]) / dt;
-        if (decel > maxDecel) {
-            maxDecel = decel;
-            eventIdx = i;
+        std::vector<float> speed = boneSpeeds(m_tracks.boneIndex(boneName));
+
+        float maxSpeed = *std::max_element(speed.begin(), speed.end());
+        if (maxSpeed < 1e-6f)
+            return events;
+
+        // Fire at the frame of largest deceleration (speed drops fastest) after peak.
+        // This is the wrist-snap / projectile-release moment.
+        size_t peakIdx = std::max_element(speed.begin(), speed.end()) - speed.begin();
+        float maxDecel = 0.0f;
+        size_t eventIdx = peakIdx;
+        for (size_t i = peakIdx + 1; i < speed.size(); ++i) {
+            float dt = m_tracks.time(i) - m_tracks.time(i - 1);
+            if (dt < 1e-6f)
+                continue;
+            float decel = (speed[i - 1] - speed[i]) / dt;
+            if (decel > maxDecel) {
+                maxDecel = decel;
+                eventIdx = i;
+            }
         }
-    }
 
-    SoundEvent ev;
-    ev.timeSeconds = clip.frames[eventIdx].time;
-    ev.boneName = boneName;
-    ev.intensity = std::min(1.0f, speed[peakIdx] / (maxSpeed * 0.8f));
-    events.push_back(ev);
-    return events;
+        SoundEvent ev;
+        ev.timeSeconds = m_tracks.time(eventIdx);
+        ev.boneName = boneName;
+        ev.intensity = std::min(1.0f, speed[peakIdx] / (maxSpeed * 0.8f));
+        events.push_back(ev);
+        return events;
+    });
 }
 
-std::vector<SoundEvent> SoundEventDetector::detectHandSettle(
-    const RigAnimationClip& clip,
-    const std::string& boneName)
+std::vector<SoundEvent> SoundEventDetector::detectHandSettle(const std::string& boneName)
 {
-    std::vector<SoundEvent> events;
-    if (clip.frames.size() < 3)
-        return events;
+    return cachedDetection("settle:" + boneName, { boneName }, [&]() {
+        std::vector<SoundEvent> events;
+        if (m_tracks.frameCount() < 3)
+            return events;
 
-    // Compute per-frame 3-D speed
-    std::vector<float> speed(clip.frames.size(), 0.0f);
-    for (size_t i = 1; i < clip.frames.size(); ++i) {
-        float dt = clip.frames[i].time - clip.frames[i - 1].time;
-        if (dt < 1e-6f)
-            continue;
-        float dx = getBoneX(clip.frames[i], boneName) - getBoneX(clip.frames[i - 1], boneName);
-        float dy = getBoneY(clip.frames[i], boneName) - getBoneY(clip.frames[i - 1], boneName);
-        float dz = getBoneZ(clip.frames[i], boneName) - getBoneZ(clip.frames[i - 1], boneName);
-        speed[i] = std::sqrt(dx * dx + dy * dy + dz * dz) / dt;
-    }
+        std::vector<float> speed = boneSpeeds(m_tracks.boneIndex(boneName));
 
-    float maxSpeed = *std::max_element(speed.begin(), speed.end());
-    if (maxSpeed < 1e-6f)
-        return events;
+        float maxSpeed = *std::max_element(speed.begin(), speed.end());
+        if (maxSpeed < 1e-6f)
+            return events;
 
-    // Find peak speed frame, then find first frame after where speed falls
-    // below 15% of peak — that is the "hands locked" / channel-onset moment.
-    size_t peakIdx = std::max_element(speed.begin(), speed.end()) - speed.begin();
-    float settleThreshold = maxSpeed * 0.15f;
-    size_t settleIdx = peakIdx;
-    for (size_t i = peakIdx + 1; i < speed.size(); ++i) {
-        if (speed[i] < settleThreshold) {
-            settleIdx = i;
-            break;
+        // Find peak speed frame, then find first frame after where speed falls
+        // below 15% of peak — that is the "hands locked" / channel-onset moment.
+        size_t peakIdx = std::max_element(speed.begin(), speed.end()) - speed.begin();
+        float settleThreshold = maxSpeed * 0.15f;
+        size_t settleIdx = peakIdx;
+        for (size_t i = peakIdx + 1; i < speed.size(); ++i) {
+            if (speed[i] < settleThreshold) {
+                settleIdx = i;
+                break;
+            }
         }
-    }
 
-    if (settleIdx == peakIdx)
-        return events; // hands never settle (shouldn't happen in a channel anim)
+        if (settleIdx == peakIdx)
+            return events; // hands never settle (shouldn't happen in a channel anim)
 
-    SoundEvent ev;
-    ev.timeSeconds = clip.frames[settleIdx].time;
-    ev.boneName = boneName;
-    ev.intensity = std::min(1.0f, maxSpeed / (maxSpeed * 0.8f)); // full intensity onset
-    events.push_back(ev);
-    return events;
+        SoundEvent ev;
+        ev.timeSeconds = m_tracks.time(settleIdx);
+        ev.boneName = boneName;
+        ev.intensity = std::min(1.0f, maxSpeed / (maxSpeed * 0.8f)); // full intensity onset
+        events.push_back(ev);
+        return events;
+    });
 }
 
-std::vector<SoundEvent> SoundEventDetector::detectFootContacts(
-    const RigAnimationClip& clip,
-    const std::vector<std::string>& footBones)
+std::vector<SoundEvent> SoundEventDetector::detectFootContacts(const std::vector<std::string>& footBones)
 {
-    std::vector<SoundEvent> events;
-
-    if (clip.frames.size() < 3)
-        return events;
+    size_t frameCount = m_tracks.frameCount();
+    if (frameCount < 3)
+        return {};
 
-    for (const auto& boneName : footBones) {
-        // Find the minimum Y across all frames to establish ground level
+    struct FootState {
+        size_t footIndex;
+        const double* y;
+        std::vector<double> signature;
         float minY = 1e10f;
         float maxY = -1e10f;
-        for (const auto& frame : clip.frames) {
-            float y = getBoneY(frame, boneName);
-            if (y < minY)
-                minY = y;
-            if (y > maxY)
-                maxY = y;
+        float range = 0.0f;
+        float threshold = 0.0f;
+        bool wasAbove = false;
+    };
+
+    // Feet whose tracks did not change keep their previous contacts
+    std::vector<std::vector<SoundEvent>> footEvents(footBones.size());
+    std::vector<FootState> feet;
+    for (size_t k = 0; k < footBones.size(); ++k) {
+        size_t boneIndex = m_tracks.boneIndex(footBones[k]);
+        std::vector<double> signature = m_tracks.signature({ boneIndex });
+        auto findCache = m_cache.find("contact:" + footBones[k]);
+        if (findCache != m_cache.end() && findCache->second.signature == signature) {
+            footEvents[k] = findCache->second.events;
+            continue;
         }
+        FootState foot;
+        foot.footIndex = k;
+        foot.y = m_tracks.y(boneIndex);
+        foot.signature = std::move(signature);
+        feet.push_back(std::move(foot));
+    }
 
-        float range = maxY - minY;
-        if (range < 1e-6f)
-            continue;
+    if (!feet.empty()) {
+        // Find the minimum Y across all frames to establish ground level
+        for (size_t i = 0; i < frameCount; ++i) {
+            for (auto& foot : feet) {
+                float y = static_cast<float>(foot.y[i]);
+                if (y < foot.minY)
+                    foot.minY = y;
+                if (y > foot.maxY)
+                    foot.maxY = y;
+            }
+        }
 
         // Ground contact threshold: within 15% of minimum
-        float threshold = minY + range * 0.15f;
+        std::vector<FootState*> movingFeet;
+        for (auto& foot : feet) {
+            foot.range = foot.maxY - foot.minY;
+            if (foot.range < 1e-6f)
+                continue;
+            foot.threshold = foot.minY + foot.range * 0.15f;
+            foot.wasAbove = static_cast<float>(foot.y[0]) > foot.threshold;
+            movingFeet.push_back(&foot);
+        }
 
         // Detect downward zero-crossings of (y - threshold)
         // i.e., frames where foot goes from above threshold to at/below
-        bool wasAbove = getBoneY(clip.frames[0], boneName) > threshold;
-
-        for (size_t i = 1; i < clip.frames.size(); ++i) {
-            float y = getBoneY(clip.frames[i], boneName);
-            bool isAbove = y > threshold;
-
-            if (wasAbove && !isAbove) {
-                // Contact event detected
-                SoundEvent event;
-                event.timeSeconds = clip.frames[i].time;
-                event.boneName = boneName;
-
-                // Intensity based on downward velocity
-                float prevY = getBoneY(clip.frames[i - 1], boneName);
-                float dt = clip.frames[i].time - clip.frames[i - 1].time;
-                if (dt > 0.0f) {
-                    float velocity = (prevY - y) / dt;
-                    // Normalize velocity to 0-1 range, higher velocity = louder
-                    event.intensity = std::min(1.0f, std::max(0.2f, velocity / (range * 10.0f)));
-                } else {
-                    event.intensity = 0.5f;
+        for (size_t i = 1; i < frameCount; ++i) {
+            float dt = m_tracks.time(i) - m_tracks.time(i - 1);
+            for (auto* foot : movingFeet) {
+                float y = static_cast<float>(foot->y[i]);
+                bool isAbove = y > foot->threshold;
+
+                if (foot->wasAbove && !isAbove) {
+                    // Contact event detected
+                    SoundEvent event;
+                    event.timeSeconds = m_tracks.time(i);
+                    event.boneName = footBones[foot->footIndex];
+
+                    // Intensity based on downward velocity
+                    float prevY = static_cast<float>(foot->y[i - 1]);
+                    if (dt > 0.0f) {
+                        float velocity = (prevY - y) / dt;
+                        // Normalize velocity to 0-1 range, higher velocity = louder
+                        event.intensity = std::min(1.0f, std::max(0.2f, velocity / (foot->range * 10.0f)));
+                    } else {
+                        event.intensity = 0.5f;
+                    }
+
+                    footEvents[foot->footIndex].push_back(event);
                 }
-
-                events.push_back(event);
+                foot->wasAbove = isAbove;
             }
-            wasAbove = isAbove;
+        }
+
+        for (auto& foot : feet) {
+            const auto& name = footBones[foot.footIndex];
+            m_cache["contact:" + name] = CachedDetection { std::move(foot.signature), footEvents[foot.footIndex] };
         }
     }
 
+    std::vector<SoundEvent> events;
+    for (const auto& it : footEvents)
+        events.insert(events.end(), it.begin(), it.end());
+
     // Sort by time
     std::sort(events.begin(), events.end(), [](const SoundEvent& a, const SoundEvent& b) {
         return a.timeSeconds < b.timeSeconds;
@@ -213,79 +277,117 @@ std::vector<SoundEvent> SoundEventDetector::detectFootContacts(
     return events;
 }
 
-std::vector<SoundEvent> SoundEventDetector::detectBodyImpact(
-    const RigAnimationClip& clip,
-    const std::string& rootBone)
+std::vector<SoundEvent> SoundEventDetector::detectBodyImpact(const std::string& rootBone)
 {
-    std::vector<SoundEvent> events;
+    return cachedDetection("impact:" + rootBone, { rootBone }, [&]() {
+        std::vector<SoundEvent> events;
 
-    if (clip.frames.size() < 3)
-        return events;
+        size_t frameCount = m_tracks.frameCount();
+        if (frameCount < 3)
+            return events;
 
-    // Detect sudden downward acceleration of the root bone (body collapse/impact)
-    std::vector<float> yPositions;
-    yPositions.reserve(clip.frames.size());
-    for (const auto& frame : clip.frames) {
-        yPositions.push_back(getBoneY(frame, rootBone));
-    }
+        // Detect sudden downward acceleration of the root bone (body collapse/impact)
+        const double* track = m_tracks.y(m_tracks.boneIndex(rootBone));
+        std::vector<float> yPositions(track, track + frameCount);
 
-    float maxY = *std::max_element(yPositions.begin(), yPositions.end());
-    float minY = *std::min_element(yPositions.begin(), yPositions.end());
-    float range = maxY - minY;
-    if (range < 1e-6f)
-        return events;
+        float maxY = *std::max_element(yPositions.begin(), yPositions.end());
+        float minY = *std::min_element(yPositions.begin(), yPositions.end());
+        float range = maxY - minY;
+        if (range < 1e-6f)
+            return events;
 
-    // Look for frames where second derivative is large (sudden deceleration = impact)
-    for (size_t i = 2; i < clip.frames.size(); ++i) {
-        float dt1 = clip.frames[i].time - clip.frames[i - 1].time;
-        float dt0 = clip.frames[i - 1].time - clip.frames[i - 2].time;
-        if (dt1 < 1e-6f || dt0 < 1e-6f)
-            continue;
+        // Look for frames where second derivative is large (sudden deceleration = impact)
+        for (size_t i = 2; i < frameCount; ++i) {
+            float dt1 = m_tracks.time(i) - m_tracks.time(i - 1);
+            float dt0 = m_tracks.time(i - 1) - m_tracks.time(i - 2);
+            if (dt1 < 1e-6f || dt0 < 1e-6f)
+                continue;
+
+            float v1 = (yPositions[i] - yPositions[i - 1]) / dt1;
+            float v0 = (yPositions[i - 1] - yPositions[i - 2]) / dt0;
+            float accel = (v1 - v0) / ((dt0 + dt1) * 0.5f);
 
-        float v1 = (yPositions[i] - yPositions[i - 1]) / dt1;
-        float v0 = (yPositions[i - 1] - yPositions[i - 2]) / dt0;
-        float accel = (v1 - v0) / ((dt0 + dt1) * 0.5f);
-
-        // Large upward acceleration after downward motion = ground impact
-        if (accel > range * 5.0f && v0 < 0.0f) {
-            SoundEvent event;
-            event.timeSeconds = clip.frames[i].time;
-            event.boneName = rootBone;
-            event.intensity = std::min(1.0f, std::max(0.3f, std::abs(v0) / (range * 5.0f)));
-            events.push_back(event);
+            // Large upward acceleration after downward motion = ground impact
+            if (accel > range * 5.0f && v0 < 0.0f) {
+                SoundEvent event;
+                event.timeSeconds = m_tracks.time(i);
+                event.boneName = rootBone;
+                event.intensity = std::min(1.0f, std::max(0.3f, std::abs(v0) / (range * 5.0f)));
+                events.push_back(event);
+            }
         }
-    }
 
-    return events;
+        return events;
+    });
 }
 
-std::vector<SoundEvent> SoundEventDetector::detect(
-    const RigAnimationClip& clip,
-    const std::string& animationType)
+std::vector<SoundEvent> SoundEventDetector::detectWhoosh(const std::string& boneName)
 {
-    if (clip.frames.empty())
-        return {};
+    return cachedDetection("whoosh:" + boneName, { boneName }, [&]() {
+        std::vector<SoundEvent> events;
+        if (m_tracks.frameCount() < 3)
+            return events;
+
+        // Track bone velocity magnitude and emit a whoosh event when velocity
+        // exceeds a threshold. The whoosh duration spans the high-velocity window.
+        std::vector<float> speed = boneSpeeds(m_tracks.boneIndex(boneName));
+
+        // Find peak velocity and threshold at 30% of peak
+        float peakSpeed = *std::max_element(speed.begin(), speed.end());
+        if (peakSpeed <= 1e-4f)
+            return events;
+        float threshold = peakSpeed * 0.3f;
+        // Find the first window where speed exceeds threshold
+        int whooshStart = -1;
+        int whooshEnd = -1;
+        for (size_t i = 1; i < speed.size(); ++i) {
+            if (speed[i] > threshold && whooshStart < 0)
+                whooshStart = static_cast<int>(i);
+            if (whooshStart >= 0 && speed[i] > threshold)
+                whooshEnd = static_cast<int>(i);
+        }
+        if (whooshStart >= 0 && whooshEnd > whooshStart) {
+            SoundEvent whoosh;
+            whoosh.timeSeconds = m_tracks.time(whooshStart);
+            whoosh.boneName = boneName;
+            whoosh.isWhoosh = true;
+            whoosh.whooshDuration = m_tracks.time(whooshEnd) - m_tracks.time(whooshStart);
+            whoosh.intensity = std::min(1.0f, peakSpeed / (peakSpeed + 1.0f)); // normalized
+            events.push_back(whoosh);
+        }
+        return events;
+    });
+}
+
+std::vector<SoundEvent> SoundEventDetector::detectEvents(
+    const std::string& animationType,
+    const AnimationParams& parameters)
+{
+    size_t frameCount = m_tracks.frameCount();
+    auto sortByTime = [](std::vector<SoundEvent>& events) {
+        std::sort(events.begin(), events.end(), [](const SoundEvent& a, const SoundEvent& b) {
+            return a.timeSeconds < b.timeSeconds;
+        });
+    };
 
     // Biped locomotion: detect foot contacts
     if (animationType == "BipedWalk" || animationType == "BipedRun") {
-        return detectFootContacts(clip, { "leftFoot", "rightFoot", "LeftFoot", "RightFoot", "leftToe", "rightToe", "LeftToe", "RightToe" });
+        return detectFootContacts({ "leftFoot", "rightFoot", "LeftFoot", "RightFoot", "leftToe", "rightToe", "LeftToe", "RightToe" });
     }
 
     // Biped jump: detect landing impact
     if (animationType == "BipedJump") {
-        auto footEvents = detectFootContacts(clip, { "leftFoot", "rightFoot", "LeftFoot", "RightFoot" });
-        auto bodyEvents = detectBodyImpact(clip, "hip");
+        auto footEvents = detectFootContacts({ "leftFoot", "rightFoot", "LeftFoot", "RightFoot" });
+        auto bodyEvents = detectBodyImpact("hip");
         footEvents.insert(footEvents.end(), bodyEvents.begin(), bodyEvents.end());
-        std::sort(footEvents.begin(), footEvents.end(), [](const SoundEvent& a, const SoundEvent& b) {
-            return a.timeSeconds < b.timeSeconds;
-        });
+        sortByTime(footEvents);
         return footEvents;
     }
 
     // Biped hand/fist strikes: detect hand impact at moment of hit
     if (animationType == "BipedStab") {
-        auto rightEvents = detectBodyImpact(clip, "RightHand");
-        auto leftEvents = detectBodyImpact(clip, "LeftHand");
+        auto rightEvents = detectBodyImpact("RightHand");
+        auto leftEvents = detectBodyImpact("LeftHand");
         // Prioritize right hand (primary striking hand)
         if (!rightEvents.empty()) {
             for (auto& e : rightEvents)
@@ -297,22 +399,20 @@ std::vector<SoundEvent> SoundEventDetector::detect(
 
     // Biped slam: both hands drive down — detect peak downward velocity of hands
     if (animationType == "BipedSlam") {
-        auto rightEvents = detectBodyImpact(clip, "RightHand");
-        auto leftEvents = detectBodyImpact(clip, "LeftHand");
+        auto rightEvents = detectBodyImpact("RightHand");
+        auto leftEvents = detectBodyImpact("LeftHand");
         rightEvents.insert(rightEvents.end(), leftEvents.begin(), leftEvents.end());
         // Boost intensity for two-handed smash
         for (auto& e : rightEvents)
             e.intensity = std::min(1.0f, e.intensity * 1.5f);
-        std::sort(rightEvents.begin(), rightEvents.end(), [](const SoundEvent& a, const SoundEvent& b) {
-            return a.timeSeconds < b.timeSeconds;
-        });
+        sortByTime(rightEvents);
         return rightEvents;
     }
 
     // Biped cast: wrist-snap / spell-release on the casting hand
     if (animationType == "BipedCast") {
-        auto rightEvents = detectHandRelease(clip, "RightHand");
-        auto leftEvents = detectHandRelease(clip, "LeftHand");
+        auto rightEvents = detectHandRelease("RightHand");
+        auto leftEvents = detectHandRelease("LeftHand");
         // Use whichever hand has the stronger event; boost intensity for spell fx
         auto& best = (!rightEvents.empty() && (leftEvents.empty() || rightEvents[0].intensity >= leftEvents[0].intensity))
             ? rightEvents
@@ -324,13 +424,11 @@ std::vector<SoundEvent> SoundEventDetector::detect(
 
     // Biped channel: energy-onset sound when hands lock into the hold pose
     if (animationType == "BipedChannel") {
-        auto rightEvents = detectHandSettle(clip, "RightHand");
-        auto leftEvents = detectHandSettle(clip, "LeftHand");
+        auto rightEvents = detectHandSettle("RightHand");
+        auto leftEvents = detectHandSettle("LeftHand");
         // Merge both hands — both locking simultaneously is the channel start
         rightEvents.insert(rightEvents.end(), leftEvents.begin(), leftEvents.end());
-        std::sort(rightEvents.begin(), rightEvents.end(), [](const SoundEvent& a, const SoundEvent& b) {
-            return a.timeSeconds < b.timeSeconds;
-        });
+        sortByTime(rightEvents);
         // Keep only the earliest event (the onset impulse)
         if (rightEvents.size() > 1)
             rightEvents.resize(1);
@@ -339,26 +437,56 @@ std::vector<SoundEvent> SoundEventDetector::detect(
         return rightEvents;
     }
 
-    // Biped roar: foot stomp impact + vocal roar sound
+    // Biped roar: parameter-driven foot stomp impact
     if (animationType == "BipedRoar") {
-        // Delegate to parameter-aware overload with defaults
-        AnimationParams defaults;
-        return detect(clip, animationType, defaults);
+        std::vector<SoundEvent> events;
+
+        // Foot stomp sound from left foot contact
+        float stompVolume = static_cast<float>(parameters.getValue("stompVolume", 1.0));
+        auto stompEvents = detectFootContacts({ "LeftFoot", "leftFoot" });
+        for (auto& e : stompEvents) {
+            e.intensity = std::min(1.0f, e.intensity * 1.5f * stompVolume);
+        }
+        events.insert(events.end(), stompEvents.begin(), stompEvents.end());
+
+        sortByTime(events);
+        return events;
     }
 
-    // Quadruped roar: front paw stomp impact + vocal roar sound
+    // Quadruped roar: parameter-driven front paw stomp, body jolt and burst whoosh
     if (animationType == "QuadrupedRoar") {
-        AnimationParams defaults;
-        return detect(clip, animationType, defaults);
+        std::vector<SoundEvent> events;
+
+        // Front paw stomp sounds
+        float stompFactor = static_cast<float>(parameters.getValue("stompFactor", 1.0));
+        auto stompEvents = detectFootContacts({ "FrontLeftFoot", "FrontRightFoot" });
+        for (auto& e : stompEvents) {
+            e.intensity = std::min(1.0f, e.intensity * 1.5f * stompFactor);
+        }
+        events.insert(events.end(), stompEvents.begin(), stompEvents.end());
+
+        // Body jolt impact from the explosive burst
+        auto bodyEvents = detectBodyImpact("Pelvis");
+        for (auto& e : bodyEvents) {
+            e.intensity = std::min(1.0f, e.intensity * 1.2f * stompFactor);
+        }
+        events.insert(events.end(), bodyEvents.begin(), bodyEvents.end());
+
+        // Whoosh: head velocity during the burst (air displacement from roar)
+        auto whooshEvents = detectWhoosh("Head");
+        events.insert(events.end(), whooshEvents.begin(), whooshEvents.end());
+
+        sortByTime(events);
+        return events;
     }
 
     // Biped/Quadruped die: detect body impact
     if (animationType == "BipedDie" || animationType == "QuadrupedDie" || animationType == "BirdDie" || animationType == "InsectDie" || animationType == "SpiderDie") {
-        auto events = detectBodyImpact(clip, "hip");
+        auto events = detectBodyImpact("hip");
         if (events.empty()) {
             // Try root bone alternatives
             for (const auto& name : { "Hip", "root", "Root", "pelvis", "Pelvis", "body", "Body" }) {
-                events = detectBodyImpact(clip, name);
+                events = detectBodyImpact(name);
                 if (!events.empty())
                     break;
             }
@@ -368,76 +496,23 @@ std::vector<SoundEvent> SoundEventDetector::detect(
 
     // Quadruped locomotion
     if (animationType == "QuadrupedWalk" || animationType == "QuadrupedRun") {
-        return detectFootContacts(clip, { "FrontLeftFoot", "FrontRightFoot", "BackLeftFoot", "BackRightFoot", "leftFrontFoot", "rightFrontFoot", "leftBackFoot", "rightBackFoot", "LeftFrontFoot", "RightFrontFoot", "LeftBackFoot", "RightBackFoot", "leftFrontToe", "rightFrontToe", "leftBackToe", "rightBackToe" });
+        return detectFootContacts({ "FrontLeftFoot", "FrontRightFoot", "BackLeftFoot", "BackRightFoot", "leftFrontFoot", "rightFrontFoot", "leftBackFoot", "rightBackFoot", "LeftFrontFoot", "RightFrontFoot", "LeftBackFoot", "RightBackFoot", "leftFrontToe", "rightFrontToe", "leftBackToe", "rightBackToe" });
     }
 
     // Quadruped attack: detect head impact, front foot stomp, and charge whoosh
     if (animationType == "QuadrupedAttack") {
-        auto headEvents = detectBodyImpact(clip, "Head");
-        auto footEvents = detectFootContacts(clip, { "FrontLeftFoot", "FrontRightFoot" });
+        auto headEvents = detectBodyImpact("Head");
+        auto footEvents = detectFootContacts({ "FrontLeftFoot", "FrontRightFoot" });
         // Head impact is the primary sound; boost its intensity
         for (auto& e : headEvents)
             e.intensity = std::min(1.0f, e.intensity * 1.5f);
         headEvents.insert(headEvents.end(), footEvents.begin(), footEvents.end());
 
-        // Whoosh detection: track head velocity magnitude and emit a whoosh
-        // event when velocity exceeds a threshold (charge-to-strike transition).
-        // The whoosh duration spans the high-velocity window.
-        if (clip.frames.size() >= 3) {
-            std::vector<float> headSpeed(clip.frames.size(), 0.0f);
-            for (size_t i = 1; i < clip.frames.size(); ++i) {
-                float dt = clip.frames[i].time - clip.frames[i - 1].time;
-                if (dt < 1e-6f)
-                    continue;
-                float y0 = getBoneY(clip.frames[i - 1], "Head");
-                float y1 = getBoneY(clip.frames[i], "Head");
-                // Also get X and Z for full 3D velocity
-                auto getX = [](const BoneAnimationFrame& f, const std::string& name) -> float {
-                    auto it = f.boneWorldTransforms.find(name);
-                    if (it == f.boneWorldTransforms.end())
-                        return 0.0f;
-                    return static_cast<float>(it->second.constData()[Matrix4x4::M30]);
-                };
-                auto getZ = [](const BoneAnimationFrame& f, const std::string& name) -> float {
-                    auto it = f.boneWorldTransforms.find(name);
-                    if (it == f.boneWorldTransforms.end())
-                        return 0.0f;
-                    return static_cast<float>(it->second.constData()[Matrix4x4::M32]);
-                };
-                float dx = getX(clip.frames[i], "Head") - getX(clip.frames[i - 1], "Head");
-                float dy = y1 - y0;
-                float dz = getZ(clip.frames[i], "Head") - getZ(clip.frames[i - 1], "Head");
-                headSpeed[i] = std::sqrt(dx * dx + dy * dy + dz * dz) / dt;
-            }
-
-            // Find peak velocity and threshold at 30% of peak
-            float peakSpeed = *std::max_element(headSpeed.begin(), headSpeed.end());
-            if (peakSpeed > 1e-4f) {
-                float threshold = peakSpeed * 0.3f;
-                // Find the first window where speed exceeds threshold
-                int whooshStart = -1;
-                int whooshEnd = -1;
-                for (size_t i = 1; i < headSpeed.size(); ++i) {
-                    if (headSpeed[i] > threshold && whooshStart < 0)
-                        whooshStart = static_cast<int>(i);
-                    if (whooshStart >= 0 && headSpeed[i] > threshold)
-                        whooshEnd = static_cast<int>(i);
-                }
-                if (whooshStart >= 0 && whooshEnd > whooshStart) {
-                    SoundEvent whoosh;
-                    whoosh.timeSeconds = clip.frames[whooshStart].time;
-                    whoosh.boneName = "Head";
-                    whoosh.isWhoosh = true;
-                    whoosh.whooshDuration = clip.frames[whooshEnd].time - clip.frames[whooshStart].time;
-                    whoosh.intensity = std::min(1.0f, peakSpeed / (peakSpeed + 1.0f)); // normalized
-                    headEvents.push_back(whoosh);
-                }
-            }
-        }
+        // Charge-to-strike transition of the head
+        auto whooshEvents = detectWhoosh("Head");
+        headEvents.insert(headEvents.end(), whooshEvents.begin(), whooshEvents.end());
 
-        std::sort(headEvents.begin(), headEvents.end(), [](const SoundEvent& a, const SoundEvent& b) {
-            return a.timeSeconds < b.timeSeconds;
-        });
+        sortByTime(headEvents);
         return headEvents;
     }
 
@@ -445,19 +520,20 @@ std::vector<SoundEvent> SoundEventDetector::detect(
     if (animationType == "QuadrupedEat") {
         std::vector<SoundEvent> events;
         // Detect jaw closing events (chewing/biting sounds)
-        bool hasJaw = !clip.frames.empty() && clip.frames[0].boneWorldTransforms.count("Jaw");
-        if (hasJaw && clip.frames.size() >= 2) {
-            for (size_t i = 1; i < clip.frames.size(); ++i) {
-                float y0 = getBoneY(clip.frames[i - 1], "Jaw");
-                float y1 = getBoneY(clip.frames[i], "Jaw");
-                float dt = clip.frames[i].time - clip.frames[i - 1].time;
+        size_t jawIndex = m_tracks.boneIndex("Jaw");
+        if (m_tracks.has(jawIndex, 0) && frameCount >= 2) {
+            const double* jawY = m_tracks.y(jawIndex);
+            for (size_t i = 1; i < frameCount; ++i) {
+                float y0 = static_cast<float>(jawY[i - 1]);
+                float y1 = static_cast<float>(jawY[i]);
+                float dt = m_tracks.time(i) - m_tracks.time(i - 1);
                 if (dt < 1e-6f)
                     continue;
                 // Jaw closing = jaw moving upward (positive Y velocity)
                 float velocity = (y1 - y0) / dt;
                 if (velocity > 0.01f) {
                     SoundEvent e;
-                    e.timeSeconds = clip.frames[i].time;
+                    e.timeSeconds = m_tracks.time(i);
                     e.boneName = "Jaw";
                     e.intensity = std::min(1.0f, velocity * 2.0f);
                     events.push_back(e);
@@ -465,14 +541,12 @@ std::vector<SoundEvent> SoundEventDetector::detect(
             }
         }
         // Also detect front foot movements (weight shifting)
-        auto footEvents = detectFootContacts(clip, { "FrontLeftFoot", "FrontRightFoot" });
+        auto footEvents = detectFootContacts({ "FrontLeftFoot", "FrontRightFoot" });
         for (auto& e : footEvents)
             e.intensity *= 0.3f; // subtle foot sounds
         events.insert(events.end(), footEvents.begin(), footEvents.end());
 
-        std::sort(events.begin(), events.end(), [](const SoundEvent& a, const SoundEvent& b) {
-            return a.timeSeconds < b.timeSeconds;
-        });
+        sortByTime(events);
         return events;
     }
 
@@ -481,21 +555,17 @@ std::vector<SoundEvent> SoundEventDetector::detect(
         std::vector<SoundEvent> events;
 
         // Primary flesh/body impact sound at the start of the clip
-        if (!clip.frames.empty()) {
-            SoundEvent fleshHit;
-            fleshHit.timeSeconds = clip.frames[0].time;
-            fleshHit.boneName = "Chest";
-            fleshHit.intensity = 0.9f;
-            events.push_back(fleshHit);
-        }
-
-        auto footEvents = detectFootContacts(clip, { "LeftFoot", "RightFoot" });
-        auto bodyEvents = detectBodyImpact(clip, "Hips");
+        SoundEvent fleshHit;
+        fleshHit.timeSeconds = m_tracks.time(0);
+        fleshHit.boneName = "Chest";
+        fleshHit.intensity = 0.9f;
+        events.push_back(fleshHit);
+
+        auto footEvents = detectFootContacts({ "LeftFoot", "RightFoot" });
+        auto bodyEvents = detectBodyImpact("Hips");
         events.insert(events.end(), footEvents.begin(), footEvents.end());
         events.insert(events.end(), bodyEvents.begin(), bodyEvents.end());
-        std::sort(events.begin(), events.end(), [](const SoundEvent& a, const SoundEvent& b) {
-            return a.timeSeconds < b.timeSeconds;
-        });
+        sortByTime(events);
         return events;
     }
 
@@ -504,55 +574,56 @@ std::vector<SoundEvent> SoundEventDetector::detect(
         std::vector<SoundEvent> events;
 
         // Primary flesh/body impact sound at the start of the clip — the hit landing
-        if (!clip.frames.empty()) {
-            SoundEvent fleshHit;
-            fleshHit.timeSeconds = clip.frames[0].time;
-            fleshHit.boneName = "Chest";
-            fleshHit.intensity = 0.9f;
-            events.push_back(fleshHit);
-        }
-
-        auto footEvents = detectFootContacts(clip, { "FrontLeftFoot", "FrontRightFoot", "BackLeftFoot", "BackRightFoot" });
-        auto bodyEvents = detectBodyImpact(clip, "Pelvis");
+        SoundEvent fleshHit;
+        fleshHit.timeSeconds = m_tracks.time(0);
+        fleshHit.boneName = "Chest";
+        fleshHit.intensity = 0.9f;
+        events.push_back(fleshHit);
+
+        auto footEvents = detectFootContacts({ "FrontLeftFoot", "FrontRightFoot", "BackLeftFoot", "BackRightFoot" });
+        auto bodyEvents = detectBodyImpact("Pelvis");
         events.insert(events.end(), footEvents.begin(), footEvents.end());
         events.insert(events.end(), bodyEvents.begin(), bodyEvents.end());
-        std::sort(events.begin(), events.end(), [](const SoundEvent& a, const SoundEvent& b) {
-            return a.timeSeconds < b.timeSeconds;
-        });
+        sortByTime(events);
         return events;
     }
 
     // Bird eat: detect beak ground contact
     if (animationType == "BirdEat") {
-        return detectFootContacts(clip, { "Beak", "Head" });
+        return detectFootContacts({ "Beak", "Head" });
     }
 
     // Bird walk/run: detect foot contacts
     if (animationType == "BirdWalk" || animationType == "BirdRun") {
-        return detectFootContacts(clip, { "LeftFoot", "RightFoot" });
+        return detectFootContacts({ "LeftFoot", "RightFoot" });
     }
 
     // Insect/Spider walk: detect leg contacts
     if (animationType == "InsectWalk" || animationType == "InsectForward" || animationType == "InsectFly" || animationType == "SpiderWalk" || animationType == "SpiderRun") {
         // Collect all bones that might be leg tips
         std::vector<std::string> legBones;
-        if (!clip.frames.empty()) {
-            for (const auto& pair : clip.frames[0].boneWorldTransforms) {
-                const auto& name = pair.first;
+        const auto& layout = m_tracks.layout();
+        if (nullptr != layout) {
+            for (size_t boneIndex = 0; boneIndex < layout->boneCount(); ++boneIndex) {
+                if (!m_tracks.has(boneIndex, 0))
+                    continue;
+                const auto& name = layout->boneName(boneIndex);
                 // Match leg tip bones by common naming patterns
                 if (name.find("Foot") != std::string::npos || name.find("foot") != std::string::npos || name.find("Tip") != std::string::npos || name.find("tip") != std::string::npos || name.find("Tarsus") != std::string::npos || name.find("tarsus") != std::string::npos || name.find("Tibia") != std::string::npos || name.find("tibia") != std::string::npos) {
                     legBones.push_back(name);
                 }
             }
+            std::sort(legBones.begin(), legBones.end());
+            legBones.erase(std::unique(legBones.begin(), legBones.end()), legBones.end());
         }
         if (!legBones.empty()) {
-            return detectFootContacts(clip, legBones);
+            return detectFootContacts(legBones);
         }
     }
 
     // Bird forward/fly: detect foot contacts
     if (animationType == "BirdForward" || animationType == "BirdFly") {
-        return detectFootContacts(clip, { "leftFoot", "rightFoot", "LeftFoot", "RightFoot" });
+        return detectFootContacts({ "leftFoot", "rightFoot", "LeftFoot", "RightFoot" });
     }
 
     // Fish: underwater body/tail movement — track lateral tail undulation
@@ -564,21 +635,22 @@ std::vector<SoundEvent> SoundEventDetector::detect(
 
         // Find which bones exist
         std::vector<std::string> foundBones;
-        if (!clip.frames.empty()) {
-            for (const auto& name : bodyBones) {
-                if (clip.frames[0].boneWorldTransforms.find(name) != clip.frames[0].boneWorldTransforms.end()) {
-                    foundBones.push_back(name);
-                }
+        std::vector<size_t> foundBoneIndices;
+        for (const auto& name : bodyBones) {
+            size_t boneIndex = m_tracks.boneIndex(name);
+            if (m_tracks.has(boneIndex, 0)) {
+                foundBones.push_back(name);
+                foundBoneIndices.push_back(boneIndex);
             }
         }
 
-        if (foundBones.empty() || clip.frames.size() < 2) {
+        if (foundBones.empty() || frameCount < 2) {
             // Fallback: periodic underwater whooshes
-            float interval = clip.durationSeconds / std::max(3.0f, clip.durationSeconds * 4.0f);
-            for (float t = 0.0f; t < clip.durationSeconds; t += interval) {
+            float interval = m_durationSeconds / std::max(3.0f, m_durationSeconds * 4.0f);
+            for (float t = 0.0f; t < m_durationSeconds; t += interval) {
                 SoundEvent event;
                 event.timeSeconds = t;
-                event.intensity = 0.2f + 0.15f * sinf(t * 12.56f / clip.durationSeconds);
+                event.intensity = 0.2f + 0.15f * sinf(t * 12.56f / m_durationSeconds);
                 event.boneName = "body";
                 event.isUnderwater = true;
                 events.push_back(event);
@@ -587,26 +659,28 @@ std::vector<SoundEvent> SoundEventDetector::detect(
         }
 
         // Track lateral velocity of body/tail bones
-        float timePerFrame = clip.durationSeconds / std::max(1, static_cast<int>(clip.frames.size()) - 1);
-        for (size_t fi = 1; fi < clip.frames.size(); ++fi) {
+        float timePerFrame = m_durationSeconds / std::max(1, static_cast<int>(frameCount) - 1);
+        for (size_t fi = 1; fi < frameCount; ++fi) {
             float frameTime = fi * timePerFrame;
             float totalSpeed = 0.0f;
             std::string peakBone = "TailEnd";
             float peakSpeed = 0.0f;
 
-            for (const auto& boneName : foundBones) {
-                auto currIt = clip.frames[fi].boneWorldTransforms.find(boneName);
-                auto prevIt = clip.frames[fi - 1].boneWorldTransforms.find(boneName);
-                if (currIt == clip.frames[fi].boneWorldTransforms.end() || prevIt == clip.frames[fi - 1].boneWorldTransforms.end())
+            for (size_t k = 0; k < foundBones.size(); ++k) {
+                size_t boneIndex = foundBoneIndices[k];
+                if (!m_tracks.has(boneIndex, fi) || !m_tracks.has(boneIndex, fi - 1))
                     continue;
-                float dx = static_cast<float>(currIt->second.constData()[Matrix4x4::M30] - prevIt->second.constData()[Matrix4x4::M30]);
-                float dy = static_cast<float>(currIt->second.constData()[Matrix4x4::M31] - prevIt->second.constData()[Matrix4x4::M31]);
-                float dz = static_cast<float>(currIt->second.constData()[Matrix4x4::M32] - prevIt->second.constData()[Matrix4x4::M32]);
+                const double* x = m_tracks.x(boneIndex);
+                const double* y = m_tracks.y(boneIndex);
+                const double* z = m_tracks.z(boneIndex);
+                float dx = static_cast<float>(x[fi] - x[fi - 1]);
+                float dy = static_cast<float>(y[fi] - y[fi - 1]);
+                float dz = static_cast<float>(z[fi] - z[fi - 1]);
                 float speed = sqrtf(dx * dx + dy * dy + dz * dz) / std::max(timePerFrame, 0.001f);
                 totalSpeed += speed;
                 if (speed > peakSpeed) {
                     peakSpeed = speed;
-                    peakBone = boneName;
+                    peakBone = foundBones[k];
                 }
             }
 
@@ -627,7 +701,7 @@ std::vector<SoundEvent> SoundEventDetector::detect(
 
     // FishDie: thrashing in water
     if (animationType == "FishDie") {
-        auto events = detectBodyImpact(clip, "BodyMid");
+        auto events = detectBodyImpact("BodyMid");
         for (auto& e : events) {
             e.isUnderwater = true;
         }
@@ -645,21 +719,22 @@ std::vector<SoundEvent> SoundEventDetector::detect(
 
         // Find which spine bones exist in the clip
         std::vector<std::string> foundBones;
-        if (!clip.frames.empty()) {
-            for (const auto& name : spineBones) {
-                if (clip.frames[0].boneWorldTransforms.find(name) != clip.frames[0].boneWorldTransforms.end()) {
-                    foundBones.push_back(name);
-                }
+        std::vector<size_t> foundBoneIndices;
+        for (const auto& name : spineBones) {
+            size_t boneIndex = m_tracks.boneIndex(name);
+            if (m_tracks.has(boneIndex, 0)) {
+                foundBones.push_back(name);
+                foundBoneIndices.push_back(boneIndex);
             }
         }
 
-        if (foundBones.empty() || clip.frames.empty()) {
+        if (foundBones.empty()) {
             // Fallback: generate periodic friction events
-            float interval = clip.durationSeconds / std::max(4.0f, clip.durationSeconds * 5.0f);
-            for (float t = 0.0f; t < clip.durationSeconds; t += interval) {
+            float interval = m_durationSeconds / std::max(4.0f, m_durationSeconds * 5.0f);
+            for (float t = 0.0f; t < m_durationSeconds; t += interval) {
                 SoundEvent event;
                 event.timeSeconds = t;
-                event.intensity = 0.15f + 0.1f * sinf(t * 12.56f / clip.durationSeconds);
+                event.intensity = 0.15f + 0.1f * sinf(t * 12.56f / m_durationSeconds);
                 event.boneName = "Spine3";
                 events.push_back(event);
             }
@@ -667,26 +742,26 @@ std::vector<SoundEvent> SoundEventDetector::detect(
         }
 
         // Measure lateral velocity of each spine bone across frames to detect slither peaks
-        float timePerFrame = clip.durationSeconds / std::max(1, static_cast<int>(clip.frames.size()) - 1);
-        for (size_t fi = 1; fi < clip.frames.size(); ++fi) {
+        float timePerFrame = m_durationSeconds / std::max(1, static_cast<int>(frameCount) - 1);
+        for (size_t fi = 1; fi < frameCount; ++fi) {
             float frameTime = fi * timePerFrame;
             float totalLateralSpeed = 0.0f;
             std::string peakBone = "Spine3";
             float peakSpeed = 0.0f;
 
-            for (const auto& boneName : foundBones) {
-                auto currIt = clip.frames[fi].boneWorldTransforms.find(boneName);
-                auto prevIt = clip.frames[fi - 1].boneWorldTransforms.find(boneName);
-                if (currIt == clip.frames[fi].boneWorldTransforms.end() || prevIt == clip.frames[fi - 1].boneWorldTransforms.end())
+            for (size_t k = 0; k < foundBones.size(); ++k) {
+                size_t boneIndex = foundBoneIndices[k];
+                if (!m_tracks.has(boneIndex, fi) || !m_tracks.has(boneIndex, fi - 1))
                     continue;
-                // X position is at index M30 = 12, Z at index M32 = 14 in column-major 4x4
-                float dx = static_cast<float>(currIt->second.constData()[Matrix4x4::M30] - prevIt->second.constData()[Matrix4x4::M30]);
-                float dz = static_cast<float>(currIt->second.constData()[Matrix4x4::M32] - prevIt->second.constData()[Matrix4x4::M32]);
+                const double* x = m_tracks.x(boneIndex);
+                const double* z = m_tracks.z(boneIndex);
+                float dx = static_cast<float>(x[fi] - x[fi - 1]);
+                float dz = static_cast<float>(z[fi] - z[fi - 1]);
                 float lateralSpeed = sqrtf(dx * dx + dz * dz) / std::max(timePerFrame, 0.001f);
                 totalLateralSpeed += lateralSpeed;
                 if (lateralSpeed > peakSpeed) {
                     peakSpeed = lateralSpeed;
-                    peakBone = boneName;
+                    peakBone = foundBones[k];
                 }
             }
 
@@ -707,122 +782,20 @@ std::vector<SoundEvent> SoundEventDetector::detect(
 
     // SnakeDie: body impact
     if (animationType == "SnakeDie") {
-        return detectBodyImpact(clip, "Spine3");
+        return detectBodyImpact("Spine3");
     }
 
     // InsectAttack: head strike
     if (animationType == "InsectAttack") {
-        return detectBodyImpact(clip, "Head");
+        return detectBodyImpact("Head");
     }
 
     // InsectRubHands: detect front leg motion
     if (animationType == "InsectRubHands") {
-        return detectFootContacts(clip, { "FrontLeftTibia", "FrontRightTibia", "FrontLeftFemur", "FrontRightFemur" });
+        return detectFootContacts({ "FrontLeftTibia", "FrontRightTibia", "FrontLeftFemur", "FrontRightFemur" });
     }
 
     return {};
 }
 
-std::vector<SoundEvent> SoundEventDetector::detect(
-    const RigAnimationClip& clip,
-    const std::string& animationType,
-    const AnimationParams& parameters)
-{
-    // BipedRoar: parameter-driven sound events
-    if (animationType == "BipedRoar") {
-        std::vector<SoundEvent> events;
-
-        // Foot stomp sound from left foot contact
-        float stompVolume = static_cast<float>(parameters.getValue("stompVolume", 1.0));
-        auto stompEvents = detectFootContacts(clip, { "LeftFoot", "leftFoot" });
-        for (auto& e : stompEvents) {
-            e.intensity = std::min(1.0f, e.intensity * 1.5f * stompVolume);
-        }
-        events.insert(events.end(), stompEvents.begin(), stompEvents.end());
-
-        std::sort(events.begin(), events.end(), [](const SoundEvent& a, const SoundEvent& b) {
-            return a.timeSeconds < b.timeSeconds;
-        });
-        return events;
-    }
-
-    // QuadrupedRoar: parameter-driven sound events
-    if (animationType == "QuadrupedRoar") {
-        std::vector<SoundEvent> events;
-
-        // Front paw stomp sounds
-        float stompFactor = static_cast<float>(parameters.getValue("stompFactor", 1.0));
-        auto stompEvents = detectFootContacts(clip, { "FrontLeftFoot", "FrontRightFoot" });
-        for (auto& e : stompEvents) {
-            e.intensity = std::min(1.0f, e.intensity * 1.5f * stompFactor);
-        }
-        events.insert(events.end(), stompEvents.begin(), stompEvents.end());
-
-        // Body jolt impact from the explosive burst
-        auto bodyEvents = detectBodyImpact(clip, "Pelvis");
-        for (auto& e : bodyEvents) {
-            e.intensity = std::min(1.0f, e.intensity * 1.2f * stompFactor);
-        }
-        events.insert(events.end(), bodyEvents.begin(), bodyEvents.end());
-
-        // Whoosh: detect head velocity during the burst (air displacement from roar)
-        if (clip.frames.size() >= 3) {
-            std::vector<float> headSpeed(clip.frames.size(), 0.0f);
-            for (size_t i = 1; i < clip.frames.size(); ++i) {
-                float dt = clip.frames[i].time - clip.frames[i - 1].time;
-                if (dt < 1e-6f)
-                    continue;
-                float y0 = getBoneY(clip.frames[i - 1], "Head");
-                float y1 = getBoneY(clip.frames[i], "Head");
-                auto getX = [](const BoneAnimationFrame& f, const std::string& name) -> float {
-                    auto it = f.boneWorldTransforms.find(name);
-                    if (it == f.boneWorldTransforms.end())
-                        return 0.0f;
-                    return static_cast<float>(it->second.constData()[Matrix4x4::M30]);
-                };
-                auto getZ = [](const BoneAnimationFrame& f, const std::string& name) -> float {
-                    auto it = f.boneWorldTransforms.find(name);
-                    if (it == f.boneWorldTransforms.end())
-                        return 0.0f;
-                    return static_cast<float>(it->second.constData()[Matrix4x4::M32]);
-                };
-                float dx = getX(clip.frames[i], "Head") - getX(clip.frames[i - 1], "Head");
-                float dy = y1 - y0;
-                float dz = getZ(clip.frames[i], "Head") - getZ(clip.frames[i - 1], "Head");
-                headSpeed[i] = std::sqrt(dx * dx + dy * dy + dz * dz) / dt;
-            }
-
-            float peakSpeed = *std::max_element(headSpeed.begin(), headSpeed.end());
-            if (peakSpeed > 1e-4f) {
-                float threshold = peakSpeed * 0.3f;
-                int whooshStart = -1;
-                int whooshEnd = -1;
-                for (size_t i = 1; i < headSpeed.size(); ++i) {
-                    if (headSpeed[i] > threshold && whooshStart < 0)
-                        whooshStart = static_cast<int>(i);
-                    if (whooshStart >= 0 && headSpeed[i] > threshold)
-                        whooshEnd = static_cast<int>(i);
-                }
-                if (whooshStart >= 0 && whooshEnd > whooshStart) {
-                    SoundEvent whoosh;
-                    whoosh.timeSeconds = clip.frames[whooshStart].time;
-                    whoosh.boneName = "Head";
-                    whoosh.isWhoosh = true;
-                    whoosh.whooshDuration = clip.frames[whooshEnd].time - clip.frames[whooshStart].time;
-                    whoosh.intensity = std::min(1.0f, peakSpeed / (peakSpeed + 1.0f));
-                    events.push_back(whoosh);
-                }
-            }
-        }
-
-        std::sort(events.begin(), events.end(), [](const SoundEvent& a, const SoundEvent& b) {
-            return a.timeSeconds < b.timeSeconds;
-        });
-        return events;
-    }
-
-    // For all other animation types, delegate to the parameterless version
-    return detect(clip, animationType);
-}
-
 } // namespace dust3d
@@ -24,7 +24,10 @@
 #define DUST3D_ANIMATION_SOUND_EVENT_DETECTOR_H_
 
 #include <dust3d/animation/animation_generator.h>
+#include <dust3d/animation/bone_position_tracks.h>
 #include <dust3d/animation/sound_generator.h>
+#include <functional>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -41,31 +44,50 @@ public:
         const std::string& animationType,
         const AnimationParams& parameters);
 
+    // Detects the events of a clip that is regenerated again and again, e.g. while its
+    // parameters are being tweaked. Detections whose bone tracks did not change since
+    // the previous call are reused instead of being run again.
+    std::vector<SoundEvent> update(
+        const RigAnimationClip& clip,
+        const std::string& animationType,
+        const AnimationParams& parameters = AnimationParams());
+
 private:
-    static float getBoneY(const BoneAnimationFrame& frame, const std::string& boneName);
-    static float getBoneX(const BoneAnimationFrame& frame, const std::string& boneName);
-    static float getBoneZ(const BoneAnimationFrame& frame, const std::string& boneName);
+    struct CachedDetection {
+        std::vector<double> signature;
+        std::vector<SoundEvent> events;
+    };
 
-    static std::vector<SoundEvent> detectFootContacts(
-        const RigAnimationClip& clip,
-        const std::vector<std::string>& footBones);
+    std::vector<SoundEvent> detectEvents(
+        const std::string& animationType,
+        const AnimationParams& parameters);
+
+    std::vector<SoundEvent> cachedDetection(const std::string& key,
+        const std::vector<std::string>& boneNames,
+        const std::function<std::vector<SoundEvent>()>& detection);
+
+    // Detects contacts of all feet in the same pass over the frames
+    std::vector<SoundEvent> detectFootContacts(const std::vector<std::string>& footBones);
 
     // Detects the wrist-snap / spell-release moment: the frame of peak 3D hand
     // speed deceleration, which is the loudest impulse in a cast animation.
-    static std::vector<SoundEvent> detectHandRelease(
-        const RigAnimationClip& clip,
-        const std::string& boneName);
+    std::vector<SoundEvent> detectHandRelease(const std::string& boneName);
 
     // Detects when hands settle into the channel hold pose:
     // the frame where hand speed first drops below a fraction of its peak
     // after the windup swing, i.e. when energy begins to flow.
-    static std::vector<SoundEvent> detectHandSettle(
-        const RigAnimationClip& clip,
-        const std::string& boneName);
+    std::vector<SoundEvent> detectHandSettle(const std::string& boneName);
 
-    static std::vector<SoundEvent> detectBodyImpact(
-        const RigAnimationClip& clip,
-        const std::string& rootBone);
+    std::vector<SoundEvent> detectBodyImpact(const std::string& rootBone);
+
+    // Detects the high velocity window of a charging or bursting bone as one whoosh
+    std::vector<SoundEvent> detectWhoosh(const std::string& boneName);
+
+    std::vector<float> boneSpeeds(size_t boneIndex) const;
+
+    BonePositionTracks m_tracks;
+    float m_durationSeconds = 0.0f;
+    std::map<std::string, CachedDetection> m_cache;
 };
 
 } // namespace dust3d
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <cstring>
 #include <dust3d/animation/sound_generator.h>
+#include <memory>
 
 namespace dust3d {
 
@@ -363,25 +364,101 @@ static float randomFloat(uint32_t& state)
     return static_cast<float>(xorshift32(state)) / static_cast<float>(UINT32_MAX);
 }
 
-void SoundGenerator::synthesizeImpact(
-    std::vector<float>& buffer,
-    int sampleRate,
-    float eventTime,
-    float intensity,
-    const SurfaceSynthParams& params,
-    uint32_t seed)
+// Resonators ring down into denormal range, where float math gets many times slower;
+// anything this small is far below the 16-bit output resolution
+static float flushDenormal(float value)
+{
+    return std::fabs(value) < 1e-15f ? 0.0f : value;
+}
+
+// One sounding event. A voice keeps all of its synthesis state between blocks,
+// so rendering a clip in blocks gives the same samples as rendering it in one go.
+class SoundVoice {
+public:
+    virtual ~SoundVoice() = default;
+
+    int endSample() const
+    {
+        return m_endSample;
+    }
+
+    // Adds the samples of this voice that fall into [blockStart, blockStart + blockLength)
+    virtual void mix(float* block, int blockStart, int blockLength) = 0;
+
+protected:
+    int m_startSample = 0;
+    int m_endSample = 0;
+};
+
+class ImpactVoice : public SoundVoice {
+public:
+    ImpactVoice(int sampleRate, int startSample, int sampleCount, float intensity,
+        const SurfaceSynthParams& params, uint32_t seed);
+    void mix(float* block, int blockStart, int blockLength) override;
+
+private:
+    struct ModalState {
+        float y1 = 0.0f, y2 = 0.0f;
+        float a1 = 0.0f, a2 = 0.0f;
+        float gain = 0.0f;
+    };
+
+    SurfaceSynthParams m_params;
+    int m_sampleRate;
+    float m_dt;
+    float m_intensity;
+    uint32_t m_rng;
+    float m_pitchOffset;
+    float m_cutoff;
+    float m_softFactor;
+
+    std::vector<float> m_delayLine;
+    int m_reflectionDelaySamples;
+    int m_delayWritePos = 0;
+
+    float m_svfLow = 0.0f, m_svfBand = 0.0f;
+    float m_svfQ;
+    float m_heelF;
+
+    ModalState m_groundModeStates[4];
+    // Ring-out envelope of each mode, advanced by one multiply per sample
+    double m_groundModeEnvelopes[4];
+    double m_groundModeEnvelopeSteps[4];
+
+    // Velvet impulses summed per sample offset, in generation order
+    std::vector<float> m_velvet;
+    float m_bpLow = 0.0f, m_bpBand = 0.0f;
+    float m_bpF;
+
+    int m_heelAttackSamples;
+    int m_heelDecaySamples;
+    int m_deformOnsetSample;
+    int m_deformDurationSamples;
+    int m_weightStartSample;
+    int m_weightDurationSamples;
+    int m_toeOffStartSample;
+    int m_toeOffDurationSamples;
+
+    float m_deformF;
+    float m_toeF;
+    float m_deformLp = 0.0f;
+    float m_toeLp = 0.0f;
+    float m_absLp = 0.0f;
+};
+
+ImpactVoice::ImpactVoice(int sampleRate, int startSample, int sampleCount, float intensity,
+    const SurfaceSynthParams& params, uint32_t seed)
+    : m_params(params)
+    , m_sampleRate(sampleRate)
+    , m_dt(1.0f / sampleRate)
+    , m_intensity(intensity)
+    , m_rng(seed)
 {
     constexpr float PI = 3.14159265358979f;
     constexpr float TWO_PI = 6.28318530717959f;
-    uint32_t rng = seed;
-
-    float pitchOffset = 1.0f + (randomFloat(rng) - 0.5f) * 2.0f * params.pitchVariation;
-    float cutoff = params.filterCutoff * pitchOffset;
-    float dt = 1.0f / sampleRate;
 
-    int startSample = static_cast<int>(eventTime * sampleRate);
-    if (startSample < 0)
-        startSample = 0;
+    m_pitchOffset = 1.0f + (randomFloat(m_rng) - 0.5f) * 2.0f * params.pitchVariation;
+    m_cutoff = params.filterCutoff * m_pitchOffset;
 
     // Compute total duration from all phases + ground mode ring
     float totalTime = params.heelStrikeAttack + params.heelStrikeDecay;
@@ -404,138 +481,133 @@ void SoundGenerator::synthesizeImpact(
     totalTime = std::max(totalTime, 0.05f);
 
     int totalSamples = static_cast<int>(totalTime * sampleRate);
-    int endSample = std::min(startSample + totalSamples, static_cast<int>(buffer.size()));
-    if (endSample <= startSample)
-        return;
+    m_startSample = startSample;
+    m_endSample = std::min(startSample + totalSamples, sampleCount);
 
     // Softness factor from pad softness — slows attack, lowers brightness
-    float softFactor = 1.0f + params.padSoftness * 2.0f; // 1.0 = hard, 3.0 = very soft
+    m_softFactor = 1.0f + params.padSoftness * 2.0f; // 1.0 = hard, 3.0 = very soft
 
     // ---- Early reflection delay line ----
-    int reflectionDelaySamples = std::max(1, static_cast<int>(params.earlyReflectionDelay * sampleRate));
-    std::vector<float> delayLine(reflectionDelaySamples, 0.0f);
-    int delayWritePos = 0;
+    m_reflectionDelaySamples = std::max(1, static_cast<int>(params.earlyReflectionDelay * sampleRate));
+    m_delayLine.resize(m_reflectionDelaySamples, 0.0f);
 
     // ---- State-variable filter (shared across phases) ----
-    float svfLow = 0.0f, svfBand = 0.0f;
-    float svfF = 2.0f * sinf(PI * std::min(cutoff, sampleRate * 0.49f) / sampleRate);
-    float svfQ = 1.0f / std::max(params.resonance, 0.1f);
+    m_svfQ = 1.0f / std::max(params.resonance, 0.1f);
+    float hCut = params.heelStrikeCutoff * m_pitchOffset / m_softFactor;
+    m_heelF = 2.0f * sinf(PI * std::min(hCut, sampleRate * 0.49f) / sampleRate);
 
     // ---- Ground mode resonators ----
-    struct ModalState {
-        float y1 = 0.0f, y2 = 0.0f;
-        float a1 = 0.0f, a2 = 0.0f;
-        float gain = 0.0f;
-    };
-    ModalState groundModeStates[4];
     for (int m = 0; m < params.groundModeCount && m < 4; ++m) {
-        float freq = params.groundModes[m].frequency * pitchOffset;
+        float freq = params.groundModes[m].frequency * m_pitchOffset;
         float bw = freq / std::max(params.groundModes[m].q, 1.0f);
-        float r = expf(-PI * bw * dt);
-        float theta = TWO_PI * freq * dt;
-        groundModeStates[m].a1 = 2.0f * r * cosf(theta);
-        groundModeStates[m].a2 = -(r * r);
-        groundModeStates[m].gain = params.groundModes[m].amplitude * (1.0f - r);
+        float r = expf(-PI * bw * m_dt);
+        float theta = TWO_PI * freq * m_dt;
+        m_groundModeStates[m].a1 = 2.0f * r * cosf(theta);
+        m_groundModeStates[m].a2 = -(r * r);
+        m_groundModeStates[m].gain = params.groundModes[m].amplitude * (1.0f - r);
+        m_groundModeEnvelopes[m] = 1.0;
+        m_groundModeEnvelopeSteps[m] = std::exp(-static_cast<double>(m_dt) / params.groundModes[m].decay);
     }
 
     // ---- Velvet noise schedule for granular texture (deformation + toe-off) ----
-    std::vector<std::pair<int, float>> velvetImpulses;
     if (params.granularDensity > 0.0f) {
         float density = 300.0f + params.granularDensity * 3000.0f;
         float granDuration = params.deformationDuration + params.granularDecay;
         int granSamples = static_cast<int>(granDuration * sampleRate);
         int numImpulses = static_cast<int>(density * granDuration);
-        velvetImpulses.reserve(numImpulses);
+        m_velvet.resize(std::max(granSamples, 0), 0.0f);
         uint32_t vrng = seed ^ 0xDEADBEEF;
         for (int j = 0; j < numImpulses; ++j) {
             int pos = static_cast<int>(randomFloat(vrng) * granSamples);
             float sign = (randomFloat(vrng) > 0.5f) ? 1.0f : -1.0f;
             float amp = sign * (0.5f + 0.5f * randomFloat(vrng));
-            velvetImpulses.push_back({ pos, amp });
+            if (pos >= 0 && pos < static_cast<int>(m_velvet.size()))
+                m_velvet[pos] += amp;
         }
     }
 
     // ---- Bandpass filter state for granular texture ----
-    float bpLow = 0.0f, bpBand = 0.0f;
-    float bpF = 2.0f * sinf(PI * std::min(params.granularBandHigh, sampleRate * 0.49f) / sampleRate);
+    m_bpF = 2.0f * sinf(PI * std::min(params.granularBandHigh, sampleRate * 0.49f) / sampleRate);
 
     // ---- Phase timing (in samples relative to start) ----
-    int heelAttackSamples = std::max(1, static_cast<int>(params.heelStrikeAttack * softFactor * sampleRate));
-    int heelDecaySamples = static_cast<int>(params.heelStrikeDecay * sampleRate);
-    int deformOnsetSample = static_cast<int>(params.deformationOnset * sampleRate);
-    int deformDurationSamples = static_cast<int>(params.deformationDuration * sampleRate);
-    int weightStartSample = deformOnsetSample + deformDurationSamples / 2;
-    int weightDurationSamples = static_cast<int>(params.weightTransferDuration * sampleRate);
-    int toeOffStartSample = static_cast<int>(params.toeOffDelay * sampleRate);
-    int toeOffDurationSamples = static_cast<int>(params.toeOffDuration * sampleRate);
-
-    // ---- Filter states for deformation, toe-off, air absorption ----
-    float deformLp = 0.0f;
-    float toeLp = 0.0f;
-    float absLp = 0.0f;
-
-    // ---- Per-sample synthesis ----
-    for (int i = startSample; i < endSample; ++i) {
-        float t = static_cast<float>(i - startSample) * dt;
-        int ls = i - startSample; // local sample
+    m_heelAttackSamples = std::max(1, static_cast<int>(params.heelStrikeAttack * m_softFactor * sampleRate));
+    m_heelDecaySamples = static_cast<int>(params.heelStrikeDecay * sampleRate);
+    m_deformOnsetSample = static_cast<int>(params.deformationOnset * sampleRate);
+    m_deformDurationSamples = static_cast<int>(params.deformationDuration * sampleRate);
+    m_weightStartSample = m_deformOnsetSample + m_deformDurationSamples / 2;
+    m_weightDurationSamples = static_cast<int>(params.weightTransferDuration * sampleRate);
+    m_toeOffStartSample = static_cast<int>(params.toeOffDelay * sampleRate);
+    m_toeOffDurationSamples = static_cast<int>(params.toeOffDuration * sampleRate);
+
+    // ---- Filter coefficients for deformation and toe-off ----
+    float dCut = params.deformationCutoff * m_pitchOffset;
+    m_deformF = 2.0f * sinf(PI * std::min(dCut, sampleRate * 0.49f) / sampleRate);
+    float toeCut = params.toeOffCutoff * m_pitchOffset;
+    m_toeF = 2.0f * sinf(PI * std::min(toeCut, sampleRate * 0.49f) / sampleRate);
+}
+
+void ImpactVoice::mix(float* block, int blockStart, int blockLength)
+{
+    constexpr float PI = 3.14159265358979f;
+    constexpr float TWO_PI = 6.28318530717959f;
+    const auto& params = m_params;
+    const int sampleRate = m_sampleRate;
+    const float dt = m_dt;
+
+    int begin = std::max(m_startSample, blockStart);
+    int end = std::min(m_endSample, blockStart + blockLength);
+    for (int i = begin; i < end; ++i) {
+        float t = static_cast<float>(i - m_startSample) * dt;
+        int ls = i - m_startSample; // local sample
         float output = 0.0f;
 
         // == PHASE 1: HEEL/PAW STRIKE ==
         // Soft onset burst — the initial contact of pad/hoof/paw with ground
         {
             float heelEnv = 0.0f;
-            if (ls < heelAttackSamples) {
+            if (ls < m_heelAttackSamples) {
                 // Smooth rise (sine curve for organic feel)
-                float phase = static_cast<float>(ls) / heelAttackSamples;
+                float phase = static_cast<float>(ls) / m_heelAttackSamples;
                 heelEnv = sinf(phase * PI * 0.5f);
-            } else if (ls < heelAttackSamples + heelDecaySamples) {
-                float decayT = static_cast<float>(ls - heelAttackSamples) / sampleRate;
+            } else if (ls < m_heelAttackSamples + m_heelDecaySamples) {
+                float decayT = static_cast<float>(ls - m_heelAttackSamples) / sampleRate;
                 heelEnv = expf(-decayT / params.heelStrikeDecay * 4.0f);
             }
             if (heelEnv > 0.001f) {
-                float noise = randomFloat(rng) * 2.0f - 1.0f;
+                float noise = randomFloat(m_rng) * 2.0f - 1.0f;
                 // Lowpass at heel strike cutoff for muffled paw thud
-                float hCut = params.heelStrikeCutoff * pitchOffset / softFactor;
-                float hF = 2.0f * sinf(PI * std::min(hCut, sampleRate * 0.49f) / sampleRate);
-                svfLow += hF * svfBand;
-                float svfHigh = noise - svfLow - svfQ * svfBand;
-                svfBand += hF * svfHigh;
-                output += svfLow * heelEnv * params.heelStrikeWeight;
+                m_svfLow += m_heelF * m_svfBand;
+                float svfHigh = noise - m_svfLow - m_svfQ * m_svfBand;
+                m_svfBand += m_heelF * svfHigh;
+                output += m_svfLow * heelEnv * params.heelStrikeWeight;
             }
         }
 
         // == PHASE 2: GROUND DEFORMATION ==
         // Granular crunch/rustle as the surface compresses under the foot
         {
-            int deformLocal = ls - deformOnsetSample;
-            if (deformLocal >= 0 && deformLocal < deformDurationSamples) {
-                float deformPhase = static_cast<float>(deformLocal) / deformDurationSamples;
+            int deformLocal = ls - m_deformOnsetSample;
+            if (deformLocal >= 0 && deformLocal < m_deformDurationSamples) {
+                float deformPhase = static_cast<float>(deformLocal) / m_deformDurationSamples;
                 // Bell-shaped envelope (peaks in middle of compression)
                 float deformEnv = sinf(deformPhase * PI);
 
                 // Granular texture via velvet noise
-                float velvetSum = 0.0f;
-                for (const auto& imp : velvetImpulses) {
-                    if (imp.first == deformLocal) {
-                        velvetSum += imp.second;
-                    }
-                }
+                float velvetSum = deformLocal < static_cast<int>(m_velvet.size()) ? m_velvet[deformLocal] : 0.0f;
 
                 // Bandpass the granular texture
                 float granNoise = velvetSum * params.deformationGranularity;
-                bpLow += bpF * bpBand;
-                float bpHigh = granNoise - bpLow - 0.5f * bpBand;
-                bpBand += bpF * bpHigh;
-                float bandpassed = bpBand;
+                m_bpLow += m_bpF * m_bpBand;
+                float bpHigh = granNoise - m_bpLow - 0.5f * m_bpBand;
+                m_bpBand += m_bpF * bpHigh;
+                float bandpassed = m_bpBand;
 
                 // Also add filtered broadband for body of deformation
-                float bodyNoise = randomFloat(rng) * 2.0f - 1.0f;
-                float dCut = params.deformationCutoff * pitchOffset;
-                float dF = 2.0f * sinf(PI * std::min(dCut, sampleRate * 0.49f) / sampleRate);
+                float bodyNoise = randomFloat(m_rng) * 2.0f - 1.0f;
                 // Simple one-pole lowpass for deformation body
-                deformLp += dF * (bodyNoise - deformLp);
+                m_deformLp += m_deformF * (bodyNoise - m_deformLp);
 
-                output += (bandpassed + deformLp * (1.0f - params.deformationGranularity))
+                output += (bandpassed + m_deformLp * (1.0f - params.deformationGranularity))
                     * deformEnv * params.deformationWeight;
             }
         }
@@ -543,9 +615,9 @@ void SoundGenerator::synthesizeImpact(
         // == PHASE 3: WEIGHT TRANSFER ==
         // Deep sub-bass rumble as body mass settles onto the foot
         {
-            int weightLocal = ls - weightStartSample;
-            if (weightLocal >= 0 && weightLocal < weightDurationSamples) {
-                float weightPhase = static_cast<float>(weightLocal) / weightDurationSamples;
+            int weightLocal = ls - m_weightStartSample;
+            if (weightLocal >= 0 && weightLocal < m_weightDurationSamples) {
+                float weightPhase = static_cast<float>(weightLocal) / m_weightDurationSamples;
                 // Smooth envelope with slow release
                 float weightEnv = sinf(weightPhase * PI) * (1.0f - weightPhase * 0.5f);
 
@@ -562,19 +634,17 @@ void SoundGenerator::synthesizeImpact(
         // == PHASE 4: TOE-OFF / LIFT ==
         // Subtle scrape or displacement as the foot lifts away
         if (params.toeOffWeight > 0.001f) {
-            int toeLocal = ls - toeOffStartSample;
-            if (toeLocal >= 0 && toeLocal < toeOffDurationSamples) {
-                float toePhase = static_cast<float>(toeLocal) / toeOffDurationSamples;
+            int toeLocal = ls - m_toeOffStartSample;
+            if (toeLocal >= 0 && toeLocal < m_toeOffDurationSamples) {
+                float toePhase = static_cast<float>(toeLocal) / m_toeOffDurationSamples;
                 // Fade-out envelope
                 float toeEnv = 1.0f - toePhase;
                 toeEnv *= toeEnv; // quadratic fade
 
-                float toeNoise = randomFloat(rng) * 2.0f - 1.0f;
+                float toeNoise = randomFloat(m_rng) * 2.0f - 1.0f;
                 // Highpass for scrape character
-                float toeCut = params.toeOffCutoff * pitchOffset;
-                float toeF = 2.0f * sinf(PI * std::min(toeCut, sampleRate * 0.49f) / sampleRate);
-                toeLp += toeF * (toeNoise - toeLp);
-                float toeHp = toeNoise - toeLp;
+                m_toeLp += m_toeF * (toeNoise - m_toeLp);
+                float toeHp = toeNoise - m_toeLp;
 
                 output += toeHp * toeEnv * params.toeOffWeight;
             }
@@ -583,139 +653,161 @@ void SoundGenerator::synthesizeImpact(
         // == GROUND MODE RESONANCE ==
         // Excited by the heel strike impulse, rings according to surface material
         for (int m = 0; m < params.groundModeCount && m < 4; ++m) {
-            auto& ms = groundModeStates[m];
-            float excitation = (ls == 0) ? intensity : 0.0f;
-            float y = ms.a1 * ms.y1 + ms.a2 * ms.y2 + excitation * ms.gain;
+            auto& ms = m_groundModeStates[m];
+            float excitation = (ls == 0) ? m_intensity : 0.0f;
+            float y = flushDenormal(ms.a1 * ms.y1 + ms.a2 * ms.y2 + excitation * ms.gain);
             ms.y2 = ms.y1;
             ms.y1 = y;
-            float modeEnv = expf(-t / params.groundModes[m].decay);
+            float modeEnv = static_cast<float>(m_groundModeEnvelopes[m]);
+            m_groundModeEnvelopes[m] *= m_groundModeEnvelopeSteps[m];
             output += y * modeEnv;
         }
 
         // == AIR ABSORPTION (high-frequency rolloff over time) ==
         if (params.airAbsorption > 0.0f) {
-            float absCut = cutoff * expf(-params.airAbsorption * t * 10.0f);
+            float absCut = m_cutoff * expf(-params.airAbsorption * t * 10.0f);
             absCut = std::max(absCut, 200.0f);
             float absF = 2.0f * sinf(PI * std::min(absCut, sampleRate * 0.49f) / sampleRate);
-            absLp += absF * (output - absLp);
-            output = absLp * (1.0f - params.airAbsorption * 0.3f) + output * params.airAbsorption * 0.3f;
+            m_absLp += absF * (output - m_absLp);
+            output = m_absLp * (1.0f - params.airAbsorption * 0.3f) + output * params.airAbsorption * 0.3f;
         }
 
         // == EARLY REFLECTION ==
         float withReflection = output;
         if (params.earlyReflectionGain > 0.0f) {
-            int readPos = (delayWritePos - reflectionDelaySamples + static_cast<int>(delayLine.size())) % static_cast<int>(delayLine.size());
-            withReflection += delayLine[readPos] * params.earlyReflectionGain;
-            delayLine[delayWritePos] = output;
-            delayWritePos = (delayWritePos + 1) % static_cast<int>(delayLine.size());
+            int delaySize = static_cast<int>(m_delayLine.size());
+            int readPos = (m_delayWritePos - m_reflectionDelaySamples + delaySize) % delaySize;
+            withReflection += m_delayLine[readPos] * params.earlyReflectionGain;
+            m_delayLine[m_delayWritePos] = output;
+            m_delayWritePos = (m_delayWritePos + 1) % delaySize;
         }
 
         // Final output scaled by intensity and mass
-        buffer[i] += withReflection * intensity * params.massScale * 0.8f;
+        block[i - blockStart] += withReflection * m_intensity * params.massScale * 0.8f;
     }
 }
 
-void SoundGenerator::synthesizeUnderwater(
-    std::vector<float>& buffer,
-    int sampleRate,
-    float eventTime,
-    float intensity,
-    uint32_t seed)
+class UnderwaterVoice : public SoundVoice {
+public:
+    UnderwaterVoice(int sampleRate, int startSample, int sampleCount, float intensity, uint32_t seed);
+    void mix(float* block, int blockStart, int blockLength) override;
+
+private:
+    struct Bubble {
+        float freq;
+        float y1 = 0.0f, y2 = 0.0f;
+        float a1, a2, gain;
+        int onset; // sample offset for bubble start
+        float decay;
+    };
+
+    float randF()
+    {
+        return static_cast<float>(xorshift32(m_rng)) / static_cast<float>(UINT32_MAX);
+    }
+
+    float m_dt;
+    float m_intensity;
+    uint32_t m_rng;
+    int m_totalSamples;
+    float m_pitchMod;
+    float m_waterF;
+    float m_waterLp = 0.0f;
+    float m_waterLp2 = 0.0f; // second-order for steeper rolloff
+    Bubble m_bubbles[4];
+    int m_bubbleCount;
+    int m_attackSamples;
+    int m_sustainEnd;
+};
+
+UnderwaterVoice::UnderwaterVoice(int sampleRate, int startSample, int sampleCount, float intensity, uint32_t seed)
+    : m_dt(1.0f / sampleRate)
+    , m_intensity(intensity)
+    , m_rng(seed)
 {
     // Underwater sound synthesis for fish/aquatic creatures
     // Key characteristics: heavily lowpassed, water displacement whoosh,
     // bubble resonances, muffled body swoosh — no sharp transients
     constexpr float PI = 3.14159265358979f;
     constexpr float TWO_PI = 6.28318530717959f;
-    uint32_t rng = seed;
-
-    auto randF = [&rng]() -> float {
-        return static_cast<float>(xorshift32(rng)) / static_cast<float>(UINT32_MAX);
-    };
-
-    float dt = 1.0f / sampleRate;
-    int startSample = static_cast<int>(eventTime * sampleRate);
-    if (startSample < 0)
-        startSample = 0;
 
     // Underwater sounds are longer and smoother
     float duration = 0.15f + intensity * 0.2f;
-    int totalSamples = static_cast<int>(duration * sampleRate);
-    int endSample = std::min(startSample + totalSamples, static_cast<int>(buffer.size()));
-    if (endSample <= startSample)
-        return;
+    m_totalSamples = static_cast<int>(duration * sampleRate);
+    m_startSample = startSample;
+    m_endSample = std::min(startSample + m_totalSamples, sampleCount);
 
     // Pitch variation for organic feel
-    float pitchMod = 1.0f + (randF() - 0.5f) * 0.3f;
+    m_pitchMod = 1.0f + (randF() - 0.5f) * 0.3f;
 
     // ---- Underwater lowpass filter (very aggressive, ~600 Hz) ----
-    float waterCutoff = (400.0f + intensity * 300.0f) * pitchMod;
-    float waterF = 2.0f * sinf(PI * std::min(waterCutoff, sampleRate * 0.49f) / sampleRate);
-    float waterLp = 0.0f;
-    float waterLp2 = 0.0f; // second-order for steeper rolloff
+    float waterCutoff = (400.0f + intensity * 300.0f) * m_pitchMod;
+    m_waterF = 2.0f * sinf(PI * std::min(waterCutoff, sampleRate * 0.49f) / sampleRate);
 
     // ---- Bubble resonators (2-3 random bubble pops) ----
-    struct Bubble {
-        float freq;
-        float y1 = 0.0f, y2 = 0.0f;
-        float a1, a2, gain;
-        int onset; // sample offset for bubble start
-        float decay;
-    };
-    int bubbleCount = 2 + (static_cast<int>(randF() * 2.5f));
-    if (bubbleCount > 4)
-        bubbleCount = 4;
-    Bubble bubbles[4];
-    for (int b = 0; b < bubbleCount; ++b) {
-        float freq = (200.0f + randF() * 600.0f) * pitchMod;
+    m_bubbleCount = 2 + (static_cast<int>(randF() * 2.5f));
+    if (m_bubbleCount > 4)
+        m_bubbleCount = 4;
+    for (int b = 0; b < m_bubbleCount; ++b) {
+        float freq = (200.0f + randF() * 600.0f) * m_pitchMod;
         float bw = freq / (2.0f + randF() * 3.0f);
-        float r = expf(-PI * bw * dt);
-        float theta = TWO_PI * freq * dt;
-        bubbles[b].freq = freq;
-        bubbles[b].a1 = 2.0f * r * cosf(theta);
-        bubbles[b].a2 = -(r * r);
-        bubbles[b].gain = (0.3f + randF() * 0.5f) * (1.0f - r);
-        bubbles[b].onset = static_cast<int>(randF() * totalSamples * 0.6f);
-        bubbles[b].decay = 0.02f + randF() * 0.04f;
+        float r = expf(-PI * bw * m_dt);
+        float theta = TWO_PI * freq * m_dt;
+        m_bubbles[b].freq = freq;
+        m_bubbles[b].a1 = 2.0f * r * cosf(theta);
+        m_bubbles[b].a2 = -(r * r);
+        m_bubbles[b].gain = (0.3f + randF() * 0.5f) * (1.0f - r);
+        m_bubbles[b].onset = static_cast<int>(randF() * m_totalSamples * 0.6f);
+        m_bubbles[b].decay = 0.02f + randF() * 0.04f;
     }
 
     // ---- Water displacement whoosh (broadband, heavily filtered) ----
     // Smooth envelope: slow attack, sustained, slow decay
-    int attackSamples = static_cast<int>(0.02f * sampleRate);
-    int sustainEnd = totalSamples - static_cast<int>(0.04f * sampleRate);
+    m_attackSamples = static_cast<int>(0.02f * sampleRate);
+    m_sustainEnd = m_totalSamples - static_cast<int>(0.04f * sampleRate);
+}
 
-    for (int i = startSample; i < endSample; ++i) {
-        float t = static_cast<float>(i - startSample) * dt;
-        int ls = i - startSample;
+void UnderwaterVoice::mix(float* block, int blockStart, int blockLength)
+{
+    constexpr float PI = 3.14159265358979f;
+    constexpr float TWO_PI = 6.28318530717959f;
+    const float dt = m_dt;
+    const float intensity = m_intensity;
+
+    int begin = std::max(m_startSample, blockStart);
+    int end = std::min(m_endSample, blockStart + blockLength);
+    for (int i = begin; i < end; ++i) {
+        float t = static_cast<float>(i - m_startSample) * dt;
+        int ls = i - m_startSample;
         float output = 0.0f;
 
         // == WATER DISPLACEMENT WHOOSH ==
         // Smooth envelope
         float whooshEnv;
-        if (ls < attackSamples) {
-            float phase = static_cast<float>(ls) / attackSamples;
+        if (ls < m_attackSamples) {
+            float phase = static_cast<float>(ls) / m_attackSamples;
             whooshEnv = sinf(phase * PI * 0.5f); // smooth rise
-        } else if (ls < sustainEnd) {
+        } else if (ls < m_sustainEnd) {
             whooshEnv = 1.0f;
         } else {
-            float decayPhase = static_cast<float>(ls - sustainEnd) / static_cast<float>(totalSamples - sustainEnd);
+            float decayPhase = static_cast<float>(ls - m_sustainEnd) / static_cast<float>(m_totalSamples - m_sustainEnd);
             whooshEnv = cosf(decayPhase * PI * 0.5f); // smooth fall
         }
 
         // Broadband noise, double lowpassed for muffled underwater character
         float noise = randF() * 2.0f - 1.0f;
-        waterLp += waterF * (noise - waterLp);
-        waterLp2 += waterF * (waterLp - waterLp2); // second pass
-        output += waterLp2 * whooshEnv * 0.6f;
+        m_waterLp += m_waterF * (noise - m_waterLp);
+        m_waterLp2 += m_waterF * (m_waterLp - m_waterLp2); // second pass
+        output += m_waterLp2 * whooshEnv * 0.6f;
 
         // == BUBBLE RESONANCES ==
-        for (int b = 0; b < bubbleCount; ++b) {
-            auto& bub = bubbles[b];
+        for (int b = 0; b < m_bubbleCount; ++b) {
+            auto& bub = m_bubbles[b];
             if (ls < bub.onset)
                 continue;
             int bubLocal = ls - bub.onset;
             float excitation = (bubLocal == 0) ? intensity * bub.gain : 0.0f;
-            float y = bub.a1 * bub.y1 + bub.a2 * bub.y2 + excitation;
+            float y = flushDenormal(bub.a1 * bub.y1 + bub.a2 * bub.y2 + excitation);
             bub.y2 = bub.y1;
             bub.y1 = y;
             float bubEnv = expf(-static_cast<float>(bubLocal) * dt / bub.decay);
@@ -724,21 +816,42 @@ void SoundGenerator::synthesizeUnderwater(
 
         // == LOW-FREQUENCY BODY SWOOSH ==
         // Very low sine modulation for the "weight" of water moving
-        float swooshFreq = (30.0f + intensity * 20.0f) * pitchMod;
+        float swooshFreq = (30.0f + intensity * 20.0f) * m_pitchMod;
         float swoosh = sinf(TWO_PI * swooshFreq * t) * whooshEnv * 0.25f;
         output += swoosh;
 
-        buffer[i] += output * intensity * 0.7f;
+        block[i - blockStart] += output * intensity * 0.7f;
     }
 }
 
-void SoundGenerator::synthesizeWhoosh(
-    std::vector<float>& buffer,
-    int sampleRate,
-    float eventTime,
-    float intensity,
-    float whooshDuration,
-    uint32_t seed)
+class WhooshVoice : public SoundVoice {
+public:
+    WhooshVoice(int sampleRate, int startSample, int sampleCount, float intensity, float whooshDuration, uint32_t seed);
+    void mix(float* block, int blockStart, int blockLength) override;
+
+private:
+    int m_sampleRate;
+    float m_intensity;
+    uint32_t m_rng;
+    int m_totalSamples;
+    float m_freqLow;
+    float m_freqPeak;
+    float m_bandwidth;
+    float m_attackFraction;
+    int m_attackSamples;
+    int m_decaySamples;
+
+    // State-variable bandpass filter
+    float m_bpLow = 0.0f, m_bpBand = 0.0f;
+
+    // Second bandpass for wider, more natural sound
+    float m_bp2Low = 0.0f, m_bp2Band = 0.0f;
+};
+
+WhooshVoice::WhooshVoice(int sampleRate, int startSample, int sampleCount, float intensity, float whooshDuration, uint32_t seed)
+    : m_sampleRate(sampleRate)
+    , m_intensity(intensity)
+    , m_rng(seed)
 {
     // Air displacement whoosh for fast-moving body parts (head charge, tail whip).
     // Modeled after FMOD/Wwise whoosh design: bandpass-filtered noise with a
@@ -754,57 +867,51 @@ void SoundGenerator::synthesizeWhoosh(
     // to intensity (up to ~2500 Hz for maximum velocity), then falls back.
     // This creates the characteristic rising-then-falling pitch of a whoosh.
 
-    constexpr float PI = 3.14159265358979f;
-    uint32_t rng = seed;
-
-    float dt = 1.0f / sampleRate;
-    int startSample = static_cast<int>(eventTime * sampleRate);
-    if (startSample < 0)
-        startSample = 0;
-
     if (whooshDuration < 0.02f)
         whooshDuration = 0.15f;
 
-    int totalSamples = static_cast<int>(whooshDuration * sampleRate);
-    int endSample = std::min(startSample + totalSamples, static_cast<int>(buffer.size()));
-    if (endSample <= startSample)
-        return;
+    m_totalSamples = static_cast<int>(whooshDuration * sampleRate);
+    m_startSample = startSample;
+    m_endSample = std::min(startSample + m_totalSamples, sampleCount);
 
     // Pitch variation for organic variation
-    float pitchMod = 1.0f + (static_cast<float>(xorshift32(rng)) / static_cast<float>(UINT32_MAX) - 0.5f) * 0.15f;
+    float pitchMod = 1.0f + (static_cast<float>(xorshift32(m_rng)) / static_cast<float>(UINT32_MAX) - 0.5f) * 0.15f;
 
     // Frequency range: scales with intensity (higher velocity = brighter whoosh)
-    float freqLow = 200.0f * pitchMod;
-    float freqPeak = (800.0f + intensity * 1700.0f) * pitchMod; // 800-2500 Hz at peak
-    float bandwidth = (300.0f + intensity * 500.0f) * pitchMod; // wider bandwidth at higher velocity
+    m_freqLow = 200.0f * pitchMod;
+    m_freqPeak = (800.0f + intensity * 1700.0f) * pitchMod; // 800-2500 Hz at peak
+    m_bandwidth = (300.0f + intensity * 500.0f) * pitchMod; // wider bandwidth at higher velocity
 
     // Asymmetric envelope: attack is 30% of duration, decay is 70%
     // This matches real aeroacoustics — the leading edge is sharp,
     // the turbulent wake trails off.
-    float attackFraction = 0.3f;
-    int attackSamples = static_cast<int>(attackFraction * totalSamples);
-    int decaySamples = totalSamples - attackSamples;
-
-    // State-variable bandpass filter
-    float bpLow = 0.0f, bpBand = 0.0f;
+    m_attackFraction = 0.3f;
+    m_attackSamples = static_cast<int>(m_attackFraction * m_totalSamples);
+    m_decaySamples = m_totalSamples - m_attackSamples;
+}
 
-    // Second bandpass for wider, more natural sound
-    float bp2Low = 0.0f, bp2Band = 0.0f;
+void WhooshVoice::mix(float* block, int blockStart, int blockLength)
+{
+    constexpr float PI = 3.14159265358979f;
+    const int sampleRate = m_sampleRate;
+    const float attackFraction = m_attackFraction;
 
-    for (int i = startSample; i < endSample; ++i) {
-        int ls = i - startSample;
-        float phase = static_cast<float>(ls) / static_cast<float>(totalSamples);
+    int begin = std::max(m_startSample, blockStart);
+    int end = std::min(m_endSample, blockStart + blockLength);
+    for (int i = begin; i < end; ++i) {
+        int ls = i - m_startSample;
+        float phase = static_cast<float>(ls) / static_cast<float>(m_totalSamples);
 
         // Amplitude envelope: asymmetric bell
         float env;
-        if (ls < attackSamples) {
+        if (ls < m_attackSamples) {
             // Fast sine rise
-            float t = static_cast<float>(ls) / static_cast<float>(attackSamples);
+            float t = static_cast<float>(ls) / static_cast<float>(m_attackSamples);
             env = sinf(t * PI * 0.5f);
             env *= env; // sharpen the attack
         } else {
             // Slower exponential decay with cosine shaping
-            float t = static_cast<float>(ls - attackSamples) / static_cast<float>(std::max(1, decaySamples));
+            float t = static_cast<float>(ls - m_attackSamples) / static_cast<float>(std::max(1, m_decaySamples));
             env = cosf(t * PI * 0.5f);
             env *= expf(-t * 2.0f); // exponential falloff for natural turbulence decay
         }
@@ -819,121 +926,222 @@ void SoundGenerator::synthesizeWhoosh(
         } else {
             freqEnv = expf(-freqPhase * freqPhase * 4.0f); // Gaussian falloff
         }
-        float centerFreq = freqLow + (freqPeak - freqLow) * freqEnv;
+        float centerFreq = m_freqLow + (m_freqPeak - m_freqLow) * freqEnv;
 
         // SVF bandpass coefficients (recomputed per sample for sweep)
         float bpF = 2.0f * sinf(PI * std::min(centerFreq, sampleRate * 0.49f) / sampleRate);
-        float bpQ = 1.0f / std::max(centerFreq / bandwidth, 0.5f);
+        float bpQ = 1.0f / std::max(centerFreq / m_bandwidth, 0.5f);
 
         // Second band offset higher for width
         float centerFreq2 = centerFreq * 1.6f;
         float bp2F = 2.0f * sinf(PI * std::min(centerFreq2, sampleRate * 0.49f) / sampleRate);
-        float bp2Q = 1.0f / std::max(centerFreq2 / (bandwidth * 1.3f), 0.5f);
+        float bp2Q = 1.0f / std::max(centerFreq2 / (m_bandwidth * 1.3f), 0.5f);
 
         // White noise source
-        float noise = static_cast<float>(xorshift32(rng)) / static_cast<float>(UINT32_MAX) * 2.0f - 1.0f;
+        float noise = static_cast<float>(xorshift32(m_rng)) / static_cast<float>(UINT32_MAX) * 2.0f - 1.0f;
 
         // Primary bandpass
-        bpLow += bpF * bpBand;
-        float bpHigh = noise - bpLow - bpQ * bpBand;
-        bpBand += bpF * bpHigh;
+        m_bpLow += bpF * m_bpBand;
+        float bpHigh = noise - m_bpLow - bpQ * m_bpBand;
+        m_bpBand += bpF * bpHigh;
 
         // Secondary bandpass (higher octave, mixed quieter)
-        bp2Low += bp2F * bp2Band;
-        float bp2High = noise - bp2Low - bp2Q * bp2Band;
-        bp2Band += bp2F * bp2High;
+        m_bp2Low += bp2F * m_bp2Band;
+        float bp2High = noise - m_bp2Low - bp2Q * m_bp2Band;
+        m_bp2Band += bp2F * bp2High;
 
-        float output = bpBand * 0.7f + bp2Band * 0.3f;
-        output *= env * intensity * 0.6f;
+        float output = m_bpBand * 0.7f + m_bp2Band * 0.3f;
+        output *= env * m_intensity * 0.6f;
 
-        buffer[i] += output;
+        block[i - blockStart] += output;
     }
 }
 
-AnimationSoundData SoundGenerator::generate(
-    const std::vector<SoundEvent>& events,
+SoundRenderer::SoundRenderer(const std::vector<SoundEvent>& events,
     float durationSeconds,
     SurfaceMaterial material,
     float volumeScale)
+    : m_events(events)
+    , m_params(getSurfaceSynthParams(material))
+    , m_volumeScale(volumeScale)
+    , m_durationSeconds(durationSeconds)
 {
-    AnimationSoundData result;
-    result.sampleRate = 44100;
-    result.channels = 1;
-    result.durationSeconds = durationSeconds;
-
-    int totalSamples = static_cast<int>(durationSeconds * result.sampleRate);
-    if (totalSamples <= 0) {
-        return result;
-    }
+    m_sampleCount = std::max(0, static_cast<int>(durationSeconds * m_sampleRate));
+    m_voices.resize(m_events.size());
+    m_voiceFinished.resize(m_events.size(), 0);
+    m_block.resize(BlockSize);
+}
 
-    std::vector<float> floatBuffer(totalSamples, 0.0f);
+SoundRenderer::~SoundRenderer() = default;
 
-    SurfaceSynthParams params = getSurfaceSynthParams(material);
+void SoundRenderer::rewind()
+{
+    m_position = 0;
+    for (auto& voice : m_voices)
+        voice.reset();
+    std::fill(m_voiceFinished.begin(), m_voiceFinished.end(), 0);
+}
 
-    for (size_t i = 0; i < events.size(); ++i) {
-        const auto& event = events[i];
-        // Use event index + time as seed for deterministic variation
-        uint32_t seed = static_cast<uint32_t>(i * 2654435761u + static_cast<uint32_t>(event.timeSeconds * 10000));
-        if (seed == 0)
-            seed = 1;
+std::unique_ptr<SoundVoice> SoundRenderer::createVoice(size_t eventIndex, int startSample) const
+{
+    const auto& event = m_events[eventIndex];
+    // Use event index + time as seed for deterministic variation
+    uint32_t seed = static_cast<uint32_t>(eventIndex * 2654435761u + static_cast<uint32_t>(event.timeSeconds * 10000));
+    if (seed == 0)
+        seed = 1;
+
+    if (event.isWhoosh)
+        return std::make_unique<WhooshVoice>(m_sampleRate, startSample, m_sampleCount, event.intensity, event.whooshDuration, seed);
+    if (event.isUnderwater)
+        return std::make_unique<UnderwaterVoice>(m_sampleRate, startSample, m_sampleCount, event.intensity, seed);
+    return std::make_unique<ImpactVoice>(m_sampleRate, startSample, m_sampleCount, event.intensity, m_params, seed);
+}
 
-        if (event.isWhoosh) {
-            synthesizeWhoosh(floatBuffer, result.sampleRate, event.timeSeconds,
-                event.intensity, event.whooshDuration, seed);
-        } else if (event.isUnderwater) {
-            synthesizeUnderwater(floatBuffer, result.sampleRate, event.timeSeconds,
-                event.intensity, seed);
-        } else {
-            synthesizeImpact(floatBuffer, result.sampleRate, event.timeSeconds,
-                event.intensity, params, seed);
+size_t SoundRenderer::mix(float* samples, size_t maxSamples)
+{
+    size_t mixed = 0;
+    while (mixed < maxSamples && m_position < m_sampleCount) {
+        int blockStart = m_position;
+        int blockLength = static_cast<int>(std::min(maxSamples - mixed, static_cast<size_t>(m_sampleCount - m_position)));
+        int blockEnd = blockStart + blockLength;
+        float* block = samples + mixed;
+        std::fill(block, block + blockLength, 0.0f);
+
+        // Voices are mixed in event order, so every sample sums its voices in the same order
+        // no matter how the clip is split into blocks
+        for (size_t i = 0; i < m_events.size(); ++i) {
+            if (m_voiceFinished[i])
+                continue;
+            auto& voice = m_voices[i];
+            if (nullptr == voice) {
+                int startSample = static_cast<int>(m_events[i].timeSeconds * m_sampleRate);
+                if (startSample < 0)
+                    startSample = 0;
+                if (startSample >= blockEnd)
+                    continue;
+                voice = createVoice(i, startSample);
+            }
+            voice->mix(block, blockStart, blockLength);
+            if (voice->endSample() <= blockEnd) {
+                voice.reset();
+                m_voiceFinished[i] = 1;
+            }
         }
+
+        m_position = blockEnd;
+        mixed += blockLength;
     }
+    return mixed;
+}
+
+float SoundRenderer::peakLevel()
+{
+    if (m_peakMeasured)
+        return m_peakLevel;
 
-    // Normalize and convert to int16
+    // Render the clip once only to find its peak, one block at a time
+    int position = m_position;
+    rewind();
     float maxVal = 0.0f;
-    for (float s : floatBuffer) {
-        float abs = s < 0 ? -s : s;
-        if (abs > maxVal)
-            maxVal = abs;
+    size_t count = 0;
+    while ((count = mix(m_block.data(), m_block.size())) > 0) {
+        for (size_t i = 0; i < count; ++i)
+            maxVal = std::max(maxVal, std::fabs(m_block[i]));
+    }
+    rewind();
+    if (position > 0) {
+        while (m_position < position)
+            mix(m_block.data(), std::min(m_block.size(), static_cast<size_t>(position - m_position)));
     }
 
+    m_peakLevel = maxVal;
+    m_peakMeasured = true;
+    return m_peakLevel;
+}
+
+float SoundRenderer::normalizationGain(float peakLevel, float volumeScale)
+{
     float normalize = 1.0f;
-    if (maxVal > 0.001f) {
-        normalize = 0.9f / maxVal;
+    if (peakLevel > 0.001f) {
+        normalize = 0.9f / peakLevel;
     }
-    normalize *= volumeScale;
+    return normalize * volumeScale;
+}
 
-    result.pcmSamples.resize(totalSamples);
-    for (int i = 0; i < totalSamples; ++i) {
-        float s = floatBuffer[i] * normalize;
+void SoundRenderer::convertToPcm(const float* samples, int16_t* pcmSamples, size_t count, float gain)
+{
+    for (size_t i = 0; i < count; ++i) {
+        float s = samples[i] * gain;
         s = std::max(-1.0f, std::min(1.0f, s));
-        result.pcmSamples[i] = static_cast<int16_t>(s * 32767.0f);
+        pcmSamples[i] = static_cast<int16_t>(s * 32767.0f);
+    }
+}
+
+size_t SoundRenderer::render(int16_t* pcmSamples, size_t maxSamples)
+{
+    float gain = normalizationGain(peakLevel(), m_volumeScale);
+    size_t rendered = 0;
+    while (rendered < maxSamples) {
+        size_t count = mix(m_block.data(), std::min(m_block.size(), maxSamples - rendered));
+        if (0 == count)
+            break;
+        convertToPcm(m_block.data(), pcmSamples + rendered, count, gain);
+        rendered += count;
+    }
+    return rendered;
+}
+
+AnimationSoundData SoundGenerator::generate(
+    const std::vector<SoundEvent>& events,
+    float durationSeconds,
+    SurfaceMaterial material,
+    float volumeScale)
+{
+    AnimationSoundData result;
+    result.sampleRate = SoundRenderer::SampleRate;
+    result.channels = 1;
+    result.durationSeconds = durationSeconds;
+
+    SoundRenderer renderer(events, durationSeconds, material, volumeScale);
+    size_t totalSamples = renderer.sampleCount();
+    if (0 == totalSamples) {
+        return result;
     }
 
+    // The whole clip is kept here anyway, so mix it once and measure the peak afterwards
+    std::vector<float> floatBuffer(totalSamples);
+    renderer.mix(floatBuffer.data(), floatBuffer.size());
+
+    float maxVal = 0.0f;
+    for (float s : floatBuffer)
+        maxVal = std::max(maxVal, std::fabs(s));
+
+    result.pcmSamples.resize(totalSamples);
+    SoundRenderer::convertToPcm(floatBuffer.data(), result.pcmSamples.data(), totalSamples,
+        SoundRenderer::normalizationGain(maxVal, volumeScale));
+
     return result;
 }
 
-std::vector<uint8_t> SoundGenerator::encodeWav(const AnimationSoundData& data)
+static void writeWavHeader(uint8_t* header, int sampleRate, int channels, size_t sampleCount)
 {
-    uint32_t dataSize = static_cast<uint32_t>(data.pcmSamples.size() * 2);
+    uint32_t dataSize = static_cast<uint32_t>(sampleCount * 2);
     uint32_t fileSize = 36 + dataSize;
-
-    std::vector<uint8_t> wav;
-    wav.reserve(44 + dataSize);
+    size_t offset = 0;
 
     auto writeU32 = [&](uint32_t v) {
-        wav.push_back(v & 0xFF);
-        wav.push_back((v >> 8) & 0xFF);
-        wav.push_back((v >> 16) & 0xFF);
-        wav.push_back((v >> 24) & 0xFF);
+        header[offset++] = v & 0xFF;
+        header[offset++] = (v >> 8) & 0xFF;
+        header[offset++] = (v >> 16) & 0xFF;
+        header[offset++] = (v >> 24) & 0xFF;
     };
     auto writeU16 = [&](uint16_t v) {
-        wav.push_back(v & 0xFF);
-        wav.push_back((v >> 8) & 0xFF);
+        header[offset++] = v & 0xFF;
+        header[offset++] = (v >> 8) & 0xFF;
     };
     auto writeStr = [&](const char* s) {
         for (int i = 0; s[i]; ++i)
-            wav.push_back(static_cast<uint8_t>(s[i]));
+            header[offset++] = static_cast<uint8_t>(s[i]);
     };
 
     // RIFF header
@@ -945,22 +1153,50 @@ std::vector<uint8_t> SoundGenerator::encodeWav(const AnimationSoundData& data)
     writeStr("fmt ");
     writeU32(16); // chunk size
     writeU16(1); // PCM format
-    writeU16(static_cast<uint16_t>(data.channels));
-    writeU32(static_cast<uint32_t>(data.sampleRate));
-    writeU32(static_cast<uint32_t>(data.sampleRate * data.channels * 2)); // byte rate
-    writeU16(static_cast<uint16_t>(data.channels * 2)); // block align
+    writeU16(static_cast<uint16_t>(channels));
+    writeU32(static_cast<uint32_t>(sampleRate));
+    writeU32(static_cast<uint32_t>(sampleRate * channels * 2)); // byte rate
+    writeU16(static_cast<uint16_t>(channels * 2)); // block align
     writeU16(16); // bits per sample
 
     // data chunk
     writeStr("data");
     writeU32(dataSize);
+}
 
-    for (int16_t sample : data.pcmSamples) {
-        wav.push_back(static_cast<uint8_t>(sample & 0xFF));
-        wav.push_back(static_cast<uint8_t>((sample >> 8) & 0xFF));
+static void writeWavSamples(const int16_t* samples, size_t count, uint8_t* bytes)
+{
+    for (size_t i = 0; i < count; ++i) {
+        bytes[i * 2] = static_cast<uint8_t>(samples[i] & 0xFF);
+        bytes[i * 2 + 1] = static_cast<uint8_t>((samples[i] >> 8) & 0xFF);
     }
+}
 
+std::vector<uint8_t> SoundGenerator::encodeWav(const AnimationSoundData& data)
+{
+    std::vector<uint8_t> wav(WavHeaderSize + data.pcmSamples.size() * 2);
+    writeWavHeader(wav.data(), data.sampleRate, data.channels, data.pcmSamples.size());
+    writeWavSamples(data.pcmSamples.data(), data.pcmSamples.size(), wav.data() + WavHeaderSize);
     return wav;
 }
 
+bool SoundGenerator::writeWav(SoundRenderer& renderer, const std::function<bool(const uint8_t*, size_t)>& write)
+{
+    uint8_t header[WavHeaderSize];
+    writeWavHeader(header, renderer.sampleRate(), renderer.channels(), renderer.sampleCount());
+    if (!write(header, sizeof(header)))
+        return false;
+
+    renderer.rewind();
+    std::vector<int16_t> pcmSamples(SoundRenderer::BlockSize);
+    std::vector<uint8_t> bytes(SoundRenderer::BlockSize * 2);
+    size_t count = 0;
+    while ((count = renderer.render(pcmSamples.data(), pcmSamples.size())) > 0) {
+        writeWavSamples(pcmSamples.data(), count, bytes.data());
+        if (!write(bytes.data(), count * 2))
+            return false;
+    }
+    return true;
+}
+
 } // namespace dust3d
@@ -24,6 +24,8 @@
 #define DUST3D_ANIMATION_SOUND_GENERATOR_H_
 
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -122,8 +124,71 @@ struct AnimationSoundData {
     float durationSeconds = 0.0f;
 };
 
+class SoundVoice;
+
+// Renders the sound of one clip in fixed-size blocks with one voice per sound event.
+// Only the voices currently sounding and one block of float samples are kept alive,
+// so memory does not grow with the clip length.
+class SoundRenderer {
+public:
+    static constexpr int SampleRate = 44100;
+    static constexpr size_t BlockSize = 1024;
+
+    SoundRenderer(const std::vector<SoundEvent>& events,
+        float durationSeconds,
+        SurfaceMaterial material,
+        float volumeScale = 1.0f);
+    ~SoundRenderer();
+
+    int sampleRate() const
+    {
+        return m_sampleRate;
+    }
+    int channels() const
+    {
+        return 1;
+    }
+    size_t sampleCount() const
+    {
+        return static_cast<size_t>(m_sampleCount);
+    }
+    float durationSeconds() const
+    {
+        return m_durationSeconds;
+    }
+
+    // Mixes up to maxSamples unnormalized samples from the current position, returns the count mixed
+    size_t mix(float* samples, size_t maxSamples);
+    // Renders up to maxSamples normalized 16-bit samples from the current position, returns the count rendered.
+    // The first call renders the whole clip once to find its peak level.
+    size_t render(int16_t* pcmSamples, size_t maxSamples);
+    void rewind();
+
+    static float normalizationGain(float peakLevel, float volumeScale);
+    static void convertToPcm(const float* samples, int16_t* pcmSamples, size_t count, float gain);
+
+private:
+    std::unique_ptr<SoundVoice> createVoice(size_t eventIndex, int startSample) const;
+    float peakLevel();
+
+    std::vector<SoundEvent> m_events;
+    SurfaceSynthParams m_params;
+    float m_volumeScale = 1.0f;
+    float m_durationSeconds = 0.0f;
+    int m_sampleRate = SampleRate;
+    int m_sampleCount = 0;
+    int m_position = 0;
+    std::vector<std::unique_ptr<SoundVoice>> m_voices;
+    std::vector<char> m_voiceFinished;
+    std::vector<float> m_block;
+    bool m_peakMeasured = false;
+    float m_peakLevel = 0.0f;
+};
+
 class SoundGenerator {
 public:
+    static constexpr size_t WavHeaderSize = 44;
+
     static AnimationSoundData generate(
         const std::vector<SoundEvent>& events,
         float durationSeconds,
@@ -132,29 +197,8 @@ public:
 
     static std::vector<uint8_t> encodeWav(const AnimationSoundData& data);
 
-private:
-    static void synthesizeImpact(
-        std::vector<float>& buffer,
-        int sampleRate,
-        float eventTime,
-        float intensity,
-        const SurfaceSynthParams& params,
-        uint32_t seed);
-
-    static void synthesizeUnderwater(
-        std::vector<float>& buffer,
-        int sampleRate,
-        float eventTime,
-        float intensity,
-        uint32_t seed);
-
-    static void synthesizeWhoosh(
-        std::vector<float>& buffer,
-        int sampleRate,
-        float eventTime,
-        float intensity,
-        float whooshDuration,
-        uint32_t seed);
+    // Streams a WAV file block by block to write, stops and returns false as soon as write fails
+    static bool writeWav(SoundRenderer& renderer, const std::function<bool(const uint8_t*, size_t)>& write);
 };
 
 } // namespace dust3d
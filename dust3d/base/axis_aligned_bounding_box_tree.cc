@@ -20,35 +20,53 @@
  *  SOFTWARE.
  */
 
+#include <algorithm>
+#include <array>
 #include <dust3d/base/axis_aligned_bounding_box_tree.h>
+#include <limits>
 
 namespace dust3d {
 
-const size_t AxisAlignedBoudingBoxTree::m_leafMaxNodeSize = 20;
+const size_t AxisAlignedBoudingBoxTree::m_leafMaxNodeSize = 8;
+const size_t AxisAlignedBoudingBoxTree::m_parallelTasksPerThread = 16;
 
-AxisAlignedBoudingBoxTree::AxisAlignedBoudingBoxTree(const std::vector<AxisAlignedBoudingBox>* boxes,
-    const std::vector<size_t>& boxIndices,
-    const AxisAlignedBoudingBox& outterBox)
-{
-    m_boxes = boxes;
+static const size_t g_binCount = 16;
 
-    m_root = new Node;
-    m_root->boundingBox = outterBox;
-    m_root->boxIndices = boxIndices;
+// Below this depth nodes are split by halving, which bounds the depth of any tree to
+// well under g_maxDepth, so queries can walk it with a fixed size stack
+static const size_t g_surfaceAreaHeuristicMaxDepth = 32;
+static const size_t g_maxDepth = 64;
 
-    if (!boxIndices.empty()) {
-        for (const auto& boxIndex : boxIndices) {
-            m_root->center += (*boxes)[boxIndex].center();
-        }
-        m_root->center /= (float)boxIndices.size();
+static AxisAlignedBoudingBoxTree::Box emptyBox()
+{
+    return AxisAlignedBoudingBoxTree::Box {
+        Vector3(std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()),
+        Vector3(std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest())
+    };
+}
+
+static void growBox(AxisAlignedBoudingBoxTree::Box& box, const Vector3& lowerBound, const Vector3& upperBound)
+{
+    for (size_t i = 0; i < 3; ++i) {
+        box.lowerBound[i] = std::min(box.lowerBound[i], lowerBound[i]);
+        box.upperBound[i] = std::max(box.upperBound[i], upperBound[i]);
     }
+}
 
-    splitNode(m_root);
+static double boxSurfaceArea(const AxisAlignedBoudingBoxTree::Box& box)
+{
+    Vector3 size = box.upperBound - box.lowerBound;
+    if (size[0] < 0 || size[1] < 0 || size[2] < 0)
+        return 0.0;
+    return 2.0 * (size[0] * size[1] + size[1] * size[2] + size[2] * size[0]);
 }
 
-const AxisAlignedBoudingBoxTree::Node* AxisAlignedBoudingBoxTree::root() const
+AxisAlignedBoudingBoxTree::AxisAlignedBoudingBoxTree(const std::vector<AxisAlignedBoudingBox>* boxes,
+    const std::vector<size_t>& boxIndices)
+    : m_boxes(boxes)
+    , m_boxIndices(boxIndices)
 {
-    return m_root;
+    build();
 }
 
 const std::vector<AxisAlignedBoudingBox>* AxisAlignedBoudingBoxTree::boxes() const
@@ -56,89 +74,290 @@ const std::vector<AxisAlignedBoudingBox>* AxisAlignedBoudingBoxTree::boxes() con
     return m_boxes;
 }
 
-AxisAlignedBoudingBoxTree::~AxisAlignedBoudingBoxTree()
+const std::vector<AxisAlignedBoudingBoxTree::Node>& AxisAlignedBoudingBoxTree::nodes() const
 {
-    deleteNode(m_root);
+    return m_nodes;
 }
 
-void AxisAlignedBoudingBoxTree::deleteNode(Node* node)
+bool AxisAlignedBoudingBoxTree::isEmpty() const
 {
-    if (nullptr == node)
-        return;
-    deleteNode(node->left);
-    deleteNode(node->right);
-    delete node;
+    return m_boxIndices.empty();
 }
 
-void AxisAlignedBoudingBoxTree::splitNode(Node* node)
+void AxisAlignedBoudingBoxTree::build()
 {
-    const auto& boxIndices = node->boxIndices;
-    if (boxIndices.size() <= m_leafMaxNodeSize)
+    if (m_boxIndices.empty())
         return;
-    const auto& splitBox = node->boundingBox;
-    const Vector3& lower = splitBox.lowerBound();
-    const Vector3& upper = splitBox.upperBound();
-    for (size_t i = 0; i < 3; ++i)
-        m_spans[i] = { i, upper[i] - lower[i] };
-    size_t longestAxis = std::max_element(m_spans.begin(), m_spans.end(), [](const std::pair<size_t, float>& first, const std::pair<size_t, float>& second) {
-        return first.second < second.second;
-    })->first;
-    auto splitPoint = node->center[longestAxis];
-    node->left = new Node;
-    node->right = new Node;
-    m_boxIndicesOrderList.resize(boxIndices.size() + boxIndices.size() + 2);
-    size_t leftOffset = boxIndices.size();
-    size_t rightOffset = boxIndices.size() - 1;
-    size_t leftCount = 0;
-    size_t rightCount = 0;
-    for (size_t i = 0; i < boxIndices.size(); ++i) {
-        const auto& boxIndex = boxIndices[i];
-        const AxisAlignedBoudingBox& box = (*m_boxes)[boxIndex];
-        const auto& center = box.center()[longestAxis];
-        if (center < splitPoint) {
-            m_boxIndicesOrderList[--leftOffset] = boxIndex;
-            ++leftCount;
-        } else {
-            m_boxIndicesOrderList[++rightOffset] = boxIndex;
-            ++rightCount;
+
+    // Work on a compact copy of the boxes, which is partitioned together with the indices
+    // and ends up in leaf order for the queries
+    m_orderedBoxes.resize(m_boxIndices.size());
+    std::vector<Vector3> centers(m_boxIndices.size());
+    Box rootBox = emptyBox();
+    Box rootCenterBox = emptyBox();
+    for (size_t i = 0; i < m_boxIndices.size(); ++i) {
+        const auto& box = (*m_boxes)[m_boxIndices[i]];
+        m_orderedBoxes[i] = Box { box.lowerBound(), box.upperBound() };
+        centers[i] = (box.lowerBound() + box.upperBound()) * 0.5;
+        growBox(rootBox, box.lowerBound(), box.upperBound());
+        growBox(rootCenterBox, centers[i], centers[i]);
+    }
+
+    m_nodes.reserve(m_boxIndices.size() / m_leafMaxNodeSize * 2 + 1);
+    m_nodes.emplace_back();
+    m_nodes[0].box = rootBox;
+    m_nodes[0].boxCount = (std::uint32_t)m_boxIndices.size();
+    std::vector<Box> centerBoxes = { rootCenterBox };
+    std::vector<std::uint8_t> binIndices(m_boxIndices.size());
+
+    std::vector<std::pair<std::uint32_t, size_t>> stack = { { 0, 0 } };
+    while (!stack.empty()) {
+        auto [nodeIndex, depth] = stack.back();
+        stack.pop_back();
+        if (!splitNode(nodeIndex, centers, centerBoxes, binIndices, depth < g_surfaceAreaHeuristicMaxDepth))
+            continue;
+        stack.push_back({ m_nodes[nodeIndex].firstChild + 1, depth + 1 });
+        stack.push_back({ m_nodes[nodeIndex].firstChild, depth + 1 });
+    }
+}
+
+bool AxisAlignedBoudingBoxTree::splitNode(std::uint32_t nodeIndex, std::vector<Vector3>& centers, std::vector<Box>& centerBoxes,
+    std::vector<std::uint8_t>& binIndices, bool useSurfaceAreaHeuristic)
+{
+    size_t boxStart = m_nodes[nodeIndex].boxStart;
+    size_t boxCount = m_nodes[nodeIndex].boxCount;
+    size_t boxEnd = boxStart + boxCount;
+
+    if (boxCount <= m_leafMaxNodeSize)
+        return false;
+
+    const Box& centerBox = centerBoxes[nodeIndex];
+    Vector3 centerSpan = centerBox.upperBound - centerBox.lowerBound;
+    size_t axis = 0;
+    if (centerSpan[1] > centerSpan[axis])
+        axis = 1;
+    if (centerSpan[2] > centerSpan[axis])
+        axis = 2;
+
+    struct Bin {
+        Box box = emptyBox();
+        Box centerBox = emptyBox();
+        size_t count = 0;
+    };
+
+    size_t middle = boxStart;
+    Box leftBox = emptyBox();
+    Box leftCenterBox = emptyBox();
+    Box rightBox = emptyBox();
+    Box rightCenterBox = emptyBox();
+    if (useSurfaceAreaHeuristic && centerSpan[axis] > 0) {
+        // Binned surface area heuristic along the longest axis of the box centers
+        std::array<Bin, g_binCount> bins;
+        double binScale = (double)g_binCount / centerSpan[axis];
+        for (size_t i = boxStart; i < boxEnd; ++i) {
+            size_t binIndex = std::min((size_t)((centers[i][axis] - centerBox.lowerBound[axis]) * binScale), g_binCount - 1);
+            binIndices[i] = (std::uint8_t)binIndex;
+            auto& bin = bins[binIndex];
+            growBox(bin.box, m_orderedBoxes[i].lowerBound, m_orderedBoxes[i].upperBound);
+            growBox(bin.centerBox, centers[i], centers[i]);
+            ++bin.count;
+        }
+        std::array<double, g_binCount> rightCosts;
+        Box sweepBox = emptyBox();
+        size_t rightCount = 0;
+        for (size_t i = g_binCount - 1; i > 0; --i) {
+            growBox(sweepBox, bins[i].box.lowerBound, bins[i].box.upperBound);
+            rightCount += bins[i].count;
+            rightCosts[i] = boxSurfaceArea(sweepBox) * rightCount;
+        }
+        sweepBox = emptyBox();
+        size_t leftCount = 0;
+        double bestCost = std::numeric_limits<double>::max();
+        size_t bestSplit = 0;
+        for (size_t i = 1; i < g_binCount; ++i) {
+            growBox(sweepBox, bins[i - 1].box.lowerBound, bins[i - 1].box.upperBound);
+            leftCount += bins[i - 1].count;
+            if (0 == leftCount || leftCount == boxCount)
+                continue;
+            double cost = boxSurfaceArea(sweepBox) * leftCount + rightCosts[i];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = i;
+            }
+        }
+        if (0 != bestSplit) {
+            size_t write = boxStart;
+            for (size_t i = boxStart; i < boxEnd; ++i) {
+                if (binIndices[i] < bestSplit) {
+                    std::swap(m_boxIndices[i], m_boxIndices[write]);
+                    std::swap(m_orderedBoxes[i], m_orderedBoxes[write]);
+                    std::swap(centers[i], centers[write]);
+                    ++write;
+                }
+            }
+            middle = write;
+            for (size_t i = 0; i < g_binCount; ++i) {
+                Box& childBox = i < bestSplit ? leftBox : rightBox;
+                Box& childCenterBox = i < bestSplit ? leftCenterBox : rightCenterBox;
+                growBox(childBox, bins[i].box.lowerBound, bins[i].box.upperBound);
+                growBox(childCenterBox, bins[i].centerBox.lowerBound, bins[i].centerBox.upperBound);
+            }
         }
     }
 
-    if (0 == leftCount) {
-        leftCount = rightCount / 2;
-        rightCount -= leftCount;
-        leftOffset = rightOffset - boxIndices.size() + 1;
-    } else if (0 == rightCount) {
-        rightCount = leftCount / 2;
-        leftCount -= rightCount;
-        rightOffset = leftOffset + boxIndices.size() - 1;
+    if (middle == boxStart || middle == boxEnd) {
+        // Too deep or all centers fall on the same spot, halve the range so leaves stay small
+        middle = boxStart + boxCount / 2;
+        for (size_t i = boxStart; i < boxEnd; ++i) {
+            Box& childBox = i < middle ? leftBox : rightBox;
+            Box& childCenterBox = i < middle ? leftCenterBox : rightCenterBox;
+            growBox(childBox, m_orderedBoxes[i].lowerBound, m_orderedBoxes[i].upperBound);
+            growBox(childCenterBox, centers[i], centers[i]);
+        }
     }
 
-    size_t middle = leftOffset + leftCount - 1;
+    std::uint32_t firstChild = (std::uint32_t)m_nodes.size();
+    m_nodes[nodeIndex].firstChild = firstChild;
+    m_nodes.emplace_back();
+    m_nodes.emplace_back();
+    Node& leftNode = m_nodes[firstChild];
+    leftNode.box = leftBox;
+    leftNode.boxStart = (std::uint32_t)boxStart;
+    leftNode.boxCount = (std::uint32_t)(middle - boxStart);
+    Node& rightNode = m_nodes[firstChild + 1];
+    rightNode.box = rightBox;
+    rightNode.boxStart = (std::uint32_t)middle;
+    rightNode.boxCount = (std::uint32_t)(boxEnd - middle);
+    centerBoxes.push_back(leftCenterBox);
+    centerBoxes.push_back(rightCenterBox);
+    return true;
+}
 
-    for (size_t i = leftOffset; i <= middle; ++i) {
-        const auto& boxIndex = m_boxIndicesOrderList[i];
-        const AxisAlignedBoudingBox& box = (*m_boxes)[boxIndex];
-        node->left->boundingBox.update(box.lowerBound());
-        node->left->boundingBox.update(box.upperBound());
-        node->left->boxIndices.push_back(boxIndex);
-        node->left->center += box.center();
+void AxisAlignedBoudingBoxTree::test(const AxisAlignedBoudingBoxTree& other,
+    std::vector<std::pair<size_t, size_t>>* pairs,
+    ThreadPool* threadPool) const
+{
+    if (isEmpty() || other.isEmpty())
+        return;
+
+    if (nullptr == threadPool || threadPool->threadCount() <= 1) {
+        testNodePair(other, { 0, 0 }, pairs);
+        return;
+    }
+
+    // Expand the top of the traversal breadth first into independent node pairs,
+    // children replace their parent in place, so walking the tasks in order
+    // visits the leaves in the same order as the serial traversal
+    size_t targetTaskCount = threadPool->threadCount() * m_parallelTasksPerThread;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> tasks = { { 0, 0 } };
+    while (tasks.size() < targetTaskCount) {
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> expandedTasks;
+        expandedTasks.reserve(tasks.size() * 2);
+        bool expanded = false;
+        for (const auto& nodePair : tasks) {
+            const Node& first = m_nodes[nodePair.first];
+            const Node& second = other.m_nodes[nodePair.second];
+            if (!first.box.intersectWith(second.box))
+                continue;
+            if (first.isLeaf() && second.isLeaf()) {
+                expandedTasks.push_back(nodePair);
+                continue;
+            }
+            if (first.isLeaf() || (!second.isLeaf() && first.boxCount < second.boxCount)) {
+                expandedTasks.push_back({ nodePair.first, second.firstChild });
+                expandedTasks.push_back({ nodePair.first, second.firstChild + 1 });
+            } else {
+                expandedTasks.push_back({ first.firstChild, nodePair.second });
+                expandedTasks.push_back({ first.firstChild + 1, nodePair.second });
+            }
+            expanded = true;
+        }
+        tasks.swap(expandedTasks);
+        if (!expanded)
+            break;
+    }
+
+    if (1 == tasks.size()) {
+        testNodePair(other, tasks[0], pairs);
+        return;
     }
 
-    for (size_t i = middle + 1; i <= rightOffset; ++i) {
-        const auto& boxIndex = m_boxIndicesOrderList[i];
-        const AxisAlignedBoudingBox& box = (*m_boxes)[boxIndex];
-        node->right->boundingBox.update(box.lowerBound());
-        node->right->boundingBox.update(box.upperBound());
-        node->right->boxIndices.push_back(boxIndex);
-        node->right->center += box.center();
+    std::vector<std::vector<std::pair<size_t, size_t>>> taskPairs(tasks.size());
+    threadPool->parallelFor(tasks.size(), [&](size_t i) {
+        testNodePair(other, tasks[i], &taskPairs[i]);
+    });
+
+    size_t pairCount = pairs->size();
+    for (const auto& it : taskPairs)
+        pairCount += it.size();
+    pairs->reserve(pairCount);
+    for (const auto& it : taskPairs)
+        pairs->insert(pairs->end(), it.begin(), it.end());
+}
+
+void AxisAlignedBoudingBoxTree::testNodePair(const AxisAlignedBoudingBoxTree& other,
+    std::pair<std::uint32_t, std::uint32_t> startPair,
+    std::vector<std::pair<size_t, size_t>>* pairs) const
+{
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> stack = { startPair };
+    while (!stack.empty()) {
+        auto nodePair = stack.back();
+        stack.pop_back();
+        const Node& first = m_nodes[nodePair.first];
+        const Node& second = other.m_nodes[nodePair.second];
+        if (!first.box.intersectWith(second.box))
+            continue;
+        if (first.isLeaf() && second.isLeaf()) {
+            size_t firstEnd = first.boxStart + first.boxCount;
+            size_t secondEnd = second.boxStart + second.boxCount;
+            for (size_t a = first.boxStart; a < firstEnd; ++a) {
+                const Box& firstBox = m_orderedBoxes[a];
+                for (size_t b = second.boxStart; b < secondEnd; ++b) {
+                    if (firstBox.intersectWith(other.m_orderedBoxes[b]))
+                        pairs->push_back(std::make_pair(m_boxIndices[a], other.m_boxIndices[b]));
+                }
+            }
+            continue;
+        }
+        // Descend into the bigger node, pushing the right child first so the left side is visited first
+        if (first.isLeaf() || (!second.isLeaf() && first.boxCount < second.boxCount)) {
+            stack.push_back({ nodePair.first, second.firstChild + 1 });
+            stack.push_back({ nodePair.first, second.firstChild });
+        } else {
+            stack.push_back({ first.firstChild + 1, nodePair.second });
+            stack.push_back({ first.firstChild, nodePair.second });
+        }
     }
+}
+
+void AxisAlignedBoudingBoxTree::testSegment(const Vector3& segmentBegin, const Vector3& segmentEnd,
+    std::vector<size_t>* boxIndices) const
+{
+    if (isEmpty())
+        return;
 
-    node->left->center /= (float)node->left->boxIndices.size();
-    splitNode(node->left);
+    Box segmentBox = emptyBox();
+    growBox(segmentBox, segmentBegin, segmentBegin);
+    growBox(segmentBox, segmentEnd, segmentEnd);
 
-    node->right->center /= (float)node->right->boxIndices.size();
-    splitNode(node->right);
+    std::uint32_t stack[g_maxDepth];
+    size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if (!node.box.intersectWith(segmentBox))
+            continue;
+        if (node.isLeaf()) {
+            size_t boxEnd = node.boxStart + node.boxCount;
+            for (size_t i = node.boxStart; i < boxEnd; ++i) {
+                if (m_orderedBoxes[i].intersectWith(segmentBox))
+                    boxIndices->push_back(m_boxIndices[i]);
+            }
+            continue;
+        }
+        stack[stackSize++] = node.firstChild + 1;
+        stack[stackSize++] = node.firstChild;
+    }
 }
 
 }
@@ -23,85 +23,71 @@
 #ifndef DUST3D_BASE_AXIS_ALIGNED_BOUNDING_BOX_TREE_H_
 #define DUST3D_BASE_AXIS_ALIGNED_BOUNDING_BOX_TREE_H_
 
+#include <cstdint>
 #include <dust3d/base/axis_aligned_bounding_box.h>
+#include <dust3d/base/thread_pool.h>
 #include <vector>
 
 namespace dust3d {
 
+// Bounding volume hierarchy stored as one flat node array.
+// The two children of a node are always stored next to each other, and every node refers to
+// a range of the reordered box list, so leaves need no allocations of their own.
 class AxisAlignedBoudingBoxTree {
 public:
+    struct Box {
+        Vector3 lowerBound;
+        Vector3 upperBound;
+
+        bool intersectWith(const Box& other) const
+        {
+            for (size_t i = 0; i < 3; ++i) {
+                if (lowerBound[i] <= other.upperBound[i] && upperBound[i] >= other.lowerBound[i])
+                    continue;
+                return false;
+            }
+            return true;
+        }
+    };
+
     struct Node {
-        AxisAlignedBoudingBox boundingBox;
-        Vector3 center;
-        std::vector<size_t> boxIndices;
-        Node* left = nullptr;
-        Node* right = nullptr;
+        Box box;
+        std::uint32_t firstChild = 0;
+        std::uint32_t boxStart = 0;
+        std::uint32_t boxCount = 0;
 
         bool isLeaf() const
         {
-            return nullptr == left && nullptr == right;
-        };
+            return 0 == firstChild;
+        }
     };
 
     AxisAlignedBoudingBoxTree(const std::vector<AxisAlignedBoudingBox>* boxes,
-        const std::vector<size_t>& boxIndices,
-        const AxisAlignedBoudingBox& outterBox);
-    const Node* root() const;
+        const std::vector<size_t>& boxIndices);
     const std::vector<AxisAlignedBoudingBox>* boxes() const;
-    ~AxisAlignedBoudingBoxTree();
-    void splitNode(Node* node);
-    void deleteNode(Node* node);
-
-    void testNodes(const Node* first,
-        const Node* second,
-        const std::vector<AxisAlignedBoudingBox>* secondBoxes,
-        std::vector<std::pair<size_t, size_t>>* pairs) const
-    {
-        if (first->boundingBox.intersectWith(second->boundingBox)) {
-            if (first->isLeaf()) {
-                if (second->isLeaf()) {
-                    for (const auto& a : first->boxIndices) {
-                        for (const auto& b : second->boxIndices) {
-                            if ((*m_boxes)[a].intersectWith((*secondBoxes)[b])) {
-                                pairs->push_back(std::make_pair(a, b));
-                            }
-                        }
-                    }
-                } else {
-                    testNodes(first, second->left, secondBoxes, pairs);
-                    testNodes(first, second->right, secondBoxes, pairs);
-                }
-            } else {
-                if (second->isLeaf()) {
-                    testNodes(first->left, second, secondBoxes, pairs);
-                    testNodes(first->right, second, secondBoxes, pairs);
-                } else {
-                    if (first->boxIndices.size() < second->boxIndices.size()) {
-                        testNodes(first, second->left, secondBoxes, pairs);
-                        testNodes(first, second->right, secondBoxes, pairs);
-                    } else {
-                        testNodes(first->left, second, secondBoxes, pairs);
-                        testNodes(first->right, second, secondBoxes, pairs);
-                    }
-                }
-            }
-        }
-    }
-
-    void test(const Node* first, const Node* second,
-        const std::vector<AxisAlignedBoudingBox>* secondBoxes,
-        std::vector<std::pair<size_t, size_t>>* pairs) const
-    {
-        testNodes(first, second, secondBoxes, pairs);
-    }
+    const std::vector<Node>& nodes() const;
+    bool isEmpty() const;
+    void test(const AxisAlignedBoudingBoxTree& other,
+        std::vector<std::pair<size_t, size_t>>* pairs,
+        ThreadPool* threadPool = nullptr) const;
+    void testSegment(const Vector3& segmentBegin, const Vector3& segmentEnd,
+        std::vector<size_t>* boxIndices) const;
 
 private:
     const std::vector<AxisAlignedBoudingBox>* m_boxes = nullptr;
-    Node* m_root = nullptr;
-    std::vector<size_t> m_boxIndicesOrderList;
-    std::vector<std::pair<size_t, float>> m_spans = std::vector<std::pair<size_t, float>>(3);
+    std::vector<Node> m_nodes;
+    std::vector<size_t> m_boxIndices;
+    std::vector<Box> m_orderedBoxes;
+
+    void build();
+    void testNodePair(const AxisAlignedBoudingBoxTree& other,
+        std::pair<std::uint32_t, std::uint32_t> startPair,
+        std::vector<std::pair<size_t, size_t>>* pairs) const;
+    bool splitNode(std::uint32_t nodeIndex, std::vector<Vector3>& centers, std::vector<Box>& centerBoxes,
+        std::vector<std::uint8_t>& binIndices, bool useSurfaceAreaHeuristic);
 
     static const size_t m_leafMaxNodeSize;
+    static const size_t m_parallelTasksPerThread;
 };
 
 }
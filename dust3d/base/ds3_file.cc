@@ -20,10 +20,12 @@
  *  SOFTWARE.
  */
 
+#include <cstdio>
 #include <cstring>
 #include <dust3d/base/debug.h>
 #include <dust3d/base/ds3_file.h>
 #include <dust3d/base/string.h>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <rapidxml.hpp>
@@ -34,6 +36,8 @@ std::string Ds3FileReader::m_applicationName = std::string("DUST3D");
 std::string Ds3FileReader::m_magicApplicationName = char(0xd3) + (char(0x3d) + std::string("DUST3D"));
 std::string Ds3FileReader::m_fileFormatVersion = std::string("1.0");
 std::string Ds3FileReader::m_headFormat = std::string("xml");
+long long Ds3FileReader::m_maxDecodedItemSize = 1024LL * 1024 * 1024;
+long long Ds3FileReader::m_maxDecodeRatio = 1032;
 
 std::string Ds3FileReader::readFirstLine(const std::uint8_t* data, size_t size)
 {
@@ -84,8 +88,7 @@ Ds3FileReader::Ds3FileReader(const std::uint8_t* fileData, size_t fileSize)
         if (nullptr == rootNode)
             return;
         m_headerIsGood = true;
-        m_fileContent = std::vector<std::uint8_t>(fileSize);
-        std::memcpy(m_fileContent.data(), fileData, fileSize);
+        m_fileData = fileData;
         for (rapidxml::xml_node<>* node = rootNode->first_node(); nullptr != node; node = node->next_sibling()) {
             Ds3ReaderItem readerItem;
             rapidxml::xml_attribute<>* attribute;
@@ -96,8 +99,23 @@ Ds3FileReader::Ds3FileReader(const std::uint8_t* fileData, size_t fileSize)
                 readerItem.offset = std::stoull(attribute->value());
             if (nullptr != (attribute = node->first_attribute("size")))
                 readerItem.size = std::stoull(attribute->value());
-            if (readerItem.offset < 0 || readerItem.size < 0)
+            if (nullptr != (attribute = node->first_attribute("encoding")))
+                readerItem.encoding = attribute->value();
+            bool hasDecodedSize = nullptr != (attribute = node->first_attribute("decodedSize"));
+            if (hasDecodedSize)
+                readerItem.decodedSize = std::stoull(attribute->value());
+            if (readerItem.offset < 0 || readerItem.size < 0 || readerItem.decodedSize < 0)
                 continue;
+            if (readerItem.encoding.empty()) {
+                if (hasDecodedSize) {
+                    dust3dDebug << "Decoded size given for plain item:" << readerItem.name;
+                    continue;
+                }
+            } else if (readerItem.decodedSize > m_maxDecodedItemSize
+                || readerItem.decodedSize / m_maxDecodeRatio > readerItem.size) {
+                dust3dDebug << "Implausible decoded size:" << readerItem.decodedSize << "for item:" << readerItem.name;
+                continue;
+            }
             if (readerItem.offset > (long long)fileSize - (long long)m_binaryOffset)
                 continue;
             if (readerItem.offset + readerItem.size > (long long)fileSize - (long long)m_binaryOffset)
@@ -116,19 +134,43 @@ Ds3FileReader::Ds3FileReader(const std::uint8_t* fileData, size_t fileSize)
     }
 }
 
-void Ds3FileReader::loadItem(const std::string& name, std::vector<std::uint8_t>* byteArray)
+void Ds3FileReader::setDecoder(const std::string& encoding, Ds3ItemCodec decoder)
+{
+    m_decoders[encoding] = std::move(decoder);
+}
+
+void Ds3FileReader::loadItem(const std::string& name, std::vector<std::uint8_t>* byteArray) const
 {
     byteArray->clear();
     if (!m_headerIsGood)
         return;
-    if (m_itemsMap.find(name) == m_itemsMap.end()) {
+    auto findItem = m_itemsMap.find(name);
+    if (findItem == m_itemsMap.end()) {
+        return;
+    }
+    const Ds3ReaderItem& readerItem = findItem->second;
+    const std::uint8_t* data = itemData(readerItem);
+    if (readerItem.encoding.empty()) {
+        byteArray->assign(data, data + readerItem.size);
+        return;
+    }
+    auto findDecoder = m_decoders.find(readerItem.encoding);
+    if (findDecoder == m_decoders.end()) {
+        dust3dDebug << "Unsupported item encoding:" << readerItem.encoding;
         return;
     }
-    Ds3ReaderItem readerItem = m_itemsMap[name];
-    byteArray->resize(readerItem.size, 0);
-    std::memcpy((char*)byteArray->data(),
-        m_fileContent.data() + m_binaryOffset + readerItem.offset,
-        byteArray->size());
+    byteArray->resize(readerItem.decodedSize);
+    if (!findDecoder->second(data, readerItem.size, byteArray)) {
+        dust3dDebug << "Decode item failed:" << readerItem.name;
+        byteArray->clear();
+    }
+}
+
+const std::uint8_t* Ds3FileReader::itemData(const Ds3ReaderItem& item) const
+{
+    if (!m_headerIsGood)
+        return nullptr;
+    return m_fileData + m_binaryOffset + item.offset;
 }
 
 const std::vector<Ds3ReaderItem>& Ds3FileReader::items() const
@@ -136,22 +178,49 @@ const std::vector<Ds3ReaderItem>& Ds3FileReader::items() const
     return m_items;
 }
 
-bool Ds3FileWriter::add(const std::string& name, const std::string& type, const void* buffer, size_t bufferSize)
+bool Ds3FileWriter::add(const std::string& name, const std::string& type, const void* buffer, size_t bufferSize, bool encode)
 {
-    if (m_itemsMap.find(name) != m_itemsMap.end()) {
+    if (m_itemIndexMap.find(name) != m_itemIndexMap.end()) {
         return false;
     }
     Ds3WriterItem writerItem;
     writerItem.type = type;
     writerItem.name = name;
-    writerItem.byteArray.resize(bufferSize);
-    for (size_t i = 0; i < bufferSize; ++i)
-        writerItem.byteArray[i] = ((const std::uint8_t*)buffer)[i];
-    m_itemsMap[name] = writerItem;
-    m_items.push_back(writerItem);
+    writerItem.data = (const std::uint8_t*)buffer;
+    writerItem.size = bufferSize;
+    writerItem.encode = encode;
+    m_itemIndexMap[name] = m_items.size();
+    m_items.push_back(std::move(writerItem));
     return true;
 }
 
+void Ds3FileWriter::setEncoder(const std::string& encoding, Ds3ItemCodec encoder, ThreadPool* threadPool)
+{
+    m_encoding = encoding;
+    m_encoder = std::move(encoder);
+    m_threadPool = threadPool;
+}
+
+void Ds3FileWriter::encodeItems()
+{
+    if (!m_encoder)
+        return;
+    std::vector<size_t> itemIndices;
+    for (size_t i = 0; i < m_items.size(); ++i) {
+        if (m_items[i].encode && !m_items[i].isEncoded && m_items[i].size > 0)
+            itemIndices.push_back(i);
+    }
+    ThreadPool* threadPool = nullptr != m_threadPool ? m_threadPool : ThreadPool::globalInstance();
+    threadPool->parallelFor(itemIndices.size(), [&](size_t i) {
+        Ds3WriterItem& writerItem = m_items[itemIndices[i]];
+        if (!m_encoder(writerItem.data, writerItem.size, &writerItem.encodedData) || writerItem.encodedData.size() >= writerItem.size) {
+            writerItem.encodedData = std::vector<std::uint8_t>();
+            return;
+        }
+        writerItem.isEncoded = true;
+    });
+}
+
 void Ds3FileWriter::getHeaderXml(std::string& headerXml)
 {
     std::ostringstream headerXmlStream;
@@ -161,11 +230,16 @@ void Ds3FileWriter::getHeaderXml(std::string& headerXml)
         long long offset = 0;
         for (size_t i = 0; i < m_items.size(); i++) {
             Ds3WriterItem* writerItem = &m_items[i];
+            size_t storedSize = writerItem->isEncoded ? writerItem->encodedData.size() : writerItem->size;
             headerXmlStream << "    <" << writerItem->type;
             headerXmlStream << " name=\"" << String::doubleQuoteEscapedForXml(writerItem->name) << "\"";
             headerXmlStream << " offset=\"" << std::to_string(offset) << "\"";
-            headerXmlStream << " size=\"" << std::to_string(writerItem->byteArray.size()) << "\"";
-            offset += writerItem->byteArray.size();
+            headerXmlStream << " size=\"" << std::to_string(storedSize) << "\"";
+            if (writerItem->isEncoded) {
+                headerXmlStream << " encoding=\"" << String::doubleQuoteEscapedForXml(m_encoding) << "\"";
+                headerXmlStream << " decodedSize=\"" << std::to_string(writerItem->size) << "\"";
+            }
+            offset += storedSize;
             headerXmlStream << "/>" << std::endl;
         }
     }
@@ -173,11 +247,9 @@ void Ds3FileWriter::getHeaderXml(std::string& headerXml)
     headerXml = headerXmlStream.str();
 }
 
-bool Ds3FileWriter::save(const std::string& filename)
+bool Ds3FileWriter::save(const Sink& sink)
 {
-    std::ofstream file(filename, std::ios::out | std::ios::trunc | std::ios::binary);
-    if (!file.is_open())
-        return false;
+    encodeItems();
 
     std::string headerXml;
     getHeaderXml(headerXml);
@@ -190,38 +262,60 @@ bool Ds3FileWriter::save(const std::string& filename)
     unsigned int headerSize = (unsigned int)(firstLineSizeExcludeSizeSelf + 12 + headerXml.size());
     char headerSizeString[100] = { 0 };
     sprintf(headerSizeString, "%010u\r\n", headerSize);
-    file.write(firstLine, firstLineSizeExcludeSizeSelf);
-    file.write(headerSizeString, strlen(headerSizeString));
-    file << headerXml;
+
+    if (!sink(firstLine, firstLineSizeExcludeSizeSelf))
+        return false;
+    if (!sink(headerSizeString, strlen(headerSizeString)))
+        return false;
+    if (!sink(headerXml.data(), headerXml.size()))
+        return false;
     for (size_t i = 0; i < m_items.size(); i++) {
         Ds3WriterItem* writerItem = &m_items[i];
-        file.write((char*)writerItem->byteArray.data(), writerItem->byteArray.size());
+        bool written = writerItem->isEncoded ? sink(writerItem->encodedData.data(), writerItem->encodedData.size())
+                                             : sink(writerItem->data, writerItem->size);
+        if (!written)
+            return false;
     }
 
     return true;
 }
 
-void Ds3FileWriter::save(std::vector<std::uint8_t>& byteArray)
+bool Ds3FileWriter::save(const std::string& filename)
 {
-    std::string headerXml;
-    getHeaderXml(headerXml);
-
-    char firstLine[1024];
-    int firstLineSizeExcludeSizeSelf = sprintf(firstLine, "%s %s %s ",
-        Ds3FileReader::m_magicApplicationName.c_str(),
-        Ds3FileReader::m_fileFormatVersion.c_str(),
-        Ds3FileReader::m_headFormat.c_str());
-    unsigned int headerSize = (unsigned int)(firstLineSizeExcludeSizeSelf + 12 + headerXml.size());
-    char headerSizeString[100] = { 0 };
-    sprintf(headerSizeString, "%010u\r\n", headerSize);
+    std::string temporaryFilename = filename + ".tmp";
+    {
+        std::ofstream file(temporaryFilename, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!file.is_open())
+            return false;
+        bool saved = save([&](const void* data, size_t size) {
+            file.write((const char*)data, size);
+            return file.good();
+        });
+        file.close();
+        if (!saved || file.fail()) {
+            std::remove(temporaryFilename.c_str());
+            return false;
+        }
+    }
 
-    byteArray.insert(byteArray.end(), firstLine, firstLine + firstLineSizeExcludeSizeSelf);
-    byteArray.insert(byteArray.end(), headerSizeString, headerSizeString + strlen(headerSizeString));
-    std::copy(headerXml.begin(), headerXml.end(), std::back_inserter(byteArray));
-    for (size_t i = 0; i < m_items.size(); i++) {
-        Ds3WriterItem* writerItem = &m_items[i];
-        byteArray.insert(byteArray.end(), (char*)writerItem->byteArray.data(), (char*)writerItem->byteArray.data() + writerItem->byteArray.size());
+    // Replaces the target in one step (MoveFileEx with MOVEFILE_REPLACE_EXISTING on Windows),
+    // on failure the written temporary file is kept next to the untouched target
+    std::error_code errorCode;
+    std::filesystem::rename(temporaryFilename, filename, errorCode);
+    if (errorCode) {
+        dust3dDebug << "Failed to replace" << filename << "with" << temporaryFilename << ":" << errorCode.message();
+        return false;
     }
+
+    return true;
+}
+
+void Ds3FileWriter::save(std::vector<std::uint8_t>& byteArray)
+{
+    save([&](const void* data, size_t size) {
+        byteArray.insert(byteArray.end(), (const std::uint8_t*)data, (const std::uint8_t*)data + size);
+        return true;
+    });
 }
 
 }
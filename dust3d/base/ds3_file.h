@@ -25,34 +25,54 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <dust3d/base/thread_pool.h>
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
 
 namespace dust3d {
 
+// Items may be stored encoded, for example deflated, the codec itself is supplied by the caller.
+// An encoder fills the output with the encoded data; a decoder is handed an output which is
+// already sized to the decoded size and must fill it exactly.
+typedef std::function<bool(const std::uint8_t* data, size_t size, std::vector<std::uint8_t>* output)> Ds3ItemCodec;
+
 class Ds3ReaderItem {
 public:
     std::string type;
     std::string name;
-    long long offset;
-    long long size;
+    long long offset = 0;
+    long long size = 0;
+    std::string encoding;
+    long long decodedSize = 0;
 };
 
+// Reads the file in place: only the xml header is copied for parsing, and items are
+// handed out as pointers into the given data, which must outlive the reader.
 class Ds3FileReader {
 public:
     Ds3FileReader(const std::uint8_t* fileData, size_t fileSize);
-    void loadItem(const std::string& name, std::vector<std::uint8_t>* byteArray);
+    void setDecoder(const std::string& encoding, Ds3ItemCodec decoder);
+    // Decodes encoded items, an item whose decoder is missing or fails loads empty
+    void loadItem(const std::string& name, std::vector<std::uint8_t>* byteArray) const;
+    // The stored bytes, which are only the item content itself when the item has no encoding
+    const std::uint8_t* itemData(const Ds3ReaderItem& item) const;
     const std::vector<Ds3ReaderItem>& items() const;
     static std::string m_applicationName;
     static std::string m_magicApplicationName;
     static std::string m_fileFormatVersion;
     static std::string m_headFormat;
+    // Encoded items claiming to decode to more than this, or to more than deflate can expand
+    // their stored size to, are dropped when the header is read
+    static long long m_maxDecodedItemSize;
+    static long long m_maxDecodeRatio;
 
 private:
     std::map<std::string, Ds3ReaderItem> m_itemsMap;
     std::vector<Ds3ReaderItem> m_items;
-    std::vector<std::uint8_t> m_fileContent;
+    std::map<std::string, Ds3ItemCodec> m_decoders;
+    const std::uint8_t* m_fileData = nullptr;
 
 private:
     static std::string readFirstLine(const std::uint8_t* data, size_t size);
@@ -64,19 +84,35 @@ class Ds3WriterItem {
 public:
     std::string type;
     std::string name;
-    std::vector<std::uint8_t> byteArray;
+    const std::uint8_t* data = nullptr;
+    size_t size = 0;
+    bool encode = false;
+    bool isEncoded = false;
+    std::vector<std::uint8_t> encodedData;
 };
 
+// Items reference the added buffers instead of copying them, so the buffers must stay valid
+// until saving is done. Items added for encoding are encoded in parallel right before the
+// header is written, and keep their plain form when encoding does not make them smaller.
 class Ds3FileWriter {
 public:
-    bool add(const std::string& name, const std::string& type, const void* buffer, size_t bufferSize);
+    typedef std::function<bool(const void* data, size_t size)> Sink;
+
+    bool add(const std::string& name, const std::string& type, const void* buffer, size_t bufferSize, bool encode = false);
+    void setEncoder(const std::string& encoding, Ds3ItemCodec encoder, ThreadPool* threadPool = nullptr);
+    // Writes through a temporary file which then atomically replaces the target, so a failed save
+    // leaves the previous file untouched; if the replace fails the temporary file is kept
     bool save(const std::string& filename);
     void save(std::vector<std::uint8_t>& byteArray);
+    bool save(const Sink& sink);
 
 private:
-    std::map<std::string, Ds3WriterItem> m_itemsMap;
+    std::map<std::string, size_t> m_itemIndexMap;
     std::vector<Ds3WriterItem> m_items;
-    std::string m_filename;
+    std::string m_encoding;
+    Ds3ItemCodec m_encoder;
+    ThreadPool* m_threadPool = nullptr;
+    void encodeItems();
     void getHeaderXml(std::string& headerXml);
 };
 
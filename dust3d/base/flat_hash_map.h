@@ -0,0 +1,251 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_BASE_FLAT_HASH_MAP_H_
+#define DUST3D_BASE_FLAT_HASH_MAP_H_
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace dust3d {
+
+// Open addressing hash map with linear probing over one contiguous slot array.
+// It covers the subset of std::map used by the position keyed lookups: insert, find, operator[],
+// iteration and clear. Entries are never erased, so no tombstones are needed, and iteration
+// order follows the slots, not the keys. The hash must spread its bits well, since the slot
+// is taken from the low bits directly.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap {
+public:
+    typedef std::pair<Key, Value> value_type;
+
+    template <typename MapType, typename ValueType>
+    class Iterator {
+    public:
+        Iterator(MapType* map, size_t slot)
+            : m_map(map)
+            , m_slot(slot)
+        {
+            skipEmptySlots();
+        }
+
+        ValueType& operator*() const
+        {
+            return *m_map->m_slots[m_slot];
+        }
+
+        ValueType* operator->() const
+        {
+            return &*m_map->m_slots[m_slot];
+        }
+
+        Iterator& operator++()
+        {
+            ++m_slot;
+            skipEmptySlots();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return m_slot == other.m_slot;
+        }
+
+        bool operator!=(const Iterator& other) const
+        {
+            return m_slot != other.m_slot;
+        }
+
+    private:
+        MapType* m_map = nullptr;
+        size_t m_slot = 0;
+
+        void skipEmptySlots()
+        {
+            while (m_slot < m_map->m_slots.size() && !m_map->m_slots[m_slot].has_value())
+                ++m_slot;
+        }
+    };
+
+    typedef Iterator<FlatHashMap, value_type> iterator;
+    typedef Iterator<const FlatHashMap, const value_type> const_iterator;
+
+    FlatHashMap() = default;
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return 0 == m_size;
+    }
+
+    void clear()
+    {
+        m_slots.clear();
+        m_size = 0;
+    }
+
+    void reserve(size_t count)
+    {
+        size_t capacity = m_minCapacity;
+        while (capacity * m_maxLoadNumerator < count * m_maxLoadDenominator)
+            capacity *= 2;
+        if (capacity > m_slots.size())
+            rehash(capacity);
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    iterator end()
+    {
+        return iterator(this, m_slots.size());
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, m_slots.size());
+    }
+
+    iterator find(const Key& key)
+    {
+        return iterator(this, findSlot(key));
+    }
+
+    const_iterator find(const Key& key) const
+    {
+        return const_iterator(this, findSlot(key));
+    }
+
+    size_t count(const Key& key) const
+    {
+        return findSlot(key) == m_slots.size() ? 0 : 1;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return emplaceWithKey(value.first, value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return emplaceWithKey(value.first, std::move(value));
+    }
+
+    template <typename Pair>
+    std::pair<iterator, bool> emplace(Pair&& pair)
+    {
+        return emplaceWithKey(pair.first, std::forward<Pair>(pair));
+    }
+
+    template <typename K, typename V>
+    std::pair<iterator, bool> emplace(K&& key, V&& value)
+    {
+        return emplaceWithKey(key, std::forward<K>(key), std::forward<V>(value));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+    {
+        return emplaceWithKey(key, std::piecewise_construct,
+            std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    Value& operator[](const Key& key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+private:
+    std::vector<std::optional<value_type>> m_slots;
+    size_t m_size = 0;
+
+    static const size_t m_minCapacity = 16;
+    static const size_t m_maxLoadNumerator = 7;
+    static const size_t m_maxLoadDenominator = 8;
+
+    // Returns the slot holding the key, or the empty slot where it belongs
+    size_t probe(const Key& key) const
+    {
+        size_t mask = m_slots.size() - 1;
+        size_t slot = Hash()(key) & mask;
+        while (m_slots[slot].has_value() && !(m_slots[slot]->first == key))
+            slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    // Probes for the key first, so an existing entry costs neither a value_type nor a rehash
+    template <typename... Args>
+    std::pair<iterator, bool> emplaceWithKey(const Key& key, Args&&... args)
+    {
+        size_t slot = m_slots.size();
+        if (!m_slots.empty()) {
+            slot = probe(key);
+            if (m_slots[slot].has_value())
+                return { iterator(this, slot), false };
+        }
+        if ((m_size + 1) * m_maxLoadDenominator > m_slots.size() * m_maxLoadNumerator) {
+            rehash(m_slots.empty() ? m_minCapacity : m_slots.size() * 2);
+            slot = probe(key);
+        }
+        m_slots[slot].emplace(std::forward<Args>(args)...);
+        ++m_size;
+        return { iterator(this, slot), true };
+    }
+
+    size_t findSlot(const Key& key) const
+    {
+        if (m_slots.empty())
+            return m_slots.size();
+        size_t slot = probe(key);
+        return m_slots[slot].has_value() ? slot : m_slots.size();
+    }
+
+    void rehash(size_t capacity)
+    {
+        std::vector<std::optional<value_type>> oldSlots(capacity);
+        oldSlots.swap(m_slots);
+        for (auto& it : oldSlots) {
+            if (!it.has_value())
+                continue;
+            m_slots[probe(it->first)].emplace(std::move(*it));
+        }
+    }
+};
+
+}
+
+#endif
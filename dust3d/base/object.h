@@ -24,12 +24,15 @@
 #define DUST3D_BASE_OBJECT_H_
 
 #include <array>
+#include <cstdint>
 #include <dust3d/base/color.h>
+#include <dust3d/base/flat_hash_map.h>
 #include <dust3d/base/position_key.h>
 #include <dust3d/base/rectangle.h>
 #include <dust3d/base/uuid.h>
 #include <dust3d/base/vector2.h>
 #include <dust3d/base/vector3.h>
+#include <limits>
 #include <map>
 #include <set>
 #include <unordered_map>
@@ -53,19 +56,32 @@ struct ObjectNode {
     //bool joined = true;
 };
 
+// UV chart data of a triangle, carried from the mesh builders through every mesh boolean
+struct ObjectTriangleChart {
+    static constexpr std::uint32_t InvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+    // Component whose chart uv belongs to, as an index into the component ids the charts come with
+    std::uint32_t componentIndex = InvalidIndex;
+    std::array<Vector2, 3> uv;
+    // Bridging triangle of a boolean seam, laid out [small0, small1, large] on the small side
+    // of the seam and [large0, large1, small] on the large side
+    std::uint32_t seamIndex = InvalidIndex;
+    bool isSmallSide = false;
+    // Left in the seam area of a boolean that could not be bridged, and the component it was combined in
+    bool isBroken = false;
+    std::uint32_t brokenComponentIndex = InvalidIndex;
+};
+
 class Object {
 public:
     std::vector<Vector3> vertices;
-    std::map<PositionKey, Uuid> positionToNodeIdMap;
+    FlatHashMap<PositionKey, Uuid> positionToNodeIdMap;
     std::map<Uuid, ObjectNode> nodeMap;
     std::vector<std::vector<size_t>> triangleAndQuads;
     std::vector<std::vector<size_t>> triangles;
-    std::unordered_map<Uuid, std::map<std::array<PositionKey, 3>, std::array<Vector2, 3>>> componentTriangleUvs;
-    std::vector<std::pair<std::set<std::array<PositionKey, 3>>, std::set<std::array<PositionKey, 3>>>> seamTriangleUvs;
     std::vector<Vector3> triangleNormals;
     std::vector<Color> vertexColors;
     std::vector<float> vertexSmoothCutoffDegrees;
-    std::map<std::array<PositionKey, 3>, Uuid> brokenTrianglesToComponentIdMap;
 
     // Bone binding data: each vertex can be bound to at most 2 bones with interpolation weights
     // Indexed parallel to vertices; bone names and weights stored in pairs
@@ -149,10 +165,27 @@ public:
         m_hasTriangleLinks = true;
     }
 
+    // UV chart of each triangle, indexed parallel to triangles, the component indices
+    // of the charts refer to chartComponentIds()
+    const std::vector<ObjectTriangleChart>* triangleCharts() const
+    {
+        if (!m_hasTriangleCharts)
+            return nullptr;
+        return &m_triangleCharts;
+    }
+    const std::vector<Uuid>& chartComponentIds() const
+    {
+        return m_chartComponentIds;
+    }
+    void setTriangleCharts(const std::vector<ObjectTriangleChart>& charts, const std::vector<Uuid>& componentIds)
+    {
+        m_triangleCharts = charts;
+        m_chartComponentIds = componentIds;
+        m_hasTriangleCharts = true;
+    }
+
     void copyUvFrom(const Object& source)
     {
-        componentTriangleUvs = source.componentTriangleUvs;
-        seamTriangleUvs = source.seamTriangleUvs;
         if (source.m_hasTriangleVertexUvs) {
             m_triangleVertexUvs = source.m_triangleVertexUvs;
             m_hasTriangleVertexUvs = true;
@@ -183,6 +216,10 @@ private:
     bool m_hasPartUvRects = false;
     std::map<Uuid, std::vector<Rectangle>> m_partUvRects;
 
+    bool m_hasTriangleCharts = false;
+    std::vector<ObjectTriangleChart> m_triangleCharts;
+    std::vector<Uuid> m_chartComponentIds;
+
     bool m_hasTriangleLinks = false;
     std::vector<std::pair<std::pair<size_t, size_t>, std::pair<size_t, size_t>>> m_triangleLinks;
 };
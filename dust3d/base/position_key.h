@@ -23,6 +23,8 @@
 #ifndef DUST3D_BASE_POSITION_KEY_H_
 #define DUST3D_BASE_POSITION_KEY_H_
 
+#include <array>
+#include <cstdint>
 #include <dust3d/base/vector3.h>
 
 namespace dust3d {
@@ -34,6 +36,24 @@ public:
     bool operator<(const PositionKey& right) const;
     bool operator==(const PositionKey& right) const;
 
+    // Spreads every input bit over the whole word, so open addressing tables can take
+    // the low bits directly
+    inline size_t hash() const
+    {
+        std::uint64_t value = mix((std::uint64_t)m_intX);
+        value = mix(value ^ (std::uint64_t)m_intY);
+        value = mix(value ^ (std::uint64_t)m_intZ);
+        return (size_t)value;
+    }
+
+    static inline std::uint64_t mix(std::uint64_t value)
+    {
+        value += 0x9e3779b97f4a7c15ull;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
 private:
     long m_intX;
     long m_intY;
@@ -44,4 +64,27 @@ private:
 
 }
 
+namespace std {
+
+template <>
+struct hash<dust3d::PositionKey> {
+    size_t operator()(const dust3d::PositionKey& key) const
+    {
+        return key.hash();
+    }
+};
+
+template <>
+struct hash<std::array<dust3d::PositionKey, 3>> {
+    size_t operator()(const std::array<dust3d::PositionKey, 3>& keys) const
+    {
+        std::uint64_t value = keys[0].hash();
+        value = dust3d::PositionKey::mix(value ^ keys[1].hash());
+        value = dust3d::PositionKey::mix(value ^ keys[2].hash());
+        return (size_t)value;
+    }
+};
+
+}
+
 #endif
@@ -0,0 +1,524 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <cstring>
+#include <dust3d/base/snapshot_binary.h>
+#include <dust3d/base/string.h>
+#include <unordered_map>
+
+namespace dust3d {
+
+static const char snapshotBinaryMagic[] = { 'D', 'S', '3', 'S' };
+static const std::uint8_t snapshotBinaryVersion = 1;
+
+enum class SnapshotBinaryValueType : std::uint8_t {
+    String = 0,
+    Uuid,
+    Decimal,
+    True,
+    False
+};
+
+static int hexDigitValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return -1;
+}
+
+static bool isUuidDashPosition(size_t position)
+{
+    return 9 == position || 14 == position || 19 == position || 24 == position;
+}
+
+// Only the exact form written by the application, "{xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx}" in lower case,
+// is packed, so the string comes back unchanged
+static bool packUuid(const std::string& value, std::uint8_t* bytes)
+{
+    if (38 != value.size() || '{' != value.front() || '}' != value.back())
+        return false;
+    size_t byteIndex = 0;
+    for (size_t i = 1; i + 1 < value.size();) {
+        if (isUuidDashPosition(i)) {
+            if ('-' != value[i])
+                return false;
+            ++i;
+            continue;
+        }
+        int high = hexDigitValue(value[i]);
+        int low = hexDigitValue(value[i + 1]);
+        if (high < 0 || low < 0 || isUuidDashPosition(i + 1))
+            return false;
+        bytes[byteIndex++] = (std::uint8_t)((high << 4) | low);
+        i += 2;
+    }
+    return 16 == byteIndex;
+}
+
+static std::string unpackUuid(const std::uint8_t* bytes)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    std::string value(38, '-');
+    value.front() = '{';
+    value.back() = '}';
+    size_t byteIndex = 0;
+    for (size_t i = 1; i + 1 < value.size();) {
+        if (isUuidDashPosition(i)) {
+            ++i;
+            continue;
+        }
+        value[i] = hexDigits[bytes[byteIndex] >> 4];
+        value[i + 1] = hexDigits[bytes[byteIndex] & 0x0f];
+        ++byteIndex;
+        i += 2;
+    }
+    return value;
+}
+
+// Decimal in its canonical form, -?(0|[1-9][0-9]*)(\.[0-9]+)?, stored as mantissa and scale,
+// the number of fraction digits is kept so trailing zeros survive
+static bool packDecimal(const std::string& value, std::int64_t* mantissa, std::uint64_t* scale)
+{
+    size_t i = 0;
+    bool negative = false;
+    if (i < value.size() && '-' == value[i]) {
+        negative = true;
+        ++i;
+    }
+    size_t integerBegin = i;
+    while (i < value.size() && value[i] >= '0' && value[i] <= '9')
+        ++i;
+    size_t integerDigits = i - integerBegin;
+    if (0 == integerDigits || (integerDigits > 1 && '0' == value[integerBegin]))
+        return false;
+    size_t fractionDigits = 0;
+    if (i < value.size() && '.' == value[i]) {
+        ++i;
+        size_t fractionBegin = i;
+        while (i < value.size() && value[i] >= '0' && value[i] <= '9')
+            ++i;
+        fractionDigits = i - fractionBegin;
+        if (0 == fractionDigits)
+            return false;
+    }
+    if (i != value.size() || integerDigits + fractionDigits > 18)
+        return false;
+    std::int64_t magnitude = 0;
+    for (size_t j = integerBegin; j < value.size(); ++j) {
+        if ('.' == value[j])
+            continue;
+        magnitude = magnitude * 10 + (value[j] - '0');
+    }
+    if (negative && 0 == magnitude)
+        return false;
+    *mantissa = negative ? -magnitude : magnitude;
+    *scale = fractionDigits;
+    return true;
+}
+
+static std::string unpackDecimal(std::int64_t mantissa, std::uint64_t scale)
+{
+    char buffer[24];
+    char* end = buffer + sizeof(buffer);
+    char* begin = end;
+    std::uint64_t magnitude = mantissa < 0 ? -(std::uint64_t)mantissa : (std::uint64_t)mantissa;
+    for (std::uint64_t digitIndex = 0; 0 != magnitude || digitIndex <= scale; ++digitIndex) {
+        if (scale > 0 && digitIndex == scale)
+            *--begin = '.';
+        *--begin = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    if (mantissa < 0)
+        *--begin = '-';
+    return std::string(begin, end);
+}
+
+class SnapshotBinaryWriter {
+public:
+    void writeVarint(std::uint64_t value)
+    {
+        writeVarint(m_body, value);
+    }
+
+    // Items lead with their id, so the reader can fill the item map in place
+    void writeItem(const std::map<std::string, std::string>& attributes, const std::string& id, bool skipInternal, bool skipChildren)
+    {
+        writeValue(id);
+        writeAttributes(attributes, skipInternal, skipChildren, true);
+    }
+
+    void writeAttributes(const std::map<std::string, std::string>& attributes, bool skipInternal, bool skipChildren, bool skipId)
+    {
+        size_t count = 0;
+        for (const auto& it : attributes) {
+            if (isSkipped(it.first, skipInternal, skipChildren, skipId))
+                continue;
+            ++count;
+        }
+        writeVarint(count);
+        for (const auto& it : attributes) {
+            if (isSkipped(it.first, skipInternal, skipChildren, skipId))
+                continue;
+            writeVarint(internString(it.first));
+            writeValue(it.second);
+        }
+    }
+
+    void finish(std::vector<std::uint8_t>& byteArray)
+    {
+        byteArray.insert(byteArray.end(), snapshotBinaryMagic, snapshotBinaryMagic + sizeof(snapshotBinaryMagic));
+        byteArray.push_back(snapshotBinaryVersion);
+        writeVarint(byteArray, m_strings.size());
+        for (const auto& it : m_strings) {
+            writeVarint(byteArray, it->size());
+            byteArray.insert(byteArray.end(), it->begin(), it->end());
+        }
+        writeVarint(byteArray, m_uuids.size() / 16);
+        byteArray.insert(byteArray.end(), m_uuids.begin(), m_uuids.end());
+        byteArray.insert(byteArray.end(), m_body.begin(), m_body.end());
+    }
+
+private:
+    std::unordered_map<std::string, size_t> m_stringMap;
+    std::vector<const std::string*> m_strings;
+    std::unordered_map<std::string, size_t> m_uuidMap;
+    std::vector<std::uint8_t> m_uuids;
+    std::vector<std::uint8_t> m_body;
+
+    static void writeVarint(std::vector<std::uint8_t>& byteArray, std::uint64_t value)
+    {
+        while (value >= 0x80) {
+            byteArray.push_back((std::uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        byteArray.push_back((std::uint8_t)value);
+    }
+
+    static bool isSkipped(const std::string& name, bool skipInternal, bool skipChildren, bool skipId)
+    {
+        if (skipId && "id" == name)
+            return true;
+        if (skipChildren && "children" == name)
+            return true;
+        if (skipInternal && String::startsWith(name, "__"))
+            return true;
+        return false;
+    }
+
+    size_t internString(const std::string& value)
+    {
+        auto findString = m_stringMap.find(value);
+        if (findString != m_stringMap.end())
+            return findString->second;
+        auto insertResult = m_stringMap.insert({ value, m_strings.size() });
+        m_strings.push_back(&insertResult.first->first);
+        return insertResult.first->second;
+    }
+
+    void writeValue(const std::string& value)
+    {
+        if ("true" == value) {
+            m_body.push_back((std::uint8_t)SnapshotBinaryValueType::True);
+            return;
+        }
+        if ("false" == value) {
+            m_body.push_back((std::uint8_t)SnapshotBinaryValueType::False);
+            return;
+        }
+        std::int64_t mantissa = 0;
+        std::uint64_t scale = 0;
+        if (packDecimal(value, &mantissa, &scale)) {
+            m_body.push_back((std::uint8_t)SnapshotBinaryValueType::Decimal);
+            writeVarint(((std::uint64_t)mantissa << 1) ^ (std::uint64_t)(mantissa >> 63));
+            writeVarint(scale);
+            return;
+        }
+        std::uint8_t uuidBytes[16];
+        if (packUuid(value, uuidBytes)) {
+            auto findUuid = m_uuidMap.find(value);
+            if (findUuid == m_uuidMap.end()) {
+                findUuid = m_uuidMap.insert({ value, m_uuidMap.size() }).first;
+                m_uuids.insert(m_uuids.end(), uuidBytes, uuidBytes + 16);
+            }
+            m_body.push_back((std::uint8_t)SnapshotBinaryValueType::Uuid);
+            writeVarint(findUuid->second);
+            return;
+        }
+        m_body.push_back((std::uint8_t)SnapshotBinaryValueType::String);
+        writeVarint(internString(value));
+    }
+};
+
+class SnapshotBinaryReader {
+public:
+    SnapshotBinaryReader(const std::uint8_t* data, size_t size)
+        : m_data(data)
+        , m_end(data + size)
+    {
+    }
+
+    bool readHeader()
+    {
+        if ((size_t)(m_end - m_data) < sizeof(snapshotBinaryMagic) + 1)
+            return false;
+        if (0 != memcmp(m_data, snapshotBinaryMagic, sizeof(snapshotBinaryMagic)))
+            return false;
+        m_data += sizeof(snapshotBinaryMagic);
+        if (snapshotBinaryVersion != *m_data++)
+            return false;
+        std::uint64_t stringCount = 0;
+        if (!readVarint(&stringCount) || stringCount > (std::uint64_t)(m_end - m_data))
+            return false;
+        m_strings.resize(stringCount);
+        for (auto& it : m_strings) {
+            std::uint64_t length = 0;
+            if (!readVarint(&length) || length > (std::uint64_t)(m_end - m_data))
+                return false;
+            it.assign((const char*)m_data, length);
+            m_data += length;
+        }
+        std::uint64_t uuidCount = 0;
+        if (!readVarint(&uuidCount) || uuidCount > (std::uint64_t)(m_end - m_data) / 16)
+            return false;
+        m_uuids.resize(uuidCount);
+        for (auto& it : m_uuids) {
+            it = unpackUuid(m_data);
+            m_data += 16;
+        }
+        return true;
+    }
+
+    bool readVarint(std::uint64_t* value)
+    {
+        std::uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (m_data >= m_end)
+                return false;
+            std::uint8_t byte = *m_data++;
+            result |= (std::uint64_t)(byte & 0x7f) << shift;
+            if (0 == (byte & 0x80)) {
+                *value = result;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool readAttributes(std::map<std::string, std::string>* attributes)
+    {
+        std::uint64_t count = 0;
+        if (!readVarint(&count))
+            return false;
+        for (std::uint64_t i = 0; i < count; ++i) {
+            std::uint64_t nameIndex = 0;
+            if (!readVarint(&nameIndex) || nameIndex >= m_strings.size())
+                return false;
+            auto attribute = attributes->emplace_hint(attributes->end(), m_strings[nameIndex], std::string());
+            if (!readValue(&attribute->second))
+                return false;
+        }
+        return true;
+    }
+
+    bool isAtEnd() const
+    {
+        return m_data == m_end;
+    }
+
+    bool readValue(std::string* value)
+    {
+        if (m_data >= m_end)
+            return false;
+        std::uint64_t index = 0;
+        switch ((SnapshotBinaryValueType)*m_data++) {
+        case SnapshotBinaryValueType::String:
+            if (!readVarint(&index) || index >= m_strings.size())
+                return false;
+            *value = m_strings[index];
+            return true;
+        case SnapshotBinaryValueType::Uuid:
+            if (!readVarint(&index) || index >= m_uuids.size())
+                return false;
+            *value = m_uuids[index];
+            return true;
+        case SnapshotBinaryValueType::Decimal: {
+            std::uint64_t zigzag = 0;
+            std::uint64_t scale = 0;
+            if (!readVarint(&zigzag) || !readVarint(&scale) || scale > 18)
+                return false;
+            *value = unpackDecimal((std::int64_t)(zigzag >> 1) ^ -(std::int64_t)(zigzag & 1), scale);
+            return true;
+        }
+        case SnapshotBinaryValueType::True:
+            *value = "true";
+            return true;
+        case SnapshotBinaryValueType::False:
+            *value = "false";
+            return true;
+        default:
+            return false;
+        }
+    }
+
+private:
+    const std::uint8_t* m_data = nullptr;
+    const std::uint8_t* m_end = nullptr;
+    std::vector<std::string> m_strings;
+    std::vector<std::string> m_uuids;
+};
+
+static void saveItems(SnapshotBinaryWriter& writer, const std::map<std::string, std::map<std::string, std::string>>& items, bool skipInternal)
+{
+    size_t count = 0;
+    for (const auto& it : items) {
+        if (it.second.end() != it.second.find("id"))
+            ++count;
+    }
+    writer.writeVarint(count);
+    for (const auto& it : items) {
+        auto findId = it.second.find("id");
+        if (it.second.end() == findId)
+            continue;
+        writer.writeItem(it.second, findId->second, skipInternal, false);
+    }
+}
+
+static bool loadItems(SnapshotBinaryReader& reader, std::map<std::string, std::map<std::string, std::string>>* items)
+{
+    std::uint64_t count = 0;
+    if (!reader.readVarint(&count))
+        return false;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        std::string id;
+        if (!reader.readValue(&id))
+            return false;
+        auto& item = (*items)[id];
+        item["id"] = id;
+        if (!reader.readAttributes(&item))
+            return false;
+    }
+    return true;
+}
+
+static std::vector<const std::map<std::string, std::string>*> savableChildComponents(const Snapshot& snapshot, const std::string& childrenIds)
+{
+    std::vector<const std::map<std::string, std::string>*> children;
+    for (const auto& componentId : String::split(childrenIds, ',')) {
+        if (componentId.empty())
+            continue;
+        const auto findComponent = snapshot.components.find(componentId);
+        if (findComponent == snapshot.components.end())
+            continue;
+        if (findComponent->second.end() == findComponent->second.find("id"))
+            continue;
+        children.push_back(&findComponent->second);
+    }
+    return children;
+}
+
+static void saveComponentChildren(SnapshotBinaryWriter& writer, const Snapshot& snapshot, const std::string& childrenIds)
+{
+    auto children = savableChildComponents(snapshot, childrenIds);
+    writer.writeVarint(children.size());
+    for (const auto& component : children) {
+        writer.writeItem(*component, component->find("id")->second, true, true);
+        auto findChildren = component->find("children");
+        saveComponentChildren(writer, snapshot, findChildren == component->end() ? std::string() : findChildren->second);
+    }
+}
+
+static bool loadComponentChildren(SnapshotBinaryReader& reader, Snapshot* snapshot, std::string* childrenIds)
+{
+    std::uint64_t count = 0;
+    if (!reader.readVarint(&count))
+        return false;
+    std::vector<std::string> children;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        std::string componentId;
+        if (!reader.readValue(&componentId))
+            return false;
+        children.push_back(componentId);
+        auto& component = snapshot->components[componentId];
+        component["id"] = componentId;
+        if (!reader.readAttributes(&component))
+            return false;
+        if (!loadComponentChildren(reader, snapshot, &component["children"]))
+            return false;
+    }
+    *childrenIds = String::join(children, ",");
+    return true;
+}
+
+bool loadSnapshotFromBinary(Snapshot* snapshot, const std::uint8_t* data, size_t size)
+{
+    if (nullptr == data)
+        return false;
+    SnapshotBinaryReader reader(data, size);
+    if (!reader.readHeader())
+        return false;
+    Snapshot result;
+    if (!reader.readAttributes(&result.canvas))
+        return false;
+    if (!loadItems(reader, &result.nodes))
+        return false;
+    if (!loadItems(reader, &result.edges))
+        return false;
+    if (!loadItems(reader, &result.parts))
+        return false;
+    std::uint64_t hasComponents = 0;
+    if (!reader.readVarint(&hasComponents))
+        return false;
+    if (0 != hasComponents) {
+        std::string childrenIds;
+        if (!loadComponentChildren(reader, &result, &childrenIds))
+            return false;
+        result.rootComponent["children"] = childrenIds;
+    }
+    if (!loadItems(reader, &result.animations))
+        return false;
+    if (!reader.isAtEnd())
+        return false;
+    *snapshot = std::move(result);
+    return true;
+}
+
+void saveSnapshotToBinary(const Snapshot& snapshot, std::vector<std::uint8_t>& byteArray)
+{
+    SnapshotBinaryWriter writer;
+    writer.writeAttributes(snapshot.canvas, false, false, false);
+    saveItems(writer, snapshot.nodes, false);
+    saveItems(writer, snapshot.edges, false);
+    saveItems(writer, snapshot.parts, true);
+    const auto& childrenIds = snapshot.rootComponent.find("children");
+    if (childrenIds != snapshot.rootComponent.end()) {
+        writer.writeVarint(1);
+        saveComponentChildren(writer, snapshot, childrenIds->second);
+    } else {
+        writer.writeVarint(0);
+    }
+    saveItems(writer, snapshot.animations, false);
+    writer.finish(byteArray);
+}
+
+}
@@ -0,0 +1,40 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_BASE_SNAPSHOT_BINARY_H_
+#define DUST3D_BASE_SNAPSHOT_BINARY_H_
+
+#include <cstdint>
+#include <dust3d/base/snapshot.h>
+#include <vector>
+
+namespace dust3d {
+
+// Compact counterpart of the xml snapshot. Attribute names and plain string values are interned,
+// uuids are stored once as 16 bytes and referenced by index, and decimal, boolean values are typed.
+// Loading yields the same snapshot as loading the xml written from the same source.
+bool loadSnapshotFromBinary(Snapshot* snapshot, const std::uint8_t* data, size_t size);
+void saveSnapshotToBinary(const Snapshot& snapshot, std::vector<std::uint8_t>& byteArray);
+
+}
+
+#endif
@@ -0,0 +1,270 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <dust3d/base/snapshot_history.h>
+
+namespace dust3d {
+
+static size_t attributesMemoryUsage(const std::map<std::string, std::string>& attributes)
+{
+    // Rough cost of a map node plus the characters of its key and value, counted by size rather
+    // than capacity so the same attributes cost the same in every copy
+    size_t bytes = 0;
+    for (const auto& it : attributes)
+        bytes += 64 + it.first.size() + it.second.size();
+    return bytes;
+}
+
+static size_t entityMemoryUsage(const std::string& id, const std::map<std::string, std::string>& attributes)
+{
+    return 64 + id.size() + attributesMemoryUsage(attributes);
+}
+
+static size_t entitiesMemoryUsage(const std::map<std::string, std::map<std::string, std::string>>& entities)
+{
+    size_t bytes = 0;
+    for (const auto& it : entities)
+        bytes += entityMemoryUsage(it.first, it.second);
+    return bytes;
+}
+
+SnapshotDelta::SnapshotDelta(const Snapshot& from, const Snapshot& to)
+{
+    diffAttributes(Section::Canvas, from.canvas, to.canvas);
+    diffAttributes(Section::RootComponent, from.rootComponent, to.rootComponent);
+    diffEntities(Section::Nodes, from.nodes, to.nodes);
+    diffEntities(Section::Edges, from.edges, to.edges);
+    diffEntities(Section::Parts, from.parts, to.parts);
+    diffEntities(Section::Components, from.components, to.components);
+    diffEntities(Section::Animations, from.animations, to.animations);
+
+    for (const auto& change : m_changes) {
+        m_memoryUsage += sizeof(EntityChange) + change.id.size()
+            + attributesMemoryUsage(change.before) + attributesMemoryUsage(change.after);
+        if (Section::Canvas == change.section || Section::RootComponent == change.section) {
+            m_fromMemoryUsage += attributesMemoryUsage(change.before);
+            m_toMemoryUsage += attributesMemoryUsage(change.after);
+            continue;
+        }
+        if (change.existedBefore)
+            m_fromMemoryUsage += entityMemoryUsage(change.id, change.before);
+        if (change.existsAfter)
+            m_toMemoryUsage += entityMemoryUsage(change.id, change.after);
+    }
+}
+
+void SnapshotDelta::diffAttributes(Section section,
+    const std::map<std::string, std::string>& from,
+    const std::map<std::string, std::string>& to)
+{
+    if (from == to)
+        return;
+    EntityChange change;
+    change.section = section;
+    change.existedBefore = true;
+    change.existsAfter = true;
+    change.before = from;
+    change.after = to;
+    m_changes.push_back(std::move(change));
+}
+
+void SnapshotDelta::diffEntities(Section section,
+    const std::map<std::string, std::map<std::string, std::string>>& from,
+    const std::map<std::string, std::map<std::string, std::string>>& to)
+{
+    // Both sides are sorted by id, so one merge walk finds every added, removed and changed entity
+    auto fromIt = from.begin();
+    auto toIt = to.begin();
+    while (fromIt != from.end() || toIt != to.end()) {
+        EntityChange change;
+        change.section = section;
+        if (toIt == to.end() || (fromIt != from.end() && fromIt->first < toIt->first)) {
+            change.id = fromIt->first;
+            change.existedBefore = true;
+            change.before = fromIt->second;
+            ++fromIt;
+        } else if (fromIt == from.end() || toIt->first < fromIt->first) {
+            change.id = toIt->first;
+            change.existsAfter = true;
+            change.after = toIt->second;
+            ++toIt;
+        } else {
+            if (fromIt->second == toIt->second) {
+                ++fromIt;
+                ++toIt;
+                continue;
+            }
+            change.id = fromIt->first;
+            change.existedBefore = true;
+            change.existsAfter = true;
+            change.before = fromIt->second;
+            change.after = toIt->second;
+            ++fromIt;
+            ++toIt;
+        }
+        m_changes.push_back(std::move(change));
+    }
+}
+
+void SnapshotDelta::apply(Snapshot* snapshot, const EntityChange& change, bool forward)
+{
+    bool exists = forward ? change.existsAfter : change.existedBefore;
+    const auto& attributes = forward ? change.after : change.before;
+
+    std::map<std::string, std::map<std::string, std::string>>* entities = nullptr;
+    switch (change.section) {
+    case Section::Canvas:
+        snapshot->canvas = attributes;
+        return;
+    case Section::RootComponent:
+        snapshot->rootComponent = attributes;
+        return;
+    case Section::Nodes:
+        entities = &snapshot->nodes;
+        break;
+    case Section::Edges:
+        entities = &snapshot->edges;
+        break;
+    case Section::Parts:
+        entities = &snapshot->parts;
+        break;
+    case Section::Components:
+        entities = &snapshot->components;
+        break;
+    case Section::Animations:
+        entities = &snapshot->animations;
+        break;
+    }
+
+    if (exists)
+        (*entities)[change.id] = attributes;
+    else
+        entities->erase(change.id);
+}
+
+void SnapshotDelta::applyForward(Snapshot* snapshot) const
+{
+    for (const auto& change : m_changes)
+        apply(snapshot, change, true);
+}
+
+void SnapshotDelta::applyBackward(Snapshot* snapshot) const
+{
+    for (auto it = m_changes.rbegin(); it != m_changes.rend(); ++it)
+        apply(snapshot, *it, false);
+}
+
+void SnapshotDelta::visit(const Visitor& visitor, const EntityChange& change, bool forward)
+{
+    bool exists = forward ? change.existsAfter : change.existedBefore;
+    visitor(change.section, change.id, exists ? (forward ? &change.after : &change.before) : nullptr);
+}
+
+void SnapshotDelta::visitForward(const Visitor& visitor) const
+{
+    for (const auto& change : m_changes)
+        visit(visitor, change, true);
+}
+
+void SnapshotDelta::visitBackward(const Visitor& visitor) const
+{
+    for (auto it = m_changes.rbegin(); it != m_changes.rend(); ++it)
+        visit(visitor, *it, false);
+}
+
+SnapshotHistory::SnapshotHistory(size_t maxSteps)
+    : m_maxSteps(maxSteps)
+{
+}
+
+size_t SnapshotHistory::memoryUsage(const Snapshot& snapshot)
+{
+    return attributesMemoryUsage(snapshot.canvas)
+        + attributesMemoryUsage(snapshot.rootComponent)
+        + entitiesMemoryUsage(snapshot.nodes)
+        + entitiesMemoryUsage(snapshot.edges)
+        + entitiesMemoryUsage(snapshot.parts)
+        + entitiesMemoryUsage(snapshot.components)
+        + entitiesMemoryUsage(snapshot.animations);
+}
+
+void SnapshotHistory::record(const Snapshot& snapshot)
+{
+    for (const auto& delta : m_redoDeltas)
+        m_deltaMemoryUsage -= delta.memoryUsage();
+    m_redoDeltas.clear();
+
+    if (m_hasCurrent) {
+        SnapshotDelta delta(m_current, snapshot);
+        // The first recorded state is the base, so it takes up one of the steps
+        if (m_undoDeltas.size() + 2 > m_maxSteps && !m_undoDeltas.empty()) {
+            m_deltaMemoryUsage -= m_undoDeltas.front().memoryUsage();
+            m_undoDeltas.pop_front();
+        }
+        // Only the changed entities are copied in, and only their share of the usage recounted
+        delta.applyForward(&m_current);
+        m_currentMemoryUsage = m_currentMemoryUsage + delta.toMemoryUsage() - delta.fromMemoryUsage();
+        m_deltaMemoryUsage += delta.memoryUsage();
+        m_undoDeltas.push_back(std::move(delta));
+        return;
+    }
+
+    m_current = snapshot;
+    m_currentMemoryUsage = memoryUsage(m_current);
+    m_hasCurrent = true;
+}
+
+void SnapshotHistory::clear()
+{
+    m_undoDeltas.clear();
+    m_redoDeltas.clear();
+    m_deltaMemoryUsage = 0;
+    m_current = Snapshot();
+    m_currentMemoryUsage = 0;
+    m_hasCurrent = false;
+}
+
+const SnapshotDelta* SnapshotHistory::undo()
+{
+    if (m_undoDeltas.empty())
+        return nullptr;
+    const SnapshotDelta& delta = m_undoDeltas.back();
+    delta.applyBackward(&m_current);
+    m_currentMemoryUsage = m_currentMemoryUsage + delta.fromMemoryUsage() - delta.toMemoryUsage();
+    m_redoDeltas.push_back(std::move(m_undoDeltas.back()));
+    m_undoDeltas.pop_back();
+    return &m_redoDeltas.back();
+}
+
+const SnapshotDelta* SnapshotHistory::redo()
+{
+    if (m_redoDeltas.empty())
+        return nullptr;
+    const SnapshotDelta& delta = m_redoDeltas.back();
+    delta.applyForward(&m_current);
+    m_currentMemoryUsage = m_currentMemoryUsage + delta.toMemoryUsage() - delta.fromMemoryUsage();
+    m_undoDeltas.push_back(std::move(m_redoDeltas.back()));
+    m_redoDeltas.pop_back();
+    return &m_undoDeltas.back();
+}
+
+}
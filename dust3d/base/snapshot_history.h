@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_BASE_SNAPSHOT_HISTORY_H_
+#define DUST3D_BASE_SNAPSHOT_HISTORY_H_
+
+#include <deque>
+#include <dust3d/base/snapshot.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace dust3d {
+
+// Reversible difference between two snapshots, recorded per entity.
+// Only the canvas, root component and the nodes, edges, parts, components
+// and animations that differ are stored, each with its attributes on both sides.
+class SnapshotDelta {
+public:
+    enum class Section {
+        Canvas,
+        RootComponent,
+        Nodes,
+        Edges,
+        Parts,
+        Components,
+        Animations
+    };
+
+    // Receives a changed entity as it is after the step, attributes is nullptr if it no longer exists
+    typedef std::function<void(Section section, const std::string& id, const std::map<std::string, std::string>* attributes)> Visitor;
+
+    SnapshotDelta() = default;
+    SnapshotDelta(const Snapshot& from, const Snapshot& to);
+
+    bool empty() const
+    {
+        return m_changes.empty();
+    }
+
+    // Turns a snapshot equal to from into one equal to to
+    void applyForward(Snapshot* snapshot) const;
+    // Turns a snapshot equal to to into one equal to from
+    void applyBackward(Snapshot* snapshot) const;
+    // Lets the owner of the live state apply the step itself instead of rebuilding from a snapshot
+    void visitForward(const Visitor& visitor) const;
+    void visitBackward(const Visitor& visitor) const;
+
+    size_t memoryUsage() const
+    {
+        return m_memoryUsage;
+    }
+
+    // Heap bytes the changed entities take up in a snapshot on either side of the step
+    size_t fromMemoryUsage() const
+    {
+        return m_fromMemoryUsage;
+    }
+    size_t toMemoryUsage() const
+    {
+        return m_toMemoryUsage;
+    }
+
+private:
+    struct EntityChange {
+        Section section;
+        std::string id;
+        bool existedBefore = false;
+        bool existsAfter = false;
+        std::map<std::string, std::string> before;
+        std::map<std::string, std::string> after;
+    };
+
+    void diffEntities(Section section,
+        const std::map<std::string, std::map<std::string, std::string>>& from,
+        const std::map<std::string, std::map<std::string, std::string>>& to);
+    void diffAttributes(Section section,
+        const std::map<std::string, std::string>& from,
+        const std::map<std::string, std::string>& to);
+    static void apply(Snapshot* snapshot, const EntityChange& change, bool forward);
+    static void visit(const Visitor& visitor, const EntityChange& change, bool forward);
+
+    std::vector<EntityChange> m_changes;
+    size_t m_memoryUsage = 0;
+    size_t m_fromMemoryUsage = 0;
+    size_t m_toMemoryUsage = 0;
+};
+
+// Undo history holding the latest snapshot in full and every step before it as a delta,
+// so memory grows with the size of the edits rather than the size of the document.
+class SnapshotHistory {
+public:
+    explicit SnapshotHistory(size_t maxSteps = 1000);
+
+    // Records a new state, discarding everything that could be redone
+    void record(const Snapshot& snapshot);
+    void clear();
+
+    bool undoable() const
+    {
+        return !m_undoDeltas.empty();
+    }
+    bool redoable() const
+    {
+        return !m_redoDeltas.empty();
+    }
+
+    // Steps back or forward and returns the step taken, nullptr if there is none;
+    // the delta returned by undo() is to be applied backward, the one by redo() forward
+    const SnapshotDelta* undo();
+    const SnapshotDelta* redo();
+
+    size_t undoCount() const
+    {
+        return m_undoDeltas.size();
+    }
+    size_t redoCount() const
+    {
+        return m_redoDeltas.size();
+    }
+
+    // Approximate heap bytes held by the current snapshot and all deltas
+    size_t memoryUsage() const
+    {
+        return m_currentMemoryUsage + m_deltaMemoryUsage;
+    }
+
+    static size_t memoryUsage(const Snapshot& snapshot);
+
+private:
+    size_t m_maxSteps = 1000;
+    bool m_hasCurrent = false;
+    Snapshot m_current;
+    size_t m_currentMemoryUsage = 0;
+    std::deque<SnapshotDelta> m_undoDeltas;
+    std::deque<SnapshotDelta> m_redoDeltas;
+    size_t m_deltaMemoryUsage = 0;
+};
+
+}
+
+#endif
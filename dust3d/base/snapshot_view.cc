@@ -0,0 +1,238 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <dust3d/base/snapshot_view.h>
+#include <dust3d/base/string.h>
+
+namespace dust3d {
+
+static const std::string& attributeValue(const std::map<std::string, std::string>& attributes, const char* key)
+{
+    static const std::string s_empty;
+    auto findValue = attributes.find(key);
+    if (findValue == attributes.end())
+        return s_empty;
+    return findValue->second;
+}
+
+static float attributeFloat(const std::map<std::string, std::string>& attributes, const char* key, float defaultValue)
+{
+    const auto& value = attributeValue(attributes, key);
+    if (value.empty())
+        return defaultValue;
+    return String::toFloat(value);
+}
+
+static bool attributeIsTrue(const std::map<std::string, std::string>& attributes, const char* key)
+{
+    return String::isTrue(attributeValue(attributes, key));
+}
+
+static size_t findIndex(const std::unordered_map<std::string, size_t>& indexMap, const std::string& idString)
+{
+    if (idString.empty())
+        return SnapshotView::InvalidIndex;
+    auto findResult = indexMap.find(idString);
+    if (findResult == indexMap.end())
+        return SnapshotView::InvalidIndex;
+    return findResult->second;
+}
+
+static size_t findIndex(const std::unordered_map<Uuid, size_t>& indexMap, const Uuid& id)
+{
+    auto findResult = indexMap.find(id);
+    if (findResult == indexMap.end())
+        return SnapshotView::InvalidIndex;
+    return findResult->second;
+}
+
+static size_t findLinkedPartIndex(const std::unordered_map<std::string, size_t>& partIndexMap, const std::string& cutFaceString)
+{
+    if (Uuid(cutFaceString).isNull())
+        return SnapshotView::InvalidIndex;
+    return findIndex(partIndexMap, cutFaceString);
+}
+
+SnapshotView::SnapshotView(const Snapshot& snapshot)
+{
+    m_originX = attributeFloat(snapshot.canvas, "originX", 0.0f);
+    m_originY = attributeFloat(snapshot.canvas, "originY", 0.0f);
+    m_originZ = attributeFloat(snapshot.canvas, "originZ", 0.0f);
+
+    // Ids only have to be resolved once, so plain string maps are kept just for the duration of the build
+    std::unordered_map<std::string, size_t> partIndexMap;
+    std::unordered_map<std::string, size_t> nodeIndexMap;
+    std::unordered_map<std::string, size_t> componentIndexMap;
+    partIndexMap.reserve(snapshot.parts.size());
+    nodeIndexMap.reserve(snapshot.nodes.size());
+    componentIndexMap.reserve(snapshot.components.size());
+
+    m_parts.reserve(snapshot.parts.size());
+    for (const auto& it : snapshot.parts) {
+        partIndexMap.insert({ it.first, m_parts.size() });
+        m_parts.emplace_back();
+        m_parts.back().idString = it.first;
+        m_parts.back().id = Uuid(it.first);
+    }
+    for (size_t i = 0; i < m_parts.size(); ++i) {
+        const auto& attributes = snapshot.parts.find(m_parts[i].idString)->second;
+        auto& part = m_parts[i];
+        part.target = PartTargetFromString(attributeValue(attributes, "target").c_str());
+        part.isDirty = attributeIsTrue(attributes, "__dirty");
+        part.disabled = attributeIsTrue(attributes, "disabled");
+        part.xMirrored = attributeIsTrue(attributes, "xMirrored");
+        part.subdived = attributeIsTrue(attributes, "subdived");
+        part.rounded = attributeIsTrue(attributes, "rounded");
+        part.chamfered = attributeIsTrue(attributes, "chamfered");
+        part.deformUnified = attributeIsTrue(attributes, "deformUnified");
+        part.fillLoopInterior = attributeIsTrue(attributes, "fillLoopInterior");
+        part.deformThickness = attributeFloat(attributes, "deformThickness", 1.0f);
+        part.deformWidth = attributeFloat(attributes, "deformWidth", 1.0f);
+        part.cutRotation = attributeFloat(attributes, "cutRotation", 0.0f);
+        part.metalness = attributeFloat(attributes, "metallic", 0.0f);
+        part.roughness = attributeFloat(attributes, "roughness", 1.0f);
+        const auto& colorString = attributeValue(attributes, "color");
+        if (!colorString.empty()) {
+            part.hasColor = true;
+            part.color = Color(colorString);
+        }
+        const auto& cutFaceString = attributeValue(attributes, "cutFace");
+        part.cutFace = CutFaceFromString(cutFaceString.c_str());
+        part.cutFacePartIndex = findLinkedPartIndex(partIndexMap, cutFaceString);
+        const auto& mirrorFromPartId = attributeValue(attributes, "__mirrorFromPartId");
+        part.isMirror = !mirrorFromPartId.empty();
+        part.mirrorFromPartIndex = findIndex(partIndexMap, mirrorFromPartId);
+        part.importedModelId = attributeValue(attributes, "importedModelId");
+        if (!part.id.isNull())
+            m_partIndexMap.insert({ part.id, i });
+    }
+
+    m_nodes.reserve(snapshot.nodes.size());
+    for (const auto& it : snapshot.nodes) {
+        nodeIndexMap.insert({ it.first, m_nodes.size() });
+        m_nodes.emplace_back();
+        m_nodes.back().idString = it.first;
+        m_nodes.back().id = Uuid(it.first);
+    }
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        const auto& attributes = snapshot.nodes.find(m_nodes[i].idString)->second;
+        auto& node = m_nodes[i];
+        node.partIndex = findIndex(partIndexMap, attributeValue(attributes, "partId"));
+        node.x = attributeFloat(attributes, "x", 0.0f);
+        node.y = attributeFloat(attributes, "y", 0.0f);
+        node.z = attributeFloat(attributes, "z", 0.0f);
+        node.radius = attributeFloat(attributes, "radius", 0.0f);
+        node.cutFacePartIndex = findLinkedPartIndex(partIndexMap, attributeValue(attributes, "cutFace"));
+        node.mirroredByNodeId = Uuid(attributeValue(attributes, "__mirroredByNodeId"));
+        const auto& mirrorFromNodeId = attributeValue(attributes, "__mirrorFromNodeId");
+        node.isMirror = !mirrorFromNodeId.empty();
+        node.mirrorFromNodeIndex = findIndex(nodeIndexMap, mirrorFromNodeId);
+        if (InvalidIndex != node.partIndex)
+            m_parts[node.partIndex].nodeIndices.push_back(i);
+        if (!node.id.isNull())
+            m_nodeIndexMap.insert({ node.id, i });
+    }
+
+    m_edges.reserve(snapshot.edges.size());
+    for (const auto& it : snapshot.edges) {
+        const auto& attributes = it.second;
+        size_t edgeIndex = m_edges.size();
+        m_edges.emplace_back();
+        auto& edge = m_edges.back();
+        edge.idString = it.first;
+        edge.id = Uuid(it.first);
+        edge.partIndex = findIndex(partIndexMap, attributeValue(attributes, "partId"));
+        edge.fromNodeIndex = findIndex(nodeIndexMap, attributeValue(attributes, "from"));
+        edge.toNodeIndex = findIndex(nodeIndexMap, attributeValue(attributes, "to"));
+        edge.boneName = attributeValue(attributes, "boneName");
+        if (InvalidIndex != edge.partIndex)
+            m_parts[edge.partIndex].edgeIndices.push_back(edgeIndex);
+        if (InvalidIndex != edge.fromNodeIndex)
+            m_nodes[edge.fromNodeIndex].edgeIndices.push_back(edgeIndex);
+        if (InvalidIndex != edge.toNodeIndex && edge.toNodeIndex != edge.fromNodeIndex)
+            m_nodes[edge.toNodeIndex].edgeIndices.push_back(edgeIndex);
+    }
+
+    m_components.reserve(snapshot.components.size() + 1);
+    m_components.emplace_back();
+    m_components.back().idString = to_string(Uuid());
+    for (const auto& it : snapshot.components) {
+        componentIndexMap.insert({ it.first, m_components.size() });
+        m_components.emplace_back();
+        m_components.back().idString = it.first;
+        m_components.back().id = Uuid(it.first);
+    }
+    for (size_t i = 0; i < m_components.size(); ++i) {
+        const auto& attributes = RootComponentIndex == i ? snapshot.rootComponent : snapshot.components.find(m_components[i].idString)->second;
+        auto& component = m_components[i];
+        component.isDirty = attributeIsTrue(attributes, "__dirty");
+        if ("partId" == attributeValue(attributes, "linkDataType")) {
+            component.linksPart = true;
+            component.linkData = attributeValue(attributes, "linkData");
+            component.partIndex = findIndex(partIndexMap, component.linkData);
+        }
+        component.combineMode = CombineModeFromString(attributeValue(attributes, "combineMode").c_str());
+        if (CombineMode::Normal == component.combineMode && attributeIsTrue(attributes, "inverse"))
+            component.combineMode = CombineMode::Inversion;
+        const auto& colorString = attributeValue(attributes, "color");
+        if (!colorString.empty()) {
+            component.hasColor = true;
+            component.color = Color(colorString);
+        }
+        const auto& colorImageId = attributeValue(attributes, "colorImageId");
+        if (!colorImageId.empty()) {
+            component.hasColorImage = true;
+            component.colorImageId = Uuid(colorImageId);
+        }
+        component.smoothCutoffDegrees = attributeFloat(attributes, "smoothCutoffDegrees", 0.0f);
+        component.targetSegments = String::toInt(attributeValue(attributes, "targetSegments"));
+        component.frontClosed = attributeIsTrue(attributes, "frontClosed");
+        component.backClosed = attributeIsTrue(attributes, "backClosed");
+        component.sideClosed = attributeIsTrue(attributes, "sideClosed");
+        component.backCloseDepthRatio = attributeFloat(attributes, "backCloseDepthRatio", 1.0f);
+        component.backCloseSharpness = attributeFloat(attributes, "backCloseSharpness", 0.0f);
+        for (const auto& childId : String::split(attributeValue(attributes, "children"), ',')) {
+            size_t childIndex = findIndex(componentIndexMap, childId);
+            if (InvalidIndex != childIndex)
+                component.childIndices.push_back(childIndex);
+        }
+        if (RootComponentIndex != i && !component.id.isNull())
+            m_componentIndexMap.insert({ component.id, i });
+    }
+}
+
+size_t SnapshotView::findNode(const Uuid& id) const
+{
+    return findIndex(m_nodeIndexMap, id);
+}
+
+size_t SnapshotView::findPart(const Uuid& id) const
+{
+    return findIndex(m_partIndexMap, id);
+}
+
+size_t SnapshotView::findComponent(const Uuid& id) const
+{
+    return findIndex(m_componentIndexMap, id);
+}
+
+}
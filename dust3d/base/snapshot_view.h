@@ -0,0 +1,178 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_BASE_SNAPSHOT_VIEW_H_
+#define DUST3D_BASE_SNAPSHOT_VIEW_H_
+
+#include <dust3d/base/color.h>
+#include <dust3d/base/combine_mode.h>
+#include <dust3d/base/cut_face.h>
+#include <dust3d/base/part_target.h>
+#include <dust3d/base/snapshot.h>
+#include <dust3d/base/uuid.h>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dust3d {
+
+// Read-only, typed form of a snapshot for the generators.
+// Every attribute is parsed once, ids are resolved to indices,
+// and nodes and edges are grouped by part. Nodes, edges and parts are stored in id order,
+// so walking them gives the same order as walking the snapshot maps.
+class SnapshotView {
+public:
+    static constexpr size_t InvalidIndex = std::numeric_limits<size_t>::max();
+    static constexpr size_t RootComponentIndex = 0;
+
+    struct Node {
+        std::string idString;
+        Uuid id;
+        size_t partIndex = InvalidIndex;
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float radius = 0.0f;
+        size_t cutFacePartIndex = InvalidIndex;
+        Uuid mirroredByNodeId;
+        bool isMirror = false;
+        size_t mirrorFromNodeIndex = InvalidIndex;
+        std::vector<size_t> edgeIndices;
+    };
+
+    struct Edge {
+        std::string idString;
+        Uuid id;
+        size_t partIndex = InvalidIndex;
+        size_t fromNodeIndex = InvalidIndex;
+        size_t toNodeIndex = InvalidIndex;
+        std::string boneName;
+    };
+
+    struct Part {
+        std::string idString;
+        Uuid id;
+        PartTarget target = PartTarget::Model;
+        bool isDirty = false;
+        bool disabled = false;
+        bool xMirrored = false;
+        bool subdived = false;
+        bool rounded = false;
+        bool chamfered = false;
+        bool deformUnified = false;
+        bool fillLoopInterior = false;
+        float deformThickness = 1.0f;
+        float deformWidth = 1.0f;
+        float cutRotation = 0.0f;
+        float metalness = 0.0f;
+        float roughness = 1.0f;
+        bool hasColor = false;
+        Color color;
+        CutFace cutFace = CutFace::Quad;
+        size_t cutFacePartIndex = InvalidIndex;
+        bool isMirror = false;
+        size_t mirrorFromPartIndex = InvalidIndex;
+        std::string importedModelId;
+        std::vector<size_t> nodeIndices;
+        std::vector<size_t> edgeIndices;
+    };
+
+    struct Component {
+        std::string idString;
+        Uuid id;
+        bool isDirty = false;
+        bool linksPart = false;
+        std::string linkData;
+        size_t partIndex = InvalidIndex;
+        CombineMode combineMode = CombineMode::Normal;
+        bool hasColor = false;
+        Color color;
+        bool hasColorImage = false;
+        Uuid colorImageId;
+        float smoothCutoffDegrees = 0.0f;
+        int targetSegments = 0;
+        bool frontClosed = false;
+        bool backClosed = false;
+        bool sideClosed = false;
+        float backCloseDepthRatio = 1.0f;
+        float backCloseSharpness = 0.0f;
+        std::vector<size_t> childIndices;
+    };
+
+    explicit SnapshotView(const Snapshot& snapshot);
+
+    float originX() const
+    {
+        return m_originX;
+    }
+    float originY() const
+    {
+        return m_originY;
+    }
+    float originZ() const
+    {
+        return m_originZ;
+    }
+
+    const std::vector<Node>& nodes() const
+    {
+        return m_nodes;
+    }
+    const std::vector<Edge>& edges() const
+    {
+        return m_edges;
+    }
+    const std::vector<Part>& parts() const
+    {
+        return m_parts;
+    }
+    // The root component comes first, followed by the snapshot components
+    const std::vector<Component>& components() const
+    {
+        return m_components;
+    }
+    const Component& rootComponent() const
+    {
+        return m_components[RootComponentIndex];
+    }
+
+    size_t findNode(const Uuid& id) const;
+    size_t findPart(const Uuid& id) const;
+    size_t findComponent(const Uuid& id) const;
+
+private:
+    float m_originX = 0.0f;
+    float m_originY = 0.0f;
+    float m_originZ = 0.0f;
+    std::vector<Node> m_nodes;
+    std::vector<Edge> m_edges;
+    std::vector<Part> m_parts;
+    std::vector<Component> m_components;
+    std::unordered_map<Uuid, size_t> m_nodeIndexMap;
+    std::unordered_map<Uuid, size_t> m_partIndexMap;
+    std::unordered_map<Uuid, size_t> m_componentIndexMap;
+};
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <dust3d/base/thread_pool.h>
+#include <exception>
+
+namespace dust3d {
+
+struct ThreadPool::Job {
+    const std::function<void(size_t)>* function = nullptr;
+    size_t count = 0;
+    std::atomic<size_t> next { 0 };
+    std::atomic<size_t> finished { 0 };
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::exception_ptr exception;
+};
+
+ThreadPool::ThreadPool(size_t threadCount)
+{
+    if (0 == threadCount)
+        threadCount = defaultThreadCount();
+    // The calling thread always works too, so one less worker is enough
+    for (size_t i = 1; i < threadCount; ++i)
+        m_threads.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stopped = true;
+    }
+    m_queueCondition.notify_all();
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+size_t ThreadPool::threadCount() const
+{
+    return m_threads.size() + 1;
+}
+
+size_t ThreadPool::defaultThreadCount()
+{
+    return std::max((size_t)1, (size_t)std::thread::hardware_concurrency());
+}
+
+ThreadPool* ThreadPool::globalInstance()
+{
+    static ThreadPool s_threadPool;
+    return &s_threadPool;
+}
+
+void ThreadPool::runJob(Job* job)
+{
+    for (;;) {
+        size_t index = job->next.fetch_add(1);
+        if (index >= job->count)
+            break;
+        try {
+            (*job->function)(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job->mutex);
+            if (!job->exception)
+                job->exception = std::current_exception();
+        }
+        if (job->finished.fetch_add(1) + 1 == job->count) {
+            std::lock_guard<std::mutex> lock(job->mutex);
+            job->condition.notify_all();
+        }
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    for (;;) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCondition.wait(lock, [this] {
+                return m_stopped || !m_queue.empty();
+            });
+            if (m_queue.empty())
+                return;
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        runJob(job.get());
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& function)
+{
+    if (0 == count)
+        return;
+    if (1 == count || m_threads.empty()) {
+        for (size_t i = 0; i < count; ++i)
+            function(i);
+        return;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->function = &function;
+    job->count = count;
+
+    size_t helperCount = std::min(count - 1, m_threads.size());
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        for (size_t i = 0; i < helperCount; ++i)
+            m_queue.push_back(job);
+    }
+    if (1 == helperCount)
+        m_queueCondition.notify_one();
+    else
+        m_queueCondition.notify_all();
+
+    runJob(job.get());
+
+    {
+        std::unique_lock<std::mutex> lock(job->mutex);
+        job->condition.wait(lock, [&job] {
+            return job->finished.load() == job->count;
+        });
+    }
+
+    if (job->exception)
+        std::rethrow_exception(job->exception);
+}
+
+}
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_BASE_THREAD_POOL_H_
+#define DUST3D_BASE_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dust3d {
+
+// Fixed size pool of worker threads shared by the generators.
+// Work is handed out one index at a time from a shared counter, so idle workers keep
+// pulling whatever is left instead of waiting on a static partition. The calling thread
+// always takes part in its own loop, which keeps nested parallelFor calls from a worker
+// deadlock free.
+class ThreadPool {
+public:
+    ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+    size_t threadCount() const;
+    void parallelFor(size_t count, const std::function<void(size_t)>& function);
+
+    static ThreadPool* globalInstance();
+    static size_t defaultThreadCount();
+
+private:
+    struct Job;
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::shared_ptr<Job>> m_queue;
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCondition;
+    bool m_stopped = false;
+
+    void workerLoop();
+    static void runJob(Job* job);
+};
+
+}
+
+#endif
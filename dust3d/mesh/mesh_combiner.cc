@@ -20,6 +20,7 @@
  *  SOFTWARE.
  */
 
+#include <dust3d/base/flat_hash_map.h>
 #include <dust3d/base/position_key.h>
 #include <dust3d/mesh/mesh_combiner.h>
 #include <dust3d/mesh/solid_mesh_boolean_operation.h>
@@ -28,26 +29,44 @@
 
 namespace dust3d {
 
-MeshCombiner::Mesh::Mesh(const std::vector<Vector3>& vertices, const std::vector<std::vector<size_t>>& faces)
+MeshCombiner::Mesh::Mesh(const std::vector<Vector3>& vertices, const std::vector<std::vector<size_t>>& faces,
+    std::vector<size_t>* triangleFaceIndices)
 {
-    m_vertices = std::make_unique<std::vector<Vector3>>(vertices);
-    m_triangles = std::make_unique<std::vector<std::vector<size_t>>>();
-    triangulate(vertices, faces, m_triangles.get());
-    m_solidMesh = std::make_unique<SolidMesh>();
-    m_solidMesh->setVertices(m_vertices.get());
-    m_solidMesh->setTriangles(m_triangles.get());
-    m_solidMesh->prepare();
+    std::vector<std::vector<size_t>> triangulatedFaces;
+    if (nullptr == triangleFaceIndices) {
+        triangulate(vertices, faces, &triangulatedFaces);
+    } else {
+        triangleFaceIndices->clear();
+        for (size_t faceIndex = 0; faceIndex < faces.size(); ++faceIndex) {
+            const auto& face = faces[faceIndex];
+            if (face.size() <= 3)
+                triangulatedFaces.push_back(face);
+            else
+                triangulate(vertices, face, &triangulatedFaces);
+            triangleFaceIndices->resize(triangulatedFaces.size(), faceIndex);
+        }
+    }
+    auto triangles = std::make_shared<std::vector<SolidMesh::Triangle>>();
+    triangles->reserve(triangulatedFaces.size());
+    for (const auto& it : triangulatedFaces) {
+        triangles->push_back({ (std::uint32_t)it[0],
+            (std::uint32_t)it[1],
+            (std::uint32_t)it[2] });
+    }
+    m_vertices = std::make_shared<std::vector<Vector3>>(vertices);
+    m_triangles = triangles;
+    auto solidMesh = std::make_shared<SolidMesh>();
+    solidMesh->setVertices(m_vertices.get());
+    solidMesh->setTriangles(m_triangles.get());
+    solidMesh->prepare();
+    m_solidMesh = solidMesh;
 }
 
 MeshCombiner::Mesh::Mesh(const Mesh& other)
+    : m_vertices(other.m_vertices)
+    , m_triangles(other.m_triangles)
+    , m_solidMesh(other.m_solidMesh)
 {
-    m_vertices = std::make_unique<std::vector<Vector3>>();
-    m_triangles = std::make_unique<std::vector<std::vector<size_t>>>();
-    other.fetch(*m_vertices, *m_triangles);
-    m_solidMesh = std::make_unique<SolidMesh>();
-    m_solidMesh->setVertices(m_vertices.get());
-    m_solidMesh->setTriangles(m_triangles.get());
-    m_solidMesh->prepare();
 }
 
 MeshCombiner::Mesh::~Mesh()
@@ -59,8 +78,13 @@ void MeshCombiner::Mesh::fetch(std::vector<Vector3>& vertices, std::vector<std::
     if (nullptr != m_vertices)
         vertices = *m_vertices;
 
-    if (nullptr != m_triangles)
-        faces = *m_triangles;
+    if (nullptr != m_triangles) {
+        faces.resize(m_triangles->size());
+        for (size_t i = 0; i < m_triangles->size(); ++i) {
+            const auto& triangle = (*m_triangles)[i];
+            faces[i] = { triangle[0], triangle[1], triangle[2] };
+        }
+    }
 }
 
 bool MeshCombiner::Mesh::isNull() const
@@ -68,19 +92,32 @@ bool MeshCombiner::Mesh::isNull() const
     return nullptr == m_vertices || m_vertices->empty();
 }
 
+AxisAlignedBoudingBox MeshCombiner::Mesh::boundingBox() const
+{
+    AxisAlignedBoudingBox box;
+    if (nullptr != m_vertices) {
+        for (const auto& vertex : *m_vertices)
+            box.update(vertex);
+    }
+    return box;
+}
+
 MeshCombiner::Mesh* MeshCombiner::combine(const Mesh& firstMesh, const Mesh& secondMesh, Method method,
-    std::vector<std::pair<Source, size_t>>* combinedVerticesComeFrom)
+    std::vector<std::pair<Source, size_t>>* combinedVerticesComeFrom,
+    ThreadPool* threadPool,
+    std::vector<std::pair<Source, size_t>>* combinedTrianglesComeFrom)
 {
     if (firstMesh.isNull() || secondMesh.isNull())
         return nullptr;
 
     SolidMeshBooleanOperation booleanOperation(firstMesh.m_solidMesh.get(), secondMesh.m_solidMesh.get());
+    booleanOperation.setThreadPool(threadPool);
     if (!booleanOperation.combine())
         return nullptr;
 
-    std::map<PositionKey, std::pair<Source, size_t>> verticesSourceMap;
+    FlatHashMap<PositionKey, std::pair<Source, size_t>> verticesSourceMap;
 
-    auto addToSourceMap = [&](SolidMesh* solidMesh, Source source) {
+    auto addToSourceMap = [&](const SolidMesh* solidMesh, Source source) {
         size_t vertexIndex = 0;
         const std::vector<Vector3>* vertices = solidMesh->vertices();
         if (nullptr == vertices)
@@ -97,14 +134,31 @@ MeshCombiner::Mesh* MeshCombiner::combine(const Mesh& firstMesh, const Mesh& sec
     }
 
     std::vector<std::vector<size_t>> resultTriangles;
+    std::vector<size_t> resultTriangleSources;
+    std::vector<size_t>* resultTriangleSourcesPointer = nullptr != combinedTrianglesComeFrom ? &resultTriangleSources : nullptr;
     if (Method::Union == method) {
-        booleanOperation.fetchUnion(resultTriangles);
+        booleanOperation.fetchUnion(resultTriangles, resultTriangleSourcesPointer);
     } else if (Method::Diff == method) {
-        booleanOperation.fetchDiff(resultTriangles);
+        booleanOperation.fetchDiff(resultTriangles, resultTriangleSourcesPointer);
     } else {
         return nullptr;
     }
 
+    // The boolean numbers the second mesh's triangles after the first's
+    if (nullptr != combinedTrianglesComeFrom) {
+        size_t firstTriangleCount = firstMesh.m_triangles->size();
+        combinedTrianglesComeFrom->clear();
+        combinedTrianglesComeFrom->reserve(resultTriangleSources.size());
+        for (const auto& source : resultTriangleSources) {
+            if (SolidMeshBooleanOperation::InvalidIndex == source)
+                combinedTrianglesComeFrom->push_back({ Source::None, 0 });
+            else if (source < firstTriangleCount)
+                combinedTrianglesComeFrom->push_back({ Source::First, source });
+            else
+                combinedTrianglesComeFrom->push_back({ Source::Second, source - firstTriangleCount });
+        }
+    }
+
     const auto& resultVertices = booleanOperation.resultVertices();
     if (nullptr != combinedVerticesComeFrom) {
         combinedVerticesComeFrom->clear();
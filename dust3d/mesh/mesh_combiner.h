@@ -23,6 +23,8 @@
 #ifndef DUST3D_MESH_MESH_COMBINER_H_
 #define DUST3D_MESH_MESH_COMBINER_H_
 
+#include <dust3d/base/axis_aligned_bounding_box.h>
+#include <dust3d/base/thread_pool.h>
 #include <dust3d/base/vector3.h>
 #include <dust3d/mesh/solid_mesh.h>
 #include <memory>
@@ -46,22 +48,29 @@ public:
     class Mesh {
     public:
         Mesh() = default;
-        Mesh(const std::vector<Vector3>& vertices, const std::vector<std::vector<size_t>>& faces);
+        // Faces are triangulated in order, triangleFaceIndices receives the face each triangle comes from
+        Mesh(const std::vector<Vector3>& vertices, const std::vector<std::vector<size_t>>& faces,
+            std::vector<size_t>* triangleFaceIndices = nullptr);
         Mesh(const Mesh& other);
         ~Mesh();
         void fetch(std::vector<Vector3>& vertices, std::vector<std::vector<size_t>>& faces) const;
         bool isNull() const;
+        AxisAlignedBoudingBox boundingBox() const;
 
         friend MeshCombiner;
 
     private:
-        std::unique_ptr<SolidMesh> m_solidMesh;
-        std::unique_ptr<std::vector<Vector3>> m_vertices;
-        std::unique_ptr<std::vector<std::vector<size_t>>> m_triangles;
+        // A mesh never changes after construction, so copies share the buffers and the
+        // prepared solid mesh instead of rebuilding them
+        std::shared_ptr<const std::vector<Vector3>> m_vertices;
+        std::shared_ptr<const std::vector<SolidMesh::Triangle>> m_triangles;
+        std::shared_ptr<const SolidMesh> m_solidMesh;
     };
 
     static Mesh* combine(const Mesh& firstMesh, const Mesh& secondMesh, Method method,
-        std::vector<std::pair<Source, size_t>>* combinedVerticesComeFrom = nullptr);
+        std::vector<std::pair<Source, size_t>>* combinedVerticesComeFrom = nullptr,
+        ThreadPool* threadPool = nullptr,
+        std::vector<std::pair<Source, size_t>>* combinedTrianglesComeFrom = nullptr);
 };
 
 }
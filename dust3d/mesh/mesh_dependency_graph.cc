@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <algorithm>
+#include <dust3d/mesh/mesh_dependency_graph.h>
+
+namespace dust3d {
+
+MeshDependencyGraph::MeshDependencyGraph(const SnapshotView& snapshotView)
+{
+    const auto& nodes = snapshotView.nodes();
+    const auto& parts = snapshotView.parts();
+    const auto& components = snapshotView.components();
+
+    m_partDependentParts.resize(parts.size());
+    m_partComponents.resize(parts.size());
+    m_componentParents.resize(components.size(), SnapshotView::InvalidIndex);
+    m_dirtyParts.resize(parts.size(), false);
+    m_dirtyComponents.resize(components.size(), false);
+
+    auto addDependency = [&](size_t fromPartIndex, size_t toPartIndex) {
+        if (SnapshotView::InvalidIndex == fromPartIndex || fromPartIndex == toPartIndex)
+            return;
+        auto& dependents = m_partDependentParts[fromPartIndex];
+        if (std::find(dependents.begin(), dependents.end(), toPartIndex) == dependents.end())
+            dependents.push_back(toPartIndex);
+    };
+    for (size_t partIndex = 0; partIndex < parts.size(); ++partIndex) {
+        const auto& part = parts[partIndex];
+        addDependency(part.cutFacePartIndex, partIndex);
+        addDependency(part.mirrorFromPartIndex, partIndex);
+        for (const auto& nodeIndex : part.nodeIndices)
+            addDependency(nodes[nodeIndex].cutFacePartIndex, partIndex);
+    }
+
+    for (size_t componentIndex = 0; componentIndex < components.size(); ++componentIndex) {
+        const auto& component = components[componentIndex];
+        if (component.linksPart && SnapshotView::InvalidIndex != component.partIndex)
+            m_partComponents[component.partIndex].push_back(componentIndex);
+        for (const auto& childIndex : component.childIndices)
+            m_componentParents[childIndex] = componentIndex;
+    }
+
+    for (size_t componentIndex = 0; componentIndex < components.size(); ++componentIndex) {
+        if (components[componentIndex].isDirty)
+            markComponentDirty(componentIndex);
+    }
+    for (size_t partIndex = 0; partIndex < parts.size(); ++partIndex) {
+        if (parts[partIndex].isDirty)
+            markPartDirty(partIndex);
+    }
+}
+
+void MeshDependencyGraph::markPartDirty(size_t partIndex)
+{
+    if (m_dirtyParts[partIndex])
+        return;
+    m_dirtyParts[partIndex] = true;
+
+    std::vector<size_t> pendingParts = { partIndex };
+    while (!pendingParts.empty()) {
+        size_t currentIndex = pendingParts.back();
+        pendingParts.pop_back();
+        for (const auto& componentIndex : m_partComponents[currentIndex])
+            markComponentDirty(componentIndex);
+        for (const auto& dependentIndex : m_partDependentParts[currentIndex]) {
+            if (m_dirtyParts[dependentIndex])
+                continue;
+            m_dirtyParts[dependentIndex] = true;
+            pendingParts.push_back(dependentIndex);
+        }
+    }
+}
+
+void MeshDependencyGraph::markComponentDirty(size_t componentIndex)
+{
+    // Once an ancestor is dirty, so is the rest of the path up to the root
+    while (SnapshotView::InvalidIndex != componentIndex && !m_dirtyComponents[componentIndex]) {
+        m_dirtyComponents[componentIndex] = true;
+        m_dirtyComponentIndices.push_back(componentIndex);
+        componentIndex = m_componentParents[componentIndex];
+    }
+}
+
+bool MeshDependencyGraph::isPartDirty(size_t partIndex) const
+{
+    return m_dirtyParts[partIndex];
+}
+
+bool MeshDependencyGraph::isComponentDirty(size_t componentIndex) const
+{
+    return m_dirtyComponents[componentIndex];
+}
+
+const std::vector<size_t>& MeshDependencyGraph::dirtyComponentIndices() const
+{
+    return m_dirtyComponentIndices;
+}
+
+}
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_MESH_MESH_DEPENDENCY_GRAPH_H_
+#define DUST3D_MESH_MESH_DEPENDENCY_GRAPH_H_
+
+#include <dust3d/base/snapshot_view.h>
+#include <vector>
+
+namespace dust3d {
+
+// Which cached results of the mesh generator an edit invalidates.
+// A part is dirty when it was edited, or when a part it takes its cut face from or mirrors
+// is dirty. A component is dirty when its part is, and a dirty component dirties only its
+// ancestors, so the siblings along the way keep their cached meshes and combinations.
+class MeshDependencyGraph {
+public:
+    explicit MeshDependencyGraph(const SnapshotView& snapshotView);
+    void markPartDirty(size_t partIndex);
+    void markComponentDirty(size_t componentIndex);
+    bool isPartDirty(size_t partIndex) const;
+    bool isComponentDirty(size_t componentIndex) const;
+    const std::vector<size_t>& dirtyComponentIndices() const;
+
+private:
+    // Parts which have to be rebuilt when the keyed part changes
+    std::vector<std::vector<size_t>> m_partDependentParts;
+    std::vector<std::vector<size_t>> m_partComponents;
+    std::vector<size_t> m_componentParents;
+    std::vector<bool> m_dirtyParts;
+    std::vector<bool> m_dirtyComponents;
+    std::vector<size_t> m_dirtyComponentIndices;
+};
+
+}
+
+#endif
@@ -39,6 +39,7 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <numeric>
 
 namespace dust3d {
 
@@ -70,11 +71,40 @@ void MeshGenerator::setImportedModelData(std::map<std::string, ImportedModelData
     m_importedModelData = std::move(importedModelData);
 }
 
+void MeshGenerator::setThreadPool(ThreadPool* threadPool)
+{
+    m_threadPool = threadPool;
+}
+
+void MeshGenerator::setPartMeshCacheDirectory(const std::string& directory)
+{
+    if (directory.empty()) {
+        m_partMeshCache.reset();
+        return;
+    }
+    m_partMeshCache = std::make_unique<PartMeshCache>(directory);
+}
+
+ThreadPool* MeshGenerator::threadPool()
+{
+    return nullptr != m_threadPool ? m_threadPool : ThreadPool::globalInstance();
+}
+
 bool MeshGenerator::isSuccessful()
 {
     return m_isSuccessful;
 }
 
+void MeshGenerator::cancel()
+{
+    m_isCancelled = true;
+}
+
+bool MeshGenerator::isCancelled() const
+{
+    return m_isCancelled;
+}
+
 const std::set<Uuid>& MeshGenerator::generatedPreviewComponentIds()
 {
     return m_generatedPreviewComponentIds;
@@ -94,6 +124,11 @@ Snapshot* MeshGenerator::takeSnapshot()
     return snapshot;
 }
 
+std::shared_ptr<const SnapshotView> MeshGenerator::snapshotView()
+{
+    return m_snapshotView;
+}
+
 void MeshGenerator::chamferFace(std::vector<Vector2>* face)
 {
     auto oldFace = *face;
@@ -163,219 +198,148 @@ void MeshGenerator::recoverQuads(const std::vector<Vector3>& vertices, const std
     }
 }
 
-void MeshGenerator::collectParts()
+void MeshGenerator::checkDirtyFlags()
 {
-    for (const auto& node : m_snapshot->nodes) {
-        std::string partId = String::valueOrEmpty(node.second, "partId");
-        if (partId.empty())
-            continue;
-        m_partNodeIds[partId].insert(node.first);
-    }
-    for (const auto& edge : m_snapshot->edges) {
-        std::string partId = String::valueOrEmpty(edge.second, "partId");
-        if (partId.empty())
-            continue;
-        m_partEdgeIds[partId].insert(edge.first);
-    }
+    m_dependencyGraph = std::make_unique<MeshDependencyGraph>(*m_snapshotView);
 }
 
-bool MeshGenerator::checkIsPartDirty(const std::string& partIdString)
+std::vector<std::string> MeshGenerator::combinationComponentIdStrings(const std::string& combinationIdString)
 {
-    auto findPart = m_snapshot->parts.find(partIdString);
-    if (findPart == m_snapshot->parts.end()) {
-        return false;
+    // Combination ids are built from component id strings, which are the only braced tokens in them
+    std::vector<std::string> componentIdStrings;
+    for (size_t begin = combinationIdString.find('{'); std::string::npos != begin; begin = combinationIdString.find('{', begin + 1)) {
+        size_t end = combinationIdString.find('}', begin);
+        if (std::string::npos == end)
+            break;
+        componentIdStrings.push_back(combinationIdString.substr(begin, end - begin + 1));
     }
-    return String::isTrue(String::valueOrEmpty(findPart->second, "__dirty"));
+    return componentIdStrings;
 }
 
-bool MeshGenerator::checkIsPartDependencyDirty(const std::string& partIdString)
+void MeshGenerator::cacheCombination(const std::string& combinationIdString, std::unique_ptr<MeshState> mesh)
 {
-    auto findPart = m_snapshot->parts.find(partIdString);
-    if (findPart == m_snapshot->parts.end()) {
-        return false;
-    }
-    std::string cutFaceString = String::valueOrEmpty(findPart->second, "cutFace");
-    Uuid cutFaceLinkedPartId = Uuid(cutFaceString);
-    if (!cutFaceLinkedPartId.isNull()) {
-        if (checkIsPartDirty(cutFaceString))
-            return true;
-    }
-    for (const auto& nodeIdString : m_partNodeIds[partIdString]) {
-        auto findNode = m_snapshot->nodes.find(nodeIdString);
-        if (findNode == m_snapshot->nodes.end()) {
-            continue;
-        }
-        std::string cutFaceString = String::valueOrEmpty(findNode->second, "cutFace");
-        Uuid cutFaceLinkedPartId = Uuid(cutFaceString);
-        if (!cutFaceLinkedPartId.isNull()) {
-            if (checkIsPartDirty(cutFaceString))
-                return true;
-        }
-    }
-    return false;
+    for (const auto& componentIdString : combinationComponentIdStrings(combinationIdString))
+        m_cacheContext->componentCombinations[componentIdString].insert(combinationIdString);
+    m_cacheContext->cachedCombination.insert({ combinationIdString, std::move(mesh) });
 }
 
-bool MeshGenerator::checkIsComponentDirty(const std::string& componentIdString)
+void MeshGenerator::removeCachedCombinations(const std::string& componentIdString)
 {
-    bool isDirty = false;
-
-    const std::map<std::string, std::string>* component = &m_snapshot->rootComponent;
-    if (componentIdString != to_string(Uuid())) {
-        auto findComponent = m_snapshot->components.find(componentIdString);
-        if (findComponent == m_snapshot->components.end()) {
-            return isDirty;
-        }
-        component = &findComponent->second;
-    }
-
-    if (String::isTrue(String::valueOrEmpty(*component, "__dirty"))) {
-        isDirty = true;
-    }
-
-    std::string linkDataType = String::valueOrEmpty(*component, "linkDataType");
-    if ("partId" == linkDataType) {
-        std::string partId = String::valueOrEmpty(*component, "linkData");
-        if (checkIsPartDirty(partId)) {
-            m_dirtyPartIds.insert(partId);
-            isDirty = true;
-        }
-        if (!isDirty) {
-            if (checkIsPartDependencyDirty(partId)) {
-                isDirty = true;
-            }
-        }
-    }
-
-    for (const auto& childId : String::split(String::valueOrEmpty(*component, "children"), ',')) {
-        if (childId.empty())
-            continue;
-        if (checkIsComponentDirty(childId)) {
-            isDirty = true;
+    auto findCombinations = m_cacheContext->componentCombinations.find(componentIdString);
+    if (findCombinations == m_cacheContext->componentCombinations.end())
+        return;
+    std::set<std::string> combinationIdStrings = std::move(findCombinations->second);
+    m_cacheContext->componentCombinations.erase(findCombinations);
+    for (const auto& combinationIdString : combinationIdStrings) {
+        m_cacheContext->cachedCombination.erase(combinationIdString);
+        for (const auto& otherIdString : combinationComponentIdStrings(combinationIdString)) {
+            auto findOther = m_cacheContext->componentCombinations.find(otherIdString);
+            if (findOther == m_cacheContext->componentCombinations.end())
+                continue;
+            findOther->second.erase(combinationIdString);
+            if (findOther->second.empty())
+                m_cacheContext->componentCombinations.erase(findOther);
         }
     }
-
-    if (isDirty)
-        m_dirtyComponentIds.insert(componentIdString);
-
-    return isDirty;
 }
 
-void MeshGenerator::checkDirtyFlags()
+void MeshGenerator::cutFaceToCutTemplate(CutFace cutFace, size_t cutFacePartIndex, std::vector<Vector2>& cutTemplate) const
 {
-    checkIsComponentDirty(to_string(Uuid()));
-}
-
-void MeshGenerator::cutFaceStringToCutTemplate(const std::string& cutFaceString, std::vector<Vector2>& cutTemplate)
-{
-    Uuid cutFaceLinkedPartId = Uuid(cutFaceString);
-    if (!cutFaceLinkedPartId.isNull()) {
-        std::map<std::string, std::tuple<float, float, float>> cutFaceNodeMap;
-        auto findCutFaceLinkedPart = m_snapshot->parts.find(cutFaceString);
-        if (findCutFaceLinkedPart == m_snapshot->parts.end()) {
-            // void
-        } else {
-            // Build node info map
-            for (const auto& nodeIdString : m_partNodeIds[cutFaceString]) {
-                auto findNode = m_snapshot->nodes.find(nodeIdString);
-                if (findNode == m_snapshot->nodes.end()) {
-                    continue;
-                }
-                auto& node = findNode->second;
-                float radius = String::toFloat(String::valueOrEmpty(node, "radius"));
-                float x = (String::toFloat(String::valueOrEmpty(node, "x")) - m_mainProfileMiddleX);
-                float y = (m_mainProfileMiddleY - String::toFloat(String::valueOrEmpty(node, "y")));
-                cutFaceNodeMap.insert({ nodeIdString, std::make_tuple(radius, x, y) });
-            }
-            // Build edge link
-            std::map<std::string, std::vector<std::string>> cutFaceNodeLinkMap;
-            for (const auto& edgeIdString : m_partEdgeIds[cutFaceString]) {
-                auto findEdge = m_snapshot->edges.find(edgeIdString);
-                if (findEdge == m_snapshot->edges.end()) {
-                    continue;
-                }
-                auto& edge = findEdge->second;
-                std::string fromNodeIdString = String::valueOrEmpty(edge, "from");
-                std::string toNodeIdString = String::valueOrEmpty(edge, "to");
-                cutFaceNodeLinkMap[fromNodeIdString].push_back(toNodeIdString);
-                cutFaceNodeLinkMap[toNodeIdString].push_back(fromNodeIdString);
+    if (SnapshotView::InvalidIndex != cutFacePartIndex) {
+        const auto& nodes = m_snapshotView->nodes();
+        const auto& edges = m_snapshotView->edges();
+        const auto& cutFacePart = m_snapshotView->parts()[cutFacePartIndex];
+        // Build node info map
+        std::map<size_t, std::tuple<float, float, float>> cutFaceNodeMap;
+        for (const auto& nodeIndex : cutFacePart.nodeIndices) {
+            const auto& node = nodes[nodeIndex];
+            float radius = node.radius;
+            float x = (node.x - m_mainProfileMiddleX);
+            float y = (m_mainProfileMiddleY - node.y);
+            cutFaceNodeMap.insert({ nodeIndex, std::make_tuple(radius, x, y) });
+        }
+        // Build edge link
+        std::map<size_t, std::vector<size_t>> cutFaceNodeLinkMap;
+        for (const auto& edgeIndex : cutFacePart.edgeIndices) {
+            const auto& edge = edges[edgeIndex];
+            cutFaceNodeLinkMap[edge.fromNodeIndex].push_back(edge.toNodeIndex);
+            cutFaceNodeLinkMap[edge.toNodeIndex].push_back(edge.fromNodeIndex);
+        }
+        // Find endpoint
+        size_t endPointNodeIndex = SnapshotView::InvalidIndex;
+        std::vector<std::pair<size_t, std::tuple<float, float, float>>> endpointNodes;
+        for (const auto& it : cutFaceNodeLinkMap) {
+            if (1 == it.second.size()) {
+                const auto& findNode = cutFaceNodeMap.find(it.first);
+                if (findNode != cutFaceNodeMap.end())
+                    endpointNodes.push_back({ it.first, findNode->second });
             }
-            // Find endpoint
-            std::string endPointNodeIdString;
-            std::vector<std::pair<std::string, std::tuple<float, float, float>>> endpointNodes;
-            for (const auto& it : cutFaceNodeLinkMap) {
-                if (1 == it.second.size()) {
-                    const auto& findNode = cutFaceNodeMap.find(it.first);
-                    if (findNode != cutFaceNodeMap.end())
-                        endpointNodes.push_back({ it.first, findNode->second });
-                }
+        }
+        bool isRing = endpointNodes.empty();
+        if (endpointNodes.empty()) {
+            for (const auto& it : cutFaceNodeMap) {
+                endpointNodes.push_back({ it.first, it.second });
             }
-            bool isRing = endpointNodes.empty();
-            if (endpointNodes.empty()) {
-                for (const auto& it : cutFaceNodeMap) {
-                    endpointNodes.push_back({ it.first, it.second });
-                }
+        }
+        if (!endpointNodes.empty()) {
+            // Calculate the center points
+            Vector2 sumOfPositions;
+            for (const auto& it : endpointNodes) {
+                sumOfPositions += Vector2(std::get<1>(it.second), std::get<2>(it.second));
             }
-            if (!endpointNodes.empty()) {
-                // Calculate the center points
-                Vector2 sumOfPositions;
-                for (const auto& it : endpointNodes) {
-                    sumOfPositions += Vector2(std::get<1>(it.second), std::get<2>(it.second));
-                }
-                Vector2 center = sumOfPositions / endpointNodes.size();
-
-                // Calculate all the directions emit from center to the endpoint,
-                // choose the minimal angle, angle: (0, 0 -> -1, -1) to the direction
-                const Vector3 referenceDirection = Vector3(-1, -1, 0).normalized();
-                int choosenEndpoint = -1;
-                float choosenRadian = std::numeric_limits<float>::max();
-                for (int i = 0; i < (int)endpointNodes.size(); ++i) {
-                    const auto& it = endpointNodes[i];
-                    Vector2 direction2d = (Vector2(std::get<1>(it.second), std::get<2>(it.second)) - center);
-                    Vector3 direction = Vector3(direction2d.x(), direction2d.y(), 0).normalized();
-                    float radian = Vector3::angleBetween(referenceDirection, direction);
-                    // Use strict less-than for deterministic first-match behavior
-                    if (radian < choosenRadian) {
-                        choosenRadian = radian;
-                        choosenEndpoint = i;
-                    }
+            Vector2 center = sumOfPositions / endpointNodes.size();
+
+            // Calculate all the directions emit from center to the endpoint,
+            // choose the minimal angle, angle: (0, 0 -> -1, -1) to the direction
+            const Vector3 referenceDirection = Vector3(-1, -1, 0).normalized();
+            int choosenEndpoint = -1;
+            float choosenRadian = std::numeric_limits<float>::max();
+            for (int i = 0; i < (int)endpointNodes.size(); ++i) {
+                const auto& it = endpointNodes[i];
+                Vector2 direction2d = (Vector2(std::get<1>(it.second), std::get<2>(it.second)) - center);
+                Vector3 direction = Vector3(direction2d.x(), direction2d.y(), 0).normalized();
+                float radian = Vector3::angleBetween(referenceDirection, direction);
+                // Use strict less-than for deterministic first-match behavior
+                if (radian < choosenRadian) {
+                    choosenRadian = radian;
+                    choosenEndpoint = i;
                 }
-                endPointNodeIdString = endpointNodes[choosenEndpoint].first;
             }
-            // Loop all linked nodes
-            std::vector<std::tuple<float, float, float, std::string>> cutFaceNodes;
-            std::set<std::string> cutFaceVisitedNodeIds;
-            std::function<void(const std::string&)> loopNodeLink;
-            loopNodeLink = [&](const std::string& fromNodeIdString) {
-                auto findCutFaceNode = cutFaceNodeMap.find(fromNodeIdString);
-                if (findCutFaceNode == cutFaceNodeMap.end())
-                    return;
-                if (cutFaceVisitedNodeIds.find(fromNodeIdString) != cutFaceVisitedNodeIds.end())
-                    return;
-                cutFaceVisitedNodeIds.insert(fromNodeIdString);
-                cutFaceNodes.push_back(std::make_tuple(std::get<0>(findCutFaceNode->second),
-                    std::get<1>(findCutFaceNode->second),
-                    std::get<2>(findCutFaceNode->second),
-                    fromNodeIdString));
-                auto findNeighbor = cutFaceNodeLinkMap.find(fromNodeIdString);
-                if (findNeighbor == cutFaceNodeLinkMap.end())
-                    return;
-                for (const auto& it : findNeighbor->second) {
-                    if (cutFaceVisitedNodeIds.find(it) == cutFaceVisitedNodeIds.end()) {
-                        loopNodeLink(it);
-                        break;
-                    }
+            endPointNodeIndex = endpointNodes[choosenEndpoint].first;
+        }
+        // Loop all linked nodes
+        std::vector<std::tuple<float, float, float, std::string>> cutFaceNodes;
+        std::set<size_t> cutFaceVisitedNodeIndices;
+        std::function<void(size_t)> loopNodeLink;
+        loopNodeLink = [&](size_t fromNodeIndex) {
+            auto findCutFaceNode = cutFaceNodeMap.find(fromNodeIndex);
+            if (findCutFaceNode == cutFaceNodeMap.end())
+                return;
+            if (cutFaceVisitedNodeIndices.find(fromNodeIndex) != cutFaceVisitedNodeIndices.end())
+                return;
+            cutFaceVisitedNodeIndices.insert(fromNodeIndex);
+            cutFaceNodes.push_back(std::make_tuple(std::get<0>(findCutFaceNode->second),
+                std::get<1>(findCutFaceNode->second),
+                std::get<2>(findCutFaceNode->second),
+                nodes[fromNodeIndex].idString));
+            auto findNeighbor = cutFaceNodeLinkMap.find(fromNodeIndex);
+            if (findNeighbor == cutFaceNodeLinkMap.end())
+                return;
+            for (const auto& it : findNeighbor->second) {
+                if (cutFaceVisitedNodeIndices.find(it) == cutFaceVisitedNodeIndices.end()) {
+                    loopNodeLink(it);
+                    break;
                 }
-            };
-            if (!endPointNodeIdString.empty()) {
-                loopNodeLink(endPointNodeIdString);
             }
-            // Fetch points from linked nodes
-            std::vector<std::string> cutTemplateNames;
-            cutFacePointsFromNodes(cutTemplate, cutFaceNodes, isRing, &cutTemplateNames);
+        };
+        if (SnapshotView::InvalidIndex != endPointNodeIndex) {
+            loopNodeLink(endPointNodeIndex);
         }
+        // Fetch points from linked nodes
+        std::vector<std::string> cutTemplateNames;
+        cutFacePointsFromNodes(cutTemplate, cutFaceNodes, isRing, &cutTemplateNames);
     }
     if (cutTemplate.size() < 3) {
-        CutFace cutFace = CutFaceFromString(cutFaceString.c_str());
         cutTemplate = CutFaceToPoints(cutFace);
     }
 }
@@ -418,48 +382,42 @@ void MeshGenerator::flattenLinks(const std::map<size_t, size_t>& links,
     }
 }
 
-bool MeshGenerator::fetchPartOrderedNodes(const std::string& partIdString, bool xMirrored, std::vector<MeshNode>* meshNodes, bool* isCircle)
+bool MeshGenerator::fetchPartOrderedNodes(size_t partIndex, bool xMirrored, std::vector<MeshNode>* meshNodes, bool* isCircle) const
 {
+    if (SnapshotView::InvalidIndex == partIndex)
+        return false;
+    const auto& part = m_snapshotView->parts()[partIndex];
+    const auto& nodes = m_snapshotView->nodes();
+
     std::vector<MeshNode> builderNodes;
-    std::map<std::string, size_t> builderNodeIdStringToIndexMap;
-    for (const auto& nodeIdString : m_partNodeIds[partIdString]) {
-        auto findNode = m_snapshot->nodes.find(nodeIdString);
-        if (findNode == m_snapshot->nodes.end()) {
-            continue;
-        }
-        auto& node = findNode->second;
+    std::unordered_map<size_t, size_t> builderNodeIndexMap;
+    for (const auto& nodeIndex : part.nodeIndices) {
+        const auto& node = nodes[nodeIndex];
 
-        float radius = String::toFloat(String::valueOrEmpty(node, "radius"));
-        float x = (String::toFloat(String::valueOrEmpty(node, "x")) - m_mainProfileMiddleX);
-        float y = (m_mainProfileMiddleY - String::toFloat(String::valueOrEmpty(node, "y")));
-        float z = (m_sideProfileMiddleX - String::toFloat(String::valueOrEmpty(node, "z")));
+        float radius = node.radius;
+        float x = (node.x - m_mainProfileMiddleX);
+        float y = (m_mainProfileMiddleY - node.y);
+        float z = (m_sideProfileMiddleX - node.z);
 
-        builderNodeIdStringToIndexMap.insert({ nodeIdString, builderNodes.size() });
+        builderNodeIndexMap.insert({ nodeIndex, builderNodes.size() });
         builderNodes.emplace_back(MeshNode {
-            Vector3((double)x, (double)y, (double)z), (double)radius, Uuid(xMirrored ? String::valueOrEmpty(node, "__mirroredByNodeId") : nodeIdString) });
+            Vector3((double)x, (double)y, (double)z), (double)radius, xMirrored ? node.mirroredByNodeId : node.id });
     }
 
     if (builderNodes.empty()) {
-        dust3dDebug << "Expected at least one node in part:" << partIdString;
+        dust3dDebug << "Expected at least one node in part:" << part.idString;
         return false;
     }
 
     std::map<size_t, size_t> builderNodeLinks;
-    for (const auto& edgeIdString : m_partEdgeIds[partIdString]) {
-        auto findEdge = m_snapshot->edges.find(edgeIdString);
-        if (findEdge == m_snapshot->edges.end()) {
-            continue;
-        }
-        auto& edge = findEdge->second;
-
-        std::string fromNodeIdString = String::valueOrEmpty(edge, "from");
-        std::string toNodeIdString = String::valueOrEmpty(edge, "to");
+    for (const auto& edgeIndex : part.edgeIndices) {
+        const auto& edge = m_snapshotView->edges()[edgeIndex];
 
-        auto findFrom = builderNodeIdStringToIndexMap.find(fromNodeIdString);
-        if (findFrom == builderNodeIdStringToIndexMap.end())
+        auto findFrom = builderNodeIndexMap.find(edge.fromNodeIndex);
+        if (findFrom == builderNodeIndexMap.end())
             continue;
-        auto findTo = builderNodeIdStringToIndexMap.find(toNodeIdString);
-        if (findTo == builderNodeIdStringToIndexMap.end())
+        auto findTo = builderNodeIndexMap.find(edge.toNodeIndex);
+        if (findTo == builderNodeIndexMap.end())
             continue;
         builderNodeLinks[findFrom->second] = findTo->second;
     }
@@ -477,9 +435,8 @@ bool MeshGenerator::fetchPartOrderedNodes(const std::string& partIdString, bool
     return true;
 }
 
-std::unique_ptr<MeshState> MeshGenerator::combineStitchingMesh(const std::string& componentIdString,
-    const std::vector<std::string>& partIdStrings,
-    const std::vector<std::string>& componentIdStrings,
+std::unique_ptr<MeshState> MeshGenerator::combineStitchingMesh(size_t componentIndex,
+    const std::vector<size_t>& childComponentIndices,
     bool frontClosed,
     bool backClosed,
     bool sideClosed,
@@ -489,21 +446,15 @@ std::unique_ptr<MeshState> MeshGenerator::combineStitchingMesh(const std::string
     GeneratedComponent& componentCache)
 {
     std::vector<StitchMeshBuilder::Spline> splines;
-    splines.reserve(partIdStrings.size());
-    std::vector<Uuid> componentIds(componentIdStrings.size());
-    for (size_t i = 0; i < componentIdStrings.size(); ++i)
-        componentIds[i] = componentIdStrings[i];
+    splines.reserve(childComponentIndices.size());
     std::map<Uuid, Color> splineColors;
-    for (size_t partIndex = 0; partIndex < partIdStrings.size(); ++partIndex) {
-        const auto& partIdString = partIdStrings[partIndex];
-        auto findPart = m_snapshot->parts.find(partIdString);
-        if (findPart != m_snapshot->parts.end()) {
-            if (String::isTrue(String::valueOrEmpty(findPart->second, "disabled")))
-                continue;
-        }
+    for (const auto& childComponentIndex : childComponentIndices) {
+        const auto& childComponent = m_snapshotView->components()[childComponentIndex];
+        if (m_snapshotView->parts()[childComponent.partIndex].disabled)
+            continue;
         bool isCircle = false;
         std::vector<MeshNode> orderedBuilderNodes;
-        if (!fetchPartOrderedNodes(partIdString, false, &orderedBuilderNodes, &isCircle))
+        if (!fetchPartOrderedNodes(childComponent.partIndex, false, &orderedBuilderNodes, &isCircle))
             continue;
         if (isCircle)
             continue;
@@ -513,17 +464,10 @@ std::unique_ptr<MeshState> MeshGenerator::combineStitchingMesh(const std::string
             componentCache.nodeMap.emplace(std::make_pair(meshNode.sourceId,
                 ObjectNode { meshNode.origin, color, smoothCutoffDegrees }));
         }
-        Color splineColor = color;
-        auto findComponent = m_snapshot->components.find(componentIdStrings[partIndex]);
-        if (findComponent != m_snapshot->components.end()) {
-            std::string componentColorString = String::valueOrEmpty(findComponent->second, "color");
-            if (!componentColorString.empty())
-                splineColor = Color(componentColorString);
-        }
-        splineColors[componentIds[partIndex]] = splineColor;
+        splineColors[childComponent.id] = childComponent.hasColor ? childComponent.color : color;
         splines.emplace_back(StitchMeshBuilder::Spline {
             std::move(orderedBuilderNodes),
-            componentIds[partIndex] });
+            childComponent.id });
     }
 
     auto stitchMeshBuilder = std::make_unique<StitchMeshBuilder>(std::move(splines),
@@ -540,33 +484,15 @@ std::unique_ptr<MeshState> MeshGenerator::combineStitchingMesh(const std::string
         generatedFaces,
         &componentCache.sharedQuadEdges);
 
+    const Uuid& componentId = m_snapshotView->components()[componentIndex].id;
     auto mesh = std::make_unique<MeshState>(generatedVertices,
-        generatedFaces);
+        generatedFaces,
+        stitchMeshBuilder->generatedFaceUvs(),
+        std::vector<Uuid> { componentId },
+        std::vector<std::uint32_t>(generatedFaces.size(), 0));
     if (mesh && mesh->isNull())
         mesh.reset();
 
-    const auto& faceUvs = stitchMeshBuilder->generatedFaceUvs();
-    Uuid componentId = Uuid(componentIdString);
-    auto& triangleUvs = componentCache.componentTriangleUvs[componentId];
-    for (size_t i = 0; i < faceUvs.size(); ++i) {
-        const auto& uv = faceUvs[i];
-        const auto& face = generatedFaces[i];
-        if (3 == face.size()) {
-            triangleUvs.insert({ { PositionKey(generatedVertices[face[0]]),
-                                     PositionKey(generatedVertices[face[1]]),
-                                     PositionKey(generatedVertices[face[2]]) },
-                { uv[0], uv[1], uv[2] } });
-        } else if (4 == face.size()) {
-            triangleUvs.insert({ { PositionKey(generatedVertices[face[0]]),
-                                     PositionKey(generatedVertices[face[1]]),
-                                     PositionKey(generatedVertices[face[2]]) },
-                { uv[0], uv[1], uv[2] } });
-            triangleUvs.insert({ { PositionKey(generatedVertices[face[2]]),
-                                     PositionKey(generatedVertices[face[3]]),
-                                     PositionKey(generatedVertices[face[0]]) },
-                { uv[2], uv[3], uv[0] } });
-        }
-    }
     const auto& vertexSources = stitchMeshBuilder->generatedVertexSources();
     for (size_t i = 0; i < vertexSources.size(); ++i) {
         componentCache.positionToNodeIdMap.emplace(std::make_pair(PositionKey(generatedVertices[i]), vertexSources[i]));
@@ -622,9 +548,8 @@ std::unique_ptr<MeshState> MeshGenerator::combineStitchingMesh(const std::string
     return mesh;
 }
 
-std::unique_ptr<MeshState> MeshGenerator::combineStitchingLoopMesh(const std::string& componentIdString,
-    const std::vector<std::string>& partIdStrings,
-    const std::vector<std::string>& componentIdStrings,
+std::unique_ptr<MeshState> MeshGenerator::combineStitchingLoopMesh(size_t componentIndex,
+    const std::vector<size_t>& childComponentIndices,
     bool backClosed,
     float backCloseDepthRatio,
     float backCloseSharpness,
@@ -634,25 +559,17 @@ std::unique_ptr<MeshState> MeshGenerator::combineStitchingLoopMesh(const std::st
     GeneratedComponent& componentCache)
 {
     std::vector<StitchLoopMeshBuilder::Loop> loops;
-    loops.reserve(partIdStrings.size());
-    std::vector<Uuid> componentIds(componentIdStrings.size());
-    for (size_t i = 0; i < componentIdStrings.size(); ++i)
-        componentIds[i] = componentIdStrings[i];
+    loops.reserve(childComponentIndices.size());
     std::map<Uuid, Color> loopPartColors;
-    for (size_t partIndex = 0; partIndex < partIdStrings.size(); ++partIndex) {
-        const auto& partIdString = partIdStrings[partIndex];
-        auto findPart = m_snapshot->parts.find(partIdString);
-        Color partColor = color;
-        if (findPart != m_snapshot->parts.end()) {
-            if (String::isTrue(String::valueOrEmpty(findPart->second, "disabled")))
-                continue;
-            std::string partColorString = String::valueOrEmpty(findPart->second, "color");
-            if (!partColorString.empty())
-                partColor = Color(partColorString);
-        }
+    for (const auto& childComponentIndex : childComponentIndices) {
+        const auto& childComponent = m_snapshotView->components()[childComponentIndex];
+        const auto& part = m_snapshotView->parts()[childComponent.partIndex];
+        if (part.disabled)
+            continue;
+        Color partColor = part.hasColor ? part.color : color;
         bool isCircle = false;
         std::vector<MeshNode> orderedBuilderNodes;
-        if (!fetchPartOrderedNodes(partIdString, false, &orderedBuilderNodes, &isCircle))
+        if (!fetchPartOrderedNodes(childComponent.partIndex, false, &orderedBuilderNodes, &isCircle))
             continue;
         if (orderedBuilderNodes.size() < 2)
             continue;
@@ -660,20 +577,12 @@ std::unique_ptr<MeshState> MeshGenerator::combineStitchingLoopMesh(const std::st
             componentCache.nodeMap.emplace(std::make_pair(meshNode.sourceId,
                 ObjectNode { meshNode.origin, partColor, smoothCutoffDegrees }));
         }
-        Color loopColor = color;
-        auto findComponent = m_snapshot->components.find(componentIdStrings[partIndex]);
-        if (findComponent != m_snapshot->components.end()) {
-            std::string componentColorString = String::valueOrEmpty(findComponent->second, "color");
-            if (!componentColorString.empty())
-                loopColor = Color(componentColorString);
-        }
-        loopPartColors[componentIds[partIndex]] = loopColor;
+        loopPartColors[childComponent.id] = childComponent.hasColor ? childComponent.color : color;
         StitchLoopMeshBuilder::Loop loop;
         loop.nodes = std::move(orderedBuilderNodes);
-        loop.sourceId = componentIds[partIndex];
+        loop.sourceId = childComponent.id;
         loop.closed = isCircle;
-        if (findPart != m_snapshot->parts.end())
-            loop.fillInterior = String::isTrue(String::valueOrEmpty(findPart->second, "fillLoopInterior"));
+        loop.fillInterior = part.fillLoopInterior;
         loops.emplace_back(std::move(loop));
     }
 
@@ -688,12 +597,8 @@ std::unique_ptr<MeshState> MeshGenerator::combineStitchingLoopMesh(const std::st
 
     collectSharedQuadEdges(generatedVertices, generatedFaces, &componentCache.sharedQuadEdges);
 
-    auto mesh = std::make_unique<MeshState>(generatedVertices, generatedFaces);
-    if (mesh && mesh->isNull())
-        mesh.reset();
-
-    const auto& faceUvs = loopMeshBuilder->generatedFaceUvs();
-    Uuid componentId = Uuid(componentIdString);
+    const auto& component = m_snapshotView->components()[componentIndex];
+    const Uuid& componentId = component.id;
 
     // Determine whether the component has a texture image configured.
     // If yes: use a single chart keyed by componentId with the 2D-projection UVs so the
@@ -701,44 +606,36 @@ std::unique_ptr<MeshState> MeshGenerator::combineStitchingLoopMesh(const std::st
     // If no:  split faces into per-part sub-charts keyed by each loop's sourceId (which is
     //         a child component ID in the snapshot). Each sub-chart uses that part's color
     //         (or its own colorImageId if configured), painted as a solid fill or textured tile.
-    bool componentHasImage = false;
-    {
-        auto findComp = m_snapshot->components.find(componentIdString);
-        if (findComp != m_snapshot->components.end())
-            componentHasImage = !String::valueOrEmpty(findComp->second, "colorImageId").empty();
-    }
-
-    auto insertTriangleUv = [&](std::map<std::array<PositionKey, 3>, std::array<Vector2, 3>>& uvMap,
-                                const std::vector<size_t>& face, const std::vector<Vector2>& uv) {
-        if (3 == face.size()) {
-            uvMap.insert({ { PositionKey(generatedVertices[face[0]]),
-                               PositionKey(generatedVertices[face[1]]),
-                               PositionKey(generatedVertices[face[2]]) },
-                { uv[0], uv[1], uv[2] } });
-        } else if (4 == face.size()) {
-            uvMap.insert({ { PositionKey(generatedVertices[face[0]]),
-                               PositionKey(generatedVertices[face[1]]),
-                               PositionKey(generatedVertices[face[2]]) },
-                { uv[0], uv[1], uv[2] } });
-            uvMap.insert({ { PositionKey(generatedVertices[face[2]]),
-                               PositionKey(generatedVertices[face[3]]),
-                               PositionKey(generatedVertices[face[0]]) },
-                { uv[2], uv[3], uv[0] } });
-        }
-    };
+    bool componentHasImage = component.hasColorImage;
 
+    std::vector<Uuid> chartComponentIds;
+    std::vector<std::uint32_t> faceComponentIndices;
     if (componentHasImage) {
         // Single chart: all faces mapped to the component texture via 2D projection UVs.
-        auto& triangleUvs = componentCache.componentTriangleUvs[componentId];
-        for (size_t i = 0; i < faceUvs.size(); ++i)
-            insertTriangleUv(triangleUvs, generatedFaces[i], faceUvs[i]);
+        chartComponentIds.push_back(componentId);
+        faceComponentIndices.resize(generatedFaces.size(), 0);
     } else {
         // Per-part sub-charts: delegate to the builder.
-        for (auto& [id, uvMap] : loopMeshBuilder->buildPerLoopTriangleUvs()) {
-            auto& dest = componentCache.componentTriangleUvs[id.isNull() ? componentId : id];
-            dest.insert(uvMap.begin(), uvMap.end());
+        std::map<Uuid, std::uint32_t> chartIndices;
+        for (const auto& id : loopMeshBuilder->buildPerLoopFaceSourceIds()) {
+            if (id.isNull()) {
+                faceComponentIndices.push_back(ObjectTriangleChart::InvalidIndex);
+                continue;
+            }
+            auto insertResult = chartIndices.insert({ id, (std::uint32_t)chartComponentIds.size() });
+            if (insertResult.second)
+                chartComponentIds.push_back(id);
+            faceComponentIndices.push_back(insertResult.first->second);
         }
     }
+    auto mesh = std::make_unique<MeshState>(generatedVertices,
+        generatedFaces,
+        loopMeshBuilder->generatedFaceUvs(),
+        chartComponentIds,
+        faceComponentIndices);
+    if (mesh && mesh->isNull())
+        mesh.reset();
+
     const auto& vertexSources = loopMeshBuilder->generatedVertexSources();
     for (size_t i = 0; i < vertexSources.size(); ++i) {
         componentCache.positionToNodeIdMap.emplace(std::make_pair(PositionKey(generatedVertices[i]), vertexSources[i]));
@@ -791,78 +688,75 @@ std::unique_ptr<MeshState> MeshGenerator::combineStitchingLoopMesh(const std::st
     return mesh;
 }
 
-std::unique_ptr<MeshState> MeshGenerator::combinePartMesh(const std::string& partIdString,
-    const std::string& componentIdString,
+std::unique_ptr<MeshState> MeshGenerator::combinePartMesh(size_t componentIndex,
     Color color,
     float smoothCutoffDegrees,
     bool* hasError)
 {
-    auto findPart = m_snapshot->parts.find(partIdString);
-    if (findPart == m_snapshot->parts.end()) {
-        return nullptr;
+    const auto& component = m_snapshotView->components()[componentIndex];
+    std::unique_ptr<PreparedPart> preparedPart;
+    if (componentIndex < m_preparedParts.size() && nullptr != m_preparedParts[componentIndex]
+        && m_preparedParts[componentIndex]->partIndex == component.partIndex) {
+        preparedPart = std::move(m_preparedParts[componentIndex]);
+    } else {
+        preparedPart = preparePartMesh(component.partIndex, component.id, color, smoothCutoffDegrees);
     }
 
-    auto& part = findPart->second;
+    if (!preparedPart->isBuilt)
+        return nullptr;
 
-    bool isDisabled = String::isTrue(String::valueOrEmpty(part, "disabled"));
-    std::string __mirroredByPartId = String::valueOrEmpty(part, "__mirroredByPartId");
-    std::string __mirrorFromPartId = String::valueOrEmpty(part, "__mirrorFromPartId");
-    bool subdived = String::isTrue(String::valueOrEmpty(part, "subdived"));
-    bool rounded = String::isTrue(String::valueOrEmpty(part, "rounded"));
-    bool chamfered = String::isTrue(String::valueOrEmpty(part, "chamfered"));
-    float deformThickness = 1.0;
-    float deformWidth = 1.0;
-    float cutRotation = 0.0;
-    auto target = PartTargetFromString(String::valueOrEmpty(part, "target").c_str());
+    m_cacheContext->parts[component.linkData] = std::move(preparedPart->part);
 
-    std::string searchPartIdString = __mirrorFromPartId.empty() ? partIdString : __mirrorFromPartId;
+    if (preparedPart->hasPreview)
+        addComponentPreview(component.id, std::move(preparedPart->preview));
 
-    std::string cutFaceString = String::valueOrEmpty(part, "cutFace");
-    std::vector<Vector2> cutTemplate;
-    cutFaceStringToCutTemplate(cutFaceString, cutTemplate);
-    if (chamfered)
-        chamferFace(&cutTemplate);
-    if (subdived)
-        subdivideFace(&cutTemplate);
+    if (preparedPart->hasError)
+        *hasError = true;
 
-    std::string cutRotationString = String::valueOrEmpty(part, "cutRotation");
-    if (!cutRotationString.empty()) {
-        cutRotation = String::toFloat(cutRotationString);
-    }
+    return std::move(preparedPart->mesh);
+}
 
-    std::string thicknessString = String::valueOrEmpty(part, "deformThickness");
-    if (!thicknessString.empty()) {
-        deformThickness = String::toFloat(thicknessString);
-    }
+std::unique_ptr<MeshGenerator::PreparedPart> MeshGenerator::preparePartMesh(size_t partIndex,
+    const Uuid& componentId,
+    Color color,
+    float smoothCutoffDegrees) const
+{
+    auto preparedPart = std::make_unique<PreparedPart>();
+    preparedPart->partIndex = partIndex;
 
-    std::string widthString = String::valueOrEmpty(part, "deformWidth");
-    if (!widthString.empty()) {
-        deformWidth = String::toFloat(widthString);
-    }
+    if (SnapshotView::InvalidIndex == partIndex)
+        return preparedPart;
+
+    const auto& part = m_snapshotView->parts()[partIndex];
 
-    bool deformUnified = String::isTrue(String::valueOrEmpty(part, "deformUnified"));
+    bool isDisabled = part.disabled;
+    bool isMirror = part.isMirror;
+    float deformThickness = part.deformThickness;
+    float deformWidth = part.deformWidth;
+    float cutRotation = part.cutRotation;
+    bool deformUnified = part.deformUnified;
+    auto target = part.target;
 
-    float metalness = 0;
-    std::string metalnessString = String::valueOrEmpty(part, "metallic");
-    if (!metalnessString.empty())
-        metalness = String::toFloat(metalnessString);
+    size_t searchPartIndex = isMirror ? part.mirrorFromPartIndex : partIndex;
 
-    float roughness = 1.0;
-    std::string roughnessString = String::valueOrEmpty(part, "roughness");
-    if (!roughnessString.empty())
-        roughness = String::toFloat(roughnessString);
+    std::vector<Vector2> cutTemplate;
+    cutFaceToCutTemplate(part.cutFace, part.cutFacePartIndex, cutTemplate);
+    if (part.chamfered)
+        chamferFace(&cutTemplate);
+    if (part.subdived)
+        subdivideFace(&cutTemplate);
 
     std::vector<MeshNode> meshNodes;
     bool isCircle = false;
-    if (!fetchPartOrderedNodes(searchPartIdString, !__mirrorFromPartId.empty(), &meshNodes, &isCircle))
-        return nullptr;
+    if (!fetchPartOrderedNodes(searchPartIndex, isMirror, &meshNodes, &isCircle))
+        return preparedPart;
 
-    auto& partCache = m_cacheContext->parts[partIdString];
-    partCache.reset();
+    preparedPart->isBuilt = true;
+    auto& partCache = preparedPart->part;
 
     partCache.color = color;
-    partCache.metalness = metalness;
-    partCache.roughness = roughness;
+    partCache.metalness = part.metalness;
+    partCache.roughness = part.roughness;
     partCache.isSuccessful = false;
     partCache.joined = ((target == PartTarget::Model || target == PartTarget::ImportedModel) && !isDisabled);
 
@@ -874,6 +768,7 @@ std::unique_ptr<MeshState> MeshGenerator::combinePartMesh(const std::string& par
         }
     }
 
+    std::vector<std::vector<Vector2>> faceUvs;
     if (PartTarget::Model == target) {
         std::unique_ptr<TubeMeshBuilder> tubeMeshBuilder;
         TubeMeshBuilder::BuildParameters buildParameters;
@@ -882,44 +777,39 @@ std::unique_ptr<MeshState> MeshGenerator::combinePartMesh(const std::string& par
         buildParameters.deformUnified = deformUnified;
         buildParameters.baseNormalRotation = cutRotation * Math::Pi;
         buildParameters.cutFace = cutTemplate;
-        buildParameters.frontEndRounded = buildParameters.backEndRounded = rounded;
-        tubeMeshBuilder = std::make_unique<TubeMeshBuilder>(buildParameters, std::move(meshNodes), isCircle);
-        tubeMeshBuilder->build();
-        partCache.vertices = tubeMeshBuilder->generatedVertices();
-        partCache.faces = tubeMeshBuilder->generatedFaces();
-        if (!__mirrorFromPartId.empty()) {
+        buildParameters.frontEndRounded = buildParameters.backEndRounded = part.rounded;
+        PartMeshCache::Mesh tubeMesh;
+        PartMeshCache::Key tubeMeshCacheKey;
+        bool isTubeMeshCached = false;
+        if (nullptr != m_partMeshCache) {
+            tubeMeshCacheKey = PartMeshCache::makeKey(buildParameters, meshNodes, isCircle);
+            isTubeMeshCached = m_partMeshCache->load(tubeMeshCacheKey, &tubeMesh);
+        }
+        if (!isTubeMeshCached) {
+            tubeMeshBuilder = std::make_unique<TubeMeshBuilder>(buildParameters, std::move(meshNodes), isCircle);
+            tubeMeshBuilder->build();
+            tubeMesh.vertices = tubeMeshBuilder->generatedVertices();
+            tubeMesh.faces = tubeMeshBuilder->generatedFaces();
+            tubeMesh.faceUvs = tubeMeshBuilder->generatedFaceUvs();
+            tubeMesh.vertexSources = tubeMeshBuilder->generatedVertexSources();
+            if (nullptr != m_partMeshCache)
+                m_partMeshCache->save(tubeMeshCacheKey, tubeMesh);
+        }
+        partCache.vertices = tubeMesh.vertices;
+        partCache.faces = tubeMesh.faces;
+        if (isMirror) {
             for (auto& it : partCache.vertices)
                 it.setX(-it.x());
             for (auto& it : partCache.faces)
                 std::reverse(it.begin(), it.end());
         }
-        const auto& faceUvs = tubeMeshBuilder->generatedFaceUvs();
-        for (size_t i = 0; i < faceUvs.size(); ++i) {
-            const auto& uv = faceUvs[i];
-            const auto& face = partCache.faces[i];
-            if (3 == face.size()) {
-                partCache.triangleUvs.insert({ { PositionKey(partCache.vertices[face[0]]),
-                                                   PositionKey(partCache.vertices[face[1]]),
-                                                   PositionKey(partCache.vertices[face[2]]) },
-                    { uv[0], uv[1], uv[2] } });
-            } else if (4 == face.size()) {
-                partCache.triangleUvs.insert({ { PositionKey(partCache.vertices[face[0]]),
-                                                   PositionKey(partCache.vertices[face[1]]),
-                                                   PositionKey(partCache.vertices[face[2]]) },
-                    { uv[0], uv[1], uv[2] } });
-                partCache.triangleUvs.insert({ { PositionKey(partCache.vertices[face[2]]),
-                                                   PositionKey(partCache.vertices[face[3]]),
-                                                   PositionKey(partCache.vertices[face[0]]) },
-                    { uv[2], uv[3], uv[0] } });
-            }
-        }
-        const auto& vertexSources = tubeMeshBuilder->generatedVertexSources();
+        faceUvs = tubeMesh.faceUvs;
+        const auto& vertexSources = tubeMesh.vertexSources;
         for (size_t i = 0; i < vertexSources.size(); ++i) {
             partCache.positionToNodeIdMap.emplace(std::make_pair(PositionKey(partCache.vertices[i]), vertexSources[i]));
         }
     } else if (PartTarget::ImportedModel == target) {
-        std::string importedModelIdString = String::valueOrEmpty(part, "importedModelId");
-        auto findImportedModel = m_importedModelData.find(importedModelIdString);
+        auto findImportedModel = m_importedModelData.find(part.importedModelId);
         if (findImportedModel != m_importedModelData.end()) {
             const auto& importedData = findImportedModel->second;
             if (!importedData.vertices.empty() && !importedData.faces.empty()) {
@@ -945,20 +835,19 @@ std::unique_ptr<MeshState> MeshGenerator::combinePartMesh(const std::string& par
                     partCache.vertices[vi] = spineDeformer.deformVertex(importedData.vertices[vi]);
                 }
 
-                if (!__mirrorFromPartId.empty()) {
+                if (isMirror) {
                     for (auto& it : partCache.vertices)
                         it.setX(-it.x());
                 }
 
                 partCache.faces = importedData.faces;
-                if (!__mirrorFromPartId.empty()) {
+                if (isMirror) {
                     for (auto& it : partCache.faces)
                         std::reverse(it.begin(), it.end());
                 }
 
-                // Build triangleUvs using deformed vertex positions as keys.
                 // importedData.triangleUvs uses pre-deformation position keys,
-                // but the packer/renderer looks up by deformed position keys.
+                // resolve them to per-vertex uvs before the faces are deformed.
                 if (!importedData.triangleUvs.empty()) {
                     std::vector<Vector2> perVertexUv(importedData.vertices.size(), Vector2(0, 0));
                     for (const auto& face : importedData.faces) {
@@ -973,13 +862,10 @@ std::unique_ptr<MeshState> MeshGenerator::combinePartMesh(const std::string& par
                             perVertexUv[face[2]] = findUv->second[2];
                         }
                     }
-                    for (const auto& face : partCache.faces) {
-                        if (face.size() < 3)
-                            continue;
-                        partCache.triangleUvs.insert({ { PositionKey(partCache.vertices[face[0]]),
-                                                           PositionKey(partCache.vertices[face[1]]),
-                                                           PositionKey(partCache.vertices[face[2]]) },
-                            { perVertexUv[face[0]], perVertexUv[face[1]], perVertexUv[face[2]] } });
+                    faceUvs.resize(partCache.faces.size());
+                    for (size_t i = 0; i < partCache.faces.size(); ++i) {
+                        for (const auto& vertexIndex : partCache.faces[i])
+                            faceUvs[i].push_back(perVertexUv[vertexIndex]);
                     }
                 }
 
@@ -998,7 +884,7 @@ std::unique_ptr<MeshState> MeshGenerator::combinePartMesh(const std::string& par
                     auto transformNormal = [&](size_t vi) -> Vector3 {
                         const auto& sv = importedData.vertices[vi];
                         Vector3 transformed = spineDeformer.deformNormal(importedData.vertexNormals[vi], sv.y());
-                        if (!__mirrorFromPartId.empty())
+                        if (isMirror)
                             transformed.setX(-transformed.x());
                         return transformed;
                     };
@@ -1043,24 +929,31 @@ std::unique_ptr<MeshState> MeshGenerator::combinePartMesh(const std::string& par
     bool hasMeshError = false;
     std::unique_ptr<MeshState> mesh;
 
-    mesh = std::make_unique<MeshState>(partCache.vertices, partCache.faces);
+    mesh = std::make_unique<MeshState>(partCache.vertices,
+        partCache.faces,
+        faceUvs,
+        std::vector<Uuid> { componentId },
+        std::vector<std::uint32_t>(partCache.faces.size(), 0));
     if (mesh->isNull()) {
         hasMeshError = true;
     }
 
     if (PartTarget::Model == target || PartTarget::ImportedModel == target) {
-        ComponentPreview preview;
+        auto& preview = preparedPart->preview;
         if (mesh)
             mesh->fetch(preview.vertices, preview.triangles);
         preview.color = partCache.color;
         preview.metalness = partCache.metalness;
         preview.roughness = partCache.roughness;
-        preview.triangleUvs = partCache.triangleUvs;
-        addComponentPreview(componentIdString, std::move(preview));
+        if (!faceUvs.empty()) {
+            preview.triangleUvs.reserve(mesh->triangleCharts.size());
+            for (const auto& chart : mesh->triangleCharts)
+                preview.triangleUvs.push_back(chart.uv);
+        }
+        preparedPart->hasPreview = true;
     } else if (PartTarget::CutFace == target) {
-        ComponentPreview preview;
-        cutFaceStringToCutTemplate(partIdString, preview.cutFaceTemplate);
-        addComponentPreview(componentIdString, std::move(preview));
+        cutFaceToCutTemplate(CutFace::Quad, partIndex, preparedPart->preview.cutFaceTemplate);
+        preparedPart->hasPreview = true;
     }
 
     if (nullptr != mesh) {
@@ -1072,93 +965,122 @@ std::unique_ptr<MeshState> MeshGenerator::combinePartMesh(const std::string& par
     }
 
     if (hasMeshError && (target == PartTarget::Model || target == PartTarget::ImportedModel)) {
-        *hasError = true;
+        preparedPart->hasError = true;
     }
 
-    return mesh;
+    preparedPart->mesh = std::move(mesh);
+    return preparedPart;
 }
 
-const std::map<std::string, std::string>* MeshGenerator::findComponent(const std::string& componentIdString)
+void MeshGenerator::componentColorAndSmoothCutoff(const SnapshotView::Component& component, Color* color, float* smoothCutoffDegrees) const
 {
-    const std::map<std::string, std::string>* component = &m_snapshot->rootComponent;
-    if (componentIdString != to_string(Uuid())) {
-        auto findComponent = m_snapshot->components.find(componentIdString);
-        if (findComponent == m_snapshot->components.end()) {
-            return nullptr;
-        }
-        return &findComponent->second;
+    *smoothCutoffDegrees = component.smoothCutoffDegrees;
+    *color = component.hasColor ? component.color : m_defaultPartColor;
+}
+
+bool MeshGenerator::isComponentCacheValid(size_t componentIndex) const
+{
+    if (!m_cacheEnabled)
+        return false;
+    if (m_dependencyGraph->isComponentDirty(componentIndex))
+        return false;
+    auto findCache = m_cacheContext->components.find(m_snapshotView->components()[componentIndex].idString);
+    if (findCache == m_cacheContext->components.end())
+        return false;
+    return nullptr != findCache->second.mesh;
+}
+
+bool MeshGenerator::isStitchingComponent(const SnapshotView::Component& component) const
+{
+    if (!component.linksPart || SnapshotView::InvalidIndex == component.partIndex)
+        return false;
+    auto target = m_snapshotView->parts()[component.partIndex].target;
+    return PartTarget::StitchingLine == target || PartTarget::StitchingLoop == target;
+}
+
+void MeshGenerator::collectDirtyPartComponents(size_t componentIndex, std::vector<size_t>* componentIndices) const
+{
+    // Mirror the traversal of combineComponentMesh, stopping wherever it would hit the cache
+    const auto& component = m_snapshotView->components()[componentIndex];
+
+    if (isComponentCacheValid(componentIndex))
+        return;
+
+    if (component.linksPart) {
+        componentIndices->push_back(componentIndex);
+        return;
+    }
+
+    for (const auto& childIndex : component.childIndices) {
+        if (isStitchingComponent(m_snapshotView->components()[childIndex]))
+            continue;
+        collectDirtyPartComponents(childIndex, componentIndices);
     }
-    return component;
 }
 
-CombineMode MeshGenerator::componentCombineMode(const std::map<std::string, std::string>* component)
+void MeshGenerator::prepareDirtyParts()
 {
-    if (nullptr == component)
-        return CombineMode::Normal;
-    CombineMode combineMode = CombineModeFromString(String::valueOrEmpty(*component, "combineMode").c_str());
-    if (combineMode == CombineMode::Normal) {
-        if (String::isTrue(String::valueOrEmpty(*component, "inverse")))
-            combineMode = CombineMode::Inversion;
-    }
-    return combineMode;
+    // Parts are independent of each other until the component combine, so build all the dirty ones
+    // up front on the thread pool. combinePartMesh then consumes the results in the usual serial
+    // traversal order, which keeps the output identical to a fully serial generation.
+    std::vector<size_t> componentIndices;
+    collectDirtyPartComponents(SnapshotView::RootComponentIndex, &componentIndices);
+    if (componentIndices.size() < 2)
+        return;
+
+    // Each task writes its own slot, so the results need no merge step
+    m_preparedParts.resize(m_snapshotView->components().size());
+    threadPool()->parallelFor(componentIndices.size(), [&](size_t i) {
+        if (isCancelled())
+            return;
+        const auto& component = m_snapshotView->components()[componentIndices[i]];
+        Color color;
+        float smoothCutoffDegrees = 0.0;
+        componentColorAndSmoothCutoff(component, &color, &smoothCutoffDegrees);
+        m_preparedParts[componentIndices[i]] = preparePartMesh(component.partIndex, component.id, color, smoothCutoffDegrees);
+    });
 }
 
-std::unique_ptr<MeshState> MeshGenerator::combineComponentMesh(const std::string& componentIdString, CombineMode* combineMode)
+std::unique_ptr<MeshState> MeshGenerator::combineComponentMesh(size_t componentIndex, CombineMode* combineMode)
 {
     std::unique_ptr<MeshState> mesh;
 
-    Uuid componentId;
-    const std::map<std::string, std::string>* component = &m_snapshot->rootComponent;
-    if (componentIdString != to_string(Uuid())) {
-        componentId = Uuid(componentIdString);
-        auto findComponent = m_snapshot->components.find(componentIdString);
-        if (findComponent == m_snapshot->components.end()) {
-            return nullptr;
-        }
-        component = &findComponent->second;
-    }
+    const auto& component = m_snapshotView->components()[componentIndex];
+    const std::string& componentIdString = component.idString;
+    const Uuid& componentId = component.id;
 
-    *combineMode = componentCombineMode(component);
+    *combineMode = component.combineMode;
 
+    Color color;
     float smoothCutoffDegrees = 0.0;
-    std::string smoothCutoffDegreesString = String::valueOrEmpty(*component, "smoothCutoffDegrees");
-    if (!smoothCutoffDegreesString.empty()) {
-        smoothCutoffDegrees = String::toFloat(smoothCutoffDegreesString);
-    }
+    componentColorAndSmoothCutoff(component, &color, &smoothCutoffDegrees);
 
-    std::string colorString = String::valueOrEmpty(*component, "color");
-    Color color = colorString.empty() ? m_defaultPartColor : Color(colorString);
-
-    size_t targetSegments = (size_t)String::toInt(String::valueOrEmpty(*component, "targetSegments"));
+    size_t targetSegments = (size_t)component.targetSegments;
     // Validate target segments, 100 should be a reasonable large number
     if (targetSegments > 100)
         targetSegments = 0;
 
     auto& componentCache = m_cacheContext->components[componentIdString];
 
-    if (m_cacheEnabled) {
-        if (m_dirtyComponentIds.find(componentIdString) == m_dirtyComponentIds.end()) {
-            if (nullptr != componentCache.mesh)
-                return std::make_unique<MeshState>(*componentCache.mesh);
-        }
-    }
+    if (isComponentCacheValid(componentIndex))
+        return std::make_unique<MeshState>(*componentCache.mesh);
+
+    if (isCancelled())
+        return nullptr;
 
     componentCache.reset();
 
-    std::string linkDataType = String::valueOrEmpty(*component, "linkDataType");
-    if ("partId" == linkDataType) {
-        std::string partIdString = String::valueOrEmpty(*component, "linkData");
+    if (component.linksPart) {
         bool hasError = false;
-        mesh = combinePartMesh(partIdString, componentIdString, color, smoothCutoffDegrees, &hasError);
+        mesh = combinePartMesh(componentIndex, color, smoothCutoffDegrees, &hasError);
         if (hasError) {
             m_isSuccessful = false;
         }
-        const auto& partCache = m_cacheContext->parts[partIdString];
+        const auto& partCache = m_cacheContext->parts[component.linkData];
         if (partCache.joined) {
             for (const auto& vertex : partCache.vertices)
                 componentCache.noneSeamVertices.insert(vertex);
             collectSharedQuadEdges(partCache.vertices, partCache.faces, &componentCache.sharedQuadEdges);
-            componentCache.componentTriangleUvs.insert({ componentId, partCache.triangleUvs });
             for (const auto& it : partCache.positionToNodeIdMap)
                 componentCache.positionToNodeIdMap.emplace(it);
             for (const auto& it : partCache.importedVertexColorMap)
@@ -1173,36 +1095,29 @@ std::unique_ptr<MeshState> MeshGenerator::combineComponentMesh(const std::string
                 mesh.reset();
         }
     } else {
-        std::vector<std::pair<CombineMode, std::vector<std::string>>> combineGroups;
+        const auto& components = m_snapshotView->components();
+        auto joinIdStrings = [&](const std::vector<size_t>& componentIndices, const char* separator) {
+            std::vector<std::string> idStrings;
+            idStrings.reserve(componentIndices.size());
+            for (const auto& it : componentIndices)
+                idStrings.push_back(components[it].idString);
+            return String::join(idStrings, separator);
+        };
+        std::vector<std::pair<CombineMode, std::vector<size_t>>> combineGroups;
         int currentGroupIndex = -1;
         auto lastCombineMode = CombineMode::Count;
-        std::vector<std::string> stitchingParts;
-        std::vector<std::string> stitchingComponents;
-        std::vector<std::string> stitchingLoopParts;
-        std::vector<std::string> stitchingLoopComponents;
-        for (const auto& childIdString : String::split(String::valueOrEmpty(*component, "children"), ',')) {
-            if (childIdString.empty())
+        std::vector<size_t> stitchingComponents;
+        std::vector<size_t> stitchingLoopComponents;
+        for (const auto& childIndex : component.childIndices) {
+            const auto& child = components[childIndex];
+            if (isStitchingComponent(child)) {
+                if (PartTarget::StitchingLine == m_snapshotView->parts()[child.partIndex].target)
+                    stitchingComponents.push_back(childIndex);
+                else
+                    stitchingLoopComponents.push_back(childIndex);
                 continue;
-            const auto& child = findComponent(childIdString);
-            if (nullptr == child)
-                continue;
-            if ("partId" == String::valueOrEmpty(*child, "linkDataType")) {
-                auto partIdString = String::valueOrEmpty(*child, "linkData");
-                auto findPart = m_snapshot->parts.find(partIdString);
-                if (findPart != m_snapshot->parts.end()) {
-                    if ("StitchingLine" == String::valueOrEmpty(findPart->second, "target")) {
-                        stitchingParts.emplace_back(partIdString);
-                        stitchingComponents.emplace_back(childIdString);
-                        continue;
-                    }
-                    if ("StitchingLoop" == String::valueOrEmpty(findPart->second, "target")) {
-                        stitchingLoopParts.emplace_back(partIdString);
-                        stitchingLoopComponents.emplace_back(childIdString);
-                        continue;
-                    }
-                }
             }
-            auto combineMode = componentCombineMode(child);
+            auto combineMode = child.combineMode;
             if (lastCombineMode != combineMode || lastCombineMode == CombineMode::Inversion) {
                 combineGroups.push_back({ combineMode, {} });
                 ++currentGroupIndex;
@@ -1211,65 +1126,57 @@ std::unique_ptr<MeshState> MeshGenerator::combineComponentMesh(const std::string
             if (-1 == currentGroupIndex) {
                 continue;
             }
-            combineGroups[currentGroupIndex].second.push_back(childIdString);
+            combineGroups[currentGroupIndex].second.push_back(childIndex);
         }
         std::vector<std::tuple<std::unique_ptr<MeshState>, CombineMode, std::string>> groupMeshes;
         for (const auto& group : combineGroups) {
-            auto childMesh = combineComponentChildGroupMesh(group.second, componentCache, &componentCache.brokenTriangles);
+            auto childMesh = combineComponentChildGroupMesh(group.second, componentCache);
             if (nullptr == childMesh || childMesh->isNull())
                 continue;
-            groupMeshes.emplace_back(std::make_tuple(std::move(childMesh), group.first, String::join(group.second, "|")));
+            groupMeshes.emplace_back(std::make_tuple(std::move(childMesh), group.first, joinIdStrings(group.second, "|")));
         }
-        if (!stitchingParts.empty()) {
-            auto stitchingMesh = combineStitchingMesh(componentIdString,
-                stitchingParts,
+        if (!stitchingComponents.empty()) {
+            auto stitchingMesh = combineStitchingMesh(componentIndex,
                 stitchingComponents,
-                String::isTrue(String::valueOrEmpty(*component, "frontClosed")),
-                String::isTrue(String::valueOrEmpty(*component, "backClosed")),
-                String::isTrue(String::valueOrEmpty(*component, "sideClosed")),
+                component.frontClosed,
+                component.backClosed,
+                component.sideClosed,
                 targetSegments,
                 color,
                 smoothCutoffDegrees,
                 componentCache);
             if (stitchingMesh && !stitchingMesh->isNull()) {
-                groupMeshes.emplace_back(std::make_tuple(std::move(stitchingMesh), CombineMode::Normal, String::join(stitchingComponents, ":")));
+                groupMeshes.emplace_back(std::make_tuple(std::move(stitchingMesh), CombineMode::Normal, joinIdStrings(stitchingComponents, ":")));
             }
         }
-        if (!stitchingLoopParts.empty()) {
-            float backCloseDepthRatio = 1.0f;
-            float backCloseSharpness = 0.0f;
-            {
-                auto it = component->find("backCloseDepthRatio");
-                if (it != component->end())
-                    backCloseDepthRatio = String::toFloat(it->second);
-                it = component->find("backCloseSharpness");
-                if (it != component->end())
-                    backCloseSharpness = String::toFloat(it->second);
-            }
-            auto stitchingLoopMesh = combineStitchingLoopMesh(componentIdString,
-                stitchingLoopParts,
+        if (!stitchingLoopComponents.empty()) {
+            auto stitchingLoopMesh = combineStitchingLoopMesh(componentIndex,
                 stitchingLoopComponents,
-                String::isTrue(String::valueOrEmpty(*component, "backClosed")),
-                backCloseDepthRatio,
-                backCloseSharpness,
+                component.backClosed,
+                component.backCloseDepthRatio,
+                component.backCloseSharpness,
                 targetSegments,
                 color,
                 smoothCutoffDegrees,
                 componentCache);
             if (stitchingLoopMesh && !stitchingLoopMesh->isNull()) {
-                groupMeshes.emplace_back(std::make_tuple(std::move(stitchingLoopMesh), CombineMode::Normal, String::join(stitchingLoopComponents, ":")));
+                groupMeshes.emplace_back(std::make_tuple(std::move(stitchingLoopMesh), CombineMode::Normal, joinIdStrings(stitchingLoopComponents, ":")));
             }
         }
-        mesh = combineMultipleMeshes(std::move(groupMeshes), &componentCache.brokenTriangles);
+        mesh = combineMultipleMeshes(std::move(groupMeshes));
+        // Some children may be missing, so the result must not be cached
+        if (isCancelled())
+            return nullptr;
+        if (mesh)
+            mesh->assignBrokenTriangles(componentId);
         ComponentPreview preview;
         if (mesh) {
             mesh->fetch(preview.vertices, preview.triangles);
             preview.color = color;
-            if (!stitchingParts.empty() || !stitchingLoopParts.empty()) {
-                for (const auto& it : componentCache.componentTriangleUvs) {
-                    for (const auto& uvs : it.second)
-                        preview.triangleUvs.insert(uvs);
-                }
+            if (!stitchingComponents.empty() || !stitchingLoopComponents.empty()) {
+                preview.triangleUvs.resize(preview.triangles.size());
+                for (size_t i = 0; i < mesh->triangleCharts.size() && i < preview.triangleUvs.size(); ++i)
+                    preview.triangleUvs[i] = mesh->triangleCharts[i].uv;
             }
         }
         addComponentPreview(componentId, std::move(preview));
@@ -1285,50 +1192,228 @@ std::unique_ptr<MeshState> MeshGenerator::combineComponentMesh(const std::string
     return mesh;
 }
 
-std::unique_ptr<MeshState> MeshGenerator::combineMultipleMeshes(std::vector<std::tuple<std::unique_ptr<MeshState>, CombineMode, std::string>>&& multipleMeshes,
-    std::set<std::array<PositionKey, 3>>* brokenTriangles)
+void MeshGenerator::combineMeshPairs(std::vector<MeshCombination>* combinations)
 {
-    std::unique_ptr<MeshState> mesh;
-    std::string meshIdStrings;
-    for (auto& it : multipleMeshes) {
-        auto subMesh = std::move(std::get<0>(it));
-        const auto& childCombineMode = std::get<1>(it);
-        const std::string& subMeshIdString = std::get<2>(it);
-        if (nullptr == subMesh || subMesh->isNull()) {
+    std::vector<size_t> uncachedIndices;
+    for (size_t i = 0; i < combinations->size(); ++i) {
+        auto& combination = (*combinations)[i];
+        auto findCached = m_cacheContext->cachedCombination.find(combination.idString);
+        if (findCached != m_cacheContext->cachedCombination.end()) {
+            if (nullptr != findCached->second)
+                combination.result = std::make_unique<MeshState>(*findCached->second);
             continue;
         }
-        if (nullptr == mesh) {
-            mesh = std::move(subMesh);
-            meshIdStrings = subMeshIdString;
-            continue;
+        uncachedIndices.push_back(i);
+    }
+
+    threadPool()->parallelFor(uncachedIndices.size(), [&](size_t i) {
+        if (isCancelled())
+            return;
+        auto& combination = (*combinations)[uncachedIndices[i]];
+        combination.result = MeshState::combine(*combination.first,
+            *combination.second,
+            combination.method,
+            threadPool());
+    });
+
+    // Skipped combinations have no result, which must not be cached as a failure
+    if (isCancelled())
+        return;
+
+    for (const auto& i : uncachedIndices) {
+        const auto& combination = (*combinations)[i];
+        if (nullptr != combination.result)
+            cacheCombination(combination.idString, std::make_unique<MeshState>(*combination.result));
+        else
+            cacheCombination(combination.idString, nullptr);
+    }
+
+    for (auto& combination : *combinations) {
+        if (!combination.result || combination.result->isNull()) {
+            combination.result.reset();
+            m_isSuccessful = false;
         }
-        auto combinerMethod = childCombineMode == CombineMode::Inversion ? MeshCombiner::Method::Diff : MeshCombiner::Method::Union;
-        auto combinerMethodString = combinerMethod == MeshCombiner::Method::Union ? "+" : "-";
-        meshIdStrings += combinerMethodString + subMeshIdString;
-        std::unique_ptr<MeshState> newMesh;
-        auto findCached = m_cacheContext->cachedCombination.find(meshIdStrings);
-        if (findCached != m_cacheContext->cachedCombination.end()) {
-            if (nullptr != findCached->second) {
-                newMesh = std::make_unique<MeshState>(*findCached->second);
+    }
+}
+
+std::pair<std::unique_ptr<MeshState>, std::string> MeshGenerator::combineUnionMeshes(std::vector<std::pair<std::unique_ptr<MeshState>, std::string>>&& meshes)
+{
+    if (meshes.size() < 2)
+        return std::move(meshes.front());
+
+    // Meshes are grouped when their bounding boxes overlap, directly or through other members of the group
+    std::vector<AxisAlignedBoudingBox> boxes(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i)
+        boxes[i] = meshes[i].first->mesh->boundingBox();
+    std::vector<size_t> groupRoots(meshes.size());
+    std::iota(groupRoots.begin(), groupRoots.end(), 0);
+    auto findRoot = [&](size_t i) {
+        while (groupRoots[i] != i)
+            i = groupRoots[i] = groupRoots[groupRoots[i]];
+        return i;
+    };
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        for (size_t j = i + 1; j < meshes.size(); ++j) {
+            if (!boxes[i].intersectWith(boxes[j]))
+                continue;
+            size_t first = findRoot(i);
+            size_t second = findRoot(j);
+            if (first != second)
+                groupRoots[std::max(first, second)] = std::min(first, second);
+        }
+    }
+    std::vector<std::vector<size_t>> groups;
+    std::vector<size_t> rootToGroup(meshes.size(), 0);
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        size_t root = findRoot(i);
+        if (root == i) {
+            rootToGroup[root] = groups.size();
+            groups.emplace_back();
+        }
+        groups[rootToGroup[root]].push_back(i);
+    }
+
+    // Inside a group the meshes are folded in their original order, so the boolean operands are the ones
+    // a plain sequential fold would see, the groups themselves are folded side by side
+    std::vector<std::pair<std::unique_ptr<MeshState>, std::string>> groupMeshes(groups.size());
+    for (size_t g = 0; g < groups.size(); ++g)
+        groupMeshes[g] = std::move(meshes[groups[g][0]]);
+    for (size_t step = 1;; ++step) {
+        std::vector<MeshCombination> combinations;
+        std::vector<size_t> combinationGroups;
+        for (size_t g = 0; g < groups.size(); ++g) {
+            if (step >= groups[g].size())
+                continue;
+            const auto& next = meshes[groups[g][step]];
+            MeshCombination combination;
+            combination.first = groupMeshes[g].first.get();
+            combination.second = next.first.get();
+            combination.method = MeshCombiner::Method::Union;
+            combination.idString = groupMeshes[g].second + "+" + next.second;
+            combinations.push_back(std::move(combination));
+            combinationGroups.push_back(g);
+        }
+        if (combinations.empty())
+            break;
+        combineMeshPairs(&combinations);
+        for (size_t i = 0; i < combinations.size(); ++i) {
+            auto& combination = combinations[i];
+            if (nullptr != combination.result)
+                groupMeshes[combinationGroups[i]] = { std::move(combination.result), std::move(combination.idString) };
+        }
+    }
+    if (1 == groupMeshes.size())
+        return std::move(groupMeshes.front());
+
+    // Meshes of different groups can't intersect, so the groups are reduced as a balanced tree with all the pairs
+    // of one level running concurrently. When a pair still fails, the groups under it are folded one by one
+    // instead, which only loses the group that actually fails
+    auto foldGroups = [&](const std::vector<size_t>& groupIndices) {
+        std::pair<std::unique_ptr<MeshState>, std::string> folded = {
+            std::make_unique<MeshState>(*groupMeshes[groupIndices[0]].first),
+            groupMeshes[groupIndices[0]].second
+        };
+        for (size_t i = 1; i < groupIndices.size(); ++i) {
+            const auto& next = groupMeshes[groupIndices[i]];
+            std::vector<MeshCombination> combinations(1);
+            combinations[0].first = folded.first.get();
+            combinations[0].second = next.first.get();
+            combinations[0].method = MeshCombiner::Method::Union;
+            combinations[0].idString = folded.second + "+" + next.second;
+            combineMeshPairs(&combinations);
+            if (nullptr != combinations[0].result)
+                folded = { std::move(combinations[0].result), std::move(combinations[0].idString) };
+        }
+        return folded;
+    };
+    struct UnionNode {
+        const MeshState* mesh = nullptr;
+        std::unique_ptr<MeshState> combinedMesh;
+        std::string idString;
+        std::vector<size_t> groupIndices;
+    };
+    std::vector<UnionNode> nodes(groupMeshes.size());
+    for (size_t g = 0; g < groupMeshes.size(); ++g) {
+        nodes[g].mesh = groupMeshes[g].first.get();
+        nodes[g].idString = groupMeshes[g].second;
+        nodes[g].groupIndices = { g };
+    }
+    while (nodes.size() > 1) {
+        std::vector<MeshCombination> combinations(nodes.size() / 2);
+        for (size_t i = 0; i < combinations.size(); ++i) {
+            auto& combination = combinations[i];
+            combination.first = nodes[i * 2].mesh;
+            combination.second = nodes[i * 2 + 1].mesh;
+            combination.method = MeshCombiner::Method::Union;
+            combination.idString = "(" + nodes[i * 2].idString + "+" + nodes[i * 2 + 1].idString + ")";
+        }
+        // A failed pair only counts as a failure when its fallback fold fails too
+        bool isSuccessful = m_isSuccessful;
+        combineMeshPairs(&combinations);
+        m_isSuccessful = isSuccessful;
+        std::vector<UnionNode> combinedNodes((nodes.size() + 1) / 2);
+        for (size_t i = 0; i < combinations.size(); ++i) {
+            auto& node = combinedNodes[i];
+            node.groupIndices = nodes[i * 2].groupIndices;
+            node.groupIndices.insert(node.groupIndices.end(), nodes[i * 2 + 1].groupIndices.begin(), nodes[i * 2 + 1].groupIndices.end());
+            auto& combination = combinations[i];
+            if (nullptr != combination.result) {
+                node.combinedMesh = std::move(combination.result);
+                node.idString = std::move(combination.idString);
+            } else {
+                auto folded = foldGroups(node.groupIndices);
+                node.combinedMesh = std::move(folded.first);
+                node.idString = std::move(folded.second);
             }
-        } else {
-            newMesh = MeshState::combine(*mesh,
-                *subMesh,
-                combinerMethod);
-            if (nullptr != newMesh)
-                m_cacheContext->cachedCombination.insert({ meshIdStrings, std::make_unique<MeshState>(*newMesh) });
-            else
-                m_cacheContext->cachedCombination.insert({ meshIdStrings, nullptr });
+            node.mesh = node.combinedMesh.get();
         }
-        if (newMesh && !newMesh->isNull()) {
-            if (nullptr != brokenTriangles) {
-                for (const auto& brokenTriangle : newMesh->brokenTriangles)
-                    brokenTriangles->insert(brokenTriangle);
+        if (0 != nodes.size() % 2)
+            combinedNodes.back() = std::move(nodes.back());
+        nodes = std::move(combinedNodes);
+    }
+    return { std::move(nodes.front().combinedMesh), std::move(nodes.front().idString) };
+}
+
+std::unique_ptr<MeshState> MeshGenerator::combineMultipleMeshes(std::vector<std::tuple<std::unique_ptr<MeshState>, CombineMode, std::string>>&& multipleMeshes)
+{
+    std::vector<std::tuple<std::unique_ptr<MeshState>, CombineMode, std::string>> validMeshes;
+    validMeshes.reserve(multipleMeshes.size());
+    for (auto& it : multipleMeshes) {
+        const auto& subMesh = std::get<0>(it);
+        if (nullptr == subMesh || subMesh->isNull())
+            continue;
+        validMeshes.emplace_back(std::move(it));
+    }
+
+    // Inversions keep their place and are subtracted from everything in front of them, each run of unioned
+    // meshes between them is reduced together with the result so far, which leads the run
+    std::unique_ptr<MeshState> mesh;
+    std::string meshIdStrings;
+    for (size_t i = 0; i < validMeshes.size();) {
+        if (nullptr != mesh && CombineMode::Inversion == std::get<1>(validMeshes[i])) {
+            std::vector<MeshCombination> combinations(1);
+            combinations[0].first = mesh.get();
+            combinations[0].second = std::get<0>(validMeshes[i]).get();
+            combinations[0].method = MeshCombiner::Method::Diff;
+            combinations[0].idString = meshIdStrings + "-" + std::get<2>(validMeshes[i]);
+            combineMeshPairs(&combinations);
+            if (nullptr != combinations[0].result) {
+                mesh = std::move(combinations[0].result);
+                meshIdStrings = std::move(combinations[0].idString);
             }
-            mesh = std::move(newMesh);
-        } else {
-            m_isSuccessful = false;
+            ++i;
+            continue;
         }
+        std::vector<std::pair<std::unique_ptr<MeshState>, std::string>> unionMeshes;
+        if (nullptr != mesh)
+            unionMeshes.emplace_back(std::move(mesh), std::move(meshIdStrings));
+        do {
+            unionMeshes.emplace_back(std::move(std::get<0>(validMeshes[i])), std::get<2>(validMeshes[i]));
+            ++i;
+        } while (i < validMeshes.size() && CombineMode::Inversion != std::get<1>(validMeshes[i]));
+        auto unionMesh = combineUnionMeshes(std::move(unionMeshes));
+        mesh = std::move(unionMesh.first);
+        meshIdStrings = std::move(unionMesh.second);
     }
     if (nullptr != mesh && mesh->isNull()) {
         mesh.reset();
@@ -1336,14 +1421,14 @@ std::unique_ptr<MeshState> MeshGenerator::combineMultipleMeshes(std::vector<std:
     return mesh;
 }
 
-std::unique_ptr<MeshState> MeshGenerator::combineComponentChildGroupMesh(const std::vector<std::string>& componentIdStrings,
-    GeneratedComponent& componentCache,
-    std::set<std::array<PositionKey, 3>>* brokenTriangles)
+std::unique_ptr<MeshState> MeshGenerator::combineComponentChildGroupMesh(const std::vector<size_t>& componentIndices,
+    GeneratedComponent& componentCache)
 {
     std::vector<std::tuple<std::unique_ptr<MeshState>, CombineMode, std::string>> multipleMeshes;
-    for (const auto& childIdString : componentIdStrings) {
+    for (const auto& childIndex : componentIndices) {
+        const std::string& childIdString = m_snapshotView->components()[childIndex].idString;
         CombineMode childCombineMode = CombineMode::Normal;
-        std::unique_ptr<MeshState> subMesh = combineComponentMesh(childIdString, &childCombineMode);
+        std::unique_ptr<MeshState> subMesh = combineComponentMesh(childIndex, &childCombineMode);
 
         if (CombineMode::Uncombined == childCombineMode) {
             const auto& uncombinedCache = m_cacheContext->components[childIdString];
@@ -1357,8 +1442,6 @@ std::unique_ptr<MeshState> MeshGenerator::combineComponentChildGroupMesh(const s
             componentCache.noneSeamVertices.insert(vertex);
         for (const auto& it : childComponentCache.sharedQuadEdges)
             componentCache.sharedQuadEdges.insert(it);
-        for (const auto& it : childComponentCache.componentTriangleUvs)
-            componentCache.componentTriangleUvs.insert({ it.first, it.second });
         for (const auto& it : childComponentCache.positionToNodeIdMap)
             componentCache.positionToNodeIdMap.emplace(it);
         for (const auto& it : childComponentCache.nodeMap)
@@ -1373,7 +1456,7 @@ std::unique_ptr<MeshState> MeshGenerator::combineComponentChildGroupMesh(const s
 
         multipleMeshes.emplace_back(std::make_tuple(std::move(subMesh), childCombineMode, childIdString));
     }
-    return combineMultipleMeshes(std::move(multipleMeshes), brokenTriangles);
+    return combineMultipleMeshes(std::move(multipleMeshes));
 }
 
 void MeshGenerator::collectSharedQuadEdges(const std::vector<Vector3>& vertices, const std::vector<std::vector<size_t>>& faces,
@@ -1437,7 +1520,7 @@ void MeshGenerator::postprocessObject(Object* object)
     // flat normals from smoothNormal. This pass groups face normals by position and only
     // merges those within the cutoff angle.
     if (!m_importedModelData.empty()) {
-        std::map<PositionKey, std::vector<size_t>> posToTriangles;
+        FlatHashMap<PositionKey, std::vector<size_t>> posToTriangles;
         for (size_t ti = 0; ti < object->triangles.size(); ++ti) {
             const auto& face = object->triangles[ti];
             for (size_t j = 0; j < face.size() && j < 3; ++j) {
@@ -1494,8 +1577,7 @@ void MeshGenerator::collectIncombinableMesh(const MeshState* mesh, const Generat
     updateVertexIndices(uncombinedFaces);
     updateVertexIndices(uncombinedTriangleAndQuads);
 
-    for (const auto& it : componentCache.componentTriangleUvs)
-        m_object->componentTriangleUvs.insert({ it.first, it.second });
+    collectTriangleCharts(*mesh);
     for (const auto& it : componentCache.positionToNodeIdMap)
         m_object->positionToNodeIdMap.emplace(it);
     for (const auto& it : componentCache.nodeMap)
@@ -1506,36 +1588,40 @@ void MeshGenerator::collectIncombinableMesh(const MeshState* mesh, const Generat
     m_object->triangleAndQuads.insert(m_object->triangleAndQuads.end(), uncombinedTriangleAndQuads.begin(), uncombinedTriangleAndQuads.end());
 }
 
-void MeshGenerator::collectUncombinedComponent(const std::string& componentIdString)
+void MeshGenerator::collectUncombinedComponent(size_t componentIndex)
 {
-    const auto& component = findComponent(componentIdString);
-    if (CombineMode::Uncombined == componentCombineMode(component)) {
-        const auto& componentCache = m_cacheContext->components[componentIdString];
+    const auto& component = m_snapshotView->components()[componentIndex];
+    if (CombineMode::Uncombined == component.combineMode) {
+        const auto& componentCache = m_cacheContext->components[component.idString];
         if (nullptr == componentCache.mesh || componentCache.mesh->isNull()) {
             return;
         }
         collectIncombinableMesh(componentCache.mesh.get(), componentCache);
         return;
     }
-    for (const auto& childIdString : String::split(String::valueOrEmpty(*component, "children"), ',')) {
-        if (childIdString.empty())
-            continue;
-        collectUncombinedComponent(childIdString);
-    }
+    for (const auto& childIndex : component.childIndices)
+        collectUncombinedComponent(childIndex);
 }
 
-void MeshGenerator::collectBrokenTriangles(const std::string& componentIdString)
+void MeshGenerator::collectTriangleCharts(const MeshState& mesh)
 {
-    const auto& component = findComponent(componentIdString);
-    for (const auto& childIdString : String::split(String::valueOrEmpty(*component, "children"), ',')) {
-        if (childIdString.empty())
-            continue;
-        collectBrokenTriangles(childIdString);
-    }
-    const auto& componentCache = m_cacheContext->components[componentIdString];
-    for (const auto& triangle : componentCache.brokenTriangles) {
-        m_object->brokenTrianglesToComponentIdMap.insert({ triangle, Uuid(componentIdString) });
-    }
+    std::vector<std::uint32_t> componentIndices(mesh.chartComponentIds.size());
+    for (size_t i = 0; i < mesh.chartComponentIds.size(); ++i) {
+        componentIndices[i] = (std::uint32_t)(std::find(m_chartComponentIds.begin(), m_chartComponentIds.end(), mesh.chartComponentIds[i]) - m_chartComponentIds.begin());
+        if (componentIndices[i] == m_chartComponentIds.size())
+            m_chartComponentIds.push_back(mesh.chartComponentIds[i]);
+    }
+    m_triangleCharts.reserve(m_triangleCharts.size() + mesh.triangleCharts.size());
+    for (auto chart : mesh.triangleCharts) {
+        if (ObjectTriangleChart::InvalidIndex != chart.componentIndex)
+            chart.componentIndex = componentIndices[chart.componentIndex];
+        if (ObjectTriangleChart::InvalidIndex != chart.brokenComponentIndex)
+            chart.brokenComponentIndex = componentIndices[chart.brokenComponentIndex];
+        if (ObjectTriangleChart::InvalidIndex != chart.seamIndex)
+            chart.seamIndex += m_seamCount;
+        m_triangleCharts.push_back(chart);
+    }
+    m_seamCount += (std::uint32_t)mesh.seamCount;
 }
 
 void MeshGenerator::setDefaultPartColor(const Color& color)
@@ -1707,7 +1793,6 @@ void MeshGenerator::preprocessMirror()
 
         mirroredPart["__mirrorFromPartId"] = mirroredPart["id"];
         mirroredPart["id"] = newPartIdString;
-        mirroredPart["__dirty"] = "true";
         newParts.push_back(mirroredPart);
     }
 
@@ -1832,7 +1917,6 @@ void MeshGenerator::preprocessMirror()
         std::string newComponentIdString = reverseUuid(mirroredComponent["id"]);
         mirroredComponent["linkData"] = findPart->second;
         mirroredComponent["id"] = newComponentIdString;
-        mirroredComponent["__dirty"] = "true";
         parentMap[newComponentIdString] = parentMap[String::valueOrEmpty(componentIt.second, "id")];
         newComponents.push_back(mirroredComponent);
     }
@@ -1865,13 +1949,15 @@ void MeshGenerator::generate()
 
     m_isSuccessful = true;
 
-    m_mainProfileMiddleX = String::toFloat(String::valueOrEmpty(m_snapshot->canvas, "originX"));
-    m_mainProfileMiddleY = String::toFloat(String::valueOrEmpty(m_snapshot->canvas, "originY"));
-    m_sideProfileMiddleX = String::toFloat(String::valueOrEmpty(m_snapshot->canvas, "originZ"));
-
     interpolateEdgesAroundJoints();
     preprocessMirror();
 
+    // Everything past the preprocessing passes reads the parsed view instead of the attribute strings
+    m_snapshotView = std::make_shared<SnapshotView>(*m_snapshot);
+    m_mainProfileMiddleX = m_snapshotView->originX();
+    m_mainProfileMiddleY = m_snapshotView->originY();
+    m_sideProfileMiddleX = m_snapshotView->originZ();
+
     m_object = new Object;
     m_object->meshId = m_id;
 
@@ -1898,13 +1984,7 @@ void MeshGenerator::generate()
         }
         for (auto it = m_cacheContext->components.begin(); it != m_cacheContext->components.end();) {
             if (m_snapshot->components.find(it->first) == m_snapshot->components.end()) {
-                for (auto combinationIt = m_cacheContext->cachedCombination.begin(); combinationIt != m_cacheContext->cachedCombination.end();) {
-                    if (std::string::npos != combinationIt->first.find(it->first)) {
-                        combinationIt = m_cacheContext->cachedCombination.erase(combinationIt);
-                        continue;
-                    }
-                    combinationIt++;
-                }
+                removeCachedCombinations(it->first);
                 it = m_cacheContext->components.erase(it);
                 continue;
             }
@@ -1912,43 +1992,58 @@ void MeshGenerator::generate()
         }
     }
 
-    collectParts();
     checkDirtyFlags();
 
-    for (const auto& dirtyComponentId : m_dirtyComponentIds) {
-        for (auto combinationIt = m_cacheContext->cachedCombination.begin(); combinationIt != m_cacheContext->cachedCombination.end();) {
-            if (std::string::npos != combinationIt->first.find(dirtyComponentId)) {
-                combinationIt = m_cacheContext->cachedCombination.erase(combinationIt);
-                continue;
-            }
-            combinationIt++;
-        }
+    // Stale meshes are dropped up front rather than when each component is rebuilt. The caller has
+    // already cleared its dirty flags, so a cancelled generation must not leave any of them behind.
+    for (const auto& componentIndex : m_dependencyGraph->dirtyComponentIndices()) {
+        const auto& componentIdString = m_snapshotView->components()[componentIndex].idString;
+        removeCachedCombinations(componentIdString);
+        auto findCache = m_cacheContext->components.find(componentIdString);
+        if (findCache != m_cacheContext->components.end())
+            findCache->second.mesh.reset();
     }
 
-    m_dirtyComponentIds.insert(to_string(Uuid()));
+    m_dependencyGraph->markComponentDirty(SnapshotView::RootComponentIndex);
+
+    prepareDirtyParts();
 
     CombineMode combineMode;
-    auto combinedMesh = combineComponentMesh(to_string(Uuid()), &combineMode);
+    auto combinedMesh = combineComponentMesh(SnapshotView::RootComponentIndex, &combineMode);
+    m_preparedParts.clear();
+
+    if (isCancelled()) {
+        m_isSuccessful = false;
+        delete m_object;
+        m_object = nullptr;
+        if (needDeleteCacheContext) {
+            delete m_cacheContext;
+            m_cacheContext = nullptr;
+        }
+        return;
+    }
 
     const auto& componentCache = m_cacheContext->components[to_string(Uuid())];
 
     m_object->positionToNodeIdMap = componentCache.positionToNodeIdMap;
     m_object->nodeMap = componentCache.nodeMap;
-    m_object->componentTriangleUvs = componentCache.componentTriangleUvs;
+    m_triangleCharts.clear();
+    m_chartComponentIds.clear();
+    m_seamCount = 0;
 
     std::vector<Vector3> combinedVertices;
     std::vector<std::vector<size_t>> combinedFaces;
     if (nullptr != combinedMesh) {
         combinedMesh->fetch(combinedVertices, combinedFaces);
-        m_object->seamTriangleUvs = combinedMesh->seamTriangleUvs;
+        collectTriangleCharts(*combinedMesh);
         recoverQuads(combinedVertices, combinedFaces, componentCache.sharedQuadEdges, m_object->triangleAndQuads);
         m_object->vertices = combinedVertices;
         m_object->triangles = combinedFaces;
     }
 
     // Recursively check uncombined components
-    collectUncombinedComponent(to_string(Uuid()));
-    collectBrokenTriangles(to_string(Uuid()));
+    collectUncombinedComponent(SnapshotView::RootComponentIndex);
+    m_object->setTriangleCharts(m_triangleCharts, m_chartComponentIds);
 
     postprocessObject(m_object);
 
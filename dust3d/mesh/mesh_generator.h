@@ -23,14 +23,21 @@
 #ifndef DUST3D_MESH_MESH_GENERATOR_H_
 #define DUST3D_MESH_MESH_GENERATOR_H_
 
+#include <atomic>
 #include <dust3d/base/combine_mode.h>
+#include <dust3d/base/flat_hash_map.h>
 #include <dust3d/base/object.h>
 #include <dust3d/base/position_key.h>
 #include <dust3d/base/snapshot.h>
+#include <dust3d/base/snapshot_view.h>
+#include <dust3d/base/thread_pool.h>
 #include <dust3d/base/uuid.h>
 #include <dust3d/mesh/mesh_combiner.h>
+#include <dust3d/mesh/mesh_dependency_graph.h>
 #include <dust3d/mesh/mesh_node.h>
 #include <dust3d/mesh/mesh_state.h>
+#include <dust3d/mesh/part_mesh_cache.h>
+#include <memory>
 #include <set>
 #include <tuple>
 #include <unordered_map>
@@ -44,22 +51,20 @@ public:
 
     struct GeneratedPart {
         std::vector<Vector3> vertices;
-        std::map<PositionKey, Uuid> positionToNodeIdMap;
+        FlatHashMap<PositionKey, Uuid> positionToNodeIdMap;
         std::map<Uuid, ObjectNode> nodeMap;
         std::vector<std::vector<size_t>> faces;
-        std::map<std::array<PositionKey, 3>, std::array<Vector2, 3>> triangleUvs;
         Color color = Color(1.0, 1.0, 1.0);
         float metalness = 0.0;
         float roughness = 1.0;
         bool isSuccessful = false;
         bool joined = true;
-        std::map<PositionKey, Color> importedVertexColorMap;
+        FlatHashMap<PositionKey, Color> importedVertexColorMap;
         std::map<std::array<PositionKey, 3>, std::array<Vector3, 3>> importedTriangleNormals;
         void reset()
         {
             vertices.clear();
             faces.clear();
-            triangleUvs.clear();
             positionToNodeIdMap.clear();
             nodeMap.clear();
             importedVertexColorMap.clear();
@@ -75,19 +80,15 @@ public:
     struct GeneratedComponent {
         std::unique_ptr<MeshState> mesh;
         std::set<std::pair<PositionKey, PositionKey>> sharedQuadEdges;
-        std::unordered_map<Uuid, std::map<std::array<PositionKey, 3>, std::array<Vector2, 3>>> componentTriangleUvs;
-        std::set<std::array<PositionKey, 3>> brokenTriangles;
         std::set<PositionKey> noneSeamVertices;
-        std::map<PositionKey, Uuid> positionToNodeIdMap;
+        FlatHashMap<PositionKey, Uuid> positionToNodeIdMap;
         std::map<Uuid, ObjectNode> nodeMap;
-        std::map<PositionKey, Color> importedVertexColorMap;
+        FlatHashMap<PositionKey, Color> importedVertexColorMap;
         std::map<std::array<PositionKey, 3>, std::array<Vector3, 3>> importedTriangleNormals;
         void reset()
         {
             mesh.reset();
             sharedQuadEdges.clear();
-            componentTriangleUvs.clear();
-            brokenTriangles.clear();
             noneSeamVertices.clear();
             positionToNodeIdMap.clear();
             nodeMap.clear();
@@ -101,12 +102,15 @@ public:
         std::map<std::string, GeneratedPart> parts;
         std::map<std::string, std::string> partMirrorIdMap;
         std::map<std::string, std::unique_ptr<MeshState>> cachedCombination;
+        // Keys of cachedCombination by each component id they were built from
+        std::map<std::string, std::set<std::string>> componentCombinations;
     };
 
     struct ComponentPreview {
         std::vector<Vector3> vertices;
         std::vector<std::vector<size_t>> triangles;
-        std::map<std::array<PositionKey, 3>, std::array<Vector2, 3>> triangleUvs;
+        // Indexed parallel to triangles, empty when the preview has no uvs
+        std::vector<std::array<Vector2, 3>> triangleUvs;
         Color color = Color(1.0, 1.0, 1.0);
         float metalness = 0.0;
         float roughness = 1.0;
@@ -129,6 +133,7 @@ public:
     const std::map<Uuid, ComponentPreview>& generatedComponentPreviews();
     Object* takeObject();
     Snapshot* takeSnapshot();
+    std::shared_ptr<const SnapshotView> snapshotView();
     virtual void generate();
     void setGeneratedCacheContext(GeneratedCacheContext* cacheContext);
     void setSmoothShadingThresholdAngleDegrees(float degrees);
@@ -136,6 +141,12 @@ public:
     void setId(uint64_t id);
     uint64_t id();
     void setImportedModelData(std::map<std::string, ImportedModelData>&& importedModelData);
+    void setThreadPool(ThreadPool* threadPool);
+    void setPartMeshCacheDirectory(const std::string& directory);
+    // Safe to call from another thread while generate() runs. The generation then stops at the
+    // next part or boolean, produces no object, and leaves the cache context reusable.
+    void cancel();
+    bool isCancelled() const;
 
 protected:
     Snapshot* snapshot() { return m_snapshot; }
@@ -144,47 +155,76 @@ protected:
     Object* m_object = nullptr;
 
 private:
+    struct PreparedPart {
+        size_t partIndex = SnapshotView::InvalidIndex;
+        bool isBuilt = false;
+        GeneratedPart part;
+        std::unique_ptr<MeshState> mesh;
+        bool hasPreview = false;
+        ComponentPreview preview;
+        bool hasError = false;
+    };
+
+    struct MeshCombination {
+        const MeshState* first = nullptr;
+        const MeshState* second = nullptr;
+        MeshCombiner::Method method = MeshCombiner::Method::Union;
+        std::string idString;
+        std::unique_ptr<MeshState> result;
+    };
+
     Color m_defaultPartColor = Color::createWhite();
     Snapshot* m_snapshot = nullptr;
+    std::shared_ptr<const SnapshotView> m_snapshotView;
     GeneratedCacheContext* m_cacheContext = nullptr;
-    std::set<std::string> m_dirtyComponentIds;
-    std::set<std::string> m_dirtyPartIds;
+    std::unique_ptr<MeshDependencyGraph> m_dependencyGraph;
     float m_mainProfileMiddleX = 0;
     float m_sideProfileMiddleX = 0;
     float m_mainProfileMiddleY = 0;
-    std::map<std::string, std::set<std::string>> m_partNodeIds;
-    std::map<std::string, std::set<std::string>> m_partEdgeIds;
     bool m_isSuccessful = false;
+    std::atomic<bool> m_isCancelled = false;
     bool m_cacheEnabled = false;
     float m_smoothShadingThresholdAngleDegrees = 60;
     uint64_t m_id = 0;
     std::map<std::string, ImportedModelData> m_importedModelData;
+    std::vector<std::unique_ptr<PreparedPart>> m_preparedParts;
+    ThreadPool* m_threadPool = nullptr;
+    std::unique_ptr<PartMeshCache> m_partMeshCache;
+    std::vector<ObjectTriangleChart> m_triangleCharts;
+    std::vector<Uuid> m_chartComponentIds;
+    std::uint32_t m_seamCount = 0;
+
+    ThreadPool* threadPool();
 
-    void collectParts();
     void interpolateEdgesAroundJoints();
     void collectIncombinableMesh(const MeshState* mesh, const GeneratedComponent& componentCache);
-    bool checkIsComponentDirty(const std::string& componentIdString);
-    bool checkIsPartDirty(const std::string& partIdString);
-    bool checkIsPartDependencyDirty(const std::string& partIdString);
     void checkDirtyFlags();
-    std::unique_ptr<MeshState> combinePartMesh(const std::string& partIdString,
-        const std::string& componentIdString,
+    void cacheCombination(const std::string& combinationIdString, std::unique_ptr<MeshState> mesh);
+    void removeCachedCombinations(const std::string& componentIdString);
+    static std::vector<std::string> combinationComponentIdStrings(const std::string& combinationIdString);
+    void componentColorAndSmoothCutoff(const SnapshotView::Component& component, Color* color, float* smoothCutoffDegrees) const;
+    bool isStitchingComponent(const SnapshotView::Component& component) const;
+    bool isComponentCacheValid(size_t componentIndex) const;
+    void collectDirtyPartComponents(size_t componentIndex, std::vector<size_t>* componentIndices) const;
+    void prepareDirtyParts();
+    std::unique_ptr<PreparedPart> preparePartMesh(size_t partIndex,
+        const Uuid& componentId,
+        Color color,
+        float smoothCutoffDegrees) const;
+    std::unique_ptr<MeshState> combinePartMesh(size_t componentIndex,
         Color color,
         float smoothCutoffDegrees,
         bool* hasError);
-    std::unique_ptr<MeshState> combineComponentMesh(const std::string& componentIdString, CombineMode* combineMode);
+    std::unique_ptr<MeshState> combineComponentMesh(size_t componentIndex, CombineMode* combineMode);
     void collectSharedQuadEdges(const std::vector<Vector3>& vertices, const std::vector<std::vector<size_t>>& faces,
         std::set<std::pair<PositionKey, PositionKey>>* sharedQuadEdges);
-    const std::map<std::string, std::string>* findComponent(const std::string& componentIdString);
-    CombineMode componentCombineMode(const std::map<std::string, std::string>* component);
-    std::unique_ptr<MeshState> combineComponentChildGroupMesh(const std::vector<std::string>& componentIdStrings,
-        GeneratedComponent& componentCache,
-        std::set<std::array<PositionKey, 3>>* brokenTriangles);
-    std::unique_ptr<MeshState> combineMultipleMeshes(std::vector<std::tuple<std::unique_ptr<MeshState>, CombineMode, std::string>>&& multipleMeshes,
-        std::set<std::array<PositionKey, 3>>* brokenTriangles);
-    std::unique_ptr<MeshState> combineStitchingMesh(const std::string& componentIdString,
-        const std::vector<std::string>& partIdStrings,
-        const std::vector<std::string>& componentIdStrings,
+    std::unique_ptr<MeshState> combineComponentChildGroupMesh(const std::vector<size_t>& componentIndices,
+        GeneratedComponent& componentCache);
+    void combineMeshPairs(std::vector<MeshCombination>* combinations);
+    std::pair<std::unique_ptr<MeshState>, std::string> combineUnionMeshes(std::vector<std::pair<std::unique_ptr<MeshState>, std::string>>&& meshes);
+    std::unique_ptr<MeshState> combineMultipleMeshes(std::vector<std::tuple<std::unique_ptr<MeshState>, CombineMode, std::string>>&& multipleMeshes);
+    std::unique_ptr<MeshState> combineStitchingMesh(size_t componentIndex,
+        const std::vector<size_t>& childComponentIndices,
         bool frontClosed,
         bool backClosed,
         bool sideClosed,
@@ -192,9 +232,8 @@ private:
         Color color,
         float smoothCutoffDegrees,
         GeneratedComponent& componentCache);
-    std::unique_ptr<MeshState> combineStitchingLoopMesh(const std::string& componentIdString,
-        const std::vector<std::string>& partIdStrings,
-        const std::vector<std::string>& componentIdStrings,
+    std::unique_ptr<MeshState> combineStitchingLoopMesh(size_t componentIndex,
+        const std::vector<size_t>& childComponentIndices,
         bool backClosed,
         float backCloseDepthRatio,
         float backCloseSharpness,
@@ -202,15 +241,15 @@ private:
         Color color,
         float smoothCutoffDegrees,
         GeneratedComponent& componentCache);
-    void collectUncombinedComponent(const std::string& componentIdString);
-    void collectBrokenTriangles(const std::string& componentIdString);
-    void cutFaceStringToCutTemplate(const std::string& cutFaceString, std::vector<Vector2>& cutTemplate);
+    void collectUncombinedComponent(size_t componentIndex);
+    void collectTriangleCharts(const MeshState& mesh);
+    void cutFaceToCutTemplate(CutFace cutFace, size_t cutFacePartIndex, std::vector<Vector2>& cutTemplate) const;
     void postprocessObject(Object* object);
     void preprocessMirror();
     std::string reverseUuid(const std::string& uuidString);
     void recoverQuads(const std::vector<Vector3>& vertices, const std::vector<std::vector<size_t>>& triangles, const std::set<std::pair<PositionKey, PositionKey>>& sharedQuadEdges, std::vector<std::vector<size_t>>& triangleAndQuads);
     void addComponentPreview(const Uuid& componentId, ComponentPreview&& preview);
-    bool fetchPartOrderedNodes(const std::string& partIdString, bool xMirrored, std::vector<MeshNode>* meshNodes, bool* isCircle);
+    bool fetchPartOrderedNodes(size_t partIndex, bool xMirrored, std::vector<MeshNode>* meshNodes, bool* isCircle) const;
 
     static void chamferFace(std::vector<Vector2>* face);
     static void subdivideFace(std::vector<Vector2>* face);
@@ -325,6 +325,7 @@ void MeshRecombiner::copyNonSeamFacesAsRegenerated()
         if (findFaceInSeam != m_facesInSeamArea.end() && m_goodSeams.find(findFaceInSeam->second) != m_goodSeams.end())
             continue;
         m_regeneratedFaces.push_back((*m_faces)[faceIndex]);
+        m_regeneratedFaceSources.push_back({ faceIndex, false, false });
     }
 }
 
@@ -343,6 +344,16 @@ const std::vector<std::vector<size_t>>& MeshRecombiner::regeneratedFaces()
     return m_regeneratedFaces;
 }
 
+const std::vector<MeshRecombiner::FaceSource>& MeshRecombiner::regeneratedFaceSources()
+{
+    return m_regeneratedFaceSources;
+}
+
+size_t MeshRecombiner::generatedBridgeCount() const
+{
+    return m_generatedBridgeCount;
+}
+
 size_t MeshRecombiner::nearestIndex(const Vector3& position, const std::vector<size_t>& edgeLoop)
 {
     float minDist2 = std::numeric_limits<float>::max();
@@ -526,7 +537,7 @@ bool MeshRecombiner::advanceSmallForBridgeQuad(const Vector3& smallCurrent, cons
 
 void MeshRecombiner::fillPairs(const std::vector<size_t>& small, const std::vector<size_t>& large)
 {
-    std::pair<std::vector<std::array<Vector3, 3>>, std::vector<std::array<Vector3, 3>>> bridgingTriangles;
+    size_t bridgeFaceStart = m_regeneratedFaces.size();
 
     size_t smallIndex = 0;
     size_t largeIndex = 0;
@@ -541,14 +552,14 @@ void MeshRecombiner::fillPairs(const std::vector<size_t>& small, const std::vect
                 m_regeneratedFaces.push_back({ small[smallIndex],
                     small[smallIndex + 1],
                     large[largeIndex] });
-                bridgingTriangles.second.push_back({ (*m_vertices)[small[smallIndex]], (*m_vertices)[small[smallIndex + 1]], (*m_vertices)[large[largeIndex]] });
+                m_regeneratedFaceSources.push_back({ m_generatedBridgeCount, true, true });
                 ++smallIndex;
                 continue;
             }
             m_regeneratedFaces.push_back({ large[largeIndex + 1],
                 large[largeIndex],
                 small[smallIndex] });
-            bridgingTriangles.first.push_back({ (*m_vertices)[large[largeIndex + 1]], (*m_vertices)[large[largeIndex]], (*m_vertices)[small[smallIndex]] });
+            m_regeneratedFaceSources.push_back({ m_generatedBridgeCount, true, false });
             ++largeIndex;
             continue;
         }
@@ -556,7 +567,7 @@ void MeshRecombiner::fillPairs(const std::vector<size_t>& small, const std::vect
             m_regeneratedFaces.push_back({ large[largeIndex + 1],
                 large[largeIndex],
                 small[smallIndex] });
-            bridgingTriangles.first.push_back({ (*m_vertices)[large[largeIndex + 1]], (*m_vertices)[large[largeIndex]], (*m_vertices)[small[smallIndex]] });
+            m_regeneratedFaceSources.push_back({ m_generatedBridgeCount, true, false });
             ++largeIndex;
             continue;
         }
@@ -564,14 +575,15 @@ void MeshRecombiner::fillPairs(const std::vector<size_t>& small, const std::vect
             m_regeneratedFaces.push_back({ small[smallIndex],
                 small[smallIndex + 1],
                 large[largeIndex] });
-            bridgingTriangles.second.push_back({ (*m_vertices)[small[smallIndex]], (*m_vertices)[small[smallIndex + 1]], (*m_vertices)[large[largeIndex]] });
+            m_regeneratedFaceSources.push_back({ m_generatedBridgeCount, true, true });
             ++smallIndex;
             continue;
         }
         break;
     }
 
-    m_generatedBridgingTriangles.emplace_back(bridgingTriangles);
+    if (m_regeneratedFaces.size() > bridgeFaceStart)
+        ++m_generatedBridgeCount;
 }
 
 void MeshRecombiner::removeReluctantVertices()
@@ -597,9 +609,4 @@ void MeshRecombiner::removeReluctantVertices()
     m_regeneratedFaces = rearrangedFaces;
 }
 
-const std::vector<std::pair<std::vector<std::array<Vector3, 3>>, std::vector<std::array<Vector3, 3>>>>& MeshRecombiner::generatedBridgingTriangles()
-{
-    return m_generatedBridgingTriangles;
-}
-
 }
@@ -33,13 +33,23 @@ namespace dust3d {
 
 class MeshRecombiner {
 public:
+    struct FaceSource {
+        // Input face the regenerated face was copied from, or the bridge a bridging triangle was generated for
+        size_t index = 0;
+        bool isBridging = false;
+        // Bridging triangles are laid out [small0, small1, large] on the small side and [large0, large1, small]
+        // on the large side, after the edge loops they connect
+        bool isSmallSide = false;
+    };
+
     void setVertices(const std::vector<Vector3>* vertices,
         const std::vector<std::pair<MeshCombiner::Source, size_t>>* verticesSourceIndices);
     void setFaces(const std::vector<std::vector<size_t>>* faces);
     const std::vector<Vector3>& regeneratedVertices();
     const std::vector<std::pair<MeshCombiner::Source, size_t>>& regeneratedVerticesSourceIndices();
     const std::vector<std::vector<size_t>>& regeneratedFaces();
-    const std::vector<std::pair<std::vector<std::array<Vector3, 3>>, std::vector<std::array<Vector3, 3>>>>& generatedBridgingTriangles();
+    const std::vector<FaceSource>& regeneratedFaceSources();
+    size_t generatedBridgeCount() const;
     bool recombine();
     const std::map<size_t, size_t>& inputFacesInSeamArea() const;
 
@@ -50,10 +60,11 @@ private:
     std::vector<Vector3> m_regeneratedVertices;
     std::vector<std::pair<MeshCombiner::Source, size_t>> m_regeneratedVerticesSourceIndices;
     std::vector<std::vector<size_t>> m_regeneratedFaces;
+    std::vector<FaceSource> m_regeneratedFaceSources;
     std::map<std::pair<size_t, size_t>, size_t> m_halfEdgeToFaceMap;
     std::map<size_t, size_t> m_facesInSeamArea;
     std::set<size_t> m_goodSeams;
-    std::vector<std::pair<std::vector<std::array<Vector3, 3>>, std::vector<std::array<Vector3, 3>>>> m_generatedBridgingTriangles;
+    size_t m_generatedBridgeCount = 0;
 
     bool buildHalfEdgeToFaceMap(std::map<std::pair<size_t, size_t>, size_t>& halfEdgeToFaceMap);
     bool convertHalfEdgesToEdgeLoops(const std::vector<std::pair<size_t, size_t>>& halfEdges,
@@ -20,7 +20,7 @@
  *  SOFTWARE.
  */
 
-#include <array>
+#include <algorithm>
 #include <dust3d/base/debug.h>
 #include <dust3d/mesh/mesh_recombiner.h>
 #include <dust3d/mesh/mesh_state.h>
@@ -30,14 +30,53 @@ namespace dust3d {
 
 MeshState::MeshState(const std::vector<Vector3>& vertices, const std::vector<std::vector<size_t>>& faces)
 {
-    mesh = std::make_unique<MeshCombiner::Mesh>(vertices, faces);
+    std::vector<size_t> triangleFaceIndices;
+    mesh = std::make_unique<MeshCombiner::Mesh>(vertices, faces, &triangleFaceIndices);
+    triangleCharts.resize(triangleFaceIndices.size());
+}
+
+MeshState::MeshState(const std::vector<Vector3>& vertices, const std::vector<std::vector<size_t>>& faces,
+    const std::vector<std::vector<Vector2>>& faceUvs,
+    const std::vector<Uuid>& componentIds,
+    const std::vector<std::uint32_t>& faceComponentIndices)
+{
+    std::vector<size_t> triangleFaceIndices;
+    mesh = std::make_unique<MeshCombiner::Mesh>(vertices, faces, &triangleFaceIndices);
+    chartComponentIds = componentIds;
+    triangleCharts.resize(triangleFaceIndices.size());
+    for (size_t i = 0; i < triangleFaceIndices.size(); ++i) {
+        size_t faceIndex = triangleFaceIndices[i];
+        if (faceIndex >= faceUvs.size() || faceIndex >= faceComponentIndices.size())
+            continue;
+        if (ObjectTriangleChart::InvalidIndex == faceComponentIndices[faceIndex])
+            continue;
+        const auto& face = faces[faceIndex];
+        const auto& uv = faceUvs[faceIndex];
+        if (uv.size() < face.size())
+            continue;
+        auto& chart = triangleCharts[i];
+        if (3 == face.size()) {
+            chart.uv = { uv[0], uv[1], uv[2] };
+        } else if (4 == face.size()) {
+            // Quads are split into (0, 1, 2) and (2, 3, 0)
+            if (i > 0 && triangleFaceIndices[i - 1] == faceIndex)
+                chart.uv = { uv[2], uv[3], uv[0] };
+            else
+                chart.uv = { uv[0], uv[1], uv[2] };
+        } else {
+            continue;
+        }
+        chart.componentIndex = faceComponentIndices[faceIndex];
+    }
 }
 
 MeshState::MeshState(const MeshState& other)
 {
     if (nullptr != other.mesh)
         mesh = std::make_unique<MeshCombiner::Mesh>(*other.mesh);
-    seamTriangleUvs = other.seamTriangleUvs;
+    triangleCharts = other.triangleCharts;
+    chartComponentIds = other.chartComponentIds;
+    seamCount = other.seamCount;
 }
 
 void MeshState::fetch(std::vector<Vector3>& vertices, std::vector<std::vector<size_t>>& faces) const
@@ -53,66 +92,112 @@ bool MeshState::isNull() const
     return mesh->isNull();
 }
 
+void MeshState::assignBrokenTriangles(const Uuid& componentId)
+{
+    std::uint32_t componentIndex = ObjectTriangleChart::InvalidIndex;
+    for (auto& chart : triangleCharts) {
+        if (!chart.isBroken || ObjectTriangleChart::InvalidIndex != chart.brokenComponentIndex)
+            continue;
+        if (ObjectTriangleChart::InvalidIndex == componentIndex) {
+            componentIndex = (std::uint32_t)(std::find(chartComponentIds.begin(), chartComponentIds.end(), componentId) - chartComponentIds.begin());
+            if (componentIndex == chartComponentIds.size())
+                chartComponentIds.push_back(componentId);
+        }
+        chart.brokenComponentIndex = componentIndex;
+    }
+}
+
 std::unique_ptr<MeshState> MeshState::combine(const MeshState& first, const MeshState& second,
-    MeshCombiner::Method method)
+    MeshCombiner::Method method, ThreadPool* threadPool)
 {
     if (first.mesh->isNull() || second.mesh->isNull())
         return nullptr;
     auto newMeshState = std::make_unique<MeshState>();
     std::vector<std::pair<MeshCombiner::Source, size_t>> combinedVerticesSources;
+    std::vector<std::pair<MeshCombiner::Source, size_t>> combinedTrianglesSources;
     auto newMesh = std::unique_ptr<MeshCombiner::Mesh>(MeshCombiner::combine(*first.mesh,
         *second.mesh,
         method,
-        &combinedVerticesSources));
-    if (nullptr == newMesh)
+        &combinedVerticesSources,
+        threadPool,
+        &combinedTrianglesSources));
+    if (nullptr == newMesh || newMesh->isNull())
         return nullptr;
-    if (!newMesh->isNull()) {
-        MeshRecombiner recombiner;
-        std::vector<Vector3> combinedVertices;
-        std::vector<std::vector<size_t>> combinedFaces;
-        newMesh->fetch(combinedVertices, combinedFaces);
-        recombiner.setVertices(&combinedVertices, &combinedVerticesSources);
-        recombiner.setFaces(&combinedFaces);
-        if (recombiner.recombine()) {
-            auto reMesh = std::make_unique<MeshCombiner::Mesh>(recombiner.regeneratedVertices(), recombiner.regeneratedFaces());
-            if (!reMesh->isNull()) {
-                for (const auto& bridgingTriangles : recombiner.generatedBridgingTriangles()) {
-                    std::pair<std::set<std::array<PositionKey, 3>>, std::set<std::array<PositionKey, 3>>> triangles;
-                    for (const auto& tri : bridgingTriangles.first) {
-                        triangles.first.insert(std::array<PositionKey, 3> {
-                            PositionKey(tri[0]),
-                            PositionKey(tri[1]),
-                            PositionKey(tri[2]) });
-                    }
-                    for (const auto& tri : bridgingTriangles.second) {
-                        triangles.second.insert(std::array<PositionKey, 3> {
-                            PositionKey(tri[0]),
-                            PositionKey(tri[1]),
-                            PositionKey(tri[2]) });
-                    }
-                    if (triangles.first.empty() && triangles.second.empty())
-                        continue;
-                    newMeshState->seamTriangleUvs.push_back(triangles);
-                }
-                newMesh = std::move(reMesh);
-            }
-            for (const auto& faceIt : recombiner.inputFacesInSeamArea()) {
-                const auto& face = combinedFaces[faceIt.first];
-                newMeshState->brokenTriangles.push_back(std::array<PositionKey, 3> {
-                    PositionKey(combinedVertices[face[0]]),
-                    PositionKey(combinedVertices[face[1]]),
-                    PositionKey(combinedVertices[face[2]]) });
-            }
+
+    MeshRecombiner recombiner;
+    std::vector<Vector3> combinedVertices;
+    std::vector<std::vector<size_t>> combinedFaces;
+    newMesh->fetch(combinedVertices, combinedFaces);
+    recombiner.setVertices(&combinedVertices, &combinedVerticesSources);
+    recombiner.setFaces(&combinedFaces);
+    bool hasSeams = recombiner.recombine();
+    bool isRecombined = false;
+    if (hasSeams) {
+        auto reMesh = std::make_unique<MeshCombiner::Mesh>(recombiner.regeneratedVertices(), recombiner.regeneratedFaces());
+        if (!reMesh->isNull()) {
+            newMesh = std::move(reMesh);
+            isRecombined = true;
         }
     }
-    if (newMesh->isNull()) {
-        return nullptr;
+
+    // Both meshes share one component list, and the seams bridged here come before the ones of each mesh
+    std::uint32_t bridgeCount = isRecombined ? (std::uint32_t)recombiner.generatedBridgeCount() : 0;
+    newMeshState->seamCount = bridgeCount + first.seamCount + second.seamCount;
+    newMeshState->chartComponentIds = first.chartComponentIds;
+    std::vector<std::uint32_t> secondComponentIndices(second.chartComponentIds.size());
+    for (size_t i = 0; i < second.chartComponentIds.size(); ++i) {
+        const auto& componentIds = newMeshState->chartComponentIds;
+        secondComponentIndices[i] = (std::uint32_t)(std::find(componentIds.begin(), componentIds.end(), second.chartComponentIds[i]) - componentIds.begin());
+        if (secondComponentIndices[i] == componentIds.size())
+            newMeshState->chartComponentIds.push_back(second.chartComponentIds[i]);
+    }
+    auto offsetSeam = [](ObjectTriangleChart& chart, std::uint32_t offset) {
+        if (ObjectTriangleChart::InvalidIndex != chart.seamIndex)
+            chart.seamIndex += offset;
+    };
+    auto remapComponent = [&](std::uint32_t& componentIndex) {
+        if (ObjectTriangleChart::InvalidIndex != componentIndex)
+            componentIndex = secondComponentIndices[componentIndex];
+    };
+
+    std::vector<ObjectTriangleChart> combinedCharts(combinedFaces.size());
+    for (size_t i = 0; i < combinedTrianglesSources.size() && i < combinedCharts.size(); ++i) {
+        const auto& source = combinedTrianglesSources[i];
+        if (MeshCombiner::Source::First == source.first && source.second < first.triangleCharts.size()) {
+            auto& chart = combinedCharts[i];
+            chart = first.triangleCharts[source.second];
+            offsetSeam(chart, bridgeCount);
+        } else if (MeshCombiner::Source::Second == source.first && source.second < second.triangleCharts.size()) {
+            auto& chart = combinedCharts[i];
+            chart = second.triangleCharts[source.second];
+            offsetSeam(chart, bridgeCount + (std::uint32_t)first.seamCount);
+            remapComponent(chart.componentIndex);
+            remapComponent(chart.brokenComponentIndex);
+        }
     }
+    if (hasSeams) {
+        for (const auto& faceIt : recombiner.inputFacesInSeamArea())
+            combinedCharts[faceIt.first].isBroken = true;
+    }
+
+    if (isRecombined) {
+        const auto& faceSources = recombiner.regeneratedFaceSources();
+        newMeshState->triangleCharts.resize(faceSources.size());
+        for (size_t i = 0; i < faceSources.size(); ++i) {
+            const auto& source = faceSources[i];
+            auto& chart = newMeshState->triangleCharts[i];
+            if (source.isBridging) {
+                chart.seamIndex = (std::uint32_t)source.index;
+                chart.isSmallSide = source.isSmallSide;
+                continue;
+            }
+            chart = combinedCharts[source.index];
+        }
+    } else {
+        newMeshState->triangleCharts = std::move(combinedCharts);
+    }
+
     newMeshState->mesh = std::move(newMesh);
-    for (const auto& it : first.seamTriangleUvs)
-        newMeshState->seamTriangleUvs.push_back(it);
-    for (const auto& it : second.seamTriangleUvs)
-        newMeshState->seamTriangleUvs.push_back(it);
     return newMeshState;
 }
 
@@ -23,26 +23,37 @@
 #ifndef DUST3D_MESH_MESH_STATE_H_
 #define DUST3D_MESH_MESH_STATE_H_
 
-#include <dust3d/base/position_key.h>
+#include <cstdint>
+#include <dust3d/base/object.h>
+#include <dust3d/base/uuid.h>
+#include <dust3d/base/vector2.h>
 #include <dust3d/mesh/mesh_combiner.h>
-#include <map>
-#include <set>
 
 namespace dust3d {
 
 class MeshState {
 public:
     std::unique_ptr<MeshCombiner::Mesh> mesh;
-    std::vector<std::pair<std::set<std::array<PositionKey, 3>>, std::set<std::array<PositionKey, 3>>>> seamTriangleUvs;
-    std::vector<std::array<PositionKey, 3>> brokenTriangles;
+    // Indexed parallel to the triangles of mesh, the charts refer to chartComponentIds by index
+    std::vector<ObjectTriangleChart> triangleCharts;
+    std::vector<Uuid> chartComponentIds;
+    size_t seamCount = 0;
 
     MeshState() = default;
     MeshState(const std::vector<Vector3>& vertices, const std::vector<std::vector<size_t>>& faces);
+    // The triangles of each face with three or four corners take their uvs from faceUvs, in the chart
+    // of componentIds[faceComponentIndices[face]]
+    MeshState(const std::vector<Vector3>& vertices, const std::vector<std::vector<size_t>>& faces,
+        const std::vector<std::vector<Vector2>>& faceUvs,
+        const std::vector<Uuid>& componentIds,
+        const std::vector<std::uint32_t>& faceComponentIndices);
     MeshState(const MeshState& other);
     void fetch(std::vector<Vector3>& vertices, std::vector<std::vector<size_t>>& faces) const;
     bool isNull() const;
+    // Broken triangles not yet owned by a component are given to componentId
+    void assignBrokenTriangles(const Uuid& componentId);
     static std::unique_ptr<MeshState> combine(const MeshState& first, const MeshState& second,
-        MeshCombiner::Method method);
+        MeshCombiner::Method method, ThreadPool* threadPool = nullptr);
     static bool isWatertight(const std::vector<std::vector<size_t>>& faces);
 };
 
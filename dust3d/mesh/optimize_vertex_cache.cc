@@ -0,0 +1,191 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <dust3d/mesh/optimize_vertex_cache.h>
+
+namespace dust3d {
+
+static constexpr size_t forsythCacheSize = 32;
+static constexpr size_t forsythMaxValence = 32;
+
+class ForsythScores {
+public:
+    ForsythScores()
+    {
+        for (size_t i = 0; i < forsythCacheSize; ++i) {
+            // The three vertices of the last triangle get a fixed score, so the next one doesn't simply reuse them
+            m_cacheScores[i] = i < 3 ? 0.75f : std::pow(1.0f - (float)(i - 3) / (forsythCacheSize - 3), 1.5f);
+        }
+        m_valenceScores[0] = 0.0f;
+        for (size_t i = 1; i <= forsythMaxValence; ++i)
+            m_valenceScores[i] = 2.0f / std::sqrt((float)i);
+    }
+
+    float vertexScore(int cachePosition, size_t remainingTriangles) const
+    {
+        if (0 == remainingTriangles)
+            return -1.0f;
+        float score = cachePosition >= 0 ? m_cacheScores[cachePosition] : 0.0f;
+        score += remainingTriangles <= forsythMaxValence ? m_valenceScores[remainingTriangles] : 2.0f / std::sqrt((float)remainingTriangles);
+        return score;
+    }
+
+private:
+    float m_cacheScores[forsythCacheSize];
+    float m_valenceScores[forsythMaxValence + 1];
+};
+
+void optimizeVertexCache(std::vector<std::uint32_t>* indices, size_t vertexCount)
+{
+    static const ForsythScores scores;
+
+    size_t triangleCount = indices->size() / 3;
+    if (triangleCount < 2)
+        return;
+
+    std::vector<std::uint32_t> vertexTriangleOffsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+        ++vertexTriangleOffsets[(*indices)[i] + 1];
+    for (size_t v = 0; v < vertexCount; ++v)
+        vertexTriangleOffsets[v + 1] += vertexTriangleOffsets[v];
+    std::vector<std::uint32_t> remainingTriangles(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+        remainingTriangles[v] = vertexTriangleOffsets[v + 1] - vertexTriangleOffsets[v];
+    std::vector<std::uint32_t> vertexTriangles(triangleCount * 3);
+    std::vector<std::uint32_t> fillCounts(vertexCount, 0);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (size_t j = 0; j < 3; ++j) {
+            std::uint32_t v = (*indices)[t * 3 + j];
+            vertexTriangles[vertexTriangleOffsets[v] + fillCounts[v]++] = (std::uint32_t)t;
+        }
+    }
+
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+        vertexScores[v] = scores.vertexScore(-1, remainingTriangles[v]);
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<std::uint32_t> cache;
+    std::vector<std::uint32_t> newCache;
+    cache.reserve(forsythCacheSize + 3);
+    newCache.reserve(forsythCacheSize + 3);
+    std::vector<std::uint32_t> optimizedIndices;
+    optimizedIndices.reserve(triangleCount * 3);
+
+    size_t nextUnemittedTriangle = 0;
+    size_t bestTriangle = 0;
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (triangleCount == bestTriangle) {
+            while (emitted[nextUnemittedTriangle])
+                ++nextUnemittedTriangle;
+            bestTriangle = nextUnemittedTriangle;
+        }
+        emitted[bestTriangle] = true;
+
+        newCache.clear();
+        for (size_t j = 0; j < 3; ++j) {
+            std::uint32_t v = (*indices)[bestTriangle * 3 + j];
+            optimizedIndices.push_back(v);
+            std::uint32_t* begin = &vertexTriangles[vertexTriangleOffsets[v]];
+            std::uint32_t* end = begin + remainingTriangles[v];
+            std::uint32_t* found = std::find(begin, end, (std::uint32_t)bestTriangle);
+            if (found != end) {
+                *found = *(end - 1);
+                --remainingTriangles[v];
+            }
+            if (newCache.end() == std::find(newCache.begin(), newCache.end(), v))
+                newCache.push_back(v);
+        }
+        for (const auto& v : cache) {
+            if (newCache.end() == std::find(newCache.begin(), newCache.end(), v))
+                newCache.push_back(v);
+        }
+        for (size_t i = forsythCacheSize; i < newCache.size(); ++i) {
+            std::uint32_t v = newCache[i];
+            cachePositions[v] = -1;
+            vertexScores[v] = scores.vertexScore(-1, remainingTriangles[v]);
+        }
+        if (newCache.size() > forsythCacheSize)
+            newCache.resize(forsythCacheSize);
+        cache.swap(newCache);
+
+        for (size_t i = 0; i < cache.size(); ++i) {
+            std::uint32_t v = cache[i];
+            cachePositions[v] = (int)i;
+            vertexScores[v] = scores.vertexScore((int)i, remainingTriangles[v]);
+        }
+
+        // Only triangles touching the cache changed score, the best of them goes next
+        bestTriangle = triangleCount;
+        float bestScore = -1.0f;
+        for (const auto& v : cache) {
+            const std::uint32_t* begin = &vertexTriangles[vertexTriangleOffsets[v]];
+            for (const std::uint32_t* it = begin; it != begin + remainingTriangles[v]; ++it) {
+                const std::uint32_t* triangle = &(*indices)[*it * 3];
+                float score = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = *it;
+                }
+            }
+        }
+    }
+
+    indices->swap(optimizedIndices);
+}
+
+void optimizeVertexFetch(std::vector<std::uint32_t>* indices, size_t vertexCount,
+    std::vector<std::uint32_t>* newToOldVertices)
+{
+    constexpr std::uint32_t unassigned = (std::uint32_t)-1;
+    std::vector<std::uint32_t> oldToNewVertices(vertexCount, unassigned);
+    newToOldVertices->clear();
+    for (auto& index : *indices) {
+        std::uint32_t& newIndex = oldToNewVertices[index];
+        if (unassigned == newIndex) {
+            newIndex = (std::uint32_t)newToOldVertices->size();
+            newToOldVertices->push_back(index);
+        }
+        index = newIndex;
+    }
+}
+
+float averageCacheMissRatio(const std::vector<std::uint32_t>& indices, size_t vertexCount, size_t cacheSize)
+{
+    size_t triangleCount = indices.size() / 3;
+    if (0 == triangleCount)
+        return 0.0f;
+    std::vector<size_t> cachedAt(vertexCount, 0);
+    size_t misses = 0;
+    for (const auto& index : indices) {
+        if (0 != cachedAt[index] && misses - cachedAt[index] < cacheSize)
+            continue;
+        ++misses;
+        cachedAt[index] = misses;
+    }
+    return (float)misses / triangleCount;
+}
+
+}
@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_MESH_OPTIMIZE_VERTEX_CACHE_H_
+#define DUST3D_MESH_OPTIMIZE_VERTEX_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dust3d {
+
+// Reorders triangles for the post-transform vertex cache, following Tom Forsyth's
+// "Linear-Speed Vertex Cache Optimisation"
+void optimizeVertexCache(std::vector<std::uint32_t>* indices, size_t vertexCount);
+
+// Renumbers vertices in order of first use, so vertex fetch walks the buffers forward.
+// newToOldVertices receives the old vertex of each new one, unreferenced vertices are dropped
+void optimizeVertexFetch(std::vector<std::uint32_t>* indices, size_t vertexCount,
+    std::vector<std::uint32_t>* newToOldVertices);
+
+// Transformed vertices per triangle with a FIFO cache of the given size, 3 means no reuse at all
+float averageCacheMissRatio(const std::vector<std::uint32_t>& indices, size_t vertexCount, size_t cacheSize = 16);
+
+}
+
+#endif
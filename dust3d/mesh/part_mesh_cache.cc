@@ -0,0 +1,505 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <dust3d/mesh/part_mesh_cache.h>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace dust3d {
+
+const std::uint32_t PartMeshCache::m_version = 2;
+
+static const char g_magic[8] = { 'D', 'S', '3', 'P', 'M', 'E', 'S', 'H' };
+
+class PartMeshCache::KeyWriter {
+public:
+    void add(const void* data, size_t size)
+    {
+        m_inputs.append((const char*)data, size);
+    }
+
+    template <typename T>
+    void add(const T& value)
+    {
+        add(&value, sizeof(value));
+    }
+
+    void add(const std::string& string)
+    {
+        add((std::uint64_t)string.size());
+        add(string.data(), string.size());
+    }
+
+    void add(const Vector3& vector)
+    {
+        add(vector.x());
+        add(vector.y());
+        add(vector.z());
+    }
+
+    void add(const Vector2& vector)
+    {
+        add(vector.x());
+        add(vector.y());
+    }
+
+    Key key() const
+    {
+        Key key;
+        key.hash = 0xcbf29ce484222325ull;
+        for (const auto& byte : m_inputs) {
+            key.hash ^= (unsigned char)byte;
+            key.hash *= 0x100000001b3ull;
+        }
+        key.inputs = m_inputs;
+        return key;
+    }
+
+private:
+    std::string m_inputs;
+};
+
+class PartMeshCache::EntryWriter {
+public:
+    template <typename T>
+    void write(const T& value)
+    {
+        m_data.append((const char*)&value, sizeof(value));
+    }
+
+    void write(const Vector3& vector)
+    {
+        write(vector.x());
+        write(vector.y());
+        write(vector.z());
+    }
+
+    void write(const Vector2& vector)
+    {
+        write(vector.x());
+        write(vector.y());
+    }
+
+    const std::string& data() const
+    {
+        return m_data;
+    }
+
+private:
+    std::string m_data;
+};
+
+class PartMeshCache::EntryReader {
+public:
+    EntryReader(const std::string& data)
+        : m_data(data)
+    {
+    }
+
+    template <typename T>
+    bool read(T* value)
+    {
+        if (m_offset + sizeof(T) > m_data.size())
+            return false;
+        std::memcpy(value, m_data.data() + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return true;
+    }
+
+    bool read(Vector3* vector)
+    {
+        double x, y, z;
+        if (!read(&x) || !read(&y) || !read(&z))
+            return false;
+        *vector = Vector3(x, y, z);
+        return true;
+    }
+
+    bool read(Vector2* vector)
+    {
+        double x, y;
+        if (!read(&x) || !read(&y))
+            return false;
+        *vector = Vector2(x, y);
+        return true;
+    }
+
+    // Counts come from the file, so check them against what is left before allocating
+    bool readCount(std::uint32_t* count, size_t minimalItemSize)
+    {
+        if (!read(count))
+            return false;
+        return (size_t)*count * minimalItemSize <= m_data.size() - m_offset;
+    }
+
+    bool readString(std::string* string, size_t size)
+    {
+        if (m_offset + size > m_data.size())
+            return false;
+        string->assign(m_data.data() + m_offset, size);
+        m_offset += size;
+        return true;
+    }
+
+    bool atEnd() const
+    {
+        return m_offset == m_data.size();
+    }
+
+private:
+    const std::string& m_data;
+    size_t m_offset = 0;
+};
+
+// Writes, modification time refreshes and evictions of every cache run in order on one thread,
+// which also owns the size bookkeeping of the cache directories
+class PartMeshCache::Writer {
+public:
+    static Writer* instance()
+    {
+        static Writer s_writer;
+        return &s_writer;
+    }
+
+    ~Writer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopped = true;
+        }
+        m_condition.notify_all();
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    void post(std::function<void(Writer*)> task)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_thread.joinable())
+            m_thread = std::thread(&Writer::run, this);
+        m_tasks.push_back(std::move(task));
+        m_condition.notify_one();
+    }
+
+    std::string temporaryPath(const std::string& path)
+    {
+        char suffix[64];
+        snprintf(suffix, sizeof(suffix), ".%016llx-%llu.tmp", (unsigned long long)m_processToken, (unsigned long long)++m_temporaryCount);
+        return path + suffix;
+    }
+
+    void addEntry(const std::string& directory, std::uint64_t size, std::uint64_t sizeLimit)
+    {
+        auto findSize = m_directorySizes.find(directory);
+        if (findSize == m_directorySizes.end()) {
+            m_directorySizes.insert({ directory, evict(directory, sizeLimit) });
+            return;
+        }
+        findSize->second += size;
+        if (findSize->second > sizeLimit)
+            findSize->second = evict(directory, sizeLimit);
+    }
+
+private:
+    std::thread m_thread;
+    std::deque<std::function<void(Writer*)>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopped = false;
+    std::map<std::string, std::uint64_t> m_directorySizes;
+    std::uint64_t m_processToken = 0;
+    std::uint64_t m_temporaryCount = 0;
+
+    Writer()
+    {
+        // Other processes share the directory, so temporary names carry a random token
+        std::random_device device;
+        m_processToken = ((std::uint64_t)device() << 32) ^ device()
+            ^ (std::uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    void run()
+    {
+        for (;;) {
+            std::function<void(Writer*)> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [&] { return m_stopped || !m_tasks.empty(); });
+                if (m_tasks.empty())
+                    return;
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task(this);
+        }
+    }
+
+    // Removes the least recently used entries until the directory is a quarter below the limit,
+    // along with temporary files left behind by writers that died, and returns the size left
+    static std::uint64_t evict(const std::string& directory, std::uint64_t sizeLimit)
+    {
+        struct Entry {
+            std::filesystem::path path;
+            std::filesystem::file_time_type time;
+            std::uint64_t size;
+        };
+        std::vector<Entry> entries;
+        std::uint64_t totalSize = 0;
+        std::error_code error;
+        auto staleTime = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+        for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+            auto time = it->last_write_time(error);
+            if (error)
+                continue;
+            auto extension = it->path().extension();
+            if (".tmp" == extension) {
+                if (time < staleTime)
+                    std::filesystem::remove(it->path(), error);
+                continue;
+            }
+            if (".mesh" != extension)
+                continue;
+            std::uint64_t size = it->file_size(error);
+            if (error)
+                continue;
+            entries.push_back({ it->path(), time, size });
+            totalSize += size;
+        }
+        if (totalSize <= sizeLimit)
+            return totalSize;
+        std::sort(entries.begin(), entries.end(), [](const Entry& first, const Entry& second) {
+            return first.time < second.time;
+        });
+        std::uint64_t targetSize = sizeLimit - sizeLimit / 4;
+        for (const auto& entry : entries) {
+            if (totalSize <= targetSize)
+                break;
+            if (std::filesystem::remove(entry.path, error))
+                totalSize -= entry.size;
+        }
+        return totalSize;
+    }
+};
+
+PartMeshCache::PartMeshCache(const std::string& directory, std::uint64_t sizeLimit)
+    : m_directory(directory)
+    , m_sizeLimit(sizeLimit)
+{
+}
+
+PartMeshCache::Key PartMeshCache::makeKey(const TubeMeshBuilder::BuildParameters& buildParameters,
+    const std::vector<MeshNode>& nodes,
+    bool isCircle)
+{
+    KeyWriter keyWriter;
+    keyWriter.add(m_version);
+    keyWriter.add((std::uint64_t)buildParameters.cutFace.size());
+    for (const auto& it : buildParameters.cutFace)
+        keyWriter.add(it);
+    keyWriter.add(buildParameters.deformThickness);
+    keyWriter.add(buildParameters.deformWidth);
+    keyWriter.add(buildParameters.deformUnified);
+    keyWriter.add(buildParameters.baseNormalRotation);
+    keyWriter.add(buildParameters.frontEndRounded);
+    keyWriter.add(buildParameters.backEndRounded);
+    keyWriter.add(buildParameters.interpolationEnabled);
+    keyWriter.add(isCircle);
+    keyWriter.add((std::uint64_t)nodes.size());
+    for (const auto& it : nodes) {
+        keyWriter.add(it.origin);
+        keyWriter.add(it.radius);
+        keyWriter.add(it.sourceId.toString());
+    }
+    return keyWriter.key();
+}
+
+std::string PartMeshCache::entryPath(std::uint64_t hash) const
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.mesh", (unsigned long long)hash);
+    return m_directory + "/" + name;
+}
+
+bool PartMeshCache::load(const Key& key, Mesh* mesh) const
+{
+    std::string path = entryPath(key.hash);
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return false;
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    EntryReader reader(data);
+    char magic[sizeof(g_magic)];
+    std::uint32_t version = 0;
+    std::uint64_t storedHash = 0;
+    std::uint32_t inputsSize = 0;
+    std::string storedInputs;
+    for (size_t i = 0; i < sizeof(magic); ++i) {
+        if (!reader.read(&magic[i]) || magic[i] != g_magic[i])
+            return false;
+    }
+    if (!reader.read(&version) || m_version != version)
+        return false;
+    if (!reader.read(&storedHash) || key.hash != storedHash)
+        return false;
+    if (!reader.read(&inputsSize) || !reader.readString(&storedInputs, inputsSize) || key.inputs != storedInputs)
+        return false;
+
+    std::uint32_t count = 0;
+    if (!reader.readCount(&count, sizeof(double) * 3))
+        return false;
+    mesh->vertices.resize(count);
+    for (auto& it : mesh->vertices) {
+        if (!reader.read(&it))
+            return false;
+    }
+
+    if (!reader.readCount(&count, sizeof(std::uint32_t)))
+        return false;
+    mesh->faces.resize(count);
+    for (auto& face : mesh->faces) {
+        std::uint32_t size = 0;
+        if (!reader.readCount(&size, sizeof(std::uint32_t)))
+            return false;
+        face.resize(size);
+        for (auto& index : face) {
+            std::uint32_t value = 0;
+            if (!reader.read(&value) || value >= mesh->vertices.size())
+                return false;
+            index = value;
+        }
+    }
+
+    if (!reader.readCount(&count, sizeof(std::uint32_t)))
+        return false;
+    mesh->faceUvs.resize(count);
+    for (auto& faceUv : mesh->faceUvs) {
+        std::uint32_t size = 0;
+        if (!reader.readCount(&size, sizeof(double) * 2))
+            return false;
+        faceUv.resize(size);
+        for (auto& uv : faceUv) {
+            if (!reader.read(&uv))
+                return false;
+        }
+    }
+
+    if (!reader.readCount(&count, sizeof(std::uint32_t)))
+        return false;
+    mesh->vertexSources.resize(count);
+    for (auto& source : mesh->vertexSources) {
+        std::uint32_t size = 0;
+        std::string string;
+        if (!reader.read(&size) || !reader.readString(&string, size))
+            return false;
+        source = Uuid(string);
+    }
+
+    if (!reader.atEnd())
+        return false;
+
+    Writer::instance()->post([path](Writer*) {
+        std::error_code error;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+    });
+    return true;
+}
+
+void PartMeshCache::save(const Key& key, const Mesh& mesh) const
+{
+    Writer::instance()->post([directory = m_directory, sizeLimit = m_sizeLimit, path = entryPath(key.hash), key, mesh](Writer* writer) {
+        std::string data = serialize(key, mesh);
+        std::string temporaryPath = writer->temporaryPath(path);
+        {
+            std::ofstream file(temporaryPath, std::ios::out | std::ios::trunc | std::ios::binary);
+            if (!file.is_open())
+                return;
+            file.write(data.data(), data.size());
+            if (!file.good()) {
+                file.close();
+                std::remove(temporaryPath.c_str());
+                return;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, path, error);
+        if (error) {
+            std::remove(temporaryPath.c_str());
+            return;
+        }
+        writer->addEntry(directory, data.size(), sizeLimit);
+    });
+}
+
+std::string PartMeshCache::serialize(const Key& key, const Mesh& mesh)
+{
+    EntryWriter writer;
+    for (size_t i = 0; i < sizeof(g_magic); ++i)
+        writer.write(g_magic[i]);
+    writer.write(m_version);
+    writer.write(key.hash);
+    writer.write((std::uint32_t)key.inputs.size());
+    for (const auto& character : key.inputs)
+        writer.write(character);
+
+    writer.write((std::uint32_t)mesh.vertices.size());
+    for (const auto& it : mesh.vertices)
+        writer.write(it);
+
+    writer.write((std::uint32_t)mesh.faces.size());
+    for (const auto& face : mesh.faces) {
+        writer.write((std::uint32_t)face.size());
+        for (const auto& index : face)
+            writer.write((std::uint32_t)index);
+    }
+
+    writer.write((std::uint32_t)mesh.faceUvs.size());
+    for (const auto& faceUv : mesh.faceUvs) {
+        writer.write((std::uint32_t)faceUv.size());
+        for (const auto& uv : faceUv)
+            writer.write(uv);
+    }
+
+    writer.write((std::uint32_t)mesh.vertexSources.size());
+    for (const auto& source : mesh.vertexSources) {
+        std::string string = source.toString();
+        writer.write((std::uint32_t)string.size());
+        for (const auto& character : string)
+            writer.write(character);
+    }
+
+    return writer.data();
+}
+
+}
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef DUST3D_MESH_PART_MESH_CACHE_H_
+#define DUST3D_MESH_PART_MESH_CACHE_H_
+
+#include <cstdint>
+#include <dust3d/base/uuid.h>
+#include <dust3d/base/vector2.h>
+#include <dust3d/base/vector3.h>
+#include <dust3d/mesh/mesh_node.h>
+#include <dust3d/mesh/tube_mesh_builder.h>
+#include <string>
+#include <vector>
+
+namespace dust3d {
+
+// On disk store of built tube meshes, shared across sessions.
+// Entries are addressed by a hash of everything the tube builder consumes, so reopening a
+// document finds the meshes of every unchanged part, and an edited part simply misses.
+// The inputs are stored along with each entry and compared on load, so a hash collision
+// is a miss rather than the wrong mesh.
+// Writes go to one background thread shared by all caches. Each entry is written through
+// a process unique temporary name and renamed into place, which keeps concurrent writers
+// from exposing half written files. Loading an entry refreshes its modification time, and
+// the least recently used entries are removed once the directory grows past the size limit.
+class PartMeshCache {
+public:
+    struct Key {
+        std::uint64_t hash = 0;
+        std::string inputs;
+    };
+
+    struct Mesh {
+        std::vector<Vector3> vertices;
+        std::vector<std::vector<size_t>> faces;
+        std::vector<std::vector<Vector2>> faceUvs;
+        std::vector<Uuid> vertexSources;
+    };
+
+    static const std::uint64_t DefaultSizeLimit = 64 * 1024 * 1024;
+
+    PartMeshCache(const std::string& directory, std::uint64_t sizeLimit = DefaultSizeLimit);
+    bool load(const Key& key, Mesh* mesh) const;
+    void save(const Key& key, const Mesh& mesh) const;
+
+    static Key makeKey(const TubeMeshBuilder::BuildParameters& buildParameters,
+        const std::vector<MeshNode>& nodes,
+        bool isCircle);
+
+private:
+    class KeyWriter;
+    class EntryWriter;
+    class EntryReader;
+    class Writer;
+
+    std::string m_directory;
+    std::uint64_t m_sizeLimit = DefaultSizeLimit;
+
+    std::string entryPath(std::uint64_t hash) const;
+    static std::string serialize(const Key& key, const Mesh& mesh);
+
+    // Bump whenever the tube builder output or the file layout changes
+    static const std::uint32_t m_version;
+};
+
+}
+
+#endif
@@ -36,7 +36,7 @@ void SolidMesh::setVertices(const std::vector<Vector3>* vertices)
     m_vertices = vertices;
 }
 
-void SolidMesh::setTriangles(const std::vector<std::vector<size_t>>* triangles)
+void SolidMesh::setTriangles(const std::vector<Triangle>* triangles)
 {
     m_triangles = triangles;
 }
@@ -66,14 +66,8 @@ void SolidMesh::prepare()
     for (size_t i = 0; i < m_triangleAxisAlignedBoundingBoxes->size(); ++i)
         firstGroupOfFacesIn.push_back(i);
 
-    AxisAlignedBoudingBox groupBox;
-    for (const auto& i : firstGroupOfFacesIn) {
-        addTriagleToAxisAlignedBoundingBox((*m_triangles)[i], &groupBox);
-    }
-    groupBox.updateCenter();
-
     m_axisAlignedBoundingBoxTree = new AxisAlignedBoudingBoxTree(m_triangleAxisAlignedBoundingBoxes,
-        firstGroupOfFacesIn, groupBox);
+        firstGroupOfFacesIn);
 }
 
 }
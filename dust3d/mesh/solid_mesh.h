@@ -23,6 +23,8 @@
 #ifndef DUST3D_MESH_SOLID_MESH_H_
 #define DUST3D_MESH_SOLID_MESH_H_
 
+#include <array>
+#include <cstdint>
 #include <dust3d/base/axis_aligned_bounding_box.h>
 #include <dust3d/base/axis_aligned_bounding_box_tree.h>
 #include <dust3d/base/vector3.h>
@@ -31,16 +33,18 @@ namespace dust3d {
 
 class SolidMesh {
 public:
+    typedef std::array<std::uint32_t, 3> Triangle;
+
     ~SolidMesh();
     void setVertices(const std::vector<Vector3>* vertices);
-    void setTriangles(const std::vector<std::vector<size_t>>* triangles);
+    void setTriangles(const std::vector<Triangle>* triangles);
 
     const std::vector<Vector3>* vertices() const
     {
         return m_vertices;
     }
 
-    const std::vector<std::vector<size_t>>* triangles() const
+    const std::vector<Triangle>* triangles() const
     {
         return m_triangles;
     }
@@ -63,14 +67,14 @@ public:
     void prepare();
 
 private:
-    void addTriagleToAxisAlignedBoundingBox(const std::vector<size_t>& triangle, AxisAlignedBoudingBox* box)
+    void addTriagleToAxisAlignedBoundingBox(const Triangle& triangle, AxisAlignedBoudingBox* box)
     {
         for (size_t i = 0; i < 3; ++i)
             box->update((*m_vertices)[triangle[i]]);
     }
 
     const std::vector<Vector3>* m_vertices = nullptr;
-    const std::vector<std::vector<size_t>>* m_triangles = nullptr;
+    const std::vector<Triangle>* m_triangles = nullptr;
     std::vector<Vector3>* m_triangleNormals = nullptr;
     AxisAlignedBoudingBoxTree* m_axisAlignedBoundingBoxTree = nullptr;
     std::vector<AxisAlignedBoudingBox>* m_triangleAxisAlignedBoundingBoxes = nullptr;
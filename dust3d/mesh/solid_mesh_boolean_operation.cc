@@ -21,6 +21,7 @@
  */
 
 #include <GuigueDevillers03/tri_tri_intersect.h>
+#include <algorithm>
 #include <dust3d/base/debug.h>
 #include <dust3d/base/position_key.h>
 #include <dust3d/mesh/re_triangulator.h>
@@ -37,6 +38,8 @@ static const std::vector<Vector3> g_testAxisList = {
     { std::numeric_limits<double>::epsilon(), std::numeric_limits<double>::epsilon(), std::numeric_limits<double>::max() },
 };
 
+static const size_t g_intersectionBlockSize = 256;
+
 SolidMeshBooleanOperation::SolidMeshBooleanOperation(const SolidMesh* m_firstMesh,
     const SolidMesh* m_secondMesh)
     : m_firstMesh(m_firstMesh)
@@ -48,27 +51,25 @@ SolidMeshBooleanOperation::~SolidMeshBooleanOperation()
 {
 }
 
+void SolidMeshBooleanOperation::setThreadPool(ThreadPool* threadPool)
+{
+    m_threadPool = threadPool;
+}
+
 bool SolidMeshBooleanOperation::isPointInMesh(const Vector3& testPosition,
     const SolidMesh* targetMesh,
     const AxisAlignedBoudingBoxTree* meshBoxTree,
-    const Vector3& testAxis)
+    const Vector3& testAxis,
+    PointInMeshContext* context) const
 {
     Vector3 testEnd = testPosition + testAxis;
-    bool inside = false;
-    std::vector<AxisAlignedBoudingBox> rayBox(1);
-    auto& box = rayBox[0];
-    box.update(testPosition);
-    box.update(testEnd);
-    AxisAlignedBoudingBoxTree testTree(&rayBox,
-        { 0 },
-        rayBox[0]);
-    std::vector<std::pair<size_t, size_t>> pairs;
-    meshBoxTree->test(meshBoxTree->root(), testTree.root(), &rayBox, &pairs);
-    std::set<PositionKey> hits;
-
-    for (const auto& it : pairs) {
-        const auto& triangle = (*targetMesh->triangles())[it.first];
-        std::vector<Vector3> trianglePositions = {
+    context->candidates.clear();
+    context->hits.clear();
+    meshBoxTree->testSegment(testPosition, testEnd, &context->candidates);
+
+    for (const auto& candidate : context->candidates) {
+        const auto& triangle = (*targetMesh->triangles())[candidate];
+        const Vector3 trianglePositions[3] = {
             (*targetMesh->vertices())[triangle[0]],
             (*targetMesh->vertices())[triangle[1]],
             (*targetMesh->vertices())[triangle[2]]
@@ -76,21 +77,23 @@ bool SolidMeshBooleanOperation::isPointInMesh(const Vector3& testPosition,
         Vector3 intersection;
         if (Vector3::intersectSegmentAndPlane(testPosition, testEnd,
                 trianglePositions[0],
-                (*targetMesh->triangleNormals())[it.first],
+                (*targetMesh->triangleNormals())[candidate],
                 &intersection)) {
-            std::vector<Vector3> normals;
+            Vector3 normals[3];
             for (size_t i = 0; i < 3; ++i) {
                 size_t j = (i + 1) % 3;
-                normals.push_back(Vector3::normal(intersection, trianglePositions[i], trianglePositions[j]));
+                normals[i] = Vector3::normal(intersection, trianglePositions[i], trianglePositions[j]);
             }
             if (Vector3::dotProduct(normals[0], normals[1]) > 0 && Vector3::dotProduct(normals[0], normals[2]) > 0) {
-                hits.insert(PositionKey(intersection));
+                context->hits.push_back(PositionKey(intersection));
             }
         }
     }
-    inside = 0 != hits.size() % 2;
 
-    return inside;
+    // Hits on shared edges are reported by every triangle around the edge, count them once
+    std::sort(context->hits.begin(), context->hits.end());
+    size_t hitCount = std::unique(context->hits.begin(), context->hits.end()) - context->hits.begin();
+    return 0 != hitCount % 2;
 }
 
 void SolidMeshBooleanOperation::searchPotentialIntersectedPairs()
@@ -98,11 +101,20 @@ void SolidMeshBooleanOperation::searchPotentialIntersectedPairs()
     const AxisAlignedBoudingBoxTree* leftTree = m_firstMesh->axisAlignedBoundingBoxTree();
     const AxisAlignedBoudingBoxTree* rightTree = m_secondMesh->axisAlignedBoundingBoxTree();
 
-    leftTree->test(leftTree->root(), rightTree->root(), m_secondMesh->triangleAxisAlignedBoundingBoxes(),
-        &m_potentialIntersectedPairs);
+    leftTree->test(*rightTree, &m_potentialIntersectedPairs, m_threadPool);
+}
+
+void SolidMeshBooleanOperation::parallelFor(size_t count, const std::function<void(size_t)>& function)
+{
+    if (nullptr == m_threadPool) {
+        for (size_t i = 0; i < count; ++i)
+            function(i);
+        return;
+    }
+    m_threadPool->parallelFor(count, function);
 }
 
-bool SolidMeshBooleanOperation::intersectTwoFaces(size_t firstIndex, size_t secondIndex, std::pair<Vector3, Vector3>& newEdge)
+bool SolidMeshBooleanOperation::intersectTwoFaces(size_t firstIndex, size_t secondIndex, std::pair<Vector3, Vector3>& newEdge) const
 {
     const auto& firstFace = (*m_firstMesh->triangles())[firstIndex];
     const auto& secondFace = (*m_secondMesh->triangles())[secondIndex];
@@ -250,6 +262,7 @@ size_t SolidMeshBooleanOperation::addNewPoint(const Vector3& position)
 }
 
 bool SolidMeshBooleanOperation::addUnintersectedTriangles(const SolidMesh* mesh,
+    size_t sourceTriangleOffset,
     const std::set<size_t>& usedFaces,
     std::map<std::uint64_t, size_t>* halfEdges)
 {
@@ -260,6 +273,7 @@ bool SolidMeshBooleanOperation::addUnintersectedTriangles(const SolidMesh* mesh,
         vertices.begin(), vertices.end());
     size_t triangleCount = mesh->triangles()->size();
     m_newTriangles.reserve(m_newTriangles.size() + triangleCount - usedFaces.size());
+    m_newTriangleSources.reserve(m_newTriangleSources.size() + triangleCount - usedFaces.size());
     for (size_t i = 0; i < triangleCount; ++i) {
         if (usedFaces.find(i) != usedFaces.end())
             continue;
@@ -268,6 +282,7 @@ bool SolidMeshBooleanOperation::addUnintersectedTriangles(const SolidMesh* mesh,
         m_newTriangles.push_back({ oldTriangle[0] + oldVertexCount,
             oldTriangle[1] + oldVertexCount,
             oldTriangle[2] + oldVertexCount });
+        m_newTriangleSources.push_back(sourceTriangleOffset + i);
         const auto& newInsertedTriangle = m_newTriangles.back();
         if (!halfEdges->insert({ makeHalfEdgeKey(newInsertedTriangle[0], newInsertedTriangle[1]), newInsertedIndex }).second) {
             dust3dDebug << "Found repeated halfedge:" << newInsertedTriangle[0] << "," << newInsertedTriangle[1];
@@ -291,7 +306,7 @@ bool SolidMeshBooleanOperation::combine()
 
     struct IntersectedContext {
         std::vector<Vector3> points;
-        std::map<PositionKey, size_t> positionMap;
+        FlatHashMap<PositionKey, size_t> positionMap;
         std::map<size_t, std::set<size_t>> neighborMap;
     };
 
@@ -305,9 +320,23 @@ bool SolidMeshBooleanOperation::combine()
         return insertResult.first->second;
     };
 
-    for (const auto& pair : m_potentialIntersectedPairs) {
-        std::pair<Vector3, Vector3> newEdge;
-        if (intersectTwoFaces(pair.first, pair.second, newEdge)) {
+    // Intersect the candidate pairs in parallel, then bucket the segments by triangle in pair order,
+    // so the contexts come out the same as with a serial loop
+    std::vector<std::pair<Vector3, Vector3>> pairEdges(m_potentialIntersectedPairs.size());
+    std::vector<char> pairIntersected(m_potentialIntersectedPairs.size(), 0);
+    size_t pairBlockCount = (m_potentialIntersectedPairs.size() + g_intersectionBlockSize - 1) / g_intersectionBlockSize;
+    parallelFor(pairBlockCount, [&](size_t block) {
+        size_t end = std::min((block + 1) * g_intersectionBlockSize, m_potentialIntersectedPairs.size());
+        for (size_t i = block * g_intersectionBlockSize; i < end; ++i) {
+            const auto& pair = m_potentialIntersectedPairs[i];
+            pairIntersected[i] = intersectTwoFaces(pair.first, pair.second, pairEdges[i]) ? 1 : 0;
+        }
+    });
+
+    for (size_t pairIndex = 0; pairIndex < m_potentialIntersectedPairs.size(); ++pairIndex) {
+        const auto& pair = m_potentialIntersectedPairs[pairIndex];
+        const auto& newEdge = pairEdges[pairIndex];
+        if (pairIntersected[pairIndex]) {
             m_firstIntersectedFaces.insert(pair.first);
             m_secondIntersectedFaces.insert(pair.second);
 
@@ -345,7 +374,16 @@ bool SolidMeshBooleanOperation::combine()
                              size_t startOldVertex,
                              std::map<size_t, std::set<size_t>>& edges,
                              std::map<std::uint64_t, size_t>& halfEdges) {
-        for (const auto& [contextKey, it] : context) {
+        // Every intersected triangle is retriangulated on its own, only the stitching below
+        // touches the shared vertices and triangles, and it runs in triangle order
+        std::vector<const std::pair<const size_t, IntersectedContext>*> contextList;
+        contextList.reserve(context.size());
+        for (const auto& it : context)
+            contextList.push_back(&it);
+        std::vector<std::vector<std::vector<size_t>>> reTriangulatedTriangles(contextList.size());
+        std::vector<char> reTriangulated(contextList.size(), 0);
+        parallelFor(contextList.size(), [&](size_t i) {
+            const auto& [contextKey, it] = *contextList[i];
             const auto& triangle = (*mesh->triangles())[contextKey];
             ReTriangulator reTriangulator({ (*mesh->vertices())[triangle[0]],
                                               (*mesh->vertices())[triangle[1]],
@@ -353,7 +391,16 @@ bool SolidMeshBooleanOperation::combine()
                 (*mesh->triangleNormals())[contextKey]);
             reTriangulator.setEdges(it.points,
                 &it.neighborMap);
-            if (!reTriangulator.reTriangulate()) {
+            if (!reTriangulator.reTriangulate())
+                return;
+            reTriangulatedTriangles[i] = reTriangulator.triangles();
+            reTriangulated[i] = 1;
+        });
+
+        for (size_t contextIndex = 0; contextIndex < contextList.size(); ++contextIndex) {
+            const auto& [contextKey, it] = *contextList[contextIndex];
+            const auto& triangle = (*mesh->triangles())[contextKey];
+            if (!reTriangulated[contextIndex]) {
                 dust3dDebug << "Retriangle failed";
                 return false;
             }
@@ -364,11 +411,12 @@ bool SolidMeshBooleanOperation::combine()
             newIndices.push_back(startOldVertex + triangle[2]);
             for (const auto& point : it.points)
                 newIndices.push_back(addNewPoint(point));
-            for (const auto& triangle : reTriangulator.triangles()) {
+            for (const auto& triangle : reTriangulatedTriangles[contextIndex]) {
                 size_t newInsertedIndex = m_newTriangles.size();
                 m_newTriangles.push_back({ newIndices[triangle[0]],
                     newIndices[triangle[1]],
                     newIndices[triangle[2]] });
+                m_newTriangleSources.push_back(InvalidIndex);
                 const auto& newInsertedTriangle = m_newTriangles.back();
                 if (!halfEdges.insert({ makeHalfEdgeKey(newInsertedTriangle[0], newInsertedTriangle[1]), newInsertedIndex }).second) {
                     dust3dDebug << "Found repeated halfedge:" << newInsertedTriangle[0] << "," << newInsertedTriangle[1];
@@ -393,13 +441,13 @@ bool SolidMeshBooleanOperation::combine()
     };
 
     size_t firstRemainingStartTriangleIndex = m_newTriangles.size();
-    if (!addUnintersectedTriangles(m_firstMesh, m_firstIntersectedFaces, &firstHalfEdges)) {
+    if (!addUnintersectedTriangles(m_firstMesh, 0, m_firstIntersectedFaces, &firstHalfEdges)) {
         dust3dDebug << "Add first mesh remaining triangles failed";
     }
     size_t firstRemainingTriangleCount = m_newTriangles.size() - firstRemainingStartTriangleIndex;
 
     size_t secondRemainingStartTriangleIndex = m_newTriangles.size();
-    if (!addUnintersectedTriangles(m_secondMesh, m_secondIntersectedFaces, &secondHalfEdges)) {
+    if (!addUnintersectedTriangles(m_secondMesh, m_firstMesh->triangles()->size(), m_secondIntersectedFaces, &secondHalfEdges)) {
         dust3dDebug << "Add second mesh remaining triangles failed";
     }
     size_t secondRemainingTriangleCount = m_newTriangles.size() - secondRemainingStartTriangleIndex;
@@ -450,11 +498,14 @@ void SolidMeshBooleanOperation::decideGroupSide(const std::vector<std::vector<si
     const AxisAlignedBoudingBoxTree* tree,
     std::vector<bool>& groupSides)
 {
-    groupSides.resize(groups.size());
-    for (size_t i = 0; i < groups.size(); ++i) {
+    // Groups are classified independently, collect into bytes first because std::vector<bool>
+    // can not be written from several threads
+    std::vector<char> sides(groups.size(), 0);
+    parallelFor(groups.size(), [&](size_t i) {
         const auto& group = groups[i];
         if (group.empty())
-            continue;
+            return;
+        PointInMeshContext context;
         size_t insideCount = 0;
         size_t totalCount = 0;
         for (size_t pickIndex = 0; pickIndex < 1 && pickIndex < group.size(); ++pickIndex) {
@@ -463,40 +514,53 @@ void SolidMeshBooleanOperation::decideGroupSide(const std::vector<std::vector<si
                 bool inside = isPointInMesh((m_newVertices[pickedTriangle[0]] + m_newVertices[pickedTriangle[1]] + m_newVertices[pickedTriangle[2]]) / 3.0,
                     mesh,
                     tree,
-                    g_testAxisList[axisIndex]);
+                    g_testAxisList[axisIndex],
+                    &context);
                 if (inside)
                     ++insideCount;
                 ++totalCount;
             }
         }
-        groupSides[i] = (float)insideCount / totalCount > 0.5;
-    }
+        sides[i] = (float)insideCount / totalCount > 0.5 ? 1 : 0;
+    });
+    groupSides.resize(groups.size());
+    for (size_t i = 0; i < groups.size(); ++i)
+        groupSides[i] = 0 != sides[i];
 }
 
-void SolidMeshBooleanOperation::fetchUnion(std::vector<std::vector<size_t>>& resultTriangles)
+void SolidMeshBooleanOperation::fetchUnion(std::vector<std::vector<size_t>>& resultTriangles, std::vector<size_t>* resultTriangleSources)
 {
     for (size_t i = 0; i < m_firstGroupSides.size(); ++i) {
         if (m_firstGroupSides[i])
             continue;
-        for (const auto& it : m_firstTriangleGroups[i])
+        for (const auto& it : m_firstTriangleGroups[i]) {
             resultTriangles.push_back(m_newTriangles[it]);
+            if (nullptr != resultTriangleSources)
+                resultTriangleSources->push_back(m_newTriangleSources[it]);
+        }
     }
 
     for (size_t i = 0; i < m_secondGroupSides.size(); ++i) {
         if (m_secondGroupSides[i])
             continue;
-        for (const auto& it : m_secondTriangleGroups[i])
+        for (const auto& it : m_secondTriangleGroups[i]) {
             resultTriangles.push_back(m_newTriangles[it]);
+            if (nullptr != resultTriangleSources)
+                resultTriangleSources->push_back(m_newTriangleSources[it]);
+        }
     }
 }
 
-void SolidMeshBooleanOperation::fetchDiff(std::vector<std::vector<size_t>>& resultTriangles)
+void SolidMeshBooleanOperation::fetchDiff(std::vector<std::vector<size_t>>& resultTriangles, std::vector<size_t>* resultTriangleSources)
 {
     for (size_t i = 0; i < m_firstGroupSides.size(); ++i) {
         if (m_firstGroupSides[i])
             continue;
-        for (const auto& it : m_firstTriangleGroups[i])
+        for (const auto& it : m_firstTriangleGroups[i]) {
             resultTriangles.push_back(m_newTriangles[it]);
+            if (nullptr != resultTriangleSources)
+                resultTriangleSources->push_back(m_newTriangleSources[it]);
+        }
     }
 
     for (size_t i = 0; i < m_secondGroupSides.size(); ++i) {
@@ -505,24 +569,32 @@ void SolidMeshBooleanOperation::fetchDiff(std::vector<std::vector<size_t>>& resu
         for (const auto& it : m_secondTriangleGroups[i]) {
             auto triangle = m_newTriangles[it];
             resultTriangles.push_back({ triangle[2], triangle[1], triangle[0] });
+            if (nullptr != resultTriangleSources)
+                resultTriangleSources->push_back(InvalidIndex);
         }
     }
 }
 
-void SolidMeshBooleanOperation::fetchIntersect(std::vector<std::vector<size_t>>& resultTriangles)
+void SolidMeshBooleanOperation::fetchIntersect(std::vector<std::vector<size_t>>& resultTriangles, std::vector<size_t>* resultTriangleSources)
 {
     for (size_t i = 0; i < m_firstGroupSides.size(); ++i) {
         if (!m_firstGroupSides[i])
             continue;
-        for (const auto& it : m_firstTriangleGroups[i])
+        for (const auto& it : m_firstTriangleGroups[i]) {
             resultTriangles.push_back(m_newTriangles[it]);
+            if (nullptr != resultTriangleSources)
+                resultTriangleSources->push_back(m_newTriangleSources[it]);
+        }
     }
 
     for (size_t i = 0; i < m_secondGroupSides.size(); ++i) {
         if (!m_secondGroupSides[i])
             continue;
-        for (const auto& it : m_secondTriangleGroups[i])
+        for (const auto& it : m_secondTriangleGroups[i]) {
             resultTriangles.push_back(m_newTriangles[it]);
+            if (nullptr != resultTriangleSources)
+                resultTriangleSources->push_back(m_newTriangleSources[it]);
+        }
     }
 }
 
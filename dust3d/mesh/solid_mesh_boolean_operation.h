@@ -25,9 +25,13 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <dust3d/base/flat_hash_map.h>
 #include <dust3d/base/position_key.h>
+#include <dust3d/base/thread_pool.h>
 #include <dust3d/base/vector3.h>
 #include <dust3d/mesh/solid_mesh.h>
+#include <functional>
+#include <limits>
 #include <map>
 #include <set>
 
@@ -35,23 +39,30 @@ namespace dust3d {
 
 class SolidMeshBooleanOperation {
 public:
+    static constexpr size_t InvalidIndex = std::numeric_limits<size_t>::max();
+
     SolidMeshBooleanOperation(const SolidMesh* firstMesh,
         const SolidMesh* secondMesh);
     ~SolidMeshBooleanOperation();
+    void setThreadPool(ThreadPool* threadPool);
     bool combine();
-    void fetchUnion(std::vector<std::vector<size_t>>& resultTriangles);
-    void fetchDiff(std::vector<std::vector<size_t>>& resultTriangles);
-    void fetchIntersect(std::vector<std::vector<size_t>>& resultTriangles);
+    // A triangle kept as it was reports its index in the first mesh's triangles followed by the second's
+    // through resultTriangleSources, the retriangulated and flipped ones report InvalidIndex
+    void fetchUnion(std::vector<std::vector<size_t>>& resultTriangles, std::vector<size_t>* resultTriangleSources = nullptr);
+    void fetchDiff(std::vector<std::vector<size_t>>& resultTriangles, std::vector<size_t>* resultTriangleSources = nullptr);
+    void fetchIntersect(std::vector<std::vector<size_t>>& resultTriangles, std::vector<size_t>* resultTriangleSources = nullptr);
 
     const std::vector<Vector3>& resultVertices();
 
 private:
     const SolidMesh* m_firstMesh = nullptr;
     const SolidMesh* m_secondMesh = nullptr;
+    ThreadPool* m_threadPool = nullptr;
     std::vector<std::pair<size_t, size_t>> m_potentialIntersectedPairs;
     std::vector<Vector3> m_newVertices;
     std::vector<std::vector<size_t>> m_newTriangles;
-    std::map<PositionKey, size_t> m_newPositionMap;
+    std::vector<size_t> m_newTriangleSources;
+    FlatHashMap<PositionKey, size_t> m_newPositionMap;
     std::vector<std::vector<size_t>> m_firstTriangleGroups;
     std::vector<std::vector<size_t>> m_secondTriangleGroups;
     std::vector<bool> m_firstGroupSides;
@@ -61,6 +72,11 @@ private:
     std::map<size_t, std::vector<size_t>> m_firstFacesAroundVertexMap;
     std::map<size_t, std::vector<size_t>> m_secondFacesAroundVertexMap;
 
+    struct PointInMeshContext {
+        std::vector<size_t> candidates;
+        std::vector<PositionKey> hits;
+    };
+
     static inline std::uint64_t makeHalfEdgeKey(size_t first, size_t second)
     {
         return ((std::uint64_t)first << 32) | second;
@@ -73,13 +89,15 @@ private:
     }
 
     void searchPotentialIntersectedPairs();
-    bool intersectTwoFaces(size_t firstIndex, size_t secondIndex, std::pair<Vector3, Vector3>& newEdge);
+    void parallelFor(size_t count, const std::function<void(size_t)>& function);
+    bool intersectTwoFaces(size_t firstIndex, size_t secondIndex, std::pair<Vector3, Vector3>& newEdge) const;
     bool buildPolygonsFromEdges(const std::map<size_t, std::set<size_t>>& edges,
         std::vector<std::vector<size_t>>& polygons);
     bool isPointInMesh(const Vector3& testPosition,
         const SolidMesh* targetMesh,
         const AxisAlignedBoudingBoxTree* meshBoxTree,
-        const Vector3& testAxis);
+        const Vector3& testAxis,
+        PointInMeshContext* context) const;
     void buildFaceGroups(const std::vector<std::vector<size_t>>& intersections,
         const std::map<std::uint64_t, size_t>& halfEdges,
         const std::vector<std::vector<size_t>>& triangles,
@@ -88,6 +106,7 @@ private:
         std::vector<std::vector<size_t>>& triangleGroups);
     size_t addNewPoint(const Vector3& position);
     bool addUnintersectedTriangles(const SolidMesh* mesh,
+        size_t sourceTriangleOffset,
         const std::set<size_t>& usedFaces,
         std::map<std::uint64_t, size_t>* halfEdges);
     void decideGroupSide(const std::vector<std::vector<size_t>>& groups,
@@ -1181,28 +1181,9 @@ void StitchLoopMeshBuilder::debugVisualizeCellColors()
     dust3dDebug << "debugVisualizeCellColors: wrote /tmp/stitch_loop_debug.svg";
 }
 
-std::map<Uuid, std::map<std::array<PositionKey, 3>, std::array<Vector2, 3>>> StitchLoopMeshBuilder::buildPerLoopTriangleUvs() const
+std::vector<Uuid> StitchLoopMeshBuilder::buildPerLoopFaceSourceIds() const
 {
-    std::map<Uuid, std::map<std::array<PositionKey, 3>, std::array<Vector2, 3>>> result;
-
-    auto insertTriangleUv = [&](std::map<std::array<PositionKey, 3>, std::array<Vector2, 3>>& uvMap,
-                                const std::vector<size_t>& face, const std::vector<Vector2>& uv) {
-        if (3 == face.size()) {
-            uvMap.insert({ { PositionKey(m_generatedVertices[face[0]]),
-                               PositionKey(m_generatedVertices[face[1]]),
-                               PositionKey(m_generatedVertices[face[2]]) },
-                { uv[0], uv[1], uv[2] } });
-        } else if (4 == face.size()) {
-            uvMap.insert({ { PositionKey(m_generatedVertices[face[0]]),
-                               PositionKey(m_generatedVertices[face[1]]),
-                               PositionKey(m_generatedVertices[face[2]]) },
-                { uv[0], uv[1], uv[2] } });
-            uvMap.insert({ { PositionKey(m_generatedVertices[face[2]]),
-                               PositionKey(m_generatedVertices[face[3]]),
-                               PositionKey(m_generatedVertices[face[0]]) },
-                { uv[2], uv[3], uv[0] } });
-        }
-    };
+    std::vector<Uuid> result(m_generatedFaceUvs.size());
 
     // Build a set of sourceIds that belong to open (non-closed) loops so that
     // Pass 2 can prefer them over closed loops when both are candidates.
@@ -1245,8 +1226,7 @@ std::map<Uuid, std::map<std::array<PositionKey, 3>, std::array<Vector2, 3>>> Sti
                 bestVotes = votes;
             }
         }
-        if (!assignedId.isNull())
-            insertTriangleUv(result[assignedId], face, m_generatedFaceUvs[i]);
+        result[i] = assignedId;
     }
 
     return result;
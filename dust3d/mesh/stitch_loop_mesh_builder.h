@@ -67,7 +67,8 @@ public:
     const std::vector<std::vector<size_t>>& generatedFaces() const;
     const std::vector<std::vector<Vector2>>& generatedFaceUvs() const;
     const std::vector<Loop>& loops() const;
-    std::map<Uuid, std::map<std::array<PositionKey, 3>, std::array<Vector2, 3>>> buildPerLoopTriangleUvs() const;
+    // Loop source id of the sub-chart each face belongs to, null for faces without one
+    std::vector<Uuid> buildPerLoopFaceSourceIds() const;
 
 private:
     struct CellColor {
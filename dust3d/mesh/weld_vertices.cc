@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2016-2026 Jeremy HU <jeremy-at-dust3d dot org>. All rights reserved. 
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <dust3d/mesh/weld_vertices.h>
+#include <string_view>
+#include <unordered_map>
+
+namespace dust3d {
+
+void weldVertices(const void* cornerRecords, size_t cornerCount, size_t recordSize,
+    std::vector<std::uint32_t>* indices,
+    std::vector<std::uint32_t>* vertexCorners)
+{
+    const char* records = (const char*)cornerRecords;
+    std::unordered_map<std::string_view, std::uint32_t> recordToVertexMap;
+    recordToVertexMap.reserve(cornerCount);
+    indices->resize(cornerCount);
+    vertexCorners->clear();
+    for (size_t corner = 0; corner < cornerCount; ++corner) {
+        auto insertResult = recordToVertexMap.insert({ std::string_view(records + corner * recordSize, recordSize),
+            (std::uint32_t)vertexCorners->size() });
+        if (insertResult.second)
+            vertexCorners->push_back((std::uint32_t)corner);
+        (*indices)[corner] = insertResult.first->second;
+    }
+}
+
+}
@@ -23,58 +23,42 @@
 #include <algorithm>
 #include <cmath>
 #include <dust3d/base/debug.h>
+#include <dust3d/base/flat_hash_map.h>
 #include <dust3d/base/matrix4x4.h>
 #include <dust3d/base/part_target.h>
 #include <dust3d/base/position_key.h>
 #include <dust3d/base/quaternion.h>
-#include <dust3d/base/string.h>
 #include <dust3d/base/vector3.h>
 #include <dust3d/rig/rig_generator.h>
 #include <limits>
 
 namespace dust3d {
 
-static bool targetPartIsModel(const Snapshot* snapshot, const std::string& partIdString)
+static bool targetPartIsModel(const SnapshotView* snapshot, size_t partIndex)
 {
-    if (!snapshot || partIdString.empty())
+    if (!snapshot || SnapshotView::InvalidIndex == partIndex)
         return false;
 
-    auto partIt = snapshot->parts.find(partIdString);
-    if (partIt == snapshot->parts.end())
-        return false;
-
-    auto target = PartTargetFromString(String::valueOrEmpty(partIt->second, "target").c_str());
+    auto target = snapshot->parts()[partIndex].target;
 
     return PartTarget::Model == target || PartTarget::StitchingLine == target || PartTarget::StitchingLoop == target || PartTarget::ImportedModel == target;
 }
 
-static bool nodeBelongsToModelPart(const Snapshot* snapshot, const Uuid& nodeId)
+static bool nodeBelongsToModelPart(const SnapshotView* snapshot, size_t nodeIndex)
 {
-    if (!snapshot)
+    if (!snapshot || SnapshotView::InvalidIndex == nodeIndex)
         return false;
 
-    auto it = snapshot->nodes.find(nodeId.toString());
-    if (it == snapshot->nodes.end())
-        return false;
-
-    return targetPartIsModel(snapshot, String::valueOrEmpty(it->second, "partId"));
+    return targetPartIsModel(snapshot, snapshot->nodes()[nodeIndex].partIndex);
 }
 
-static bool edgeBelongsToModelPart(const Snapshot* snapshot,
-    const std::map<std::string, std::string>& edgeAttributes)
+static bool edgeBelongsToModelPart(const SnapshotView* snapshot, const SnapshotView::Edge& edge)
 {
     if (!snapshot)
         return false;
 
-    std::string fromNode = String::valueOrEmpty(edgeAttributes, "from");
-    std::string toNode = String::valueOrEmpty(edgeAttributes, "to");
-    if (fromNode.empty() || toNode.empty())
-        return false;
-
-    Uuid fromId(fromNode);
-    Uuid toId(toNode);
-    return nodeBelongsToModelPart(snapshot, fromId)
-        && nodeBelongsToModelPart(snapshot, toId);
+    return nodeBelongsToModelPart(snapshot, edge.fromNodeIndex)
+        && nodeBelongsToModelPart(snapshot, edge.toNodeIndex);
 }
 
 static bool boneUsesParentEndAsReference(const std::string& boneName)
@@ -91,7 +75,7 @@ RigGenerator::~RigGenerator()
 {
 }
 
-bool RigGenerator::generateRig(const Snapshot* snapshot, const RigStructure& templateRig, RigStructure& actualRig)
+bool RigGenerator::generateRig(const SnapshotView* snapshot, const RigStructure& templateRig, RigStructure& actualRig)
 {
     if (!snapshot) {
         m_errorMessage = "Snapshot not initialized";
@@ -101,9 +85,9 @@ bool RigGenerator::generateRig(const Snapshot* snapshot, const RigStructure& tem
     actualRig = templateRig; // Copy template structure
 
     // Extract coordinate transformation offsets from snapshot's canvas
-    m_mainProfileMiddleX = String::toFloat(String::valueOrEmpty(snapshot->canvas, "originX"));
-    m_mainProfileMiddleY = String::toFloat(String::valueOrEmpty(snapshot->canvas, "originY"));
-    m_sideProfileMiddleX = String::toFloat(String::valueOrEmpty(snapshot->canvas, "originZ"));
+    m_mainProfileMiddleX = snapshot->originX();
+    m_mainProfileMiddleY = snapshot->originY();
+    m_sideProfileMiddleX = snapshot->originZ();
 
     // Clear template positions - they are only for template visualization
     for (auto& bone : actualRig.bones) {
@@ -128,29 +112,19 @@ bool RigGenerator::generateRig(const Snapshot* snapshot, const RigStructure& tem
     std::set<Uuid> allEdgeNodes;
     std::map<std::string, std::set<Uuid>> boneEdgeNodesMap;
     std::set<Uuid> nodesWithAnyEdge;
-    for (const auto& edgePair : snapshot->edges) {
-        const auto& edgeAttributes = edgePair.second;
-        if (!edgeBelongsToModelPart(snapshot, edgeAttributes))
+    for (const auto& edge : snapshot->edges()) {
+        if (!edgeBelongsToModelPart(snapshot, edge))
             continue;
-        std::string fromNode = String::valueOrEmpty(edgeAttributes, "from");
-        std::string toNode = String::valueOrEmpty(edgeAttributes, "to");
-        if (!fromNode.empty())
-            nodesWithAnyEdge.insert(Uuid(fromNode));
-        if (!toNode.empty())
-            nodesWithAnyEdge.insert(Uuid(toNode));
-        std::string edgeBoneName = String::valueOrEmpty(edgeAttributes, "boneName");
-        if (edgeBoneName.empty())
+        const Uuid& fromId = snapshot->nodes()[edge.fromNodeIndex].id;
+        const Uuid& toId = snapshot->nodes()[edge.toNodeIndex].id;
+        nodesWithAnyEdge.insert(fromId);
+        nodesWithAnyEdge.insert(toId);
+        if (edge.boneName.empty())
             continue;
-        if (!fromNode.empty()) {
-            Uuid id(fromNode);
-            allEdgeNodes.insert(id);
-            boneEdgeNodesMap[edgeBoneName].insert(id);
-        }
-        if (!toNode.empty()) {
-            Uuid id(toNode);
-            allEdgeNodes.insert(id);
-            boneEdgeNodesMap[edgeBoneName].insert(id);
-        }
+        allEdgeNodes.insert(fromId);
+        boneEdgeNodesMap[edge.boneName].insert(fromId);
+        allEdgeNodes.insert(toId);
+        boneEdgeNodesMap[edge.boneName].insert(toId);
     }
 
     // Clear single node bone map before processing bones
@@ -839,9 +813,9 @@ bool RigGenerator::generateRig(const Snapshot* snapshot, const RigStructure& tem
                 for (const auto& nodeId : chain) {
                     float nx = 0, ny = 0, nz = 0;
                     if (getNodePosition(snapshot, nodeId, nx, ny, nz)) {
-                        auto it = snapshot->nodes.find(nodeId.toString());
-                        if (it != snapshot->nodes.end()) {
-                            float nodeRadius = String::toFloat(String::valueOrEmpty(it->second, "radius"));
+                        size_t nodeIndex = snapshot->findNode(nodeId);
+                        if (SnapshotView::InvalidIndex != nodeIndex) {
+                            float nodeRadius = snapshot->nodes()[nodeIndex].radius;
                             if (nodeRadius > 1e-6f) {
                                 radiusSum += nodeRadius;
                                 ++radiusCount;
@@ -961,7 +935,7 @@ bool RigGenerator::computeBoneInverseBindMatrices(const RigStructure& rigStructu
 
 float RigGenerator::computeTwoBoneLerp(const RigStructure& rigStructure,
     const std::string& bone1, const std::string& bone2,
-    const Snapshot* snapshot, const Uuid& nodeId)
+    const SnapshotView* snapshot, const Uuid& nodeId)
 {
     // Build parent lookup
     std::map<std::string, std::string> parentOf;
@@ -1057,7 +1031,7 @@ float RigGenerator::computeTwoBoneLerp(const RigStructure& rigStructure,
     return (childLerp > 0.5f) ? jointBias : (1.0f - jointBias);
 }
 
-bool RigGenerator::computeNodeBoneInfluences(const Snapshot* snapshot,
+bool RigGenerator::computeNodeBoneInfluences(const SnapshotView* snapshot,
     const RigStructure& rigStructure,
     std::map<Uuid, NodeBoneInfluence>& nodeBoneInfluences)
 {
@@ -1068,33 +1042,28 @@ bool RigGenerator::computeNodeBoneInfluences(const Snapshot* snapshot,
 
     nodeBoneInfluences.clear();
 
-    // Pre-build a map from node -> set of bone names from connected edges (single pass over edges)
-    std::map<std::string, std::set<std::string>> nodeToBoneNames;
-    for (const auto& edgePair : snapshot->edges) {
-        const auto& edgeAttributes = edgePair.second;
-        if (!edgeBelongsToModelPart(snapshot, edgeAttributes))
+    // Pre-build a table from node index -> set of bone names from connected edges (single pass over edges)
+    const auto& nodes = snapshot->nodes();
+    std::vector<std::set<std::string>> nodeToBoneNames(nodes.size());
+    for (const auto& edge : snapshot->edges()) {
+        if (!edgeBelongsToModelPart(snapshot, edge))
             continue;
-        std::string boneName = String::valueOrEmpty(edgeAttributes, "boneName");
-        if (boneName.empty())
+        if (edge.boneName.empty())
             continue;
-        std::string fromNode = String::valueOrEmpty(edgeAttributes, "from");
-        std::string toNode = String::valueOrEmpty(edgeAttributes, "to");
-        if (!fromNode.empty())
-            nodeToBoneNames[fromNode].insert(boneName);
-        if (!toNode.empty())
-            nodeToBoneNames[toNode].insert(boneName);
+        nodeToBoneNames[edge.fromNodeIndex].insert(edge.boneName);
+        nodeToBoneNames[edge.toNodeIndex].insert(edge.boneName);
     }
 
     // For each node in the snapshot, determine which bones influence it
-    for (const auto& nodePair : snapshot->nodes) {
-        const std::string& nodeIdString = nodePair.first;
-        Uuid nodeId(nodeIdString);
+    for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex) {
+        const std::string& nodeIdString = nodes[nodeIndex].idString;
+        const Uuid& nodeId = nodes[nodeIndex].id;
 
-        if (!nodeBelongsToModelPart(snapshot, nodeId))
+        if (!nodeBelongsToModelPart(snapshot, nodeIndex))
             continue;
 
-        const auto& boneNamesIt = nodeToBoneNames.find(nodeIdString);
-        if (boneNamesIt == nodeToBoneNames.end() || boneNamesIt->second.empty()) {
+        const std::set<std::string>& boneNames = nodeToBoneNames[nodeIndex];
+        if (boneNames.empty()) {
             // No bone-assigned edges for this node.
             // Use m_singleNodeBoneMap (populated by attachSingleNodesToBone) for truly isolated nodes.
             auto singleIt = m_singleNodeBoneMap.find(nodeId);
@@ -1107,8 +1076,6 @@ bool RigGenerator::computeNodeBoneInfluences(const Snapshot* snapshot,
             continue;
         }
 
-        const std::set<std::string>& boneNames = boneNamesIt->second;
-
         if (boneNames.size() == 1) {
             // Single bone influence
             std::string boneName = *boneNames.begin();
@@ -1195,17 +1162,18 @@ bool RigGenerator::computeVertexBoneBindings(Object* object,
     return true;
 }
 
-void RigGenerator::attachSingleNodesToBone(const Snapshot* snapshot,
+void RigGenerator::attachSingleNodesToBone(const SnapshotView* snapshot,
     const std::string& boneName,
     const std::set<Uuid>& boneEdgeNodes,
     const std::set<Uuid>& allEdgeNodes,
     const std::set<Uuid>& nodesWithAnyEdge,
     std::vector<std::vector<Uuid>>& nodeChains)
 {
-    for (const auto& nodePair : snapshot->nodes) {
-        Uuid nodeId(nodePair.first);
+    const auto& nodes = snapshot->nodes();
+    for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex) {
+        const Uuid& nodeId = nodes[nodeIndex].id;
 
-        if (!nodeBelongsToModelPart(snapshot, nodeId))
+        if (!nodeBelongsToModelPart(snapshot, nodeIndex))
             continue;
 
         // Only attach nodes that have NO edges at all (truly isolated).
@@ -1262,7 +1230,7 @@ void RigGenerator::attachSingleNodesToBone(const Snapshot* snapshot,
     }
 }
 
-bool RigGenerator::extractNodeChainsForBone(const Snapshot* snapshot,
+bool RigGenerator::extractNodeChainsForBone(const SnapshotView* snapshot,
     const std::string& boneName,
     std::vector<std::vector<Uuid>>& nodeChains)
 {
@@ -1338,7 +1306,7 @@ bool RigGenerator::extractNodeChainsForBone(const Snapshot* snapshot,
     return !nodeChains.empty();
 }
 
-void RigGenerator::orientChainTowardPoint(const Snapshot* snapshot,
+void RigGenerator::orientChainTowardPoint(const SnapshotView* snapshot,
     std::vector<Uuid>& chain,
     float refX, float refY, float refZ)
 {
@@ -1365,27 +1333,21 @@ void RigGenerator::orientChainTowardPoint(const Snapshot* snapshot,
     }
 }
 
-bool RigGenerator::getNodePositionInternal(const Snapshot* snapshot, const Uuid& nodeId,
-    float& x, float& y, float& z, std::set<std::string>& visited)
+bool RigGenerator::getNodePositionInternal(const SnapshotView* snapshot, size_t nodeIndex,
+    float& x, float& y, float& z, std::set<size_t>& visited)
 {
-    if (!snapshot)
+    if (!snapshot || SnapshotView::InvalidIndex == nodeIndex)
         return false;
 
-    std::string nodeIdString = nodeId.toString();
-    if (visited.count(nodeIdString))
+    if (visited.count(nodeIndex))
         return false; // cycle detected
 
-    visited.insert(nodeIdString);
+    visited.insert(nodeIndex);
 
-    auto it = snapshot->nodes.find(nodeIdString);
-    if (it == snapshot->nodes.end())
-        return false;
-
-    std::string mirrorFromNodeId = String::valueOrEmpty(it->second, "__mirrorFromNodeId");
-    if (!mirrorFromNodeId.empty()) {
-        Uuid mirrorNode(mirrorFromNodeId);
+    const auto& node = snapshot->nodes()[nodeIndex];
+    if (node.isMirror) {
         float mx = 0, my = 0, mz = 0;
-        if (getNodePositionInternal(snapshot, mirrorNode, mx, my, mz, visited)) {
+        if (getNodePositionInternal(snapshot, node.mirrorFromNodeIndex, mx, my, mz, visited)) {
             x = -mx;
             y = my;
             z = mz;
@@ -1396,20 +1358,22 @@ bool RigGenerator::getNodePositionInternal(const Snapshot* snapshot, const Uuid&
     }
 
     // Apply same coordinate transformation as MeshGenerator uses
-    x = (String::toFloat(String::valueOrEmpty(it->second, "x")) - m_mainProfileMiddleX);
-    y = (m_mainProfileMiddleY - String::toFloat(String::valueOrEmpty(it->second, "y")));
-    z = (m_sideProfileMiddleX - String::toFloat(String::valueOrEmpty(it->second, "z")));
+    x = (node.x - m_mainProfileMiddleX);
+    y = (m_mainProfileMiddleY - node.y);
+    z = (m_sideProfileMiddleX - node.z);
     return true;
 }
 
-bool RigGenerator::getNodePosition(const Snapshot* snapshot, const Uuid& nodeId,
+bool RigGenerator::getNodePosition(const SnapshotView* snapshot, const Uuid& nodeId,
     float& x, float& y, float& z)
 {
-    std::set<std::string> visited;
-    return getNodePositionInternal(snapshot, nodeId, x, y, z, visited);
+    if (!snapshot)
+        return false;
+    std::set<size_t> visited;
+    return getNodePositionInternal(snapshot, snapshot->findNode(nodeId), x, y, z, visited);
 }
 
-void RigGenerator::buildNodeAdjacency(const Snapshot* snapshot,
+void RigGenerator::buildNodeAdjacency(const SnapshotView* snapshot,
     const std::string& boneName,
     std::map<Uuid, std::vector<Uuid>>& adjacency,
     std::set<Uuid>& allNodes)
@@ -1419,18 +1383,11 @@ void RigGenerator::buildNodeAdjacency(const Snapshot* snapshot,
 
     auto edgesForBone = getEdgesWithBoneName(snapshot, boneName);
 
-    for (const auto* edge : edgesForBone) {
-        if (!edge)
-            continue;
+    for (const auto& edgeIndex : edgesForBone) {
+        const auto& edge = snapshot->edges()[edgeIndex];
 
-        std::string fromNodeIdString = String::valueOrEmpty(*edge, "from");
-        std::string toNodeIdString = String::valueOrEmpty(*edge, "to");
-
-        if (fromNodeIdString.empty() || toNodeIdString.empty())
-            continue;
-
-        Uuid n1(fromNodeIdString);
-        Uuid n2(toNodeIdString);
+        const Uuid& n1 = snapshot->nodes()[edge.fromNodeIndex].id;
+        const Uuid& n2 = snapshot->nodes()[edge.toNodeIndex].id;
 
         adjacency[n1].push_back(n2);
         adjacency[n2].push_back(n1);
@@ -1440,36 +1397,33 @@ void RigGenerator::buildNodeAdjacency(const Snapshot* snapshot,
     }
 }
 
-std::vector<const std::map<std::string, std::string>*> RigGenerator::getEdgesWithBoneName(
-    const Snapshot* snapshot,
+std::vector<size_t> RigGenerator::getEdgesWithBoneName(
+    const SnapshotView* snapshot,
     const std::string& boneName)
 {
-    std::vector<const std::map<std::string, std::string>*> result;
+    std::vector<size_t> result;
 
-    for (const auto& edgePair : snapshot->edges) {
-        const auto& edgeAttributes = edgePair.second;
-        std::string edgeBoneName = String::valueOrEmpty(edgeAttributes, "boneName");
-        if (edgeBoneName == boneName && edgeBelongsToModelPart(snapshot, edgeAttributes)) {
-            result.push_back(&edgeAttributes);
+    const auto& edges = snapshot->edges();
+    for (size_t edgeIndex = 0; edgeIndex < edges.size(); ++edgeIndex) {
+        const auto& edge = edges[edgeIndex];
+        if (edge.boneName == boneName && edgeBelongsToModelPart(snapshot, edge)) {
+            result.push_back(edgeIndex);
         }
     }
 
     return result;
 }
 
-bool RigGenerator::nodeHasEdgeWithBoneName(const Snapshot* snapshot,
+bool RigGenerator::nodeHasEdgeWithBoneName(const SnapshotView* snapshot,
     const Uuid& nodeId,
     const std::string& boneName)
 {
-    std::string nodeIdString = nodeId.toString();
-
-    for (const auto& edgePair : snapshot->edges) {
-        const auto& edgeAttributes = edgePair.second;
-        std::string fromNode = String::valueOrEmpty(edgeAttributes, "from");
-        std::string toNode = String::valueOrEmpty(edgeAttributes, "to");
-        std::string edgeBoneName = String::valueOrEmpty(edgeAttributes, "boneName");
+    size_t nodeIndex = snapshot->findNode(nodeId);
+    if (SnapshotView::InvalidIndex == nodeIndex)
+        return false;
 
-        if ((fromNode == nodeIdString || toNode == nodeIdString) && edgeBoneName == boneName) {
+    for (const auto& edgeIndex : snapshot->nodes()[nodeIndex].edgeIndices) {
+        if (snapshot->edges()[edgeIndex].boneName == boneName) {
             return true;
         }
     }
@@ -1477,14 +1431,14 @@ bool RigGenerator::nodeHasEdgeWithBoneName(const Snapshot* snapshot,
     return false;
 }
 
-std::string RigGenerator::getEdgeBoneName(const std::map<std::string, std::string>* edge)
+std::string RigGenerator::getEdgeBoneName(const SnapshotView::Edge* edge)
 {
     if (!edge)
         return "";
-    return String::valueOrEmpty(*edge, "boneName");
+    return edge->boneName;
 }
 
-bool RigGenerator::generateEyelidBones(Object* object, const Snapshot* snapshot, RigStructure& actualRig)
+bool RigGenerator::generateEyelidBones(Object* object, const SnapshotView* snapshot, RigStructure& actualRig)
 {
     if (!object || !snapshot)
         return false;
@@ -1515,7 +1469,7 @@ bool RigGenerator::generateEyelidBones(Object* object, const Snapshot* snapshot,
     // We use PositionKey (quantized xyz) as vertex identity to merge duplicates.
 
     // Map position -> position key ID
-    std::map<PositionKey, size_t> posKeyToId;
+    FlatHashMap<PositionKey, size_t> posKeyToId;
     std::vector<Vector3> posKeyPositions; // id -> representative position
     auto getOrCreatePosId = [&](size_t vertexIdx) -> size_t {
         PositionKey pk(object->vertices[vertexIdx]);
@@ -1931,7 +1885,7 @@ bool RigGenerator::generateEyelidBones(Object* object, const Snapshot* snapshot,
     return true;
 }
 
-bool RigGenerator::applyRigBindings(Object* object, const Snapshot* snapshot, RigStructure* actualRig)
+bool RigGenerator::applyRigBindings(Object* object, const SnapshotView* snapshot, RigStructure* actualRig)
 {
     if (!object || !snapshot) {
         m_errorMessage = "Object or snapshot not initialized";
@@ -26,7 +26,7 @@
 #include <dust3d/base/bone_binding.h>
 #include <dust3d/base/matrix4x4.h>
 #include <dust3d/base/object.h>
-#include <dust3d/base/snapshot.h>
+#include <dust3d/base/snapshot_view.h>
 #include <dust3d/base/uuid.h>
 #include <map>
 #include <set>
@@ -56,7 +56,7 @@ struct RigStructure {
 // and calculates node-to-bone influence mappings.
 //
 // Workflow:
-// 1. Edges in Snapshot have "boneName" property
+// 1. Edges in the snapshot view have a bone name
 // 2. RigGenerator extracts node chains from these edge assignments
 // 3. Computes actual bone positions based on node locations
 // 4. Computes node-to-bone influences (which bones affect each node)
@@ -67,15 +67,15 @@ public:
     ~RigGenerator();
 
     // Generate rig: compute actual bone positions from edge assignments in snapshot
-    // input: snapshot - contains nodes, edges, and edges may have "boneName" property
+    // input: snapshot - parsed nodes and edges, edges may have a bone name
     // input: templateRig - the rig template structure (skeleton hierarchy)
     // output: actualRig - updated with computed bone positions based on snapshot edges
-    bool generateRig(const Snapshot* snapshot, const RigStructure& templateRig, RigStructure& actualRig);
+    bool generateRig(const SnapshotView* snapshot, const RigStructure& templateRig, RigStructure& actualRig);
 
     // Compute node-to-bone influences from snapshot edges
     // output: nodeBoneInfluences - maps node UUID -> bone influence
     // rigStructure is used to determine parent-child relationships for lerp weights
-    bool computeNodeBoneInfluences(const Snapshot* snapshot,
+    bool computeNodeBoneInfluences(const SnapshotView* snapshot,
         const RigStructure& rigStructure,
         std::map<Uuid, NodeBoneInfluence>& nodeBoneInfluences);
 
@@ -88,7 +88,7 @@ public:
     // Apply rig bindings to the generated mesh using the snapshot's edge bone assignments
     // This should be called after generate() to apply skeletal rig weights to vertices
     // If actualRig is provided and has foot bones, the model is grounded so feet touch Y=0
-    bool applyRigBindings(Object* object, const Snapshot* snapshot, RigStructure* actualRig = nullptr);
+    bool applyRigBindings(Object* object, const SnapshotView* snapshot, RigStructure* actualRig = nullptr);
 
     // Compute world transforms for each bone in rest pose
     // If a child bone begin position is different from parent end, it still uses its own rest position.
@@ -99,7 +99,7 @@ public:
     bool computeBoneInverseBindMatrices(const RigStructure& rigStructure,
         std::map<std::string, Matrix4x4>& inverseBindMatrices);
 
-    bool generateEyelidBones(Object* object, const Snapshot* snapshot, RigStructure& actualRig);
+    bool generateEyelidBones(Object* object, const SnapshotView* snapshot, RigStructure& actualRig);
 
     // Get error message from last operation
     const std::string& getErrorMessage() const { return m_errorMessage; }
@@ -115,52 +115,52 @@ private:
     // Helper: Extract all connected chains of nodes for a given bone name
     // Each chain is an ordered list of node UUIDs.
     // Multiple disconnected groups of edges produce multiple chains.
-    bool extractNodeChainsForBone(const Snapshot* snapshot,
+    bool extractNodeChainsForBone(const SnapshotView* snapshot,
         const std::string& boneName,
         std::vector<std::vector<Uuid>>& nodeChains);
 
     // Helper: Build node connectivity graph from edges with a given bone name
-    void buildNodeAdjacency(const Snapshot* snapshot,
+    void buildNodeAdjacency(const SnapshotView* snapshot,
         const std::string& boneName,
         std::map<Uuid, std::vector<Uuid>>& adjacency,
         std::set<Uuid>& allNodes);
 
     // Helper: Orient a chain so its end closest to refPoint comes first
-    void orientChainTowardPoint(const Snapshot* snapshot,
+    void orientChainTowardPoint(const SnapshotView* snapshot,
         std::vector<Uuid>& chain,
         float refX, float refY, float refZ);
 
     // Helper: Get position of a single node from the snapshot
-    bool getNodePosition(const Snapshot* snapshot, const Uuid& nodeId,
+    bool getNodePosition(const SnapshotView* snapshot, const Uuid& nodeId,
         float& x, float& y, float& z);
 
-    // Internal helper that tracks visited node ids to prevent mirror loops
-    bool getNodePositionInternal(const Snapshot* snapshot, const Uuid& nodeId,
-        float& x, float& y, float& z, std::set<std::string>& visited);
+    // Internal helper that tracks visited node indices to prevent mirror loops
+    bool getNodePositionInternal(const SnapshotView* snapshot, size_t nodeIndex,
+        float& x, float& y, float& z, std::set<size_t>& visited);
 
-    // Helper: Get all edges with a specific bone name
-    std::vector<const std::map<std::string, std::string>*> getEdgesWithBoneName(
-        const Snapshot* snapshot,
+    // Helper: Get indices of all edges with a specific bone name
+    std::vector<size_t> getEdgesWithBoneName(
+        const SnapshotView* snapshot,
         const std::string& boneName);
 
     // Helper: Check if node has edge with given boneName
-    bool nodeHasEdgeWithBoneName(const Snapshot* snapshot,
+    bool nodeHasEdgeWithBoneName(const SnapshotView* snapshot,
         const Uuid& nodeId,
         const std::string& boneName);
 
     // Helper: Get bone name from edge (or empty string if not assigned)
-    std::string getEdgeBoneName(const std::map<std::string, std::string>* edge);
+    std::string getEdgeBoneName(const SnapshotView::Edge* edge);
 
     // Helper: Compute lerp weight for a node influenced by two bones,
     // using rig hierarchy and bone semantics
     float computeTwoBoneLerp(const RigStructure& rigStructure,
         const std::string& bone1, const std::string& bone2,
-        const Snapshot* snapshot, const Uuid& nodeId);
+        const SnapshotView* snapshot, const Uuid& nodeId);
 
     // Helper: Find truly isolated nodes (no edges at all) that are nearest
     // to the given bone's edge-connected nodes, and append them as single-node chains.
     // Also records the mapping in m_singleNodeBoneMap for use by computeNodeBoneInfluences.
-    void attachSingleNodesToBone(const Snapshot* snapshot,
+    void attachSingleNodesToBone(const SnapshotView* snapshot,
         const std::string& boneName,
         const std::set<Uuid>& boneEdgeNodes,
         const std::set<Uuid>& allEdgeNodes,
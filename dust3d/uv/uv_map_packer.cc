@@ -35,87 +35,11 @@ void UvMapPacker::addPart(const Part& part)
     m_partTriangleUvs.push_back(part);
 }
 
-void UvMapPacker::addSeams(const std::vector<std::pair<std::set<std::array<PositionKey, 3>>, std::set<std::array<PositionKey, 3>>>>& seamTriangleUvs)
-{
-    for (const auto& it : seamTriangleUvs)
-        m_seams.push_back(it);
-}
-
-void UvMapPacker::resolveSeamUvs()
-{
-    struct TriangleUv {
-        size_t partIndex;
-        std::array<Vector2, 3> uv;
-    };
-
-    std::map<std::array<PositionKey, 2>, TriangleUv> halfEdgeToUvMap;
-    for (size_t partIndex = 0; partIndex < m_partTriangleUvs.size(); ++partIndex) {
-        const auto& part = m_partTriangleUvs[partIndex];
-        for (const auto& it : part.localUv) {
-            halfEdgeToUvMap.insert(std::make_pair(std::array<PositionKey, 2> {
-                                                      it.first[1], it.first[0] },
-                TriangleUv { partIndex, { it.second[1], it.second[0], it.second[2] } }));
-            halfEdgeToUvMap.insert(std::make_pair(std::array<PositionKey, 2> {
-                                                      it.first[2], it.first[1] },
-                TriangleUv { partIndex, { it.second[2], it.second[1], it.second[0] } }));
-            halfEdgeToUvMap.insert(std::make_pair(std::array<PositionKey, 2> {
-                                                      it.first[0], it.first[2] },
-                TriangleUv { partIndex, { it.second[0], it.second[2], it.second[1] } }));
-        }
-    }
-
-    // First pass: resolve large-side bridging triangles using the large edge (triangle[0]->triangle[1])
-    std::map<std::array<PositionKey, 2>, TriangleUv> newHalfEdgeToUvMap;
-    for (size_t seamIndex = 0; seamIndex < m_seams.size(); ++seamIndex) {
-        const auto& seam = m_seams[seamIndex];
-        for (const auto& triangle : seam.first) {
-            auto findUv = halfEdgeToUvMap.find({ triangle[0], triangle[1] });
-            if (findUv == halfEdgeToUvMap.end())
-                continue;
-            const auto& triangleUv = findUv->second;
-            m_partTriangleUvs[triangleUv.partIndex].localUv.insert({ triangle, triangleUv.uv });
-            newHalfEdgeToUvMap.insert({ { triangle[1], triangle[0] }, TriangleUv { triangleUv.partIndex, { triangleUv.uv[1], triangleUv.uv[0], triangleUv.uv[2] } } });
-            newHalfEdgeToUvMap.insert({ { triangle[2], triangle[1] }, TriangleUv { triangleUv.partIndex, { triangleUv.uv[2], triangleUv.uv[1], triangleUv.uv[0] } } });
-            newHalfEdgeToUvMap.insert({ { triangle[0], triangle[2] }, TriangleUv { triangleUv.partIndex, { triangleUv.uv[0], triangleUv.uv[2], triangleUv.uv[1] } } });
-        }
-    }
-
-    // Second pass: iteratively resolve small-side bridging triangles, propagating newly resolved edges
-    std::map<std::array<PositionKey, 2>, TriangleUv> resolvedSmallHalfEdgeToUvMap;
-    size_t resolvedCount;
-    do {
-        resolvedCount = 0;
-        for (size_t seamIndex = 0; seamIndex < m_seams.size(); ++seamIndex) {
-            const auto& seam = m_seams[seamIndex];
-            for (const auto& triangle : seam.second) {
-                for (size_t k = 0; k < 3; ++k) {
-                    auto findUv = newHalfEdgeToUvMap.find({ triangle[k], triangle[(k + 1) % 3] });
-                    if (findUv == newHalfEdgeToUvMap.end())
-                        continue;
-                    const auto& triangleUv = findUv->second;
-                    auto insertResult = m_partTriangleUvs[triangleUv.partIndex].localUv.insert({ triangle, triangleUv.uv });
-                    if (insertResult.second) {
-                        ++resolvedCount;
-                        resolvedSmallHalfEdgeToUvMap.insert({ { triangle[1], triangle[0] }, TriangleUv { triangleUv.partIndex, { triangleUv.uv[1], triangleUv.uv[0], triangleUv.uv[2] } } });
-                        resolvedSmallHalfEdgeToUvMap.insert({ { triangle[2], triangle[1] }, TriangleUv { triangleUv.partIndex, { triangleUv.uv[2], triangleUv.uv[1], triangleUv.uv[0] } } });
-                        resolvedSmallHalfEdgeToUvMap.insert({ { triangle[0], triangle[2] }, TriangleUv { triangleUv.partIndex, { triangleUv.uv[0], triangleUv.uv[2], triangleUv.uv[1] } } });
-                    }
-                    break;
-                }
-            }
-        }
-        for (const auto& it : resolvedSmallHalfEdgeToUvMap)
-            newHalfEdgeToUvMap.insert(it);
-    } while (resolvedCount > 0);
-}
-
 void UvMapPacker::pack()
 {
     if (m_partTriangleUvs.empty())
         return;
 
-    resolveSeamUvs();
-
     std::vector<std::pair<float, float>> chartSizes(m_partTriangleUvs.size());
     for (size_t i = 0; i < m_partTriangleUvs.size(); ++i) {
         const auto& part = m_partTriangleUvs[i];
@@ -161,8 +85,9 @@ void UvMapPacker::pack()
             }
             std::swap(partWidth, partHeight);
         }
+        layout.globalUv.reserve(part.localUv.size());
         for (const auto& it : part.localUv) {
-            layout.globalUv.insert({ it.first,
+            layout.globalUv.push_back({ it.first,
                 std::array<Vector2, 3> {
                     Vector2((left * m_packedTextureSize + it.second[0].x() * partWidth) / m_packedTextureSize,
                         (top * m_packedTextureSize + it.second[0].y() * partHeight) / m_packedTextureSize),
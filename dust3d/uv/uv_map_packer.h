@@ -25,12 +25,8 @@
 
 #include <array>
 #include <dust3d/base/color.h>
-#include <dust3d/base/position_key.h>
 #include <dust3d/base/uuid.h>
 #include <dust3d/base/vector2.h>
-#include <map>
-#include <set>
-#include <unordered_map>
 #include <vector>
 
 namespace dust3d {
@@ -42,7 +38,8 @@ public:
         Color color;
         double width = 0.0;
         double height = 0.0;
-        std::map<std::array<PositionKey, 3>, std::array<Vector2, 3>> localUv;
+        // Uvs of the object triangles in this chart, by triangle index
+        std::vector<std::pair<size_t, std::array<Vector2, 3>>> localUv;
     };
 
     struct Layout {
@@ -53,12 +50,11 @@ public:
         double width = 0.0;
         double height = 0.0;
         bool flipped = false;
-        std::map<std::array<PositionKey, 3>, std::array<Vector2, 3>> globalUv;
+        std::vector<std::pair<size_t, std::array<Vector2, 3>>> globalUv;
     };
 
     UvMapPacker();
     void addPart(const Part& part);
-    void addSeams(const std::vector<std::pair<std::set<std::array<PositionKey, 3>>, std::set<std::array<PositionKey, 3>>>>& seamTriangleUvs);
     void pack();
     const std::vector<Layout>& packedLayouts();
     double packedTextureSize();
@@ -66,10 +62,7 @@ public:
 private:
     std::vector<Part> m_partTriangleUvs;
     std::vector<Layout> m_packedLayouts;
-    std::vector<std::pair<std::set<std::array<PositionKey, 3>>, std::set<std::array<PositionKey, 3>>>> m_seams;
     double m_packedTextureSize = 0.0;
-
-    void resolveSeamUvs();
 };
 
 }